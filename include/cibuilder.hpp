@@ -67,6 +67,10 @@ namespace ChronusQ {
     virtual void computeOneRDM(MCWaveFunction<MatsT, IntsT> &, MatsT *, SquareMatrix<MatsT> &) = 0;
     virtual void computeTwoRDM(MCWaveFunction<MatsT, IntsT> &, MatsT *, InCore4indexTPI<MatsT> &) = 0;
     virtual void computeTDM(MCWaveFunction<MatsT, IntsT> &, MatsT *, MatsT *, SquareMatrix<MatsT> &) = 0;
+
+    // Densities of several CI vectors in a single pass (see cibuilder/impl.hpp)
+    virtual void computeDensities(MCWaveFunction<MatsT, IntsT> &, const std::vector<MatsT*> &,
+      const std::vector<double> &, bool, MatsT *, InCore4indexTPI<MatsT> *);
   }; // class CIBuilder
   
 
@@ -75,5 +79,6 @@ namespace ChronusQ {
 // Include declaration for specialization of CIBuilder
 #include <cibuilder/casci.hpp>
 #include <cibuilder/rasci.hpp>
+#include <cibuilder/selectedci.hpp>
 
 
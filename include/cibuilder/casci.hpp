@@ -34,6 +34,24 @@ namespace ChronusQ {
   template <typename MatsT, typename IntsT>
   class CASCI: public CIBuilder<MatsT,IntsT> {
       
+  private:
+    // CASCI sigma helper functions
+    MatsT * SigmaScratch(CQMemManager &, size_t, size_t, size_t &);
+    void SigmaBlockRange(MPI_Comm, size_t, size_t &, size_t &);
+    void SigmaSameSpin(MCWaveFunction<MatsT, IntsT> &, const CASStringManager &,
+            size_t, MatsT *, MatsT *);
+    void SigmaOppositeSpin(MCWaveFunction<MatsT, IntsT> &, const CASStringManager &,
+            const CASStringManager &, size_t, MatsT *, MatsT *);
+
+    // CASCI diagonal helper function
+    void DiagSameSpin(MCWaveFunction<MatsT, IntsT> &, const CASStringManager &,
+            MatsT *, std::vector<int> &);
+
+    // CASCI density helper function
+    void densityGEMM(MCWaveFunction<MatsT, IntsT> &, const std::vector<MatsT*> &,
+            const std::vector<MatsT*> &, const std::vector<double> &, MatsT *,
+            InCore4indexTPI<MatsT> *);
+
   public:
     // Constructors
 
@@ -60,6 +78,8 @@ namespace ChronusQ {
     void computeOneRDM(MCWaveFunction<MatsT, IntsT> &, MatsT *, SquareMatrix<MatsT> &);
     void computeTwoRDM(MCWaveFunction<MatsT, IntsT> &, MatsT *, InCore4indexTPI<MatsT> &);
     void computeTDM(MCWaveFunction<MatsT, IntsT> &, MatsT *, MatsT *, SquareMatrix<MatsT> &);
+    void computeDensities(MCWaveFunction<MatsT, IntsT> &, const std::vector<MatsT*> &,
+      const std::vector<double> &, bool, MatsT *, InCore4indexTPI<MatsT> *);
   }; // class CASCI
 
 }; // namespace ChronusQ
@@ -27,6 +27,8 @@
 #include <particleintegrals/twopints/incore4indextpi.hpp>
 #include <detstringmanager.hpp>
 #include <cibuilder/casci.hpp>
+#include <cibuilder/casci/sigma.hpp>
+#include <cibuilder/casci/rdm.hpp>
 #include <cqlinalg/blas1.hpp>
 #include <cqlinalg/blas3.hpp>
 #include <cqlinalg/blasutil.hpp>
@@ -236,277 +238,199 @@ namespace ChronusQ {
   
   }; // CASCI::buildFullH
 
+  /*
+   *  Same-spin (alpha, beta or the whole 2C/4C) part of the diagonal,
+   *
+   *    H_LL = sum_k <L|E_kk|L> h'_kk + 1/2 sum_kl <L|E_lk|K><K|E_kl|L> (lk|kl)
+   *         + 1/2 sum_ik <L|E_ii|L><L|E_kk|L> (ii|kk),  K = E_kl L != L
+   *
+   *  i.e. only the excitation list of L itself is needed, which is
+   *  consumed string block by string block as in the sigma build. The
+   *  occupied orbitals of every string (nElectron per string, the E_kk
+   *  entries of its list) are returned in occ for the alpha-beta part.
+   */
+  template <typename MatsT, typename IntsT>
+  void CASCI<MatsT,IntsT>::DiagSameSpin(MCWaveFunction<MatsT, IntsT> & mcwfn,
+    const CASStringManager & detStr, MatsT * diagH, std::vector<int> & occ) {
+
+    auto & hCoreP = *(mcwfn.moints.template getIntegral<OnePInts, MatsT>("hCoreP_Correlated_Space"));
+    auto & moERI  = *(mcwfn.moints.template getIntegral<InCore4indexTPI, MatsT>("ERI_Correlated_Space"));
+
+    const size_t nStr    = detStr.nString();
+    const size_t nE      = detStr.nElectron();
+    const size_t nNZ     = detStr.nNonZero();
+    const size_t nStrBlk = detStr.stringBlockSize();
+    const size_t exDim   = 4 * nNZ;
+
+    ExcitationList exBlk(mcwfn.memManager, 4, nNZ,
+      (detStr.scheme() == COMPUTING_EXCITATION_ON_THE_FLY) ? nStrBlk : 1);
+
+    occ.assign(nStr * nE, 0);
+
+    int k, l, K;
+    double sign;
+
+    for (auto sBlk = 0ul; sBlk < nStr; sBlk += nStrBlk) {
+
+      const size_t nS = std::min(nStrBlk, nStr - sBlk);
+      const int * exList_B = detStr.excitationListBlock(sBlk, nS, exBlk);
+
+      #pragma omp parallel for schedule(static) default(shared) private(k, l, K, sign)
+      for (size_t Ls = 0; Ls < nS; Ls++) {
+
+        const int L = sBlk + Ls;
+        int * occL = occ.data() + nE * L;
+
+        // occupied orbitals
+        const int * exList_L = exList_B + Ls * exDim;
+        for (auto iNZ = 0ul, iE = 0ul; iNZ < nNZ; iNZ++, exList_L += 4) {
+          UNPACK_EXCITATIONLIST_4(exList_L, k, l, K, sign);
+          if (K == L) occL[iE++] = k;
+        }
+
+        MatsT SCR = MatsT(0.);
+        exList_L = exList_B + Ls * exDim;
+        for (auto iNZ = 0ul; iNZ < nNZ; iNZ++, exList_L += 4) {
+
+          UNPACK_EXCITATIONLIST_4(exList_L, k, l, K, sign);
+          if (K == L) {
+            SCR += sign * hCoreP(k, l);
+            for (auto iE = 0ul; iE < nE; iE++)
+              SCR += 0.5 * moERI(occL[iE], occL[iE], k, k);
+          } else SCR += 0.5 * moERI(l, k, k, l);
+
+        }
+
+        diagH[L] = SCR;
+
+      } // L
+
+    } // sBlk
+
+  } // CASCI::DiagSameSpin
+
   /*  
    *  Build Diagonal CASCI Hamiltonian 
+   *
+   *  The excitation lists are consumed string block by string block
+   *  (see DiagSameSpin), the full lists are not built for
+   *  COMPUTING_EXCITATION_ON_THE_FLY
    */ 
   template <typename MatsT, typename IntsT>
   void CASCI<MatsT,IntsT>::buildDiagH(MCWaveFunction<MatsT, IntsT> & mcwfn, MatsT * diagH) {  
     
-    CASCI_LOOP_INIT(); // check top for variable definitions
-    
-    auto & hCoreP = *(mcwfn.moints.template getIntegral<OnePInts, MatsT>("hCoreP_Correlated_Space"));
     auto & moERI  = *(mcwfn.moints.template getIntegral<InCore4indexTPI, MatsT>("ERI_Correlated_Space"));
 
-	// Allocate SCR
-    MatsT SCR;
+    const size_t nC = mcwfn.reference().nC;
+    const size_t nO = moERI.nBasis();
+    CQMemManager & mem = mcwfn.memManager;
 
-    // empty CI Diagonal Hamiltonian
-    std::fill_n(diagH, nStr_a, MatsT(0.));
-    // Alpha Part for 1C or the whole build for 2C and 4C
-    
-    int i, j, k, l, La, Lb, Ka, Kb, Ja, Jb;
-    double signij, signkl;
-    double small_number = std::numeric_limits<double>::epsilon();
-    
-#pragma omp parallel for schedule(static) default(shared) private(SCR, La, k, l, Ka, signkl, i, j, Ja, signij)  
-    for (La = 0; La < nStr_a; La++) {
-      
-      const int * exList_La = exList_a->pointerAtDet(La);
-      SCR = MatsT(0.); 
-      for (auto Ekl = 0ul; Ekl < nNZa; Ekl++, exList_La+=4) {
-        
-        UNPACK_EXCITATIONLIST_4(exList_La, k, l, Ka, signkl);
-	    if(Ka == La) SCR += signkl * hCoreP(k, l);
+    auto detStr_a = std::dynamic_pointer_cast<CASStringManager>(mcwfn.detStr);
+    const size_t nStr_a = detStr_a->nString();
 
-        const int * exList_Ka = exList_a->pointerAtDet(Ka);
-	    for (auto Eij = 0ul; Eij < nNZa; Eij++, exList_Ka+=4) {
-            
-          UNPACK_EXCITATIONLIST_4(exList_Ka, i, j, Ja, signij);
-	      if(Ja == La) SCR += 0.5 * signij * signkl * moERI(i, j, k, l); 
-	    }
-       }
-      
-      // update diagH
-      diagH[La] = SCR;
-    
-    }  // La
+    // Alpha Part for 1C or the whole build for 2C and 4C
+    std::vector<int> occ_a, occ_b;
+    DiagSameSpin(mcwfn, *detStr_a, diagH, occ_a);
     
     if (nC != 1) { 
 #ifdef _DEBUG_CIENGINE_CASCI_IMPL
-      prettyPrintSmart(std::cout,"HH full CASCI Hamiltonian",diagH, NDet, 1, NDet);
+      prettyPrintSmart(std::cout,"HH full CASCI Hamiltonian",diagH, mcwfn.NDet, 1, mcwfn.NDet);
 #endif
       return;
     }
-    // 1C Continued: Expand Alpha Part 
-    //    (Ka) -> (Ka, Kb)
-    MatsT * dH = diagH + nStr_a;
-    for (Kb = 1; Kb < nStr_b; Kb++, dH+=nStr_a) std::copy_n(diagH, nStr_a, dH);
-     
-    MatsT * tmpdH  = mcwfn.memManager.template malloc<MatsT>(nStr_b);
 
-    // 1C Continued: build Beta part
-    std::fill_n(tmpdH, nStr_b, MatsT(0.));
-#pragma omp parallel for schedule(static) default(shared) private(SCR, Lb, k, l, Kb, signkl, i, j, Jb, signij)  
-    for (Lb = 0; Lb < nStr_b; Lb++) {
-      
-      SCR = MatsT(0.); 
-      const int * exList_Lb = exList_b->pointerAtDet(Lb);
-      for (auto Ekl = 0ul; Ekl < nNZb; Ekl++, exList_Lb+=4) {
-        
-        UNPACK_EXCITATIONLIST_4(exList_Lb, k, l, Kb, signkl);
-	    if(Kb == Lb) SCR += signkl * hCoreP(k, l);
-       
-        const int * exList_Kb = exList_b->pointerAtDet(Kb);
-	    for (auto Eij = 0ul; Eij < nNZb; Eij++, exList_Kb+=4) {
-            
-          UNPACK_EXCITATIONLIST_4(exList_Kb, i, j, Jb, signij);
-	      if(Jb == Lb) SCR += 0.5 * signij * signkl * moERI(i, j, k, l); 
-	    }
-      }
-     
-      // update diagH
-      tmpdH[Lb] = SCR;
-    
-    }  // Lb
-    
-    // 1C Continued: Expand Beta Part 
-    // transpose diagH: (Ka, Kb) -> (Kb, Ka) 
-    IMatCopy('T', nStr_a, nStr_b, MatsT(1.), diagH, nStr_a, nStr_b);  
-    
-    // Expand
-    dH = diagH;
-    for (Ka = 0; Ka < nStr_a; Ka++)  
-    for (Kb = 0; Kb < nStr_b; Kb++, dH++)
-      *dH += tmpdH[Kb];
-    
-    // transpose diagH: (Kb, Ka) -> (Ka, Kb) 
-    IMatCopy('T', nStr_b, nStr_a, MatsT(1.), diagH, nStr_b, nStr_a);  
-    
-    mcwfn.memManager.free(tmpdH);
-    
-    // 1C Continued: Alpha-Beta and Beta-Aphla Part 
-    size_t nActEa = mcwfn.MOPartition.nCorrEA;
-    size_t nActEb = mcwfn.MOPartition.nCorrEB;
-#pragma omp parallel for schedule(static) default(shared) \
-  private(dH, Lb, k, l, Kb, signkl, La, i, j, Ka, signij)  
-    for(Lb = 0; Lb < nStr_b; Lb++) {
-      
-      dH = diagH + Lb*nStr_a;
-      const int * exList_Lb_head = exList_b->pointerAtDet(Lb);
+    // 1C Continued: Beta part
+    auto detStr_b = std::dynamic_pointer_cast<CASStringManager>(mcwfn.detStrBeta);
+    const size_t nStr_b = detStr_b->nString();
+    const size_t nE_a   = detStr_a->nElectron();
+    const size_t nE_b   = detStr_b->nElectron();
 
-      for(La = 0; La < nStr_a;  La++, dH++) {
-        
-        const int * exList_La_head = exList_a->pointerAtDet(La);
-      
-        auto exList_Lb = exList_Lb_head; 
-        for(auto Ekl = 0ul; Ekl < nActEa; Ekl++, exList_Lb+=4) {
-	
-          UNPACK_EXCITATIONLIST_4(exList_Lb, k, l, Kb, signkl);
-          const int * exList_La = exList_La_head; 
-        
-	      for (auto Eij = 0ul; Eij < nActEb; Eij++, exList_La+=4) {
-            
-            UNPACK_EXCITATIONLIST_4(exList_La, i, j, Ka, signij);
-            *dH += signij * signkl * moERI(i, j, k, l); 
-          }
+    MatsT * dH_a = mem.template malloc<MatsT>(nStr_a + nStr_b);
+    MatsT * dH_b = dH_a + nStr_a;
+    std::copy_n(diagH, nStr_a, dH_a);
+    DiagSameSpin(mcwfn, *detStr_b, dH_b, occ_b);
+
+    // 1C Continued: Alpha-Beta part (ii|kk), i in La and k in Lb
+    #pragma omp parallel default(shared)
+    {
+      std::vector<MatsT> J(nO);
+
+      #pragma omp for schedule(static)
+      for (size_t Lb = 0; Lb < nStr_b; Lb++) {
+
+        const int * occLb = occ_b.data() + nE_b * Lb;
+        for (auto i = 0ul; i < nO; i++) {
+          J[i] = MatsT(0.);
+          for (auto iE = 0ul; iE < nE_b; iE++)
+            J[i] += moERI(i, i, occLb[iE], occLb[iE]);
         }
-      }
+
+        MatsT * dH = diagH + Lb * nStr_a;
+        for (size_t La = 0; La < nStr_a; La++) {
+          const int * occLa = occ_a.data() + nE_a * La;
+          MatsT SCR = dH_a[La] + dH_b[Lb];
+          for (auto iE = 0ul; iE < nE_a; iE++) SCR += J[occLa[iE]];
+          dH[La] = SCR;
+        }
+
+      } // Lb
     }
+
+    mem.free(dH_a);
+
   }; // CASCI::buildDiagH
   
   /*
    *  Sigma, Matrix-vector product
+   *
+   *  All nVec trial vectors are handled at once through the
+   *  D = <I|E_kl|C>, G = (ij|kl) D GEMM intermediates, see
+   *  cibuilder/casci/sigma.hpp
    */
 
   template <typename MatsT, typename IntsT>
   void CASCI<MatsT,IntsT>::buildSigma(MCWaveFunction<MatsT, IntsT> & mcwfn, 
     size_t nVec, MatsT * C, MatsT * Sigma) {
     
-    CASCI_LOOP_INIT(); // check top for variable definitions
-    
-    auto & hCoreP = *(mcwfn.moints.template getIntegral<OnePInts,MatsT>("hCoreP_Correlated_Space"));
-    auto & moERI  = *(mcwfn.moints.template getIntegral<InCore4indexTPI,MatsT>("ERI_Correlated_Space"));
+    // No CASCI_LOOP_INIT here: the excitation lists may be generated
+    // on the fly by the string managers
+    size_t nC = mcwfn.reference().nC;
+    size_t NDet = mcwfn.NDet;
+    auto detStr_a = std::dynamic_pointer_cast<CASStringManager>(mcwfn.detStr);
+    auto detStr_b = (nC == 1) ?
+      std::dynamic_pointer_cast<CASStringManager>(mcwfn.detStrBeta) : nullptr;
+    size_t nStr_a = detStr_a->nString();
+    size_t nStr_b = (detStr_b) ? detStr_b->nString(): 1;
 
 #ifdef DEBUG_CI_SIGMA
     prettyPrintSmart(std::cout,"HH CASCI Sigma Build -- C", C, NDet, nVec, NDet);
 #endif
     
-    // Allocate SCR
-    size_t nSCR = std::max(nStr_a, nStr_b);
-    size_t nThreads = GetLAThreads();
-    MatsT * SCR  = mcwfn.memManager.template malloc<MatsT>(nSCR * nThreads);
-
     // empty Sigma
     std::fill_n(Sigma, NDet*nVec, MatsT(0.));
+
     // Alpha Part for 1C or the whole build for 2C and 4C
-    // NOTE: exList_ are row-majored c++ objects 
-    
-    int i, j, k, l, La, Lb, Ka, Kb, Ja, Jb;
-    double signij, signkl;
-    double small_number = std::numeric_limits<double>::epsilon();
-    
-    MatsT *HC, *Ci, *SCR_ith;
-    
-    // SCR_ith is a row of H instead of a column now
-#pragma omp parallel default(shared) private(HC, Ci, SCR_ith, La, k, l, Ka, signkl, \
-  i, j, Ja, signij, Kb)
-    {
-      auto iThread = GetThreadID();
-      SCR_ith = SCR + nSCR * iThread;
-      for (Ka = iThread; Ka < nStr_a; Ka+=nThreads) {
-      
-        std::fill_n(SCR_ith, nStr_a, MatsT(0.));
-        const int * exList_Ka = exList_a->pointerAtDet(Ka);
-        for (auto Ekl = 0ul; Ekl < nNZa; Ekl++, exList_Ka+=4) {
-        
-          UNPACK_EXCITATIONLIST_4(exList_Ka, l, k, La, signkl);
-	      SCR_ith[La] += signkl * hCoreP(k, l);
-       
-          const int * exList_La = exList_a->pointerAtDet(La);
-	      for (auto Eij = 0ul; Eij < nNZa; Eij++, exList_La+=4) {
-            
-            UNPACK_EXCITATIONLIST_4(exList_La, j, i, Ja, signij);
-	        SCR_ith[Ja] += 0.5 * signij * signkl * moERI(i, j, k, l); 
-	      }
-        }
-        
-        // passive screening 
-        std::vector<int> SCR_nonZero_ith;
-        for (La = 0 ; La < nStr_a;  La++) {
-          if (std::abs(SCR_ith[La]) > small_number) 
-	        SCR_nonZero_ith.push_back(La);
-        }
-        
-        // update Sigma
-        HC = Sigma;
-        Ci = C;
-        if(nC != 1) {  // for more than 1C
-          for (auto iVec = 0ul; iVec < nVec; iVec++, HC+=NDet, Ci+=NDet) 
-          for (auto iSCR = 0ul; iSCR < SCR_nonZero_ith.size(); iSCR++) {
-	        La = SCR_nonZero_ith[iSCR]; 
-	        HC[Ka] += SCR_ith[La] * Ci[La]; 
-          }	
-        } else { // 1C
-          for (auto iVec = 0ul; iVec < nVec; iVec++) 
-          for (Kb = 0; Kb < nStr_b; Kb++, HC+=nStr_a, Ci+=nStr_a)
-	      for (auto iSCR = 0ul; iSCR < SCR_nonZero_ith.size(); iSCR++) {
-	        La = SCR_nonZero_ith[iSCR]; 
-	        HC[Ka] += SCR_ith[La] * Ci[La]; 
-          }	
-        } 
-      }  // La
-    }
+    SigmaSameSpin(mcwfn, *detStr_a, nStr_b * nVec, C, Sigma);
 
     if (nC != 1) {
        
 #ifdef DEBUG_CI_SIGMA
     prettyPrintSmart(std::cout,"HH CASCI Sigma Build -- Sigma", Sigma, NDet, nVec, NDet);
 #endif
-       mcwfn.memManager.free(SCR);
        return;
     } 
     
     // 1C Continued: Build Beta part
     
-    // transpose sigma and C to make update continuous in inner loop
+    // transpose sigma and C to make the beta strings contiguous
     // (a, b) -> (b, a) 
-    HC = Sigma;
-    Ci = C;
+    MatsT *HC = Sigma, *Ci = C;
     for (auto iVec = 0ul; iVec < nVec; iVec++, HC+=NDet, Ci+=NDet) {
       IMatCopy('T', nStr_a, nStr_b, MatsT(1.), HC, nStr_a, nStr_b);  
       IMatCopy('T', nStr_a, nStr_b, MatsT(1.), Ci, nStr_a, nStr_b);  
     }
 
-#pragma omp parallel default(shared) private(HC, Ci, SCR_ith, Lb, k, l, Kb, signkl, \
-  i, j, Jb, signij, Ka)
-    {
-      auto iThread = GetThreadID();
-      SCR_ith = SCR + nSCR * iThread;
-      for (Kb = iThread; Kb < nStr_b; Kb+=nThreads) {
-        
-        std::fill_n(SCR_ith, nStr_b, MatsT(0.));
-        const int * exList_Kb = exList_b->pointerAtDet(Kb);
-        for (auto Ekl = 0ul; Ekl < nNZb; Ekl++, exList_Kb+=4) {
-          
-          UNPACK_EXCITATIONLIST_4(exList_Kb, l, k, Lb, signkl);
-	      SCR_ith[Lb] += signkl * hCoreP(k,l);
-         
-          const int * exList_Lb = exList_b->pointerAtDet(Lb);
-	      for (auto Eij = 0ul; Eij < nNZb; Eij++, exList_Lb+=4) {
-              
-            UNPACK_EXCITATIONLIST_4(exList_Lb, j, i, Jb, signij);
-	        SCR_ith[Jb] += 0.5 * signij * signkl * moERI(i, j, k, l); 
-	      }
-        }
-       
-        // passive screening 
-        std::vector<int> SCR_nonZero_ith;
-        for (Lb = 0 ; Lb < nStr_b;  Lb++) {
-          if (std::abs(SCR_ith[Lb]) > small_number) 
-	        SCR_nonZero_ith.push_back(Lb);
-        }
-        
-        // update Sigma
-        HC = Sigma;
-        Ci = C;
-        for (auto iVec = 0ul; iVec < nVec; iVec++) 
-        for (Ka = 0; Ka < nStr_a; Ka++, HC+=nStr_b, Ci+=nStr_b)
-        for (auto iSCR = 0ul; iSCR < SCR_nonZero_ith.size(); iSCR++) {
-          Lb = SCR_nonZero_ith[iSCR]; 
-          HC[Kb] += SCR_ith[Lb] * Ci[Lb]; 
-        }	
-      }  // Lb
-    }
+    SigmaSameSpin(mcwfn, *detStr_b, nStr_a * nVec, C, Sigma);
 
     // transpose sigma and C back
     HC = Sigma;
@@ -517,48 +441,8 @@ namespace ChronusQ {
       IMatCopy('T', nStr_b, nStr_a, MatsT(1.), Ci, nStr_b, nStr_a);  
     }
 
-    mcwfn.memManager.free(SCR);
-
     // 1C Continued: Alpha-Beta and Beta-Aphla Part 
-    // TODO: try to vectorized the loop
-#pragma omp parallel default(shared) private(HC, Ci, SCR_ith, Lb, k, l, Kb, signkl, \
-  i, j, La, signij, Ka)
-    {  
-      MatsT tmpH;
-      int KAddr, LAddr;
-      auto iThread = GetThreadID();
-      for(Kb = iThread; Kb < nStr_b; Kb+=nThreads) { 
-        
-        const int * exList_Kb_head = exList_b->pointerAtDet(Kb);
-       
-        for(Ka = 0, KAddr = Kb * nStr_a; Ka < nStr_a; Ka++, KAddr++) {
-          
-          const int * exList_Ka_head = exList_a->pointerAtDet(Ka);
-          
-          auto exList_Kb = exList_Kb_head;
-          for(auto Ekl = 0ul; Ekl < nNZb; Ekl++, exList_Kb+=4) {
-         
-            UNPACK_EXCITATIONLIST_4(exList_Kb, l, k, Lb, signkl);
-            
-            auto exList_Ka = exList_Ka_head;
-	        for (auto Eij = 0ul; Eij < nNZa; Eij++, exList_Ka+=4) {
-
-              UNPACK_EXCITATIONLIST_4(exList_Ka, j, i, La, signij);
-
-              tmpH  = signij * signkl * moERI(i, j, k, l);
-	  
-              if (std::abs(tmpH) > small_number) {
-                HC    = Sigma;
-                Ci    = C;
-                LAddr = La + Lb*nStr_a;
-                for (auto iVec = 0ul; iVec < nVec; iVec++, HC+=NDet, Ci+=NDet) 
-                  HC[KAddr] += tmpH*Ci[LAddr]; 
-              }
-            }
-          }
-        }  
-      }
-    }
+    SigmaOppositeSpin(mcwfn, *detStr_a, *detStr_b, nVec, C, Sigma);
 
 #ifdef DEBUG_CI_SIGMA
     prettyPrintSmart(std::cout,"HH Sigma Hamiltonian -- Sigma", Sigma, NDet, nVec, NDet);
@@ -578,164 +462,15 @@ namespace ChronusQ {
   void CASCI<MatsT,IntsT>::computeTwoRDM(MCWaveFunction<MatsT, IntsT> & mcwfn, 
     MatsT * C, InCore4indexTPI<MatsT> & twoRDM) {
        
-    CASCI_LOOP_INIT(); // check top for variable definitions
-    
-    
-    size_t nThreads = GetLAThreads();
-    std::vector<InCore4indexTPI<MatsT>> SCR;
-    auto nDim  = twoRDM.nBasis();
-    for (auto i = 0ul; i < nThreads; i++)
-      SCR.emplace_back(mcwfn.memManager, nDim);
-
-    // alpha-alpha part
-    int i, j, k, l, La, Lb, Ka, Kb, Ja, Jb;
-    double signij, signkl;
-#pragma omp parallel default(shared) private(i, j, k, l, La, Ka, Ja, Lb,\
-  signij, signkl)
-    {
-      auto iThread = GetThreadID();
-      auto & tmpRDM = SCR[iThread];
-      tmpRDM.clear();
-      for (La = iThread; La < nStr_a; La+=nThreads) {
-        
-        const int * exList_La = exList_a->pointerAtDet(La);
-        for (auto Ekl = 0ul; Ekl < nNZa; Ekl++, exList_La+=4) {
-          
-          UNPACK_EXCITATIONLIST_4(exList_La, k, l, Ka, signkl);
-          const int * exList_Ka = exList_a->pointerAtDet(Ka);
-   	  
-          for (auto Eij = 0ul; Eij < nNZa; Eij++, exList_Ka+=4) {
-              
-            UNPACK_EXCITATIONLIST_4(exList_Ka, i, j, Ja, signij);
-          
-            auto tmp = MatsT(0.); 
-            for (auto Lb = 0; Lb < nStr_b; Lb++) 
-              tmp += SmartConj(C[Ja + Lb*nStr_a]) * C[La + Lb*nStr_a];
-            
-            tmpRDM(i, j, k, l) += tmp * signkl * signij; 
-	      }
-        }
-      }
-    }
-
+    densityGEMM(mcwfn, {}, {C}, {1.}, nullptr, &twoRDM);
 
-    if (nC == 1) {
-    
-#pragma omp parallel default(shared) private(i, j, k, l, Lb, Kb, Jb, La, Ka, \
-  signij, signkl)
-      {
-        auto iThread = GetThreadID();
-        auto & tmpRDM = SCR[iThread];
-        for (Lb = iThread; Lb < nStr_b; Lb+=nThreads) {
-          
-          const int * exList_Lb = exList_b->pointerAtDet(Lb);
-          for (auto Ekl = 0ul; Ekl < nNZb; Ekl++, exList_Lb+=4) {
-            
-            UNPACK_EXCITATIONLIST_4(exList_Lb, k, l, Kb, signkl);
-            
-            // beta-beta part
-            const int * exList_Kb = exList_b->pointerAtDet(Kb);
-            for (auto Eij = 0ul; Eij < nNZb; Eij++, exList_Kb+=4) {
-              
-              UNPACK_EXCITATIONLIST_4(exList_Kb, i, j, Jb, signij);
-              
-              auto tmp = MatsT(0.);
-              for (La = 0; La < nStr_a; La++) 
-                tmp += SmartConj(C[La + Jb*nStr_a]) * C[La + Lb*nStr_a];
-
-              tmpRDM(i, j, k, l) += tmp * signkl * signij; 
-            }
-          
-            // alpha-beta and beta-alpha part
-            for(La = 0; La < nStr_a; La++) {
-              const int * exList_La = exList_a->pointerAtDet(La);
-	          for (auto Eij = 0ul; Eij < nNZa; Eij++, exList_La+=4) {
-                
-                UNPACK_EXCITATIONLIST_4(exList_La, i, j, Ka, signij);
-                tmpRDM(i, j, k, l) += 2.0 * signkl * signij *  SmartConj(C[Ka + Kb*nStr_a]) * C[La + Lb*nStr_a];
-              }
-            }
-          
-          }
-        }
-      } 
-    } 
-    
-    twoRDM.clear();
-    auto nDim2 = nDim * nDim;
-    auto nDim4 = nDim2 * nDim2;
-    for (auto i = 0ul; i < nThreads; i++) 
-      blas::axpy(nDim4, 1.0, SCR[i].pointer(), 1, twoRDM.pointer(), 1);
-    
-    return;
   } // CASCI::computeTwoRDM 
 
   template <typename MatsT, typename IntsT>
   void CASCI<MatsT,IntsT>::computeTDM(MCWaveFunction<MatsT, IntsT> & mcwfn, MatsT * Cm,
         MatsT * Cn, SquareMatrix<MatsT> & TDM) {
 
-    CASCI_LOOP_INIT(); // check top for variable definitions
-
-    size_t nThreads = GetLAThreads();
-    std::vector<SquareMatrix<MatsT>> SCR;
-    for (auto i = 0ul; i < nThreads; i++)
-      SCR.emplace_back(mcwfn.memManager, TDM.dimension());
-
-    // alpha part 
-    int k, l, La, Lb, Ka, Kb;
-    double signkl;
-#pragma omp parallel default(shared) private(La, Lb, k, l, Ka, signkl)
-    {
-      auto iThread = GetThreadID();
-      auto & tmpRDM = SCR[iThread];
-      tmpRDM.clear();
-      for (La = iThread; La < nStr_a; La+=nThreads) {
-
-        const int * exList_La = exList_a->pointerAtDet(La);
-
-        for (auto Ekl = 0ul; Ekl < nNZa; Ekl++, exList_La+=4) {
-
-          UNPACK_EXCITATIONLIST_4(exList_La, k, l, Ka, signkl);
-
-          auto tmp = MatsT(0.);
-          for (Lb = 0; Lb < nStr_b; Lb++)
-            tmp += SmartConj(Cm[Ka + Lb*nStr_a]) * Cn[La + Lb*nStr_a];
-
-          tmpRDM(k, l) += tmp * signkl;
-        }
-      }
-    }
-
-    if (nC == 1) {
-    // beta part
-#pragma omp parallel default(shared) private(La, Lb, k, l, Kb, signkl)
-      {
-        auto iThread = GetThreadID();
-        auto & tmpRDM = SCR[iThread];
-        for (Lb = iThread; Lb < nStr_b; Lb+=nThreads) {
-
-          const int * exList_Lb = exList_b->pointerAtDet(Lb);
-          for (auto Ekl = 0ul; Ekl < nNZb; Ekl++, exList_Lb+=4) {
-
-            UNPACK_EXCITATIONLIST_4(exList_Lb, k, l, Kb, signkl);
-
-            auto tmp = MatsT(0.);
-            for (La = 0; La < nStr_a; La++)
-              tmp += SmartConj(Cm[La + Kb*nStr_a]) * Cn[La + Lb*nStr_a];
-
-            tmpRDM(k, l) += tmp * signkl;
-          }
-        }
-      }
-    }
-
-    TDM.clear();
-    for (auto i = 0ul; i < nThreads; i++) TDM += SCR[i];
-
-    //prettyPrintSmart(std::cout,"PT2 TDM", TDM.pointer(), TDM.dimension(),
-    //            TDM.dimension(), TDM.dimension());
-
-    return;
+    densityGEMM(mcwfn, {Cm}, {Cn}, {}, TDM.pointer(), nullptr);
 
   } // CASCI::computeTDM
 
@@ -0,0 +1,220 @@
+/*
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *
+ *  Copyright (C) 2014-2022 Li Research Group (University of Washington)
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *
+ */
+#pragma once
+
+#include <cibuilder/casci.hpp>
+#include <detstringmanager.hpp>
+#include <cqlinalg.hpp>
+#include <util/matout.hpp>
+#include <util/threads.hpp>
+
+namespace ChronusQ {
+
+  /**
+   * \brief CASCI densities via GEMM (Knowles-Handy / Olsen):
+   *
+   *        D_n[kl][J]       = sum_L <J|E_kl|L> C^n_L = (E_kl C^n)_J
+   *        <m|E_kl|n>       = sum_J C^m*_J D_n[kl][J]
+   *        <n|E_ij E_kl|n>  = sum_J D_n*[ji][J] D_n[kl][J]
+   *
+   *        The intermediates of all ket vectors are formed together in
+   *        batches of beta strings (all alpha strings per batch), so
+   *        that every bra / ket pair and every weighted state enters
+   *        the same GEMMs. For 2C / 4C there is a single batch.
+   *
+   * \param [in]  mcwfn  MC wave function
+   * \param [in]  bra    Bra CI vectors
+   * \param [in]  ket    Ket CI vectors
+   * \param [in]  w      Weights of the ket states in twoRDM
+   * \param [out] TDM    nO^2 x nKet x nBra, <m|E_kl|n> at kl + nO^2 (n + nKet m)
+   * \param [out] twoRDM sum_n w_n <n|E_ij E_kl|n>
+   */
+  template <typename MatsT, typename IntsT>
+  void CASCI<MatsT,IntsT>::densityGEMM(MCWaveFunction<MatsT, IntsT> & mcwfn,
+    const std::vector<MatsT*> & bra, const std::vector<MatsT*> & ket,
+    const std::vector<double> & w, MatsT * TDM, InCore4indexTPI<MatsT> * twoRDM) {
+
+    auto & mem = mcwfn.memManager;
+    const size_t nC = mcwfn.reference().nC;
+    auto detStr_a = std::dynamic_pointer_cast<CASStringManager>(mcwfn.detStr);
+    auto detStr_b = (nC == 1) ?
+      std::dynamic_pointer_cast<CASStringManager>(mcwfn.detStrBeta) : nullptr;
+
+    const size_t nO     = mcwfn.MOPartition.nCorrO;
+    const size_t nO2    = nO * nO;
+    const size_t nStr_a = detStr_a->nString();
+    const size_t nStr_b = (detStr_b) ? detStr_b->nString() : 1;
+    const size_t nNZa   = detStr_a->nNonZero();
+    const size_t nNZb   = (detStr_b) ? detStr_b->nNonZero() : 0;
+    const size_t nBra   = bra.size();
+    const size_t nKet   = ket.size();
+    const size_t nKO2   = nO2 * nKet;
+
+    if (twoRDM and w.size() != nKet)
+      CErr("State weights required for the two particle density");
+    if (twoRDM and std::any_of(w.begin(), w.end(), [] (double x) { return x < 0.; }))
+      CErr("State weights of the two particle density must be non-negative");
+
+    const size_t nStrBlk_a = detStr_a->stringBlockSize();
+    const size_t nStrBlk_b = (detStr_b) ? detStr_b->stringBlockSize() : 1;
+
+    ExcitationList exBlk_a(mem, 4, nNZa,
+      (detStr_a->scheme() == COMPUTING_EXCITATION_ON_THE_FLY) ? nStrBlk_a : 1);
+    std::shared_ptr<ExcitationList> exBlk_b = (detStr_b) ?
+      std::make_shared<ExcitationList>(mem, 4, nNZb,
+        (detStr_b->scheme() == COMPUTING_EXCITATION_ON_THE_FLY) ? nStrBlk_b : 1) :
+      nullptr;
+
+    MatsT * G = nullptr;
+    if (twoRDM) {
+      try {
+        G = mem.template malloc<MatsT>(nO2 * nO2);
+      } catch (std::bad_alloc & ba) {
+        CErr("Not enough memory for CAS densities.");
+      }
+    }
+
+    // D and the bra vectors (CB) for as many beta strings as fit in memory
+    const size_t nBraCol = (TDM) ? nBra : 0;
+    const size_t strMem  = (nKO2 + nBraCol) * nStr_a;
+    size_t nBatch = nStr_b;
+    MatsT * D = nullptr;
+    try {
+      D = mem.template malloc<MatsT>(strMem * nBatch);
+    } catch (std::bad_alloc & ba) {
+      nBatch = std::min(nStr_b, mem.template max_avail_allocatable<MatsT>(strMem));
+      if (nBatch == 0) CErr("Not enough memory for CAS densities.");
+      D = mem.template malloc<MatsT>(strMem * nBatch);
+    }
+
+    MatsT * CB = (TDM) ? D + nKO2 * nStr_a * nBatch : nullptr;
+
+    if (TDM) std::fill_n(TDM, nKO2 * nBra, MatsT(0.));
+    if (G)   std::fill_n(G, nO2 * nO2, MatsT(0.));
+
+    int p, q, L;
+    double sign;
+
+    for (auto Jb0 = 0ul; Jb0 < nStr_b; Jb0 += nBatch) {
+
+      const size_t nJb  = std::min(nBatch, nStr_b - Jb0);
+      const size_t nCol = nStr_a * nJb;
+
+      std::fill_n(D, nKO2 * nCol, MatsT(0.));
+
+      // alpha (or 2C / 4C): D_n[qp][Ja,Jb] += <Y|E_pq|Ja> C^n_{Y,Jb}
+      for (auto sBlk = 0ul; sBlk < nStr_a; sBlk += nStrBlk_a) {
+
+        const size_t nS = std::min(nStrBlk_a, nStr_a - sBlk);
+        const int * exList_B = detStr_a->excitationListBlock(sBlk, nS, exBlk_a);
+
+        #pragma omp parallel for collapse(2) schedule(static) default(shared) private(p, q, L, sign)
+        for (size_t jb = 0; jb < nJb; jb++)
+        for (size_t Js = 0; Js < nS; Js++) {
+          const size_t J = sBlk + Js + nStr_a * jb;
+          for (auto n = 0ul; n < nKet; n++) {
+            const int * exList_J = exList_B + Js * 4 * nNZa;
+            const MatsT * Cn = ket[n] + nStr_a * (Jb0 + jb);
+            MatsT * DJ = D + nO2 * (n + nKet * J);
+            for (auto iNZ = 0ul; iNZ < nNZa; iNZ++, exList_J += 4) {
+              UNPACK_EXCITATIONLIST_4(exList_J, p, q, L, sign);
+              DJ[q + p*nO] += sign * Cn[L];
+            }
+          }
+        }
+
+      }
+
+      // beta: D_n[qp][Ja,Jb] += <Y|E_pq|Jb> C^n_{Ja,Y}
+      for (auto sBlk = Jb0; detStr_b and sBlk < Jb0 + nJb; sBlk += nStrBlk_b) {
+
+        const size_t nS = std::min(nStrBlk_b, Jb0 + nJb - sBlk);
+        const int * exList_B = detStr_b->excitationListBlock(sBlk, nS, *exBlk_b);
+
+        #pragma omp parallel for collapse(2) schedule(static) default(shared) private(p, q, L, sign)
+        for (size_t Js = 0; Js < nS; Js++)
+        for (size_t Ja = 0; Ja < nStr_a; Ja++) {
+          const size_t J = Ja + nStr_a * (sBlk + Js - Jb0);
+          for (auto n = 0ul; n < nKet; n++) {
+            const int * exList_J = exList_B + Js * 4 * nNZb;
+            MatsT * DJ = D + nO2 * (n + nKet * J);
+            for (auto iNZ = 0ul; iNZ < nNZb; iNZ++, exList_J += 4) {
+              UNPACK_EXCITATIONLIST_4(exList_J, p, q, L, sign);
+              DJ[q + p*nO] += sign * ket[n][Ja + L * nStr_a];
+            }
+          }
+        }
+
+      }
+
+      // TDM[kl,n][m] += sum_J D_n[kl][J] C^m*_J
+      if (TDM) {
+        #pragma omp parallel for schedule(static) default(shared)
+        for (size_t J = 0; J < nCol; J++)
+          for (auto m = 0ul; m < nBra; m++)
+            CB[m + nBra * J] = bra[m][J + nStr_a * Jb0];
+
+        blas::gemm(blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::ConjTrans,
+          nKO2, nBra, nCol, MatsT(1.), D, nKO2, CB, nBra, MatsT(1.), TDM, nKO2);
+      }
+
+      // G[kl][ji] += sum_n w_n sum_J D_n[kl][J] D_n*[ji][J]
+      if (G) {
+        #pragma omp parallel for schedule(static) default(shared)
+        for (size_t J = 0; J < nCol; J++)
+          for (auto n = 0ul; n < nKet; n++)
+            blas::scal(nO2, MatsT(std::sqrt(w[n])), D + nO2 * (n + nKet * J), 1);
+
+        blas::gemm(blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::ConjTrans,
+          nO2, nO2, nKet * nCol, MatsT(1.), D, nO2, D, nO2, MatsT(1.), G, nO2);
+      }
+
+    }
+
+    // twoRDM(i,j,k,l) = G[kl][ji]
+    if (twoRDM) {
+      MatsT * RDM2 = twoRDM->pointer();
+      #pragma omp parallel for collapse(2) schedule(static) default(shared)
+      for (size_t kl = 0; kl < nO2; kl++)
+      for (size_t i = 0; i < nO; i++)
+      for (size_t j = 0; j < nO; j++)
+        RDM2[i + j*nO + nO2 * kl] = G[kl + nO2 * (j + i*nO)];
+    }
+
+    mem.free(D);
+    if (G) mem.free(G);
+
+  } // CASCI::densityGEMM
+
+  template <typename MatsT, typename IntsT>
+  void CASCI<MatsT,IntsT>::computeDensities(MCWaveFunction<MatsT, IntsT> & mcwfn,
+    const std::vector<MatsT*> & C, const std::vector<double> & w, bool transition,
+    MatsT * TDM, InCore4indexTPI<MatsT> * twoRDM) {
+
+    // the transition densities come at the cost of one small GEMM
+    densityGEMM(mcwfn, C, C, w, TDM, twoRDM);
+
+  } // CASCI::computeDensities
+
+}; // namespace ChronusQ
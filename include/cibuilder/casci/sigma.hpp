@@ -0,0 +1,309 @@
+/*
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *
+ *  Copyright (C) 2014-2022 Li Research Group (University of Washington)
+ *
+ *  This program is free software; you ca redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *
+ */
+#pragma once
+
+#include <cibuilder/casci.hpp>
+#include <detstringmanager.hpp>
+#include <cqlinalg.hpp>
+#include <util/matout.hpp>
+#include <util/threads.hpp>
+
+namespace ChronusQ {
+
+  /**
+   * \brief Allocate the D / G intermediates of the CASCI sigma build
+   *        for nBlk column blocks of dimension blkSize.
+   *
+   *        Tries to hold all blocks at once, otherwise batches over
+   *        the largest number of blocks which fits in memory.
+   *
+   * \param [in]  mem        Memory manager
+   * \param [in]  blkSize    nActO^2 * (columns per block)
+   * \param [in]  nBlk       Total number of blocks
+   * \param [out] nBlkBatch  Number of blocks per batch
+   * \returns     Scratch of 2 * blkSize * nBlkBatch (D followed by G)
+   */
+  template <typename MatsT, typename IntsT>
+  MatsT * CASCI<MatsT,IntsT>::SigmaScratch(CQMemManager & mem, size_t blkSize,
+    size_t nBlk, size_t & nBlkBatch) {
+
+    MatsT * SCR = nullptr;
+    nBlkBatch = nBlk;
+
+    try {
+      SCR = mem.template malloc<MatsT>(2 * blkSize * nBlkBatch);
+    } catch (std::bad_alloc & ba) {
+      nBlkBatch = std::min(nBlk, mem.template max_avail_allocatable<MatsT>(2 * blkSize));
+      if (nBlkBatch == 0) CErr("Not enough memory for CAS sigma.");
+      SCR = mem.template malloc<MatsT>(2 * blkSize * nBlkBatch);
+    }
+
+    return SCR;
+
+  } // CASCI::SigmaScratch
+
+  /**
+   * \brief Contiguous range of sigma column blocks handled by this
+   *        process. Each process accumulates the sigma contributions
+   *        of its blocks only, and the partial sigmas are summed and
+   *        reduce-scattered onto the row blocks of the Davidson vectors
+   *        (onto the root if they are not distributed) by
+   *        IterSolver::reduceScatterVectors.
+   *
+   * \param [in]  comm    MPI communicator
+   * \param [in]  nBlk    Total number of blocks
+   * \param [out] blkBeg  First block of this process
+   * \param [out] blkEnd  One past the last block of this process
+   */
+  template <typename MatsT, typename IntsT>
+  void CASCI<MatsT,IntsT>::SigmaBlockRange(MPI_Comm comm, size_t nBlk,
+    size_t & blkBeg, size_t & blkEnd) {
+
+    const size_t nProc = MPISize(comm);
+    const size_t rank  = MPIRank(comm);
+
+    blkBeg = (nBlk * rank) / nProc;
+    blkEnd = (nBlk * (rank + 1)) / nProc;
+
+  } // CASCI::SigmaBlockRange
+
+  /**
+   * \brief Same-spin (alpha-alpha, beta-beta or the whole 2C/4C)
+   *        contribution to sigma via GEMM (Knowles-Handy / Olsen):
+   *
+   *        D[ij][J] = sum_L <J|E_ij|L> C_L
+   *        G[kl][J] = 1/2 sum_ij (ij|kl) D[ij][J] + h'_kl C_J
+   *        Sigma_K += sum_kl sum_J <K|E_kl|J> G[kl][J]
+   *
+   *        C and Sigma hold nBlk contiguous blocks of the nString()
+   *        strings of detStr, i.e. all trial vectors (and spectator
+   *        strings) are processed by the same GEMM. The excitation
+   *        lists are consumed string block by string block, so that
+   *        they can be generated on the fly.
+   */
+  template <typename MatsT, typename IntsT>
+  void CASCI<MatsT,IntsT>::SigmaSameSpin(MCWaveFunction<MatsT, IntsT> & mcwfn,
+    const CASStringManager & detStr, size_t nBlk, MatsT * C, MatsT * Sigma) {
+
+    auto & hCoreP = *(mcwfn.moints.template getIntegral<OnePInts,MatsT>("hCoreP_Correlated_Space"));
+    auto & moERI  = *(mcwfn.moints.template getIntegral<InCore4indexTPI,MatsT>("ERI_Correlated_Space"));
+
+    const size_t nO      = moERI.nBasis();
+    const size_t nO2     = nO * nO;
+    const size_t nStr    = detStr.nString();
+    const size_t nNZ     = detStr.nNonZero();
+    const size_t nStrBlk = detStr.stringBlockSize();
+    const size_t exDim   = 4 * nNZ;
+
+    // Blocks handled by this process
+    size_t blkBeg, blkEnd;
+    SigmaBlockRange(mcwfn.comm, nBlk, blkBeg, blkEnd);
+    if (blkBeg == blkEnd) return;
+
+    ExcitationList exBlk(mcwfn.memManager, 4, nNZ,
+      (detStr.scheme() == COMPUTING_EXCITATION_ON_THE_FLY) ? nStrBlk : 1);
+
+    size_t nBlkBatch;
+    MatsT * DBlk = SigmaScratch(mcwfn.memManager, nO2 * nStr, blkEnd - blkBeg, nBlkBatch);
+    MatsT * GBlk = DBlk + nO2 * nStr * nBlkBatch;
+
+    int p, q, L;
+    double sign;
+
+    for (auto iBlk = blkBeg; iBlk < blkEnd; iBlk += nBlkBatch) {
+
+      const size_t nB   = std::min(nBlkBatch, blkEnd - iBlk);
+      const size_t nCol = nStr * nB;
+      MatsT * CB = C + nStr * iBlk;
+      MatsT * SB = Sigma + nStr * iBlk;
+
+      std::fill_n(DBlk, nO2 * nCol, MatsT(0.));
+
+      // D[qp][J] += <L|E_pq|J> C_L
+      for (auto sBlk = 0ul; sBlk < nStr; sBlk += nStrBlk) {
+
+        const size_t nS = std::min(nStrBlk, nStr - sBlk);
+        const int * exList_B = detStr.excitationListBlock(sBlk, nS, exBlk);
+
+        #pragma omp parallel for collapse(2) schedule(static) default(shared) private(p, q, L, sign)
+        for (size_t b = 0; b < nB; b++)
+        for (size_t Js = 0; Js < nS; Js++) {
+          const int * exList_J = exList_B + Js * exDim;
+          const MatsT * Cb = CB + nStr * b;
+          MatsT * DJ = DBlk + nO2 * (sBlk + Js + nStr * b);
+          for (auto iNZ = 0ul; iNZ < nNZ; iNZ++, exList_J += 4) {
+            UNPACK_EXCITATIONLIST_4(exList_J, p, q, L, sign);
+            DJ[q + p*nO] += sign * Cb[L];
+          }
+        }
+
+      }
+
+      // G[kl][J] = 1/2 sum_ij (ij|kl) D[ij][J]
+      blas::gemm(blas::Layout::ColMajor, blas::Op::Trans, blas::Op::NoTrans,
+        nO2, nCol, nO2, MatsT(0.5), moERI.pointer(), nO2, DBlk, nO2,
+        MatsT(0.), GBlk, nO2);
+
+      // G[kl][J] += h'_kl C_J
+      #pragma omp parallel for schedule(static) default(shared)
+      for (size_t J = 0; J < nCol; J++)
+        blas::axpy(nO2, CB[J], hCoreP.pointer(), 1, GBlk + nO2 * J, 1);
+
+      // Sigma_K += <J|E_pq|K> G[qp][J]
+      for (auto sBlk = 0ul; sBlk < nStr; sBlk += nStrBlk) {
+
+        const size_t nS = std::min(nStrBlk, nStr - sBlk);
+        const int * exList_B = detStr.excitationListBlock(sBlk, nS, exBlk);
+
+        #pragma omp parallel for collapse(2) schedule(static) default(shared) private(p, q, L, sign)
+        for (size_t b = 0; b < nB; b++)
+        for (size_t Ks = 0; Ks < nS; Ks++) {
+          const int * exList_K = exList_B + Ks * exDim;
+          const MatsT * Gb = GBlk + nO2 * nStr * b;
+          MatsT tmp = MatsT(0.);
+          for (auto iNZ = 0ul; iNZ < nNZ; iNZ++, exList_K += 4) {
+            UNPACK_EXCITATIONLIST_4(exList_K, p, q, L, sign);
+            tmp += sign * Gb[q + p*nO + nO2 * L];
+          }
+          SB[sBlk + Ks + nStr * b] += tmp;
+        }
+
+      }
+
+    }
+
+    mcwfn.memManager.free(DBlk);
+
+  } // CASCI::SigmaSameSpin
+
+  /**
+   * \brief Alpha-beta contribution to the 1C sigma via GEMM:
+   *
+   *        D[kl][La,Kb] = sum_Lb <Kb|E_kl|Lb> C_{La,Lb}
+   *        G[ij][La,Kb] = sum_kl (ij|kl) D[kl][La,Kb]
+   *        Sigma_{Ka,Kb} += sum_ij sum_La <Ka|E_ij|La> G[ij][La,Kb]
+   *
+   *        Batched over the (Kb, vector) blocks of nStr_a columns.
+   */
+  template <typename MatsT, typename IntsT>
+  void CASCI<MatsT,IntsT>::SigmaOppositeSpin(MCWaveFunction<MatsT, IntsT> & mcwfn,
+    const CASStringManager & detStr_a, const CASStringManager & detStr_b,
+    size_t nVec, MatsT * C, MatsT * Sigma) {
+
+    auto & moERI  = *(mcwfn.moints.template getIntegral<InCore4indexTPI,MatsT>("ERI_Correlated_Space"));
+
+    const size_t nO     = moERI.nBasis();
+    const size_t nO2    = nO * nO;
+    const size_t nStr_a = detStr_a.nString();
+    const size_t nStr_b = detStr_b.nString();
+    const size_t nNZa   = detStr_a.nNonZero();
+    const size_t nNZb   = detStr_b.nNonZero();
+    const size_t NDet   = nStr_a * nStr_b;
+    const size_t nBlk   = nStr_b * nVec;
+
+    // Blocks handled by this process
+    size_t blkBeg, blkEnd;
+    SigmaBlockRange(mcwfn.comm, nBlk, blkBeg, blkEnd);
+    if (blkBeg == blkEnd) return;
+
+    const size_t nStrBlk_a = detStr_a.stringBlockSize();
+    const size_t nStrBlk_b = detStr_b.stringBlockSize();
+
+    ExcitationList exBlk_a(mcwfn.memManager, 4, nNZa,
+      (detStr_a.scheme() == COMPUTING_EXCITATION_ON_THE_FLY) ? nStrBlk_a : 1);
+    ExcitationList exBlk_b(mcwfn.memManager, 4, nNZb,
+      (detStr_b.scheme() == COMPUTING_EXCITATION_ON_THE_FLY) ? nStrBlk_b : 1);
+
+    size_t nBlkBatch;
+    MatsT * DBlk = SigmaScratch(mcwfn.memManager, nO2 * nStr_a, blkEnd - blkBeg, nBlkBatch);
+    MatsT * GBlk = DBlk + nO2 * nStr_a * nBlkBatch;
+
+    int p, q, L;
+    double sign;
+
+    for (auto iBlk = blkBeg; iBlk < blkEnd; iBlk += nBlkBatch) {
+
+      const size_t nB   = std::min(nBlkBatch, blkEnd - iBlk);
+      const size_t nCol = nStr_a * nB;
+
+      std::fill_n(DBlk, nO2 * nCol, MatsT(0.));
+
+      // D[qp][La,Kb] += <Lb|E_pq|Kb> C_{La,Lb}
+      for (auto sBlk = 0ul; sBlk < nStr_b; sBlk += nStrBlk_b) {
+
+        const size_t nS = std::min(nStrBlk_b, nStr_b - sBlk);
+        const int * exList_B = detStr_b.excitationListBlock(sBlk, nS, exBlk_b);
+
+        #pragma omp parallel for schedule(static) default(shared) private(p, q, L, sign)
+        for (size_t b = 0; b < nB; b++) {
+          const size_t Kb   = (iBlk + b) % nStr_b;
+          const size_t iVec = (iBlk + b) / nStr_b;
+          if (Kb < sBlk or Kb >= sBlk + nS) continue;
+
+          const int * exList_Kb = exList_B + (Kb - sBlk) * 4 * nNZb;
+          MatsT * Db = DBlk + nO2 * nStr_a * b;
+          for (auto iNZ = 0ul; iNZ < nNZb; iNZ++, exList_Kb += 4) {
+            UNPACK_EXCITATIONLIST_4(exList_Kb, p, q, L, sign);
+            const MatsT * CL = C + iVec * NDet + L * nStr_a;
+            MatsT * DL = Db + q + p*nO;
+            for (auto La = 0ul; La < nStr_a; La++)
+              DL[nO2 * La] += sign * CL[La];
+          }
+        }
+
+      }
+
+      // G[ij][La,Kb] = sum_kl (ij|kl) D[kl][La,Kb]
+      blas::gemm(blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::NoTrans,
+        nO2, nCol, nO2, MatsT(1.), moERI.pointer(), nO2, DBlk, nO2,
+        MatsT(0.), GBlk, nO2);
+
+      // Sigma_{Ka,Kb} += <La|E_pq|Ka> G[qp][La,Kb]
+      for (auto sBlk = 0ul; sBlk < nStr_a; sBlk += nStrBlk_a) {
+
+        const size_t nS = std::min(nStrBlk_a, nStr_a - sBlk);
+        const int * exList_B = detStr_a.excitationListBlock(sBlk, nS, exBlk_a);
+
+        #pragma omp parallel for collapse(2) schedule(static) default(shared) private(p, q, L, sign)
+        for (size_t b = 0; b < nB; b++)
+        for (size_t Ks = 0; Ks < nS; Ks++) {
+          const int * exList_Ka = exList_B + Ks * 4 * nNZa;
+          const MatsT * Gb = GBlk + nO2 * nStr_a * b;
+          MatsT tmp = MatsT(0.);
+          for (auto iNZ = 0ul; iNZ < nNZa; iNZ++, exList_Ka += 4) {
+            UNPACK_EXCITATIONLIST_4(exList_Ka, p, q, L, sign);
+            tmp += sign * Gb[q + p*nO + nO2 * L];
+          }
+          Sigma[nStr_a * (iBlk + b) + sBlk + Ks] += tmp;
+        }
+
+      }
+
+    }
+
+    mcwfn.memManager.free(DBlk);
+
+  } // CASCI::SigmaOppositeSpin
+
+}; // namespace ChronusQ
@@ -26,6 +26,7 @@
 #include <cibuilder.hpp>
 #include <cibuilder/casci/impl.hpp>
 #include <cibuilder/rasci/impl.hpp>
+#include <cibuilder/selectedci/impl.hpp>
 
 // #define _DEBUG_CIBuilder_IMPL
 
@@ -60,9 +61,64 @@ namespace ChronusQ {
       output_ptr = std::dynamic_pointer_cast<CIBuilder<MatsU, IntsT>>(
                      std::make_shared<RASCI<MatsU,IntsT>>(
                        *std::dynamic_pointer_cast<RASCI<MatsT,IntsT>>(ci)));
+
+    } else if (tID == typeid(SelectedCI<MatsT,IntsT>)) {
+      output_ptr = std::dynamic_pointer_cast<CIBuilder<MatsU, IntsT>>(
+                     std::make_shared<SelectedCI<MatsU,IntsT>>(
+                       *std::dynamic_pointer_cast<SelectedCI<MatsT,IntsT>>(ci)));
     }
 
     return output_ptr;
   } //CIBuilder::convert
 
+
+  /**
+   * \brief Densities of a set of CI vectors C from a single pass
+   *
+   *   TDM[kl + nO^2 (n + nS m)] = <m|E_kl|n>
+   *   twoRDM(i,j,k,l)          = sum_n w_n <n|E_ij E_kl|n>
+   *
+   * Only the m == n blocks of TDM (the 1RDMs) are required unless
+   * transition is set. Either output may be nullptr. By default this
+   * falls back to the state by state routines, builders that can form
+   * the intermediates of all states at once override it.
+   *
+   * \param [in]  mcwfn      MC wave function
+   * \param [in]  C          CI vectors
+   * \param [in]  w          Weights of the states in twoRDM
+   * \param [in]  transition Whether to form the m != n TDMs
+   * \param [out] TDM        nO^2 x nS x nS transition densities
+   * \param [out] twoRDM     Weighted two particle density
+   */
+  template <typename MatsT, typename IntsT>
+  void CIBuilder<MatsT,IntsT>::computeDensities(MCWaveFunction<MatsT, IntsT> & mcwfn,
+    const std::vector<MatsT*> & C, const std::vector<double> & w, bool transition,
+    MatsT * TDM, InCore4indexTPI<MatsT> * twoRDM) {
+
+    const size_t nS  = C.size();
+    const size_t nO  = mcwfn.MOPartition.nCorrO;
+    const size_t nO2 = nO * nO;
+
+    if (TDM) {
+      SquareMatrix<MatsT> tmp(mcwfn.memManager, nO);
+      for (auto m = 0ul; m < nS; m++)
+      for (auto n = 0ul; n < nS; n++) {
+        if (m != n and not transition) continue;
+        computeTDM(mcwfn, C[m], C[n], tmp);
+        std::copy_n(tmp.pointer(), nO2, TDM + nO2 * (n + nS * m));
+      }
+    }
+
+    if (twoRDM) {
+      if (w.size() != nS) CErr("State weights required for the two particle density");
+      InCore4indexTPI<MatsT> tmp(mcwfn.memManager, nO);
+      twoRDM->clear();
+      for (auto n = 0ul; n < nS; n++) {
+        computeTwoRDM(mcwfn, C[n], tmp);
+        blas::axpy(nO2 * nO2, MatsT(w[n]), tmp.pointer(), 1, twoRDM->pointer(), 1);
+      }
+    }
+
+  } // CIBuilder::computeDensities
+
 }; // namespace ChronusQ
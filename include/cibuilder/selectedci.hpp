@@ -0,0 +1,134 @@
+/*
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *
+ *  Copyright (C) 2014-2022 Li Research Group (University of Washington)
+ *
+ *  This program is free software; you ca redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *
+ */
+#pragma once
+
+#include <mcwavefunction.hpp>
+#include <cibuilder.hpp>
+
+namespace ChronusQ {
+
+  /**
+   *  \brief The SelectedCI Class. Heat-bath selected CI (Holmes,
+   *  Tubman, Umrigar, JCTC 12, 3674 (2016)) over the determinant space
+   *  of a SCIStringManager.
+   *
+   *  The space is grown from the reference determinant by adding the
+   *  single and double excitations D_a of the determinants D_i for
+   *  which |H_ai c_i| >= epsilon. Doubles are screened with the
+   *  antisymmetrized integrals sorted per annihilated pair, such that
+   *  only the excitations that pass the threshold are visited. The
+   *  Hamiltonian over the space is stored as a sparse (CSR) matrix
+   *  which provides sigma, the diagonal and the RDMs.
+   */
+  template <typename MatsT, typename IntsT>
+  class SelectedCI: public CIBuilder<MatsT,IntsT> {
+
+  private:
+
+    typedef DetString::word_t word_t;
+    static constexpr size_t maxWords = 8; ///< Max words (512 spin orbitals)
+
+    // Double excitation (q,s) -> (p,r) with |<pr||qs>|
+    struct HBExcitation {
+      int p, r;
+      double absH;
+    };
+
+    // Correlated space integrals, raw column-major storage
+    const MatsT * hCore_ = nullptr;
+    const MatsT * moERI_ = nullptr;
+    size_t nOrb_ = 0;   ///< Number of correlated (spatial or spinor) orbitals
+    size_t nSO_  = 0;   ///< Number of spin orbitals of a determinant
+
+    // Heat-bath double excitations of each pair q < s, sorted by |<pr||qs>|
+    std::vector<std::vector<HBExcitation>> hbDoubles_;
+
+    // Sparse Hamiltonian (CSR, diagonal first in each row)
+    size_t NDetH_ = 0;
+    std::vector<size_t> rowPtr_;
+    std::vector<size_t> colIdx_;
+    std::vector<MatsT>  HVal_;
+
+    // Spin orbital integrals, zero if spin forbidden
+    MatsT h1(size_t p, size_t q) const {
+      if (p / nOrb_ != q / nOrb_) return MatsT(0.);
+      return hCore_[p % nOrb_ + (q % nOrb_) * nOrb_];
+    }
+    MatsT eri(size_t p, size_t q, size_t r, size_t s) const {
+      if (p / nOrb_ != q / nOrb_ or r / nOrb_ != s / nOrb_) return MatsT(0.);
+      return moERI_[p % nOrb_ + nOrb_ * (q % nOrb_ + nOrb_ *
+        (r % nOrb_ + nOrb_ * (s % nOrb_)))];
+    }
+
+    // Bit helpers on packed determinants
+    static bool test(const word_t * d, size_t p) {
+      return (d[p / DetString::wordBits] >> (p % DetString::wordBits)) & 1;
+    }
+    static int applyOp(word_t *, size_t);
+    static size_t occupied(const word_t *, size_t, size_t *);
+
+    // Slater-Condon rules
+    void loadIntegrals(MCWaveFunction<MatsT, IntsT> &);
+    size_t excitation(const word_t *, const word_t *, size_t,
+      size_t *, size_t *, int &) const;
+    MatsT diagonalElement(const word_t *, size_t) const;
+    MatsT singleElement(const size_t *, size_t, size_t, size_t, int) const;
+    MatsT matrixElement(const word_t *, const word_t *, size_t) const;
+
+    size_t selectFrom(SCIStringManager &, const std::vector<double> &, double);
+    void buildConnections(CQMemManager &, const SCIStringManager &);
+
+  public:
+    // Constructors
+
+    SelectedCI() = default;
+
+    // Same or Different type, the Hamiltonian is rebuilt
+    template <typename MatsU>
+    SelectedCI(const SelectedCI<MatsU,IntsT> & other):
+    CIBuilder<MatsT, IntsT>(other) {};
+
+    template <typename MatsU>
+    SelectedCI(SelectedCI<MatsU,IntsT> && other):
+    CIBuilder<MatsT, IntsT>(other) {};
+
+    // destructor
+    ~SelectedCI() {};
+
+    // Selected CI space
+    void initialize(MCWaveFunction<MatsT, IntsT> &, double);
+    size_t select(MCWaveFunction<MatsT, IntsT> &, double);
+    void buildHamiltonian(MCWaveFunction<MatsT, IntsT> &);
+
+    // Solving CI Functions
+    void buildFullH(MCWaveFunction<MatsT, IntsT> &, MatsT *);
+    void buildDiagH(MCWaveFunction<MatsT, IntsT> &, MatsT *);
+    void buildSigma(MCWaveFunction<MatsT, IntsT> &, size_t, MatsT *, MatsT *);
+
+    void computeOneRDM(MCWaveFunction<MatsT, IntsT> &, MatsT *, SquareMatrix<MatsT> &);
+    void computeTwoRDM(MCWaveFunction<MatsT, IntsT> &, MatsT *, InCore4indexTPI<MatsT> &);
+    void computeTDM(MCWaveFunction<MatsT, IntsT> &, MatsT *, MatsT *, SquareMatrix<MatsT> &);
+  }; // class SelectedCI
+
+}; // namespace ChronusQ
@@ -0,0 +1,731 @@
+/*
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *
+ *  Copyright (C) 2014-2022 Li Research Group (University of Washington)
+ *
+ *  This program is free software; you ca redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *
+ */
+#pragma once
+
+#include <mcwavefunction.hpp>
+#include <particleintegrals/twopints/incore4indextpi.hpp>
+#include <detstringmanager.hpp>
+#include <cibuilder/selectedci.hpp>
+#include <util/matout.hpp>
+#include <util/threads.hpp>
+
+// #define _DEBUG_CIBUILDER_SELECTEDCI_IMPL
+
+namespace ChronusQ {
+
+  /*
+   * Toggle spin orbital p of a packed determinant and return the
+   * phase (-1)^(number of occupied spin orbitals below p) of the
+   * corresponding creation / annihilation operator
+   */
+  template <typename MatsT, typename IntsT>
+  int SelectedCI<MatsT,IntsT>::applyOp(word_t * d, size_t p) {
+
+    const size_t w = p / DetString::wordBits;
+    const word_t b = word_t(1) << (p % DetString::wordBits);
+
+    size_t n = 0;
+    for (auto i = 0ul; i < w; i++) n += __builtin_popcountll(d[i]);
+    n += __builtin_popcountll(d[w] & (b - 1));
+
+    d[w] ^= b;
+    return (n & 1) ? -1 : 1;
+
+  }; // SelectedCI::applyOp
+
+  /*
+   * Occupied spin orbitals of a packed determinant, returns their number
+   */
+  template <typename MatsT, typename IntsT>
+  size_t SelectedCI<MatsT,IntsT>::occupied(const word_t * d, size_t nW, size_t * occ) {
+
+    size_t n = 0;
+    for (auto w = 0ul; w < nW; w++)
+      for (word_t x = d[w]; x; x &= x - 1)
+        occ[n++] = w * DetString::wordBits + __builtin_ctzll(x);
+    return n;
+
+  }; // SelectedCI::occupied
+
+  template <typename MatsT, typename IntsT>
+  void SelectedCI<MatsT,IntsT>::loadIntegrals(MCWaveFunction<MatsT, IntsT> & mcwfn) {
+
+    hCore_ = mcwfn.moints.template getIntegral<OnePInts,MatsT>(
+      "hCore_Correlated_Space")->pointer();
+    moERI_ = mcwfn.moints.template getIntegral<InCore4indexTPI,MatsT>(
+      "ERI_Correlated_Space")->pointer();
+    nOrb_  = mcwfn.MOPartition.nCorrO;
+    nSO_   = mcwfn.detStr->nOrbital();
+
+  }; // SelectedCI::loadIntegrals
+
+  /*
+   * Excitation degree between the bra I and the ket J. For single and
+   * double excitations, returns the created (cr) and annihilated (an)
+   * spin orbitals in ascending order and the sign of
+   * <I| a+_cr0 a+_cr1 a_an1 a_an0 |J>
+   */
+  template <typename MatsT, typename IntsT>
+  size_t SelectedCI<MatsT,IntsT>::excitation(const word_t * I, const word_t * J,
+    size_t nW, size_t * cr, size_t * an, int & sign) const {
+
+    size_t deg = 0;
+    for (auto w = 0ul; w < nW; w++) deg += __builtin_popcountll(I[w] ^ J[w]);
+    deg /= 2;
+    if (deg == 0 or deg > 2) return deg;
+
+    size_t nA = 0, nC = 0;
+    for (auto w = 0ul; w < nW; w++) {
+      for (word_t x = J[w] & ~I[w]; x; x &= x - 1)
+        an[nA++] = w * DetString::wordBits + __builtin_ctzll(x);
+      for (word_t x = I[w] & ~J[w]; x; x &= x - 1)
+        cr[nC++] = w * DetString::wordBits + __builtin_ctzll(x);
+    }
+
+    word_t D[maxWords];
+    std::copy_n(J, nW, D);
+
+    sign = 1;
+    for (auto i = 0ul; i < deg; i++) sign *= applyOp(D, an[i]);
+    for (auto i = deg; i-- > 0;)      sign *= applyOp(D, cr[i]);
+
+    return deg;
+
+  }; // SelectedCI::excitation
+
+  /*
+   * <I|H|I> = sum_i h_ii + 1/2 sum_ij [ (ii|jj) - (ij|ji) ]
+   */
+  template <typename MatsT, typename IntsT>
+  MatsT SelectedCI<MatsT,IntsT>::diagonalElement(const word_t * I, size_t nW) const {
+
+    size_t occ[maxWords * DetString::wordBits];
+    const size_t nOcc = occupied(I, nW, occ);
+
+    MatsT E = MatsT(0.);
+    for (auto a = 0ul; a < nOcc; a++) {
+      const size_t i = occ[a];
+      E += h1(i, i);
+      for (auto b = 0ul; b < a; b++) {
+        const size_t j = occ[b];
+        E += eri(i, i, j, j) - eri(i, j, j, i);
+      }
+    }
+    return E;
+
+  }; // SelectedCI::diagonalElement
+
+  /*
+   * <I|H|J> for I = sign a+_p a_q J, given the occupied spin orbitals
+   * of J:  sign * ( h_pq + sum_k [ (pq|kk) - (pk|kq) ] )
+   */
+  template <typename MatsT, typename IntsT>
+  MatsT SelectedCI<MatsT,IntsT>::singleElement(const size_t * occ, size_t nOcc,
+    size_t p, size_t q, int sign) const {
+
+    MatsT H = h1(p, q);
+    for (auto a = 0ul; a < nOcc; a++) {
+      const size_t k = occ[a];
+      if (k == q) continue;
+      H += eri(p, q, k, k) - eri(p, k, k, q);
+    }
+    return double(sign) * H;
+
+  }; // SelectedCI::singleElement
+
+  /*
+   * <I|H|J> through the Slater-Condon rules
+   */
+  template <typename MatsT, typename IntsT>
+  MatsT SelectedCI<MatsT,IntsT>::matrixElement(const word_t * I, const word_t * J,
+    size_t nW) const {
+
+    size_t cr[2], an[2];
+    int sign;
+    const size_t deg = excitation(I, J, nW, cr, an, sign);
+
+    if (deg == 0) return diagonalElement(I, nW);
+
+    if (deg == 1) {
+      size_t occ[maxWords * DetString::wordBits];
+      const size_t nOcc = occupied(J, nW, occ);
+      return singleElement(occ, nOcc, cr[0], an[0], sign);
+    }
+
+    if (deg == 2)
+      return double(sign) * (eri(cr[0], an[0], cr[1], an[1]) -
+                             eri(cr[0], an[1], cr[1], an[0]));
+
+    return MatsT(0.);
+
+  }; // SelectedCI::matrixElement
+
+  /*
+   * Add to the space the singles and doubles D_a of the first w.size()
+   * determinants D_i with |H_ai| w_i >= eps. Returns the number of
+   * determinants added
+   */
+  template <typename MatsT, typename IntsT>
+  size_t SelectedCI<MatsT,IntsT>::selectFrom(SCIStringManager & space,
+    const std::vector<double> & w, double eps) {
+
+    const size_t nW = space.nWords();
+    const size_t nThreads = GetNumThreads();
+    std::vector<std::vector<word_t>> newDets(nThreads);
+
+#pragma omp parallel
+    {
+      auto iThread = GetThreadID();
+      auto & myDets = newDets[iThread];
+
+      size_t occ[maxWords * DetString::wordBits];
+      size_t vir[maxWords * DetString::wordBits];
+      word_t D[maxWords];
+
+      auto tryAdd = [&]() {
+        if (space.find(D) == SCIStringManager::npos)
+          myDets.insert(myDets.end(), D, D + nW);
+      };
+
+#pragma omp for schedule(dynamic, 16)
+      for (auto i = 0ul; i < w.size(); i++) {
+
+        const double wI = w[i];
+        if (wI == 0. and eps > 0.) continue;
+
+        const word_t * J = space.det(i);
+        const size_t nOcc = occupied(J, nW, occ);
+        size_t nVir = 0;
+        for (auto p = 0ul; p < nSO_; p++) if (not test(J, p)) vir[nVir++] = p;
+
+        // singles, exact matrix elements
+        for (auto a = 0ul; a < nOcc; a++)
+        for (auto b = 0ul; b < nVir; b++) {
+          const size_t q = occ[a], p = vir[b];
+          if (p / nOrb_ != q / nOrb_) continue;
+
+          std::copy_n(J, nW, D);
+          int sign = applyOp(D, q);
+          sign *= applyOp(D, p);
+
+          if (std::abs(singleElement(occ, nOcc, p, q, sign)) * wI >= eps) tryAdd();
+        }
+
+        // doubles, heat-bath screened
+        for (auto b = 1ul; b < nOcc; b++)
+        for (auto a = 0ul; a < b; a++) {
+          const size_t q = occ[a], s = occ[b];
+          for (const HBExcitation & ex: hbDoubles_[s * (s - 1) / 2 + q]) {
+            if (ex.absH * wI < eps) break;
+            if (test(J, ex.p) or test(J, ex.r)) continue;
+
+            std::copy_n(J, nW, D);
+            applyOp(D, q); applyOp(D, s);
+            applyOp(D, ex.p); applyOp(D, ex.r);
+            tryAdd();
+          }
+        }
+
+      } // i
+    }
+
+    // insert in lexical order so that the determinant ordering does not
+    // depend on the thread schedule
+    std::vector<const word_t *> cand;
+    for (auto & dets: newDets)
+      for (auto i = 0ul; i < dets.size(); i += nW) cand.push_back(&dets[i]);
+
+    std::sort(cand.begin(), cand.end(),
+      [nW] (const word_t * a, const word_t * b) {
+        return std::lexicographical_compare(a, a + nW, b, b + nW);
+      });
+
+    size_t nAdd = 0;
+    for (auto D: cand)
+      if (space.insert(D)) nAdd++;
+
+    return nAdd;
+
+  }; // SelectedCI::selectFrom
+
+  /*
+   * Set up the selection for the current integrals: builds the sorted
+   * heat-bath double excitation lists and, for an empty space, seeds it
+   * with the reference determinant and its screened singles and doubles
+   */
+  template <typename MatsT, typename IntsT>
+  void SelectedCI<MatsT,IntsT>::initialize(MCWaveFunction<MatsT, IntsT> & mcwfn,
+    double eps) {
+
+    loadIntegrals(mcwfn);
+
+    auto & space = dynamic_cast<SCIStringManager &>(*mcwfn.detStr);
+    const size_t nW = space.nWords();
+    if (nW > maxWords)
+      CErr("SelectedCI supports up to " + std::to_string(maxWords * DetString::wordBits) 
+        + " active spin orbitals");
+
+    // Heat-bath lists, |<pr||qs>| >= eps for each pair q < s
+    hbDoubles_.assign(nSO_ * (nSO_ - 1) / 2, std::vector<HBExcitation>());
+
+#pragma omp parallel for schedule(dynamic) default(shared)
+    for (auto s = 1ul; s < nSO_; s++)
+    for (auto q = 0ul; q < s; q++) {
+
+      auto & exList = hbDoubles_[s * (s - 1) / 2 + q];
+      for (auto r = 1ul; r < nSO_; r++)
+      for (auto p = 0ul; p < r; p++) {
+        if (p == q or p == s or r == q or r == s) continue;
+        // conserve Sz
+        if (p / nOrb_ + r / nOrb_ != q / nOrb_ + s / nOrb_) continue;
+
+        double absH = std::abs(eri(p, q, r, s) - eri(p, s, r, q));
+        if (absH >= eps) exList.push_back({int(p), int(r), absH});
+      }
+
+      std::sort(exList.begin(), exList.end(), 
+        [] (const HBExcitation & a, const HBExcitation & b) {
+          return a.absH > b.absH;
+        });
+    }
+
+    if (space.nString() != 0) return;
+
+    // reference determinant, lowest orbitals occupied
+    auto & mopart = mcwfn.MOPartition;
+    word_t ref[maxWords] = {};
+    auto occupy = [&] (size_t p) { 
+      ref[p / DetString::wordBits] |= word_t(1) << (p % DetString::wordBits); 
+    };
+
+    if (mcwfn.reference().nC == 1) {
+      for (auto i = 0ul; i < mopart.nCorrEA; i++) occupy(i);
+      for (auto i = 0ul; i < mopart.nCorrEB; i++) occupy(nOrb_ + i);
+    } else {
+      for (auto i = 0ul; i < mopart.nCorrE; i++) occupy(i);
+    }
+
+    space.insert(ref);
+    selectFrom(space, std::vector<double>(1, 1.), eps);
+
+  }; // SelectedCI::initialize
+
+  /*
+   * One selection cycle from the current CI vectors, with the weight
+   * of a determinant taken as its largest coefficient over the states
+   */
+  template <typename MatsT, typename IntsT>
+  size_t SelectedCI<MatsT,IntsT>::select(MCWaveFunction<MatsT, IntsT> & mcwfn,
+    double eps) {
+
+    std::vector<double> w(mcwfn.NDet, 0.);
+    for (auto C: mcwfn.CIVecs)
+      for (auto i = 0ul; i < mcwfn.NDet; i++)
+        w[i] = std::max(w[i], std::abs(C[i]));
+
+    return selectFrom(dynamic_cast<SCIStringManager &>(*mcwfn.detStr), w, eps);
+
+  }; // SelectedCI::select
+
+  /*
+   * Pairs of determinants connected by single and double excitations.
+   *
+   * Determinants that differ by an n-fold excitation share exactly one
+   * (N-n)-electron remainder. The remainders of all determinants are
+   * hashed and sorted, so connected pairs are found within the groups
+   * of equal remainders instead of by generating and looking up all
+   * excitations of every determinant. The remainders are processed in
+   * batches of hash keys (key % nBatch), sized to the available memory
+   */
+  template <typename MatsT, typename IntsT>
+  void SelectedCI<MatsT,IntsT>::buildConnections(CQMemManager & mem,
+    const SCIStringManager & space) {
+
+    struct Remainder {
+      size_t   key;
+      uint32_t det;
+      uint16_t o1, o2;
+    };
+
+    const size_t NDet = space.nString();
+    const size_t nW   = space.nWords();
+    const size_t nE   = space.nElectron();
+    const size_t nThreads = GetNumThreads();
+    const uint16_t none = std::numeric_limits<uint16_t>::max();
+
+    auto remainder = [&] (const Remainder & e, word_t * R) {
+      std::copy_n(space.det(e.det), nW, R);
+      applyOp(R, e.o1);
+      if (e.o2 != none) applyOp(R, e.o2);
+    };
+
+    std::vector<std::vector<std::pair<uint32_t, uint32_t>>> pairs(nThreads);
+
+    for (auto nRem = 1ul; nRem <= std::min(size_t(2), nE); nRem++) {
+
+      const size_t nComb = (nRem == 1) ? nE : nE * (nE - 1) / 2;
+
+      // Apply f(e) to the remainders e of all determinants
+      auto forRemainders = [&] (auto && f) {
+#pragma omp parallel for schedule(static) default(shared)
+        for (auto i = 0ul; i < NDet; i++) {
+          size_t occ[maxWords * DetString::wordBits];
+          occupied(space.det(i), nW, occ);
+
+          word_t R[maxWords];
+          Remainder e;
+          for (auto b = 0ul; b < nE; b++) {
+            if (nRem == 1) {
+              e = {0, uint32_t(i), uint16_t(occ[b]), none};
+              remainder(e, R);
+              e.key = space.hash(R);
+              f(e);
+            } else for (auto a = 0ul; a < b; a++) {
+              e = {0, uint32_t(i), uint16_t(occ[a]), uint16_t(occ[b])};
+              remainder(e, R);
+              e.key = space.hash(R);
+              f(e);
+            }
+          }
+        }
+      };
+
+      // Smallest number of key batches whose largest batch fits
+      const size_t maxRem = std::min(NDet * nComb,
+        mem.template max_avail_allocatable<Remainder>());
+      if (maxRem == 0) CErr("Not enough memory for the SCI connections");
+
+      size_t nBatch = (NDet * nComb - 1) / maxRem + 1;
+      std::vector<size_t> batchSize;
+      for (; ; nBatch *= 2) {
+        batchSize.assign(nBatch, 0);
+        forRemainders([&] (const Remainder & e) {
+#pragma omp atomic
+          batchSize[e.key % nBatch]++;
+        });
+        if (*std::max_element(batchSize.begin(), batchSize.end()) <= maxRem) break;
+      }
+
+      Remainder * rem = mem.template malloc<Remainder>(
+        *std::max_element(batchSize.begin(), batchSize.end()));
+
+      for (auto iBatch = 0ul; iBatch < nBatch; iBatch++) {
+
+        size_t nB = 0;
+        forRemainders([&] (const Remainder & e) {
+          if (e.key % nBatch != iBatch) return;
+          size_t pos;
+#pragma omp atomic capture
+          pos = nB++;
+          rem[pos] = e;
+        });
+
+        std::sort(rem, rem + nB, 
+          [] (const Remainder & a, const Remainder & b) { return a.key < b.key; });
+
+        std::vector<size_t> groups;
+        for (auto i = 0ul; i < nB; i++)
+          if (i == 0 or rem[i].key != rem[i-1].key) groups.push_back(i);
+        groups.push_back(nB);
+
+#pragma omp parallel default(shared)
+        {
+          auto & myPairs = pairs[GetThreadID()];
+          word_t Ra[maxWords], Rb[maxWords];
+
+#pragma omp for schedule(dynamic, 64)
+          for (auto g = 0ul; g < groups.size() - 1; g++)
+          for (auto a = groups[g]; a < groups[g+1]; a++) {
+            remainder(rem[a], Ra);
+            for (auto b = a + 1; b < groups[g+1]; b++) {
+              remainder(rem[b], Rb);
+              if (not std::equal(Ra, Ra + nW, Rb)) continue;
+
+              const word_t * DA = space.det(rem[a].det);
+              const word_t * DB = space.det(rem[b].det);
+              size_t deg = 0;
+              for (auto w = 0ul; w < nW; w++) deg += __builtin_popcountll(DA[w] ^ DB[w]);
+
+              // single excitations also share (N-2)-remainders
+              if (deg == 2 * nRem) myPairs.emplace_back(rem[a].det, rem[b].det);
+            }
+          }
+        }
+
+      } // iBatch
+
+      mem.free(rem);
+
+    } // nRem
+
+    // CSR with the diagonal first in each row
+    rowPtr_.assign(NDet + 1, 0);
+    for (auto & myPairs: pairs)
+      for (auto & ij: myPairs) { rowPtr_[ij.first + 1]++; rowPtr_[ij.second + 1]++; }
+    for (auto i = 0ul; i < NDet; i++) rowPtr_[i + 1] += rowPtr_[i] + 1;
+
+    colIdx_.resize(rowPtr_[NDet]);
+    std::vector<size_t> pos(rowPtr_.begin(), rowPtr_.end() - 1);
+    for (auto i = 0ul; i < NDet; i++) colIdx_[pos[i]++] = i;
+    for (auto & myPairs: pairs)
+      for (auto & ij: myPairs) { 
+        colIdx_[pos[ij.first]++]  = ij.second;
+        colIdx_[pos[ij.second]++] = ij.first;
+      }
+
+#pragma omp parallel for schedule(static) default(shared)
+    for (auto i = 0ul; i < NDet; i++)
+      std::sort(colIdx_.begin() + rowPtr_[i] + 1, colIdx_.begin() + rowPtr_[i + 1]);
+
+    NDetH_ = NDet;
+
+  }; // SelectedCI::buildConnections
+
+  /*
+   * Sparse CI Hamiltonian over the current space. The connectivity is
+   * only rebuilt when the space has changed
+   */
+  template <typename MatsT, typename IntsT>
+  void SelectedCI<MatsT,IntsT>::buildHamiltonian(MCWaveFunction<MatsT, IntsT> & mcwfn) {
+
+    loadIntegrals(mcwfn);
+
+    auto & space = dynamic_cast<const SCIStringManager &>(*mcwfn.detStr);
+    const size_t nW = space.nWords();
+
+    if (NDetH_ != space.nString()) buildConnections(mcwfn.memManager, space);
+
+    HVal_.resize(colIdx_.size());
+
+#pragma omp parallel for schedule(dynamic, 16) default(shared)
+    for (auto i = 0ul; i < NDetH_; i++)
+    for (auto k = rowPtr_[i]; k < rowPtr_[i + 1]; k++)
+      HVal_[k] = matrixElement(space.det(i), space.det(colIdx_[k]), nW);
+
+  }; // SelectedCI::buildHamiltonian
+
+  /*  
+   *  Full Selected CI Hamiltonian as H(K, L)
+   */ 
+  template <typename MatsT, typename IntsT>
+  void SelectedCI<MatsT,IntsT>::buildFullH(MCWaveFunction<MatsT, IntsT> & mcwfn, MatsT * fullH) {  
+
+    const size_t NDet = mcwfn.NDet;
+    std::fill_n(fullH, NDet * NDet, MatsT(0.));
+
+    for (auto i = 0ul; i < NDet; i++)
+    for (auto k = rowPtr_[i]; k < rowPtr_[i + 1]; k++)
+      fullH[i + colIdx_[k] * NDet] = HVal_[k];
+
+#ifdef _DEBUG_CIBUILDER_SELECTEDCI_IMPL
+    prettyPrintSmart(std::cout,"HH full SCI Hamiltonian", fullH, NDet, NDet, NDet);
+#endif
+
+  }; // SelectedCI::buildFullH
+
+  template <typename MatsT, typename IntsT>
+  void SelectedCI<MatsT,IntsT>::buildDiagH(MCWaveFunction<MatsT, IntsT> & mcwfn, MatsT * diagH) {  
+
+    for (auto i = 0ul; i < mcwfn.NDet; i++) diagH[i] = HVal_[rowPtr_[i]];
+
+  }; // SelectedCI::buildDiagH
+
+  /*
+   *  Sigma, sparse matrix-vector product
+   */
+  template <typename MatsT, typename IntsT>
+  void SelectedCI<MatsT,IntsT>::buildSigma(MCWaveFunction<MatsT, IntsT> & mcwfn, 
+    size_t nVec, MatsT * C, MatsT * Sigma) {
+
+    const size_t NDet = mcwfn.NDet;
+
+#pragma omp parallel for schedule(dynamic, 64) default(shared)
+    for (auto i = 0ul; i < NDet; i++)
+    for (auto iVec = 0ul; iVec < nVec; iVec++) {
+      const MatsT * Ci = C + iVec * NDet;
+      MatsT tmp = MatsT(0.);
+      for (auto k = rowPtr_[i]; k < rowPtr_[i + 1]; k++)
+        tmp += HVal_[k] * Ci[colIdx_[k]];
+      Sigma[i + iVec * NDet] = tmp;
+    }
+
+  }; // SelectedCI::buildSigma
+
+  template <typename MatsT, typename IntsT>
+  void SelectedCI<MatsT,IntsT>::computeOneRDM(MCWaveFunction<MatsT, IntsT> & mcwfn, MatsT * C, 
+    SquareMatrix<MatsT> & oneRDM) {
+  
+    computeTDM(mcwfn, C, C, oneRDM);
+  
+  } // SelectedCI::computeOneRDM 
+
+  /*
+   * TDM(k,l) = <m|E_kl|n> over the connected pairs of the space
+   */
+  template <typename MatsT, typename IntsT>
+  void SelectedCI<MatsT,IntsT>::computeTDM(MCWaveFunction<MatsT, IntsT> & mcwfn, MatsT * Cm,
+    MatsT * Cn, SquareMatrix<MatsT> & TDM) {
+
+    auto & space = dynamic_cast<const SCIStringManager &>(*mcwfn.detStr);
+    const size_t nW = space.nWords();
+    const size_t nO = mcwfn.MOPartition.nCorrO;
+
+    size_t nThreads = GetNumThreads();
+    std::vector<SquareMatrix<MatsT>> SCR;
+    for (auto i = 0ul; i < nThreads; i++)
+      SCR.emplace_back(mcwfn.memManager, TDM.dimension());
+
+#pragma omp parallel default(shared)
+    {
+      auto & tmpRDM = SCR[GetThreadID()];
+      tmpRDM.clear();
+
+      size_t occ[maxWords * DetString::wordBits], cr[2], an[2];
+      int sign;
+
+#pragma omp for schedule(dynamic, 16)
+      for (auto i = 0ul; i < mcwfn.NDet; i++) {
+        const word_t * DI = space.det(i);
+        const MatsT cI = SmartConj(Cm[i]);
+
+        for (auto k = rowPtr_[i]; k < rowPtr_[i + 1]; k++) {
+          const MatsT v = cI * Cn[colIdx_[k]];
+          if (v == MatsT(0.)) continue;
+
+          const size_t deg = excitation(DI, space.det(colIdx_[k]), nW, cr, an, sign);
+          if (deg == 0) {
+            const size_t nOcc = occupied(DI, nW, occ);
+            for (auto a = 0ul; a < nOcc; a++) tmpRDM(occ[a] % nO, occ[a] % nO) += v;
+          } else if (deg == 1) {
+            tmpRDM(cr[0] % nO, an[0] % nO) += double(sign) * v;
+          }
+        }
+      }
+    }
+
+    TDM.clear();
+    for (auto i = 0ul; i < nThreads; i++) TDM += SCR[i];
+
+  } // SelectedCI::computeTDM
+
+  /*
+   * twoRDM(i,j,k,l) = <E_ij E_kl> = P(i,j,k,l) + delta_jk D(i,l), with
+   * P(p,q,r,s) = <a+_p a+_r a_s a_q> accumulated over the connected
+   * pairs of the space and summed over spin for 1C
+   */
+  template <typename MatsT, typename IntsT>
+  void SelectedCI<MatsT,IntsT>::computeTwoRDM(MCWaveFunction<MatsT, IntsT> & mcwfn, 
+    MatsT * C, InCore4indexTPI<MatsT> & twoRDM) {
+
+    auto & space = dynamic_cast<const SCIStringManager &>(*mcwfn.detStr);
+    const size_t nW = space.nWords();
+    const size_t nO = mcwfn.MOPartition.nCorrO;
+    const size_t nDim = twoRDM.nBasis();
+
+    size_t nThreads = GetNumThreads();
+    std::vector<InCore4indexTPI<MatsT>> SCR;
+    std::vector<SquareMatrix<MatsT>> SCR1;
+    for (auto i = 0ul; i < nThreads; i++) {
+      SCR.emplace_back(mcwfn.memManager, nDim);
+      SCR1.emplace_back(mcwfn.memManager, nDim);
+    }
+
+#pragma omp parallel default(shared)
+    {
+      auto iThread = GetThreadID();
+      auto & tmpRDM = SCR[iThread];
+      auto & tmp1RDM = SCR1[iThread];
+      tmpRDM.clear();
+      tmp1RDM.clear();
+
+      // P(p,q,r,s) for spin orbitals, zero unless p,q and r,s share spin
+      auto addP = [&] (size_t p, size_t q, size_t r, size_t s, MatsT v) {
+        if (p / nO == q / nO and r / nO == s / nO)
+          tmpRDM(p % nO, q % nO, r % nO, s % nO) += v;
+      };
+
+      size_t occ[maxWords * DetString::wordBits], cr[2], an[2];
+      int sign;
+
+#pragma omp for schedule(dynamic, 16)
+      for (auto i = 0ul; i < mcwfn.NDet; i++) {
+        const word_t * DI = space.det(i);
+        const MatsT cI = SmartConj(C[i]);
+        const size_t nOcc = occupied(DI, nW, occ);
+
+        for (auto k = rowPtr_[i]; k < rowPtr_[i + 1]; k++) {
+          const MatsT v = cI * C[colIdx_[k]];
+          if (v == MatsT(0.)) continue;
+
+          const size_t deg = excitation(DI, space.det(colIdx_[k]), nW, cr, an, sign);
+          const MatsT vs = double(sign) * v;
+
+          if (deg == 0) {
+            for (auto a = 0ul; a < nOcc; a++) {
+              const size_t p = occ[a];
+              tmp1RDM(p % nO, p % nO) += v;
+              for (auto b = 0ul; b < nOcc; b++) {
+                if (a == b) continue;
+                addP(p, p, occ[b], occ[b], v);
+                addP(p, occ[b], occ[b], p, -v);
+              }
+            }
+          } else if (deg == 1) {
+            const size_t p = cr[0], q = an[0];
+            tmp1RDM(p % nO, q % nO) += vs;
+            for (auto a = 0ul; a < nOcc; a++) {
+              const size_t r = occ[a];
+              if (r == p) continue;
+              addP(p, q, r, r,  vs);
+              addP(r, r, p, q,  vs);
+              addP(p, r, r, q, -vs);
+              addP(r, q, p, r, -vs);
+            }
+          } else if (deg == 2) {
+            const size_t p = cr[0], r = cr[1], q = an[0], s = an[1];
+            addP(p, q, r, s,  vs);
+            addP(r, s, p, q,  vs);
+            addP(p, s, r, q, -vs);
+            addP(r, q, p, s, -vs);
+          }
+        }
+      }
+    }
+
+    twoRDM.clear();
+    auto nDim2 = nDim * nDim;
+    auto nDim4 = nDim2 * nDim2;
+    for (auto i = 0ul; i < nThreads; i++) {
+      blas::axpy(nDim4, 1.0, SCR[i].pointer(), 1, twoRDM.pointer(), 1);
+      if (i > 0) SCR1[0] += SCR1[i];
+    }
+
+    for (auto l = 0ul; l < nDim; l++)
+    for (auto j = 0ul; j < nDim; j++)
+    for (auto i = 0ul; i < nDim; i++)
+      twoRDM(i, j, j, l) += SCR1[0](i, l);
+
+  } // SelectedCI::computeTwoRDM
+
+}; // namespace ChronusQ
@@ -33,6 +33,7 @@
 #include <util/math.hpp>
 #include <integrals.hpp>
 #include <cerr.hpp>
+#include <particleintegrals/twopints/incoreritpi.hpp>
 #include <tiledarray.h>
 #include "./coupledcluster/DiskDIIS.hpp"
 
@@ -41,11 +42,17 @@ namespace ChronusQ {
 
   enum class CC_TYPE { CCSD};
 
+  // Particle-particle ladder: AUTO picks RI when the AO integrals are RI,
+  // STORED keeps the packed <ab||cd> also for RI integrals
+  enum class CC_LADDER_ALG { AUTO, STORED, RI };
+
   struct CoupledClusterSettings {
     CC_TYPE cctype = CC_TYPE::CCSD;
+    CC_LADDER_ALG ladderAlg = CC_LADDER_ALG::STORED;
     double eConv = 1e-8;
     double tConv = 1e-6;
     int maxiter = 1000;
+    size_t blockSize = 4; // TA tile size of the o and v ranges
   };
 
   struct CCBase
@@ -92,6 +99,26 @@ namespace ChronusQ {
 
     void initRanges();
 
+//Packed storage of the unique a < b, c < d (i < j) pairs of the
+//antisymmetric particle-particle ladder <ab||cd> tau_cdij
+    TA::TiledRange1 vvrange;
+    TA::TiledRange1 oorange;
+    std::vector<std::pair<size_t,size_t>> vvPairs;
+    std::vector<std::pair<size_t,size_t>> ooPairs;
+    TArray abcdPacked;
+
+//Virtual-virtual MO RI / Cholesky factors B(L,c,a) for the integral-direct
+//ladder, which never stores <ab||cd>
+    std::shared_ptr<InCoreRITPI<MatsT>> vvRI;
+
+    static size_t pairIndex(size_t p, size_t q) { return p + q * (q - 1) / 2; }
+    std::vector<MatsT> packVVOO(TArray T);
+    TArray vvooToTA(const std::vector<MatsT>& buf);
+    std::vector<MatsT> vvooFromTA(TArray TP);
+    void addUnpackedVVOO(const std::vector<MatsT>& buf, TArray T);
+    void addLadder(TArray tau);
+    void formLadderRI(const std::vector<MatsT>& tauP, std::vector<MatsT>& L);
+
 //Singles intermediates and tensors
     void formA_1();
     void formA_2();
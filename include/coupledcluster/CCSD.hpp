@@ -62,7 +62,8 @@ namespace ChronusQ{
 
   template <typename MatsT, typename IntsT>
   void CCSD<MatsT,IntsT>::run() {
-    if(std::dynamic_pointer_cast<InCore4indexTPI<IntsT>>(this->ref_.aoints.TPI)){
+    if(std::dynamic_pointer_cast<InCore4indexTPI<IntsT>>(this->ref_.aoints.TPI) or
+       std::dynamic_pointer_cast<InCoreRITPI<IntsT>>(this->ref_.aoints.TPI)){
       runConventional();
     }
     else {
@@ -228,25 +229,140 @@ namespace ChronusQ{
       this->fockMatrix_ta.insert(std::make_pair(focktype,tmp));
     }
 
+    auto aori = std::dynamic_pointer_cast<InCoreRITPI<IntsT>>(this->ref_.aoints.TPI);
+
+    bool useRILadder = false;
+    if (this->ccSettings.ladderAlg == CC_LADDER_ALG::RI) {
+      if (not aori) CErr("CC.LADDER = RI requires RI / Cholesky integrals");
+      useRILadder = true;
+    } else if (this->ccSettings.ladderAlg == CC_LADDER_ALG::AUTO)
+      useRILadder = bool(aori);
+
     // Start parallel without TA
     endTAThreads();
 
-    auto aoeri = std::make_shared<InCore4indexTPI<IntsT>>(
-              std::dynamic_pointer_cast<InCore4indexTPI<IntsT>>(this->ref_.aoints.TPI)
-               ->template spatialToSpinBlock<IntsT>());
-    auto moeri = std::make_shared<InCore4indexTPI<MatsT>>(
-        aoeri->transform('N', this->ref_.mo[0].pointer(), nMO, nMO));
-    Integrals<MatsT> moints;
-    moints.TPI = moeri;    
+    // (pq|rs) from the MO four index integrals or the MO RI factors
+    std::shared_ptr<InCore4indexTPI<MatsT>> moeri;
+    std::shared_ptr<InCoreRITPI<MatsT>> moRI;
+    size_t NBRI = 0;
+
+    if (aori) {
+      auto aoRIspin = aori->template spatialToSpinBlock<IntsT>();
+      moRI = std::make_shared<InCoreRITPI<MatsT>>(
+          aoRIspin.transform('N', this->ref_.mo[0].pointer(), nMO, nMO));
+      NBRI = moRI->nRIBasis();
+    } else if (auto ao4i = std::dynamic_pointer_cast<InCore4indexTPI<IntsT>>(
+                 this->ref_.aoints.TPI)) {
+      auto aoeri = std::make_shared<InCore4indexTPI<IntsT>>(
+                ao4i->template spatialToSpinBlock<IntsT>());
+      moeri = std::make_shared<InCore4indexTPI<MatsT>>(
+          aoeri->transform('N', this->ref_.mo[0].pointer(), nMO, nMO));
+    } else CErr("Only GHF/X2C-CCSD is supported!");
+
+    std::vector<std::string> mointsTypes{"abij","iabj","aibj","ijkl","abci","aijk"};
+    std::set<char> hole{'i','j','k','l'};
+    std::set<char> particle{'a','b','c','d'};  
+
+    auto moRange = [&](char ch) -> std::pair<size_t,size_t> {
+      if (hole.count(ch)) return {0, nO};
+      return {nO, nV};
+    };
+
+    // <xy||zw> = (xz|yw) - (xw|yz) of every block from GEMMs of the MO
+    // RI factors, M(x,y,z,w) column major
+    std::map<std::string,std::vector<MatsT>> riBlocks;
+    if (moRI) {
+
+      // B(L,p,q) for p, q in the ranges of x and y
+      auto factors = [&](char x, char y) {
+        auto px = moRange(x), py = moRange(y);
+        std::vector<MatsT> Bxy(NBRI * px.second * py.second);
+        #pragma omp parallel for schedule(static) default(shared)
+        for (size_t q = 0; q < py.second; q++)
+        for (size_t p = 0; p < px.second; p++)
+          std::copy_n(&(*moRI)(0, p + px.first, q + py.first), NBRI,
+            &Bxy[(p + q * px.second) * NBRI]);
+        return Bxy;
+      };
+
+      for (const auto& motype:mointsTypes) {
+        char x = motype[0], y = motype[1], z = motype[2], w = motype[3];
+        size_t nx = moRange(x).second, ny = moRange(y).second;
+        size_t nz = moRange(z).second, nw = moRange(w).second;
+
+        // J1(xz, yw) = (xz|yw), J2(xw, yz) = (xw|yz)
+        std::vector<MatsT> J1(nx * ny * nz * nw), J2(nx * ny * nz * nw);
+        {
+          auto Bxz = factors(x,z), Byw = factors(y,w);
+          blas::gemm(blas::Layout::ColMajor, blas::Op::Trans, blas::Op::NoTrans,
+            nx * nz, ny * nw, NBRI, MatsT(1.), Bxz.data(), NBRI,
+            Byw.data(), NBRI, MatsT(0.), J1.data(), nx * nz);
+        }
+        {
+          auto Bxw = factors(x,w), Byz = factors(y,z);
+          blas::gemm(blas::Layout::ColMajor, blas::Op::Trans, blas::Op::NoTrans,
+            nx * nw, ny * nz, NBRI, MatsT(1.), Bxw.data(), NBRI,
+            Byz.data(), NBRI, MatsT(0.), J2.data(), nx * nw);
+        }
+
+        // M(x,y,z,w) = J1(x,z,y,w) - J2(x,w,y,z)
+        std::vector<MatsT> M(nx * ny * nz * nw);
+        #pragma omp parallel for collapse(2) schedule(static) default(shared)
+        for (size_t iw = 0; iw < nw; iw++)
+        for (size_t iz = 0; iz < nz; iz++)
+        for (size_t iy = 0; iy < ny; iy++)
+        for (size_t ix = 0; ix < nx; ix++)
+          M[ix + nx * (iy + ny * (iz + nz * iw))] =
+            J1[ix + nx * (iz + nz * (iy + ny * iw))] -
+            J2[ix + nx * (iw + nw * (iy + ny * iz))];
+
+        riBlocks.insert(std::make_pair(motype, std::move(M)));
+      }
+
+    }
+
+    // B(L,c,a) = B(L,a+nO,c+nO), so that the factors of a fixed a are
+    // contiguous for the ladder and the packed <ab||cd>
+    if (moRI and nV > 0) {
+      vvRI = std::make_shared<InCoreRITPI<MatsT>>(this->ref_.memManager, nV, NBRI);
+      MatsT * Bvv = vvRI->pointer();
+      #pragma omp parallel for collapse(2) schedule(static) default(shared)
+      for (size_t a = 0; a < nV; a++)
+      for (size_t c = 0; c < nV; c++)
+        std::copy_n(&(*moRI)(0, a + nO, c + nO), NBRI, Bvv + (c + a * nV) * NBRI);
+    }
+
+    // Packed <ab||cd> from the RI factors, one a at a time (see formLadderRI)
+    size_t NVV = vvPairs.size();
+    std::vector<MatsT> abcdRI;
+    if (vvRI and not useRILadder and NVV > 0) {
+      abcdRI.resize(NVV * NVV);
+      std::vector<MatsT> X(nV * nV * (nV - 1));
+      const MatsT * B = vvRI->pointer();
+
+      for (auto a = 0ul; a < nV - 1; a++) {
+        size_t nb = nV - a - 1;
+
+        // X(c, d b) = B(L, a c)^T B(L, d b) = (ac|bd)
+        blas::gemm(blas::Layout::ColMajor, blas::Op::Trans, blas::Op::NoTrans,
+          nV, nV * nb, NBRI, MatsT(1.), B + a * nV * NBRI, NBRI,
+          B + (a + 1) * nV * NBRI, NBRI, MatsT(0.), X.data(), nV);
+
+        #pragma omp parallel for collapse(2) schedule(static) default(shared)
+        for (size_t cd = 0; cd < NVV; cd++)
+        for (size_t b = 0; b < nb; b++) {
+          size_t c = vvPairs[cd].first, d = vvPairs[cd].second;
+          abcdRI[pairIndex(a, a + 1 + b) + NVV * cd] =
+            X[c + d * nV + b * nV * nV] - X[d + c * nV + b * nV * nV];
+        }
+      }
+
+      vvRI = nullptr;
+    }
 
     // Go back to TA threads
     startTAThreads();
 
-    if (std::shared_ptr<InCore4indexTPI<dcomplex>> eri = 
-      std::dynamic_pointer_cast<InCore4indexTPI<dcomplex>>(moints.TPI)){
-    std::vector<std::string> mointsTypes{"abij","iabj","aibj","ijkl","abcd","abci","aijk"};
-    std::set<char> hole{'i','j','k','l'};
-    std::set<char> particle{'a','b','c','d'};  
     for(const auto& motype:mointsTypes){
 
       std::vector<TA::TiledRange1> MORangeTypes;
@@ -263,6 +379,9 @@ namespace ChronusQ{
        }
       }
 
+      size_t nx = moRange(motype[0]).second, ny = moRange(motype[1]).second;
+      size_t nz = moRange(motype[2]).second;
+      const MatsT * M = moRI ? riBlocks[motype].data() : nullptr;
                
       TArray tmp(TA::get_default_world(),TA::TiledRange{MORangeTypes[0],MORangeTypes[1],MORangeTypes[2],MORangeTypes[3]});
 
@@ -278,21 +397,53 @@ namespace ChronusQ{
           for(i[1] = lobound[1]; i[1] != upbound[1]; ++i[1])
             for(i[2] = lobound[2]; i[2] != upbound[2]; ++i[2])
               for(i[3] = lobound[3]; i[3] != upbound[3]; ++i[3])
-                tile[i] = (*eri)(i[0] + offset[0],i[2] + offset[2],i[1] + offset[1],i[3] + offset[3]) 
-                - (*eri)(i[0] + offset[0], i[3] + offset[3],i[1] + offset[1], i[2] + offset[2]);
+                tile[i] = moeri ?
+                  (*moeri)(i[0] + offset[0],i[2] + offset[2],i[1] + offset[1],i[3] + offset[3]) 
+                  - (*moeri)(i[0] + offset[0], i[3] + offset[3],i[1] + offset[1], i[2] + offset[2]) :
+                  M[i[0] + nx * (i[1] + ny * (i[2] + nz * i[3]))];
       
         *it = tile;
       }
 
       this->antiSymMoints.insert(std::make_pair(motype,tmp));
+      riBlocks.erase(motype);
+
+    }
+
+    // <ab||cd> is only stored for a < b and c < d
+    if (not useRILadder and not vvPairs.empty()) {
+
+      abcdPacked = TArray(TA::get_default_world(),TA::TiledRange{vvrange,vvrange});
+
+      for(auto it = std::begin(abcdPacked); it != std::end(abcdPacked); ++it) {
+        typename TA::Array<MatsT,2>::value_type tile(abcdPacked.trange().make_tile_range(it.ordinal()));
+
+        const auto& lobound = tile.range().lobound();
+        const auto& upbound = tile.range().upbound();
+
+        std::size_t i[] = {0,0};
+        for(i[0] = lobound[0]; i[0] != upbound[0]; ++i[0])
+          for(i[1] = lobound[1]; i[1] != upbound[1]; ++i[1]) {
+            if (not moeri) {
+              tile[i] = abcdRI[i[0] + NVV * i[1]];
+              continue;
+            }
+            size_t a = vvPairs[i[0]].first + nO, b = vvPairs[i[0]].second + nO;
+            size_t c = vvPairs[i[1]].first + nO, d = vvPairs[i[1]].second + nO;
+            tile[i] = (*moeri)(a,c,b,d) - (*moeri)(a,d,b,c);
+          }
+
+        *it = tile;
+      }
 
     }
-    } else { CErr("Only GHF/X2C-CCSD is supported!");}
 
   }  
 
   template <typename MatsT, typename IntsT>
   void CCSD<MatsT,IntsT>::initRanges(){
+    blksize = this->ccSettings.blockSize;
+
     size_t NO = this->ref_.nO;
     size_t NV = this->ref_.nV; 
 
@@ -313,6 +464,250 @@ namespace ChronusQ{
 
     orange = orangetmp;
     vrange = vrangetmp;
+
+    // unique pairs p < q, indexed by pairIndex(p,q)
+    vvPairs.clear();
+    ooPairs.clear();
+    for (auto q = 1ul; q < NV; q++)
+      for (auto p = 0ul; p < q; p++) vvPairs.emplace_back(p,q);
+    for (auto q = 1ul; q < NO; q++)
+      for (auto p = 0ul; p < q; p++) ooPairs.emplace_back(p,q);
+
+    auto pairRange = [&](size_t nPair) {
+      std::vector<std::size_t> blk;
+      for (auto i = 0ul; i < nPair; i += blksize * blksize) blk.push_back(i);
+      blk.push_back(nPair);
+      return TA::TiledRange1(blk.begin(), blk.end());
+    };
+
+    if (not vvPairs.empty()) vvrange = pairRange(vvPairs.size());
+    if (not ooPairs.empty()) oorange = pairRange(ooPairs.size());
+  }
+
+  /**
+   *  \brief Pack the unique a < b, i < j elements of an antisymmetric
+   *  (v,v,o,o) tensor into a column major (vv,oo) matrix.
+   *
+   *  Every process fills the elements of its local tiles, the sum over
+   *  the world replicates the full matrix.
+   */
+  template <typename MatsT, typename IntsT>
+  std::vector<MatsT> CCSD<MatsT,IntsT>::packVVOO(TArray T) {
+
+    size_t NVV = vvPairs.size();
+    std::vector<MatsT> buf(NVV * ooPairs.size());
+
+    for(auto it = std::begin(T); it != std::end(T); ++it) {
+      auto tile = (*it).get();
+      const auto& lobound = tile.range().lobound();
+      const auto& upbound = tile.range().upbound();
+
+      std::size_t i[] = {0,0,0,0};
+      for(i[0] = lobound[0]; i[0] != upbound[0]; ++i[0])
+        for(i[1] = std::max(lobound[1], i[0] + 1); i[1] < upbound[1]; ++i[1])
+          for(i[2] = lobound[2]; i[2] != upbound[2]; ++i[2])
+            for(i[3] = std::max(lobound[3], i[2] + 1); i[3] < upbound[3]; ++i[3])
+              buf[pairIndex(i[0],i[1]) + NVV * pairIndex(i[2],i[3])] = tile[i];
+    }
+
+    T.world().gop.sum(buf.data(), buf.size());
+
+    return buf;
+  }
+
+  /**
+   *  \brief Copy a column major (vv,oo) matrix into a TA tensor
+   */
+  template <typename MatsT, typename IntsT>
+  TA::TArray<MatsT> CCSD<MatsT,IntsT>::vvooToTA(const std::vector<MatsT>& buf) {
+
+    size_t NVV = vvPairs.size();
+    TArray TP(TA::get_default_world(),TA::TiledRange{vvrange,oorange});
+
+    for(auto it = std::begin(TP); it != std::end(TP); ++it) {
+      typename TA::Array<MatsT,2>::value_type tile(TP.trange().make_tile_range(it.ordinal()));
+      const auto& lobound = tile.range().lobound();
+      const auto& upbound = tile.range().upbound();
+
+      std::size_t i[] = {0,0};
+      for(i[0] = lobound[0]; i[0] != upbound[0]; ++i[0])
+        for(i[1] = lobound[1]; i[1] != upbound[1]; ++i[1])
+          tile[i] = buf[i[0] + NVV * i[1]];
+
+      *it = tile;
+    }
+
+    return TP;
+  }
+
+  /**
+   *  \brief Gather a (vv,oo) TA tensor into a column major matrix,
+   *  replicated on every process
+   */
+  template <typename MatsT, typename IntsT>
+  std::vector<MatsT> CCSD<MatsT,IntsT>::vvooFromTA(TArray TP) {
+
+    size_t NVV = vvPairs.size();
+    std::vector<MatsT> buf(NVV * ooPairs.size());
+
+    for(auto it = std::begin(TP); it != std::end(TP); ++it) {
+      auto tile = (*it).get();
+      const auto& lobound = tile.range().lobound();
+      const auto& upbound = tile.range().upbound();
+
+      std::size_t i[] = {0,0};
+      for(i[0] = lobound[0]; i[0] != upbound[0]; ++i[0])
+        for(i[1] = lobound[1]; i[1] != upbound[1]; ++i[1])
+          buf[i[0] + NVV * i[1]] = tile[i];
+    }
+
+    TP.world().gop.sum(buf.data(), buf.size());
+
+    return buf;
+  }
+
+  /**
+   *  \brief Add a packed (vv,oo) matrix to the antisymmetric (v,v,o,o)
+   *  tensor T, T(a,b,i,j) = -T(b,a,i,j) = -T(a,b,j,i).
+   *
+   *  The matrix must be replicated, only the local tiles of T are updated.
+   */
+  template <typename MatsT, typename IntsT>
+  void CCSD<MatsT,IntsT>::addUnpackedVVOO(const std::vector<MatsT>& buf, TArray T) {
+
+    size_t NVV = vvPairs.size();
+
+    for(auto it = std::begin(T); it != std::end(T); ++it) {
+      auto tile = (*it).get();
+      const auto& lobound = tile.range().lobound();
+      const auto& upbound = tile.range().upbound();
+
+      std::size_t i[] = {0,0,0,0};
+      for(i[0] = lobound[0]; i[0] != upbound[0]; ++i[0])
+        for(i[1] = lobound[1]; i[1] != upbound[1]; ++i[1])
+          for(i[2] = lobound[2]; i[2] != upbound[2]; ++i[2])
+            for(i[3] = lobound[3]; i[3] != upbound[3]; ++i[3]) {
+              if (i[0] == i[1] or i[2] == i[3]) continue;
+              double sign = ((i[0] > i[1]) != (i[2] > i[3])) ? -1.0 : 1.0;
+              size_t ab = pairIndex(std::min(i[0],i[1]), std::max(i[0],i[1]));
+              size_t ij = pairIndex(std::min(i[2],i[3]), std::max(i[2],i[3]));
+              tile[i] += sign * buf[ab + NVV * ij];
+            }
+    }
+  }
+
+  /**
+   *  \brief Particle-particle ladder
+   *
+   *    T2(a,b,i,j) += 1/2 sum_cd <ab||cd> tau(c,d,i,j)
+   *                 = sum_{c<d} <ab||cd> tau(c,d,i,j),  a < b, i < j
+   *
+   *  either from the packed <ab||cd> (a quarter of the memory and an
+   *  eighth of the FLOPs of the full contraction) or integral-direct
+   *  from the RI factors.
+   */
+  template <typename MatsT, typename IntsT>
+  void CCSD<MatsT,IntsT>::addLadder(TArray tau) {
+
+    if (vvPairs.empty() or ooPairs.empty()) return;
+
+    std::vector<MatsT> tauPacked = packVVOO(tau);
+    std::vector<MatsT> ladder;
+
+    if (vvRI) {
+      ladder.resize(tauPacked.size());
+      endTAThreads();
+      formLadderRI(tauPacked, ladder);
+      startTAThreads();
+    } else {
+      TArray tauTA = vvooToTA(tauPacked);
+      TArray ladderTA;
+      ladderTA("p,q") = abcdPacked("p,r") * tauTA("r,q");
+      ladder = vvooFromTA(ladderTA);
+    }
+
+    addUnpackedVVOO(ladder, this->T2_);
+  }
+
+  /**
+   *  \brief Integral-direct particle-particle ladder from the virtual
+   *  RI / Cholesky factors, one bra index a and a batch of b at a time:
+   *
+   *    X_a(c,d,b) = sum_L B(L,a,c) B(L,b,d) = (ac|bd),          b > a
+   *    W_a(cd,b)  = X_a(c,d,b) - X_a(d,c,b) = <ab||cd>,         c < d
+   *    L(ab,ij)   = sum_{c<d} W_a(cd,b) tau(cd,ij)
+   *
+   *  Only O(V^2) of <ab||cd> per b of the batch lives at any time, the
+   *  batch is as large as the memory manager allows. The two GEMMs per
+   *  batch run on the threaded BLAS and the b > a restriction halves the
+   *  FLOPs of the integral build.
+   */
+  template <typename MatsT, typename IntsT>
+  void CCSD<MatsT,IntsT>::formLadderRI(const std::vector<MatsT>& tauP,
+    std::vector<MatsT>& L) {
+
+    auto & mem = this->ref_.memManager;
+
+    size_t NV   = this->ref_.nV;
+    size_t NVV  = vvPairs.size();
+    size_t NOO  = ooPairs.size();
+    size_t NBRI = vvRI->nRIBasis();
+    size_t NVRI = NV * NBRI;
+
+    const MatsT * B = vvRI->pointer();
+
+    // X, W and LA per b
+    size_t perB   = NV * NV + NVV + NOO;
+    size_t nBatch = NV - 1;
+    MatsT * SCR   = nullptr;
+
+    try {
+      SCR = mem.template malloc<MatsT>(perB * nBatch);
+    } catch (std::bad_alloc & ba) {
+      nBatch = std::min(nBatch, mem.template max_avail_allocatable<MatsT>(perB));
+      if (nBatch == 0) CErr("Not enough memory for the RI ladder.");
+      SCR = mem.template malloc<MatsT>(perB * nBatch);
+    }
+
+    MatsT * X  = SCR;
+    MatsT * W  = X + NV * NV * nBatch;
+    MatsT * LA = W + NVV * nBatch;
+
+    for (auto a = 0ul; a < NV - 1; a++)
+    for (auto b0 = a + 1; b0 < NV; b0 += nBatch) {
+
+      size_t nb = std::min(nBatch, NV - b0);
+
+      // X(c, d b) = B(L, a c)^T B(L, d b)
+      blas::gemm(blas::Layout::ColMajor, blas::Op::Trans, blas::Op::NoTrans,
+        NV, NV * nb, NBRI, MatsT(1.), B + a * NVRI, NBRI,
+        B + b0 * NVRI, NBRI, MatsT(0.), X, NV);
+
+      // W(cd, b) = X(c,d,b) - X(d,c,b)
+      #pragma omp parallel for schedule(static) default(shared)
+      for (size_t b = 0; b < nb; b++) {
+        const MatsT * Xb = X + b * NV * NV;
+        MatsT * Wb = W + b * NVV;
+        for (auto cd = 0ul; cd < NVV; cd++) {
+          size_t c = vvPairs[cd].first, d = vvPairs[cd].second;
+          Wb[cd] = Xb[c + d * NV] - Xb[d + c * NV];
+        }
+      }
+
+      // LA(b, ij) = W(cd, b)^T tau(cd, ij)
+      blas::gemm(blas::Layout::ColMajor, blas::Op::Trans, blas::Op::NoTrans,
+        nb, NOO, NVV, MatsT(1.), W, NVV, tauP.data(), NVV,
+        MatsT(0.), LA, nb);
+
+      #pragma omp parallel for schedule(static) default(shared)
+      for (size_t ij = 0; ij < NOO; ij++)
+        for (auto b = 0ul; b < nb; b++)
+          L[pairIndex(a, b0 + b) + NVV * ij] = LA[b + nb * ij];
+
+    }
+
+    mem.free(SCR);
+
   }
   template <typename MatsT, typename IntsT>
   void CCSD<MatsT,IntsT>::doDIIS(size_t t1offset, size_t NT1blks, size_t NT2blks, TArray T1_old, TArray T2_old, std::shared_ptr<DiskDIIS<MatsT>> diis ){
@@ -397,6 +792,12 @@ namespace ChronusQ{
     std::cout << std::setw(45) << std::left << "  Amplitude Convergence Tolerance:"
               << this->ccSettings.tConv << '\n';
 
+    bool riLadder = this->ccSettings.ladderAlg == CC_LADDER_ALG::RI or
+      (this->ccSettings.ladderAlg == CC_LADDER_ALG::AUTO and
+       std::dynamic_pointer_cast<InCoreRITPI<IntsT>>(this->ref_.aoints.TPI));
+    std::cout << std::setw(45) << std::left << "  Particle-Particle Ladder:"
+              << (riLadder ? "RI Integral-Direct" : "Stored <ab||cd> (a<b, c<d)") << '\n';
+
     std::cout << std::setw(45) << std::left << "  Direct Inversion of Iterative Subspace:";
 
     if ( this->useDIIS ) {
@@ -427,6 +828,8 @@ namespace ChronusQ{
     int diis_dim = NO*NO*NV*NV + NO*NV;;
     std::shared_ptr<DiskDIIS<MatsT> > diis (new DiskDIIS<MatsT> (diis_dim, this->nDIIS, this->ref_.savFile, this->ref_.memManager));
     
+    initRanges();
+
     size_t NOblocks = NO % blksize == 0 ? NO / blksize : NO / blksize + 1;
     size_t NVblocks = NV % blksize == 0 ? NV / blksize : NV / blksize + 1; 
 
@@ -434,7 +837,6 @@ namespace ChronusQ{
     size_t NT2blks = NT1blks * NT1blks;
     size_t t1offset = NO * NO * NV * NV;
 
-    initRanges();
     transformInts();
     initIntermediates();
     initAmplitudes();
@@ -622,7 +1024,7 @@ namespace ChronusQ{
     //reuse the T2_old container
     T2_old("c,d,i,j") += T1_old("c,i") * T1_old("d,j");
     T2_old("c,d,i,j") += - T1_old("c,j") * T1_old("d,i");
-    this->T2_("a,b,i,j") += 0.5 * this->antiSymMoints["abcd"]("a,b,c,d") * T2_old("c,d,i,j");
+    addLadder(T2_old);
   
     TArray oneoverD_abij(TA::get_default_world(),TA::TiledRange{vrange,vrange,orange,orange});
     for(auto it = std::begin(oneoverD_abij); it != std::end(oneoverD_abij); ++it) {
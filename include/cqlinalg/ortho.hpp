@@ -115,6 +115,102 @@ namespace ChronusQ {
 
 
 
+  /**
+   *  \brief Blocked orthonormalization of Mnew vectors against Mold
+   *  orthonormal ones (BCGS2 + CholeskyQR2).
+   *
+   *  Each of the NRe+1 passes projects the old vectors out of the new
+   *  block with two GEMMs and orthonormalizes the block by a Cholesky
+   *  factorization of its (column scaled) Gram matrix. The Cholesky
+   *  factor of the first pass yields the Gram-Schmidt residual norms:
+   *  if one of them falls below the dropping threshold of GramSchmidt,
+   *  or the block is too ill-conditioned for CholeskyQR, the vector wise
+   *  GramSchmidt is used instead, so that linearly dependent vectors are
+   *  dropped exactly as before.
+   *
+   *  \returns the total number of orthonormal vectors
+   */
+  template <typename F, typename _VecNorm, typename _MatInner>
+  size_t BlockGramSchmidt(size_t N, size_t Mold, size_t Mnew, F *V,
+    size_t LDV, _VecNorm vecNorm, _MatInner matInner, CQMemManager &mem,
+    size_t NRe = 1, double eps = 1e-12, double condTol = 1e-6) {
+
+    if( Mnew == 0 ) return Mold;
+
+    F * W    = V + Mold * LDV;
+    F * G    = mem.template malloc<F>(Mnew * Mnew);
+    F * SCR  = Mold ? mem.template malloc<F>(Mold * Mnew) : nullptr;
+    double * D = mem.template malloc<double>(Mnew);
+
+    bool fallback = false;
+    for(auto iRe = 0; iRe < (NRe+1) and not fallback; iRe++) {
+
+      // W <- W - V (V**H W)
+      if( Mold ) {
+        matInner(Mold,Mnew,V,LDV,W,LDV,SCR);
+        blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,
+          N,Mnew,Mold,F(-1.),V,LDV,SCR,Mold,F(1.),W,LDV);
+      }
+
+      // G = D**-1 W**H W D**-1, D = diag(W**H W)**1/2
+      matInner(Mnew,Mnew,W,LDV,W,LDV,G);
+      for(auto k = 0ul; k < Mnew; k++) {
+        D[k] = std::sqrt(std::abs(G[k*(Mnew+1)]));
+        if( D[k] < N*eps ) { fallback = true; break; }
+      }
+      if( fallback ) break;
+
+      for(auto j = 0ul; j < Mnew; j++)
+      for(auto i = 0ul; i < Mnew; i++) G[i + j*Mnew] /= D[i] * D[j];
+
+      // G = R**H R
+      if( lapack::potrf(lapack::Uplo::Upper,Mnew,G,Mnew) != 0 ) {
+        fallback = true; break;
+      }
+
+      // R(k,k) D(k) is the norm of the k-th Gram-Schmidt residual
+      if( iRe == 0 )
+      for(auto k = 0ul; k < Mnew; k++) {
+        double rkk = std::abs(G[k*(Mnew+1)]);
+        if( rkk < condTol or rkk * D[k] < N*eps ) { fallback = true; break; }
+      }
+      if( fallback ) break;
+
+      // W <- W D**-1 R**-1
+      for(auto k = 0ul; k < Mnew; k++) blas::scal(N,F(1./D[k]),W + k*LDV,1);
+      blas::trsm(blas::Layout::ColMajor,blas::Side::Right,blas::Uplo::Upper,
+        blas::Op::NoTrans,blas::Diag::NonUnit,N,Mnew,F(1.),G,Mnew,W,LDV);
+
+    }
+
+    mem.free(G, D);
+    if( SCR ) mem.free(SCR);
+
+    // W still spans the original space if the blocked passes bailed out
+    if( fallback )
+      return GramSchmidt(N,Mold,Mnew,V,LDV,vecNorm,matInner,mem,NRe,eps);
+
+    return Mold + Mnew;
+
+  };
+
+
+  template <typename F>
+  size_t BlockGramSchmidt(size_t N, size_t Mold, size_t Mnew, F *V,
+    size_t LDV, CQMemManager &mem, size_t NRe = 1, double eps = 1e-12) {
+
+    return
+    BlockGramSchmidt(N,Mold,Mnew,V,LDV,
+      [&](F* Vc){ return std::sqrt(std::abs(blas::dot(N,Vc,1,Vc,1))); },
+      [&](size_t i, size_t j, F* Vi, size_t LDVi, F* Vj, size_t LDVj, 
+        F* inner){
+        blas::gemm(blas::Layout::ColMajor,blas::Op::ConjTrans,blas::Op::NoTrans,i,j,N,F(1.),Vi,LDVi,Vj,LDVj,F(0.),inner,i);
+      },
+      mem,NRe,eps);
+
+  };
+
+
   template <typename F, typename _MatInner>
   void GramSchmidt(size_t N, size_t Mold, size_t Mnew, F *VL, size_t LDVL, 
     F *VR, size_t LDVR, _MatInner matInner, CQMemManager &mem, size_t NRe = 0) {
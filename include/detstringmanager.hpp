@@ -84,14 +84,15 @@ namespace ChronusQ {
     int_matrix buildAddressingArray(size_t, size_t) const;
     int_matrix buildDeAddressingArray(size_t, size_t) const ;
     int_matrix buildDeAddressingArray(int_matrix &) const;
-    size_t detString2Address(std::vector<size_t> &, int_matrix &) const;
-    size_t detString2Address(bool *, int_matrix &) const;
-    std::vector<size_t> address2DetString(size_t, int_matrix &, int_matrix &) const;
-    DetString address2DetString(size_t, size_t, int_matrix &, int_matrix &) const;
+    size_t detString2Address(std::vector<size_t> &, const int_matrix &) const;
+    size_t detString2Address(bool *, const int_matrix &) const;
+    size_t detString2Address(const DetString &, const int_matrix &) const;
+    std::vector<size_t> address2DetString(size_t, const int_matrix &, const int_matrix &) const;
+    DetString address2DetString(size_t, size_t, const int_matrix &, const int_matrix &) const;
     
     // helper functions for computing excitation list
-    void computeSingleString1eExcitationList(DetString &, int *, size_t, size_t, int_matrix &) const; 
-    ExcitationList computeIntraCASExcitationList(size_t, size_t, int_matrix &) const;
+    void computeSingleString1eExcitationList(DetString &, int *, size_t, size_t, const int_matrix &) const; 
+    ExcitationList computeIntraCASExcitationList(size_t, size_t, const int_matrix &) const;
     
     void computeTwoString1eExcitationList(DetString &, DetString &, int *,
                     int, bool, int_matrix &, int_matrix &) const;
@@ -110,6 +111,8 @@ namespace ChronusQ {
 
     std::shared_ptr<ExcitationList> exList_; 
     int_matrix addrArray_;  
+    int_matrix deAddrArray_; // only for COMPUTING_EXCITATION_ON_THE_FLY
+    size_t blockSize_ = 0;   // strings per on-the-fly block, 0 = cache sized
 
   public:
     CASStringManager()                         = delete;
@@ -117,14 +120,22 @@ namespace ChronusQ {
     CASStringManager(CASStringManager &&)      = default;
     
     CASStringManager(CQMemManager & mem, size_t nOrb, size_t nE,
-        ExcitationScheme scheme = PRECOMPUTED_CONFIGURATION_DRIVEN_LIST):
-        DetStringManager(mem, nOrb, nE, scheme) {
+        ExcitationScheme scheme = PRECOMPUTED_CONFIGURATION_DRIVEN_LIST,
+        size_t blockSize = 0):
+        DetStringManager(mem, nOrb, nE, scheme), blockSize_(blockSize) {
+      this->nStr_ = Comb(nOrb, nE);
       addrArray_ = this->buildAddressingArray(nE, nOrb);
     }   
     
     ~CASStringManager() { dealloc(); }
     
-    std::shared_ptr<const ExcitationList> excitationList() const { return exList_; }
+    std::shared_ptr<const ExcitationList> excitationList() const;
+    
+    // Excitation lists string block by string block, see
+    // detstringmanager/casstringmanager.hpp
+    size_t nNonZero() const { return this->nE_ * (this->nOrb_ - this->nE_ + 1); }
+    size_t stringBlockSize() const;
+    const int * excitationListBlock(size_t, size_t, ExcitationList &) const;
      
     void computeList();
     
@@ -179,5 +190,57 @@ namespace ChronusQ {
 
   }; // class RASStringManager
 
+  /**
+   *  \brief Determinant space of a selected CI.
+   *
+   *  Unlike the CAS / RAS managers, which address alpha / beta strings
+   *  of a complete space, this stores an arbitrary list of full
+   *  determinants as bit-packed spin orbital strings (alpha orbitals
+   *  first and beta orbitals second for 1C), indexed in the order they
+   *  were added. Lookups go through an open addressing hash table over
+   *  the packed words.
+   */
+  class SCIStringManager: public DetStringManager {
+
+  public:
+
+    typedef DetString::word_t word_t;
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+  protected:
+
+    size_t nWords_;              // words per determinant
+    std::vector<word_t> dets_;   // nStr_ x nWords_ packed determinants
+    std::vector<size_t> table_;  // hash table of determinant indices
+
+    void rehash(size_t);
+
+  public:
+    SCIStringManager()                         = delete;
+    SCIStringManager(const SCIStringManager &) = default;
+    SCIStringManager(SCIStringManager &&)      = default;
+
+    SCIStringManager(CQMemManager & mem, size_t nOrb, size_t nE):
+        DetStringManager(mem, nOrb, nE, COMPUTING_EXCITATION_ON_THE_FLY),
+        nWords_((nOrb + DetString::wordBits - 1) / DetString::wordBits) {
+      this->nStr_ = 0;
+    }
+
+    ~SCIStringManager() { };
+
+    size_t nWords() const { return nWords_; }
+    const word_t * det(size_t i) const { return dets_.data() + i * nWords_; }
+
+    // see detstringmanager/scistringmanager.hpp
+    size_t hash(const word_t *) const;
+    size_t find(const word_t *) const;
+    bool insert(const word_t *);
+    void clear();
+
+    // excitations are generated on the fly by the SelectedCI builder
+    void computeList() { };
+
+  }; // class SCIStringManager
+
 
 }; // namespace ChronusQ
@@ -36,8 +36,73 @@ namespace ChronusQ {
       exList_ = std::make_shared<ExcitationList>(
         this->computeIntraCASExcitationList(
           this->nOrb_, this->nE_, addrArray_));
+    } else if(this->scheme_ == COMPUTING_EXCITATION_ON_THE_FLY) {
+      // only the addressing is kept, lists are generated per string block
+      exList_ = nullptr;
+      deAddrArray_ = this->buildDeAddressingArray(addrArray_);
     } else CErr("Not Implemented yet");
     
   }; // CASString::buildConfDrivenExcitationList
 
+  /*
+   * Full excitation list. For COMPUTING_EXCITATION_ON_THE_FLY this is a
+   * transient list built for the caller, meant for the explicit full
+   * Hamiltonian (CASCI::buildFullH) only. The sigma, diagonal and
+   * density builds go through excitationListBlock
+   */
+  std::shared_ptr<const ExcitationList> CASStringManager::excitationList() const {
+
+    if (exList_) return exList_;
+
+    return std::make_shared<ExcitationList>(
+      this->computeIntraCASExcitationList(this->nOrb_, this->nE_, addrArray_));
+
+  }; // CASStringManager::excitationList
+
+  /*
+   * Number of strings per block such that the 4 * nNZ ints of a
+   * block stay resident in the (L2) cache while they are reused,
+   * unless a block size was requested (MCSCF.EXCITATIONBLOCK)
+   */
+  size_t CASStringManager::stringBlockSize() const {
+
+    if (exList_ or nNonZero() == 0) return this->nStr_;
+    if (blockSize_ > 0) return std::min(this->nStr_, blockSize_);
+
+    const size_t blockInts = 65536; // 256 KB
+    return std::max(1ul, std::min(this->nStr_, blockInts / (4 * nNonZero())));
+
+  }; // CASStringManager::stringBlockSize
+
+  /*
+   * Excitation lists of the strings [first, first + n), with the same
+   * layout as ExcitationList::pointerAtDet. For a precomputed list this
+   * is a view, otherwise the lists are generated from the bit-packed
+   * strings into block, which must hold at least n strings
+   */
+  const int * CASStringManager::excitationListBlock(size_t first, size_t n,
+    ExcitationList & block) const {
+
+    if (exList_) return exList_->pointerAtDet(first);
+
+    if (block.nString() < n or block.nNonZero() != nNonZero())
+      CErr("Excitation list block is too small");
+
+    #pragma omp parallel default(shared)
+    {
+      DetString L(this->memManager_, this->nOrb_);
+
+      #pragma omp for schedule(static)
+      for (size_t iStr = 0; iStr < n; iStr++) {
+        L.set(false);
+        L.set(this->address2DetString(first + iStr, addrArray_, deAddrArray_));
+        this->computeSingleString1eExcitationList(L, block.pointerAtDet(iStr),
+          this->nOrb_, this->nE_, addrArray_);
+      }
+    }
+
+    return block.pointer();
+
+  }; // CASStringManager::excitationListBlock
+
 }; // namespace ChronusQ
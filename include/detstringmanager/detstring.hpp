@@ -33,22 +33,46 @@ namespace ChronusQ {
   /* 
    * Class of binary representations for electronic 
    * configurations in determinants form
+   *
+   * The occupations are bit-packed into 64-bit words (orbital i is
+   * bit i%64 of word i/64), such that the occupation lists, phases and
+   * excitations are evaluated with word-wide popcount / ctz operations
    */
   class DetString {
 
+  public:
+
+    typedef uint64_t word_t;
+    static constexpr size_t wordBits = 64;
+
   protected:
     
     CQMemManager & memManager_; ///< CQMemManager to allocate matricies
-    bool * ptr_ = nullptr;     ///< Raw string storage
+    word_t * ptr_ = nullptr;   ///< Raw (bit-packed) string storage
     size_t N_;
+    size_t nWords_;
     size_t n1s_;
 
+    static size_t wordIdx(size_t Loc) { return Loc / wordBits; }
+    static word_t bitMask(size_t Loc) { return word_t(1) << (Loc % wordBits); }
+
+    // mask of the lowest n bits of a word (n <= 64)
+    static word_t lowMask(size_t n) {
+      return n >= wordBits ? ~word_t(0) : (word_t(1) << n) - 1;
+    }
+
+    static size_t popcount(word_t w) { return __builtin_popcountll(w); }
+    static size_t ctz(word_t w) { return __builtin_ctzll(w); }
+
+    // mask of the valid bits in the last word
+    word_t tailMask() const { return lowMask(N_ - (nWords_ - 1) * wordBits); }
+
   public:
     
     // Constructors
     DetString() = delete;
     DetString(CQMemManager &mem, size_t n, bool b = 0):
-        N_(n), memManager_(mem) {
+        memManager_(mem), N_(n), nWords_((n + wordBits - 1) / wordBits) {
       alloc();
       set(b);
     }
@@ -59,17 +83,20 @@ namespace ChronusQ {
     }
     DetString(const DetString & other):
         DetString(other.memManager_, other.N_) {
-      std::copy_n(other.ptr_, N_, ptr_);
+      std::copy_n(other.ptr_, nWords_, ptr_);
+      n1s_ = other.n1s_;
     }
     DetString(DetString && other):
-      memManager_(other.memManager_), N_(other.N_),
-      ptr_(other.ptr_) { other.ptr_ = nullptr; }
+      memManager_(other.memManager_), ptr_(other.ptr_), N_(other.N_),
+      nWords_(other.nWords_), n1s_(other.n1s_) { other.ptr_ = nullptr; }
     
     ~DetString() { dealloc(); }
 
     // helper functions
     void set(bool b) {
-      std::fill_n(ptr_, N_, b);
+      if (nWords_ == 0) { n1s_ = 0; return; }
+      std::fill_n(ptr_, nWords_, b ? ~word_t(0) : word_t(0));
+      ptr_[nWords_ - 1] &= tailMask();
       if(b) n1s_ = N_;
       else n1s_ = 0;
     }
@@ -78,32 +105,35 @@ namespace ChronusQ {
       for (const size_t & L: Locs) {
 //        if(L >= N_) 
 //          CErr("The bit to assign is exceeding the DetString range");
-        ptr_[L] = 1;
+        ptr_[wordIdx(L)] |= bitMask(L);
       }
-      n1s_ = Locs.size();
+      n1s_ = countOnes(0, N_);
     }
     
     void flip(size_t Loc) { 
 //      if(Loc >= N_) 
 //        CErr("The bit to flip is exceeding the DetString range");
-      ptr_[Loc] = not ptr_[Loc];
-      if(ptr_[Loc]) n1s_++;
+      ptr_[wordIdx(Loc)] ^= bitMask(Loc);
+      if(test(Loc)) n1s_++;
       else n1s_--;
     } 
     
-    size_t size() const { return N_; }
-    size_t n1s()  const { return n1s_; }
-    size_t n0s()  const { return N_ - n1s_; }
-    bool * pointer(size_t i = 0) { return ptr_ + i; }
-    
-    bool & operator[](size_t Loc) { return ptr_[Loc]; }   
-    bool operator[] (size_t Loc) const { return ptr_[Loc]; }
+    size_t size()   const { return N_; }
+    size_t nWords() const { return nWords_; }
+    size_t n1s()    const { return n1s_; }
+    size_t n0s()    const { return N_ - n1s_; }
+    const word_t * words() const { return ptr_; }
+
+    bool test(size_t Loc) const { return ptr_[wordIdx(Loc)] & bitMask(Loc); }
+    bool operator[] (size_t Loc) const { return test(Loc); }
+
     DetString & operator=( const DetString & other) {
       if (this != &other) {
         N_ = other.N_;
+        nWords_ = other.nWords_;
         n1s_ = other.n1s_;
         alloc();
-        std::copy_n(other.ptr_, N_, ptr_);
+        std::copy_n(other.ptr_, nWords_, ptr_);
       }
       return *this;
     }
@@ -111,6 +141,7 @@ namespace ChronusQ {
     DetString & operator=(DetString && other) {
       if (this != &other) {
         N_ = other.N_;
+        nWords_ = other.nWords_;
         n1s_ = other.n1s_;
         dealloc();
         ptr_ = other.ptr_;
@@ -121,19 +152,47 @@ namespace ChronusQ {
 
     DetString operator+(const DetString & other) const { 
       DetString joint_str(memManager_, N_ + other.N_); 
+      std::copy_n(ptr_, nWords_, joint_str.ptr_); 
+
+      // shift the words of other into place behind this string
+      size_t off = N_ % wordBits;
+      for (auto i = 0ul; i < other.nWords_; i++) {
+        size_t iW = nWords_ - (off ? 1 : 0) + i;
+        joint_str.ptr_[iW] |= other.ptr_[i] << off;
+        if (off and iW + 1 < joint_str.nWords_)
+          joint_str.ptr_[iW + 1] |= other.ptr_[i] >> (wordBits - off);
+      }
+
       joint_str.n1s_ = n1s_ + other.n1s_; 
-      std::copy_n(ptr_, N_, joint_str.ptr_); 
-      std::copy_n(other.ptr_, other.N_, joint_str.ptr_ + N_);
       return joint_str;
     }
     
-    std::string to_string() {
+    std::string to_string() const {
       std::string s(N_, '0');
       for(auto i =0ul; i < N_; i++)
-        if (ptr_[i]) s[i] = '1';
+        if (test(i)) s[i] = '1';
 
       return s;
     }
+
+    /*
+     * Number of occupied orbitals in [first, last)
+     */
+    size_t countOnes(size_t first, size_t last) const {
+      if (first >= last) return 0;
+
+      size_t wF = wordIdx(first), wL = wordIdx(last - 1);
+      word_t fMask = ~lowMask(first % wordBits);
+      word_t lMask = lowMask((last - 1) % wordBits + 1);
+
+      if (wF == wL) return popcount(ptr_[wF] & fMask & lMask);
+
+      size_t count = popcount(ptr_[wF] & fMask) + popcount(ptr_[wL] & lMask);
+      for (auto w = wF + 1; w < wL; w++) count += popcount(ptr_[w]);
+
+      return count;
+    }
+
     /*
      * Determine the sign for nonzero matrix elements.
      * WARNING: it's assumed that p and q will generate 
@@ -141,14 +200,10 @@ namespace ChronusQ {
      */ 
     int sign1e(const size_t p, const size_t q) const {
       
-      bool sign = true;
       size_t l = std::min(p,q);
       size_t r = std::max(p,q);
-      for (auto k = l+1; k < r; k++){
-        sign ^= ptr_[k]; // using exclusive or 
-      }
 
-      return  (sign)? 1: -1; 
+      return (countOnes(l+1, r) & 1)? -1: 1; 
     } // sign1e 
     
     /* 
@@ -156,19 +211,29 @@ namespace ChronusQ {
      * p: 0->1, q: 1->0
      */
     void excitation(const size_t p, const size_t q) {
-//      if (not ptr_.[q] or (ptr_[p] and p != q)) return;
-      ptr_[q] = not ptr_[q];
-      ptr_[p] = not ptr_[p];
+//      if (not test(q) or (test(p) and p != q)) return;
+      ptr_[wordIdx(q)] ^= bitMask(q);
+      ptr_[wordIdx(p)] ^= bitMask(p);
     } // excitation
     
     template< class InputIt >
     void bitInfo(const bool bitType, const std::pair<size_t, size_t> & occRange, 
       InputIt bitList) const {
+      if (occRange.first >= occRange.second) return;
+
       auto bitList_ptr = bitList;
-      for(auto i = occRange.first; i < occRange.second; i++) {
-        if(bitType == ptr_[i]) {
-          *bitList_ptr = i;
+      size_t wF = wordIdx(occRange.first), wL = wordIdx(occRange.second - 1);
+
+      for(auto w = wF; w <= wL; w++) {
+        word_t word = bitType ? ptr_[w] : ~ptr_[w];
+        if (w == wF) word &= ~lowMask(occRange.first % wordBits);
+        if (w == wL) word &= lowMask((occRange.second - 1) % wordBits + 1);
+
+        // visit the set bits from the lowest one
+        while (word) {
+          *bitList_ptr = w * wordBits + ctz(word);
           bitList_ptr++;
+          word &= word - 1;
         }
       }
     }
@@ -188,17 +253,19 @@ namespace ChronusQ {
     // memory management
     void alloc() {
       dealloc();
-      try { ptr_ =  memManager_.malloc<bool>(N_);}
+      if (nWords_ == 0) return;
+      try { ptr_ =  memManager_.malloc<word_t>(nWords_);}
       catch(...) {
         CErr("need more memory to allocate detString" );
       }
+      std::fill_n(ptr_, nWords_, word_t(0));
     }
     
     void dealloc() { 
       if(ptr_) memManager_.free(ptr_); 
+      ptr_ = nullptr;
     }
   
   }; // ChronusQ::DetString
   
 }; // namespace ChronusQ
-  
@@ -95,7 +95,7 @@ namespace ChronusQ {
   // !!address start from 0 in C++
   // CAS type addressing
   size_t DetStringManager::detString2Address(std::vector<size_t> & elecPos, 
-    int_matrix & addr_array) const {
+    const int_matrix & addr_array) const {
       
       size_t addr = 0;
       for (auto iE = 0ul; iE < elecPos.size(); iE++)
@@ -105,7 +105,7 @@ namespace ChronusQ {
   };
   
   size_t DetStringManager::detString2Address(bool * detStr, 
-      int_matrix & addr_array) const {
+      const int_matrix & addr_array) const {
     
     size_t nE   = addr_array.size(); 
     size_t nOrb = addr_array[0].size();
@@ -124,8 +124,33 @@ namespace ChronusQ {
 
   }; // DetStringManager::detString2Address
   
+  /*
+   * Bit-packed version: walk the occupied orbitals word by word
+   * with count-trailing-zeros instead of scanning every orbital
+   */
+  size_t DetStringManager::detString2Address(const DetString & detStr,
+      const int_matrix & addr_array) const {
+
+    size_t nE = addr_array.size();
+    if (nE == 0 or addr_array[0].size() == 0) return 0;
+
+    const DetString::word_t * words = detStr.words();
+
+    size_t addr = 0, iE = 0;
+    for (auto w = 0ul; w < detStr.nWords() and iE < nE; w++) {
+      DetString::word_t word = words[w];
+      while (word and iE < nE) {
+        addr += addr_array[iE++][w * DetString::wordBits + __builtin_ctzll(word)];
+        word &= word - 1;
+      }
+    }
+
+    return addr;
+
+  }; // DetStringManager::detString2Address
+
   std::vector<size_t> DetStringManager::address2DetString(size_t addr, 
-      int_matrix & addr_array, int_matrix & de_addr_array) const {
+      const int_matrix & addr_array, const int_matrix & de_addr_array) const {
 
     size_t nE   = addr_array.size(); 
     if (nE == 0) return {};
@@ -149,7 +174,7 @@ namespace ChronusQ {
   }; // DetStringManager::address2DetString
 
   DetString DetStringManager::address2DetString(size_t addr, size_t nOrb, 
-      int_matrix & addr_array, int_matrix & de_addr_array) const {
+      const int_matrix & addr_array, const int_matrix & de_addr_array) const {
    
     return DetString(this->memManager_, nOrb, address2DetString(addr, addr_array, de_addr_array));
      
@@ -166,7 +191,7 @@ namespace ChronusQ {
    */ 
   void DetStringManager::computeSingleString1eExcitationList(
       DetString & detStr, int * exList, size_t nOrb, 
-      size_t nE, int_matrix & addrArray) const { 
+      size_t nE, const int_matrix & addrArray) const { 
     
     std::vector<size_t> LOcc = detStr.occupationInfo();
     std::vector<size_t> LVir = detStr.virtualInfo();
@@ -181,7 +206,7 @@ namespace ChronusQ {
 
     int * exList_ptr = exList;
     size_t p, q;
-    size_t LAddr = detString2Address(detStr.pointer(), addrArray); 
+    size_t LAddr = detString2Address(detStr, addrArray); 
     
     // case 1: self-excitation, p=q == occ
     for (auto pOcc = 0ul ; pOcc < nE; pOcc++) {
@@ -201,7 +226,7 @@ namespace ChronusQ {
       exList_ptr[0] = p;
       exList_ptr[1] = q;
       detStr.excitation(q,p);
-      exList_ptr[2] = detString2Address(detStr.pointer(), addrArray);
+      exList_ptr[2] = detString2Address(detStr, addrArray);
       exList_ptr[3] = detStr.sign1e(p,q); 
       detStr.excitation(p,q);
       exList_ptr += 4;  
@@ -243,19 +268,20 @@ namespace ChronusQ {
       detsq.flip(j);
       detsp.flip(i);
 
-      int Sign1e;
-      if (pqseq) {
-        DetString tmp = detsp + detsq;
-        Sign1e = Sgnoff * tmp.sign1e(i, j + detsp.size());
-      } else {
-        DetString tmp = detsq + detsp;
-        Sign1e = Sgnoff * tmp.sign1e(j, i + detsq.size());
-      }
+      // sign1e of the joint string (p+q or q+p) from the popcounts of
+      // the two pieces, without forming the concatenated string
+      size_t nCross;
+      if (pqseq)
+        nCross = detsp.countOnes(i + 1, detsp.size()) + detsq.countOnes(0, j);
+      else
+        nCross = detsq.countOnes(j + 1, detsq.size()) + detsp.countOnes(0, i);
+
+      int Sign1e = (nCross & 1) ? -Sgnoff : Sgnoff;
 
       exList_ptr[0] = i;
       exList_ptr[1] = j;
-      exList_ptr[2] = detString2Address(detsp.pointer(), addrArrayp);
-      exList_ptr[3] = detString2Address(detsq.pointer(), addrArrayq);
+      exList_ptr[2] = detString2Address(detsp, addrArrayp);
+      exList_ptr[3] = detString2Address(detsq, addrArrayq);
       exList_ptr[4] = Sign1e;
       exList_ptr += 5;
 
@@ -266,7 +292,7 @@ namespace ChronusQ {
 
   
   ExcitationList DetStringManager::computeIntraCASExcitationList(
-      size_t nOrb, size_t nE, int_matrix & addrArray) const {
+      size_t nOrb, size_t nE, const int_matrix & addrArray) const {
      
     size_t nNZ = nE * (nOrb - nE + 1);
     size_t nStr = Comb(nOrb, nE);
@@ -354,5 +380,6 @@ namespace ChronusQ {
 // Other headers
 #include <detstringmanager/casstringmanager.hpp>
 #include <detstringmanager/rasstringmanager.hpp>
+#include <detstringmanager/scistringmanager.hpp>
 
 
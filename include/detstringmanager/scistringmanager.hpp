@@ -0,0 +1,108 @@
+/* 
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *  
+ *  Copyright (C) 2014-2022 Li Research Group (University of Washington)
+ *  
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *  
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *  
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *  
+ */
+#pragma once
+
+#include <detstringmanager.hpp> 
+
+namespace ChronusQ {
+
+  /*
+   * 64-bit hash of a packed determinant (splitmix64 finalizer
+   * chained over the words)
+   */
+  size_t SCIStringManager::hash(const word_t * d) const {
+
+    uint64_t h = 0x9E3779B97F4A7C15ull;
+    for (auto w = 0ul; w < nWords_; w++) {
+      uint64_t x = d[w] + h;
+      x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+      x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+      h = x ^ (x >> 31);
+    }
+    return h;
+
+  }; // SCIStringManager::hash
+
+  /*
+   * Index of a determinant in the space, npos if it is not there
+   */
+  size_t SCIStringManager::find(const word_t * d) const {
+
+    if (table_.empty()) return npos;
+
+    const size_t mask = table_.size() - 1;
+    for (size_t slot = hash(d) & mask; ; slot = (slot + 1) & mask) {
+      const size_t i = table_[slot];
+      if (i == npos) return npos;
+      if (std::equal(d, d + nWords_, det(i))) return i;
+    }
+
+  }; // SCIStringManager::find
+
+  /*
+   * Append a determinant to the space unless it is already there.
+   * Returns whether it was added
+   */
+  bool SCIStringManager::insert(const word_t * d) {
+
+    // keep the load factor below 1/2
+    if (2 * (this->nStr_ + 1) > table_.size())
+      rehash(std::max(size_t(64), 2 * table_.size()));
+
+    const size_t mask = table_.size() - 1;
+    size_t slot = hash(d) & mask;
+    for (; table_[slot] != npos; slot = (slot + 1) & mask)
+      if (std::equal(d, d + nWords_, det(table_[slot]))) return false;
+
+    table_[slot] = this->nStr_++;
+    dets_.insert(dets_.end(), d, d + nWords_);
+    return true;
+
+  }; // SCIStringManager::insert
+
+  /*
+   * Rebuild the hash table with nSlot (a power of 2) slots
+   */
+  void SCIStringManager::rehash(size_t nSlot) {
+
+    table_.assign(nSlot, npos);
+
+    const size_t mask = nSlot - 1;
+    for (auto i = 0ul; i < this->nStr_; i++) {
+      size_t slot = hash(det(i)) & mask;
+      while (table_[slot] != npos) slot = (slot + 1) & mask;
+      table_[slot] = i;
+    }
+
+  }; // SCIStringManager::rehash
+
+  void SCIStringManager::clear() {
+
+    this->nStr_ = 0;
+    dets_.clear();
+    table_.clear();
+
+  }; // SCIStringManager::clear
+
+}; // namespace ChronusQ
@@ -76,6 +76,10 @@ namespace ChronusQ {
     // Form a fock matrix (see include/fockbuilder/impl.hpp for docs)
     virtual void formFock(SingleSlater<MatsT,IntsT> &, EMPerturbation &, bool increment = false, double xHFX = 1.);
 
+    // Form fock matrices of objects sharing the integrals in one pass (see include/fockbuilder/impl.hpp for docs)
+    void formFockBatch(std::vector<SingleSlater<MatsT,IntsT>*> &, std::vector<EMPerturbation> &,
+      bool increment = false, double xHFX = 1.);
+
     // Compute the 2e gradient
     virtual std::vector<double> getGDGrad(SingleSlater<MatsT,IntsT>&, EMPerturbation&, double xHFX = 1.);
 
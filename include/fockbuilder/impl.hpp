@@ -287,6 +287,94 @@ namespace ChronusQ {
 
 
 
+  /**
+   *  \brief Forms the Fock matrices for a set of single slater
+   *  determinants which share the same integrals (e.g. RT replicas) using
+   *  a single pass over the two-body integrals.
+   *
+   *  All densities are packed into one TwoBodyContraction list, so the
+   *  ERIs are evaluated once and contracted with every density. Builders
+   *  which specialize formFock (NEO, 4C, RO, ...) and RI exchange (which
+   *  is formed from the MOs of each object) fall back to separate builds.
+   *
+   *  \param [in] sss   SingleSlater objects, sss[0] provides the integrals
+   *  \param [in] perts Perturbation for each SingleSlater object
+   *  \param [in] increment Whether or not the Fock matrices are being
+   *  incremented using previous densities
+   *
+   *  Populates / overwrites fock strorage in each SingleSlater
+   */
+  template <typename MatsT, typename IntsT>
+  void FockBuilder<MatsT,IntsT>::formFockBatch(
+    std::vector<SingleSlater<MatsT,IntsT>*> &sss,
+    std::vector<EMPerturbation> &perts, bool increment, double xHFX) {
+
+    if( sss.size() != perts.size() )
+      CErr("Fock and perturbation number mismatch in FockBuilder::formFockBatch");
+
+    if( sss.empty() ) return;
+
+    bool canBatch = sss.size() > 1 and
+      typeid(*this) == typeid(FockBuilder<MatsT,IntsT>) and
+      not std::dynamic_pointer_cast<InCoreRITPIContraction<MatsT,IntsT>>(sss[0]->TPI);
+
+    if( not canBatch ) {
+      for(auto i = 0ul; i < sss.size(); i++)
+        sss[i]->fockBuilder->formFock(*sss[i], perts[i], increment, xHFX);
+      return;
+    }
+
+    auto GDStart = tick(); // Start time for G[D]
+
+    std::vector<std::shared_ptr<PauliSpinorSquareMatrices<MatsT>>> 
+      onePDMs, coulombMatrices, exchangeMatrices, twoeHs;
+
+    for(auto &ss : sss) {
+      onePDMs.push_back(increment ? ss->deltaOnePDM : ss->onePDM);
+      exchangeMatrices.push_back(ss->exchangeMatrix);
+      twoeHs.push_back(ss->twoeH);
+      coulombMatrices.push_back(
+        std::make_shared<PauliSpinorSquareMatrices<MatsT>>(
+        ss->memManager, ss->coulombMatrix->dimension(), false, false)
+      );
+    }
+
+    // The perturbation only enters the contraction through field dependent
+    // (GIAO) integrals, which are common to all of the objects
+    formRawGDInBatches(*sss[0], perts[0], increment, xHFX, true,
+      onePDMs, coulombMatrices, exchangeMatrices, twoeHs);
+
+    double GDDur = tock(GDStart); // G[D] Duraction
+
+    for(auto i = 0ul; i < sss.size(); i++) {
+
+      SingleSlater<MatsT,IntsT> &ss = *sss[i];
+
+      ss.GDDur = GDDur;
+      *ss.coulombMatrix = coulombMatrices[i]->S(); 
+
+      if( MPIRank(ss.comm) != 0 ) continue;
+
+      // Form Fock
+      *ss.fockMatrix = *ss.coreH + *ss.twoeH;
+
+      // Add in the electric field contributions
+      if( pert_has_type(perts[i],Electric) ) {
+
+        auto dipAmp = perts[i].getDipoleAmp(Electric);
+
+        for(auto k = 0; k < 3; k++)
+          ss.fockMatrix->S() -=
+            2. * dipAmp[k] * (*ss.aoints.lenElectric)[k].matrix();
+
+      }
+
+    }
+
+  } // FockBuilder::formFockBatch
+
+
+
   template <typename MatsT, typename IntsT>
   void MatrixFock<MatsT,IntsT>::formFock(SingleSlater<MatsT,IntsT> &ss,
                                          EMPerturbation &pert, bool increment, double xHFX) {
@@ -38,6 +38,7 @@ namespace ChronusQ {
       DIRECT_N6 = 1, // hack thru ss.formfock
       INCORE_N5 = 2,
       DIRECT_N5 = 3, // NYI
+      INCORE_RI = 4, // thru RI / Cholesky three index factors
   };
 
   /**
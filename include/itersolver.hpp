@@ -31,6 +31,7 @@
 
 #include <util/mpi.hpp>
 #include <util/math.hpp>
+#include <util/files.hpp>
 
 #include <iostream>
 
@@ -56,12 +57,26 @@ namespace ChronusQ {
 
     double convCrit_; ///< Convergence criteria
 
+    bool   distVec_ = false; ///< Whether the vectors are distributed by rows
+    size_t NLoc_    = 0;     ///< Number of rows on this process
+    size_t rowOff_  = 0;     ///< First row on this process
+    std::vector<size_t> rowCounts_; ///< Number of rows on every process
+
     LinearTrans_t linearTrans_;    ///< AX Product
     LinearTrans_t preCondNoShift_; ///< Unshifted preconditioner
 
+    SafeFile   *chkFile_     = nullptr; ///< Binary file of the checkpoints
+    std::string chkPrefix_;             ///< Group of the solver state
+    size_t      chkInterval_ = 0;       ///< Iterations between checkpoints
+    bool        chkRead_     = false;   ///< Resume / seed from the file
+    std::vector<double> chkKey_;        ///< Identifies the problem
+
     Shift_t shiftVec_;       ///< (A - sB)X given AX
     Shift_t preCondWShift_;  ///< Shifted preconditioner
 
+    bool   mixedPrec_ = false; ///< Subspace vectors stored in LowP_t
+    double lowPConv_  = 1e-4;  ///< Convergence of the single precision phase
+
     inline void defaultShiftVec_(size_t nVec, _F shift, _F *V, _F *AV) {
 
       blas::axpy(nVec*N_,shift,V,1,AV,1);
@@ -77,6 +92,10 @@ namespace ChronusQ {
 
   public:
 
+    /// Single precision counterpart of _F
+    typedef typename std::conditional< std::is_same<_F,double>::value,
+      float, std::complex<float> >::type LowP_t;
+
     // Constructor (unshifted preconditioner)
     IterSolver(
       MPI_Comm c, 
@@ -131,6 +150,82 @@ namespace ChronusQ {
     }
 
 
+    // Distributed vectors (see itersolver/distributed.hpp)
+    //
+    // In distributed mode every process holds a contiguous block of
+    // rows of all N-dimensional vectors (trial vectors, AX products,
+    // residuals) and the linear transformation and preconditioner act
+    // on these local rows. Inner products are all-reduced, the small
+    // subspace matrices are replicated on every process.
+    //
+    // Only Davidson implements the mode; GPLHR and the linear solvers
+    // (GMRES, shifted GMRES) raise an error when it is requested. It is
+    // used by the CASCI Davidson (CISolver), the response solvers keep
+    // the vectors on the root process.
+
+    void setDistributed(bool dist);
+
+    bool   distributed() const { return distVec_; }
+    size_t nLocal()      const { return distVec_ ? NLoc_ : N_; }
+    size_t rowOffset()   const { return distVec_ ? rowOff_ : 0; }
+
+    template <typename _FA, typename _FB>
+    void   distInnerProd(size_t m, size_t n, const _FA *A, size_t LDA,
+      const _FB *B, size_t LDB, _F *C);
+    double distNorm(const _F *V);
+
+    // Blocked orthonormalization of nNew (local) vectors against nOld
+    size_t orthonormalize(size_t nOld, size_t nNew, _F *V, size_t LDV);
+    template <typename _FB>
+    size_t orthonormalize(size_t nOld, const _FB *VOld, size_t LDVO,
+      size_t nNew, _F *V, size_t LDV);
+
+    void gatherVectors(size_t nVec, const _F *VLoc, _F *V, bool allProcs = false);
+    void scatterVectors(size_t nVec, const _F *V, _F *VLoc);
+    void reduceScatterVectors(size_t nVec, const _F *V, _F *VLoc);
+
+
+    // Mixed precision (see itersolver/mixedprec.hpp)
+    //
+    // The subspace vectors (trial and sigma vectors, Krylov bases,
+    // Householder vectors) are stored in single precision and their
+    // products are formed by the BLAS of _F on converted row blocks.
+    // The eigensolvers converge to lowPConv_ with the single precision
+    // subspace and are then refined in FP64 from its eigenvectors, the
+    // linear solvers refine their solutions by FP64 residuals.
+
+    void setMixedPrecision(bool mixed, double lowPConv = 1e-4);
+    bool mixedPrecision() const { return mixedPrec_; }
+
+
+    // Checkpointing (see itersolver/checkpoint.hpp)
+    //
+    // The solver state is written to the group chkPrefix_ of the binary
+    // file every chkInterval_ iterations and upon exit (root process
+    // only). A state which was written for the same key (the problem
+    // dimension and the key passed by the caller) resumes the solver
+    // without repeating linear transformations, a state of another key
+    // of the same dimension (e.g. a nearby geometry) is only used as the
+    // initial guess.
+
+    void setCheckpoint(SafeFile &file, const std::string &prefix,
+      size_t interval, bool resume, const std::vector<double> &key = {});
+
+    bool chkWrite() const { return chkFile_ and chkInterval_; }
+    bool chkDue(size_t iter) const {
+      return chkWrite() and (iter + 1) % chkInterval_ == 0;
+    }
+
+    template <typename T>
+    void chkSave(const std::string &name, const T *data,
+      const std::vector<hsize_t> &dims);
+    template <typename T>
+    bool chkLoad(const std::string &name, T *data,
+      const std::vector<hsize_t> &dims);
+
+    void chkInvalidate();
+    void chkValidate();
+    bool chkKeyMatch();
 
   };
 
@@ -154,6 +249,8 @@ namespace ChronusQ {
     std::vector<double>              rhsNorm_;
     std::vector<std::vector<double>> resNorm_;
 
+    size_t iBatch_ = 0; ///< Current (RHS, shift) batch
+
   public:
 
 
@@ -163,6 +260,8 @@ namespace ChronusQ {
     size_t shiftBS = 1;
     size_t rhsBS   = 1;
 
+    size_t maxRefine = 3; ///< Max FP64 refinements per system (mixed precision)
+
     IterLinearSolver(
       MPI_Comm c, 
       CQMemManager &mem, 
@@ -223,6 +322,9 @@ namespace ChronusQ {
 
     virtual void alloc() {
 
+      if( this->distVec_ )
+        CErr("Distributed vectors are not implemented for the linear solvers");
+
       // NO MPI
       ROOT_ONLY(this->comm_);
 
@@ -243,6 +345,9 @@ namespace ChronusQ {
     virtual void runBatch(size_t nRHS, size_t nShift, _F* RHS, _F *shifts, 
       _F* SOL, double *RHSNorm);
 
+    virtual void refineBatch(size_t nRHS, size_t nShift, _F* RHS, 
+      _F *shifts, _F* SOL, double *RHSNorm);
+
   };
 
 
@@ -268,6 +373,11 @@ namespace ChronusQ {
 
     void RayleighRitz();
 
+    void   saveSubspace(size_t nVec, const _F *X, const _F *AX,
+      const dcomplex *eig, const std::vector<bool> &conv);
+    size_t loadSubspace(size_t nMin, size_t nMax, _F *X, _F *AX, 
+      bool &hasAX);
+
 
 
   public:
@@ -329,7 +439,8 @@ namespace ChronusQ {
       // NO MPI
       ROOT_ONLY(this->comm_);
 
-      size_t NNR = this->N_ * this->mSS_;
+      // Distributed solvers only gather the converged roots
+      size_t NNR = this->N_ * (this->distVec_ ? this->nRoots_ : this->mSS_);
 
       eigVal_ = this->memManager_.template malloc<dcomplex>(this->nRoots_);
       VR_     = this->memManager_.template malloc<_F>(NNR);
@@ -351,6 +462,9 @@ namespace ChronusQ {
     virtual bool runMicro() = 0;
     virtual void restart() = 0;
 
+    /// Restart for the FP64 refinement of the single precision solution
+    virtual void startRefinement() { restart(); }
+
   };
 
 
@@ -385,27 +499,32 @@ namespace ChronusQ {
 
 
 
-    void halfProj(size_t N, size_t nV, size_t nS, _F *V, size_t LDV, _F *S, 
+    // The projectors V (and AV) may be stored in single precision
+    template <typename _FV>
+    void halfProj(size_t N, size_t nV, size_t nS, _FV *V, size_t LDV, _F *S, 
         size_t LDS, _F *smSCR, size_t LDSCR);
 
     /**
      *  \brief Overload of halfProj where nV == nS
      */
-    inline void halfProj(size_t N, size_t nV, _F *V, size_t LDV, _F *S, 
+    template <typename _FV>
+    inline void halfProj(size_t N, size_t nV, _FV *V, size_t LDV, _F *S, 
         size_t LDS, _F *smSCR, size_t LDSCR) {
 
       halfProj(N,nV,nV,V,LDV,S,LDS,smSCR,LDSCR);
 
     }
 
-    void halfProj2(size_t N, size_t nV, size_t nS, _F *V, size_t LDV, _F *AV, 
-        size_t LDAV, _F *S, size_t LDS, _F *AS, size_t LDAS, _F *smSCR, 
-        size_t LDSCR);
+    template <typename _FV>
+    void halfProj2(size_t N, size_t nV, size_t nS, _FV *V, size_t LDV, 
+        _FV *AV, size_t LDAV, _F *S, size_t LDS, _F *AS, size_t LDAS, 
+        _F *smSCR, size_t LDSCR);
 
     /**
      *  \brief Overload of halfProj2 where nV == nS
      */
-    inline void halfProj2(size_t N, size_t nV, _F *V, size_t LDV, _F *AV, 
+    template <typename _FV>
+    inline void halfProj2(size_t N, size_t nV, _FV *V, size_t LDV, _FV *AV, 
         size_t LDAV, _F *S, size_t LDS, _F *AS, size_t LDAS, _F *smSCR, 
         size_t LDSCR) {
 
@@ -414,8 +533,14 @@ namespace ChronusQ {
     }
 
 
-    void newSMatrix(size_t N, size_t nR, _F *V, size_t LDV, _F *Q, size_t LDQ,
-        _F *S, size_t LDS, _F *smSCR, size_t LDSCR);
+    template <typename _FV>
+    void newSMatrix(size_t N, size_t nR, _FV *V, size_t LDV, _FV *Q, 
+        size_t LDQ, _F *S, size_t LDS, _F *smSCR, size_t LDSCR);
+
+    // Iterations with the subspace [V W S P], its products and Q stored
+    // as _FB
+    template <typename _FB>
+    bool runMicro_();
 
 
   public:
@@ -427,6 +552,7 @@ namespace ChronusQ {
 
     using LinearTrans_t = typename IterDiagonalizer<_F>::LinearTrans_t;
     using Shift_t       = typename IterDiagonalizer<_F>::Shift_t;
+    using LowP_t        = typename IterDiagonalizer<_F>::LowP_t;
 
     GPLHR(
       MPI_Comm c, 
@@ -470,6 +596,8 @@ namespace ChronusQ {
 
     void alloc() {
 
+      if( this->distVec_ ) CErr("Distributed vectors are not implemented for GPLHR");
+
       IterDiagonalizer<_F>::alloc();
 
       // NO MPI
@@ -482,10 +610,14 @@ namespace ChronusQ {
 
     }
 
-    bool runMicro();
+    bool runMicro() {
+      return this->mixedPrec_ ? runMicro_<LowP_t>() : runMicro_<_F>();
+    }
 
     void restart();
 
+    void startRefinement();
+
     void setGuess(size_t nGuess, std::function<void(size_t,_F*,size_t)> func) {
 
       if( nGuess != this->nRoots_ ) 
@@ -528,6 +660,17 @@ namespace ChronusQ {
     _F dcomplexTo_F(dcomplex &a) { return * reinterpret_cast<_F*>(&a);}
 
   protected:
+
+    size_t nThickRestarts_ = 0; ///< Number of thick restarts so far
+
+    template <typename _FB>
+    size_t thickRestart_(size_t nV, size_t nVPrev, size_t nExam, size_t nDo,
+      const std::vector<int> &prevCols, _FB *VR, _FB *AVR, _F *XR, 
+      _F *XRPrev);
+
+    // Iterations with the subspace VR and its products AVR stored as _FB
+    template <typename _FB>
+    bool runMicro_();
     
   public:
 
@@ -535,8 +678,20 @@ namespace ChronusQ {
     size_t whenSc = 2;
     size_t kG = 3;
 
+    // Thick restart: once the subspace is full it is collapsed onto
+    // kThick Ritz vectors per root plus the previous Ritz vectors of
+    // the unconverged roots instead of restarting the macro iteration
+    bool   doThickRestart = true;
+    size_t kThick = 1;
+
+    // Soft locking: a converged root stays converged (no new vectors)
+    // as long as its Ritz value is stable and its residual norm stays
+    // below the convergence criterion
+    bool   lockRoots = true;
+
     using LinearTrans_t = typename IterDiagonalizer<_F>::LinearTrans_t;
     using Shift_t       = typename IterDiagonalizer<_F>::Shift_t;
+    using LowP_t        = typename IterDiagonalizer<_F>::LowP_t;
 
     Davidson(
       MPI_Comm c, 
@@ -570,6 +725,15 @@ namespace ChronusQ {
     }
 
     void setWhenSc(size_t _WhenSc) { whenSc = _WhenSc;}
+
+    void setThickRestart(bool _thick, size_t _kThick = 1) {
+      doThickRestart = _thick;
+      kThick = std::max(_kThick, size_t(1));
+    }
+
+    void setLockRoots(bool _lock) { lockRoots = _lock; }
+
+    size_t nThickRestarts() const { return nThickRestarts_; }
     
     void setEigForT(dcomplex * _Eig) {
       
@@ -584,15 +748,19 @@ namespace ChronusQ {
       IterDiagonalizer<_F>::alloc();
 
       // NO MPI
-      ROOT_ONLY(this->comm_);
+      if( not this->distVec_ ) ROOT_ONLY(this->comm_);
 
       // Allocate Davidson specific Memory
       this->RelRes  = this->memManager_.template malloc<double>(this->nGuess_);
     }
 
-    bool runMicro();
+    bool runMicro() {
+      return this->mixedPrec_ ? runMicro_<LowP_t>() : runMicro_<_F>();
+    }
 
     void restart();
+
+    void startRefinement();
     
     void useEnergySpecific(size_t nHER, double energyThd, double ERef) {
       assert (this->nRoots_ >= nHER);
@@ -629,16 +797,122 @@ namespace ChronusQ {
   }; // Davidson 
 
 
+
+
+  /**
+   *  \brief Chebyshev filtered subspace iteration for the eigenpairs of A
+   *  in the energy window [eMin, eMax].
+   *
+   *  Every iteration applies a Chebyshev polynomial (with Jackson
+   *  damping) which approximates the indicator function of the window
+   *  on [-rho, rho] to a block of nR vectors, followed by a Rayleigh-Ritz
+   *  projection. The eigenvalues outside of the window are damped by the
+   *  filter rather than resolved, so that interior (e.g. core
+   *  excitation) eigenvalues converge without the roots below them.
+   *
+   *  The spectrum of A is assumed real (as for the response problems)
+   *  and rho is estimated by power iteration if not given. The block
+   *  size nR has to exceed the number of eigenvalues in the window, the
+   *  eigenpairs found in the window are stored in the first nFound()
+   *  columns of VR / eigVal.
+   */
+  template <typename _F>
+  class ChebyshevFilter : public IterDiagonalizer<_F> {
+
+    _F *Guess = nullptr;
+    size_t nFound_ = 0;
+    bool converged_ = false;
+
+    void estimateBounds(_F *V);
+
+  public:
+
+    double eMin   = 0.; ///< Lower bound of the energy window
+    double eMax   = 0.; ///< Upper bound of the energy window
+    double rho    = 0.; ///< Bound of |eig(A)| (0: power iteration estimate)
+    size_t degree = 0;  ///< Filter degree (0: from rho and the window width)
+
+    using LinearTrans_t = typename IterDiagonalizer<_F>::LinearTrans_t;
+    using Shift_t       = typename IterDiagonalizer<_F>::Shift_t;
+
+    ChebyshevFilter(
+      MPI_Comm c, 
+      CQMemManager &mem, 
+      const size_t N,
+      const size_t MAXITER,
+      double conv, 
+      size_t nR, 
+      const LinearTrans_t &linearTrans, 
+      const Shift_t &preShift = Shift_t(), 
+      const Shift_t &shiftVec = Shift_t()) :
+      IterDiagonalizer<_F>(c,mem,N,nR,1,MAXITER,conv,nR,nR,
+          linearTrans,preShift,shiftVec){ } 
+
+    ~ChebyshevFilter() { 
+    
+      if( Guess ) this->memManager_.free(Guess);
+
+    }
+
+    void setWindow(double _eMin, double _eMax) {
+
+      if( _eMax <= _eMin ) CErr("Empty energy window in ChebyshevFilter");
+
+      eMin = _eMin;
+      eMax = _eMax;
+
+    }
+
+    size_t nFound() const { return nFound_; }
+    bool   isConverged() const { return converged_; }
+
+    void alloc() {
+
+      if( this->distVec_ ) 
+        CErr("Distributed vectors are not implemented for ChebyshevFilter");
+      if( this->mixedPrec_ )
+        CErr("Mixed precision is not implemented for ChebyshevFilter");
+
+      IterDiagonalizer<_F>::alloc();
+
+    }
+
+    bool runMicro();
+
+    void restart() { };
+
+    void setGuess(size_t nGuess, std::function<void(size_t,_F*,size_t)> func) {
+
+      if( nGuess != this->nRoots_ ) 
+        CErr("ChebyshevFilter Requires nGuess = nRoots",std::cout);
+
+      // NO MPI
+      ROOT_ONLY(this->comm_);
+
+      Guess = this->memManager_.template malloc<_F>(nGuess * this->N_);
+
+      func(nGuess, Guess, this->N_);
+
+    }
+
+  }; // ChebyshevFilter
+
+
   template <typename _F>
   class GMRES : public IterLinearSolver<_F> {
 
 
+    using LowP_t = typename IterLinearSolver<_F>::LowP_t;
+
     _F * HHR_ = nullptr;
     _F * U_   = nullptr;
     _F * W_   = nullptr;
     _F * J_   = nullptr;
     _F * R_   = nullptr;
 
+    LowP_t * UL_   = nullptr; ///< Single precision Householder vectors
+    _F     * UCol_ = nullptr; ///< One of UL_ in the precision of _F
+
   public:
 
     using LinearTrans_t = typename IterLinearSolver<_F>::LinearTrans_t;
@@ -674,6 +948,8 @@ namespace ChronusQ {
 
       if(HHR_)  this->memManager_.free(HHR_);
       if(U_  )  this->memManager_.free(U_);
+      if(UL_ )  this->memManager_.free(UL_);
+      if(UCol_) this->memManager_.free(UCol_);
       if(W_  )  this->memManager_.free(W_);
       if(J_  )  this->memManager_.free(J_);
       if(R_  )  this->memManager_.free(R_);
@@ -694,7 +970,11 @@ namespace ChronusQ {
       HHR_ = this->memManager_.template malloc<_F>(nBatch * this->N_);
 
       J_   = this->memManager_.template malloc<_F>(2 * MSSnBatch);
-      U_   = this->memManager_.template malloc<_F>(MSSnBatch * this->N_);
+      if( this->mixedPrec_ ) {
+        UL_   = this->memManager_.template malloc<LowP_t>(MSSnBatch * this->N_);
+        UCol_ = this->memManager_.template malloc<_F>(this->N_);
+      } else
+        U_    = this->memManager_.template malloc<_F>(MSSnBatch * this->N_);
       R_   = this->memManager_.template malloc<_F>(MSSnBatch * this->mSS_);
       W_   = this->memManager_.template malloc<_F>(MSSnBatch + nBatch);
 
@@ -705,6 +985,141 @@ namespace ChronusQ {
 
   };
 
+
+
+  /**
+   *  \brief Restarted shifted GMRES (Frommer and Glaessner) for the
+   *  family of linear systems (A - s I) X = B.
+   *
+   *  One Krylov subspace of A is built per RHS and shared by all shifts
+   *  of the batch, so that every iteration costs one linear
+   *  transformation per RHS independent of the number of shifts. Each
+   *  shift carries its own Givens QR of the shifted Hessenberg matrix
+   *  and is converged individually. At a restart the seed shift (the
+   *  worst unconverged one) takes its GMRES update and the other shifts
+   *  the update which keeps their residuals collinear to that of the
+   *  seed, so that the restarted subspace is shared as well. Shifts
+   *  whose residual such a restart would increase are detached and
+   *  finished individually on their residual systems.
+   *
+   *  A shift dependent preconditioner would destroy the shift
+   *  invariance of the Krylov subspace, the preconditioner is not used.
+   *
+   *  In mixed precision the Krylov bases are stored in single
+   *  precision (half of the subspace memory and traffic), products with
+   *  them are accumulated in the precision of _F. The solutions are
+   *  verified by FP64 residuals and refined (iterative refinement) if
+   *  they did not converge in full precision, as part of the solves of
+   *  the detached shifts (refineBatch is not used).
+   */
+  template <typename _F>
+  class ShiftedGMRES : public IterLinearSolver<_F> {
+
+    using LowP_t = typename IterLinearSolver<_F>::LowP_t;
+
+    _F * H_ = nullptr; ///< Hessenberg matrices (one per RHS)
+    _F * J_ = nullptr; ///< Givens rotations (one set per RHS and shift)
+    _F * G_ = nullptr; ///< Rotated residual vectors (per RHS and shift)
+
+    LowP_t * VL_ = nullptr; ///< Single precision Krylov bases
+
+    bool refining_ = false; ///< Inside of an FP64 residual refinement
+
+    /// Arnoldi steps left of the maxMacroIter_ * mSS_ budget, shared by
+    /// the restart cycles and the solves of the detached shifts
+    size_t iterLeft_ = 0;
+
+    size_t nIterTotal_ = 0; ///< Arnoldi steps so far, all batches
+    size_t nDetached_  = 0; ///< Shifts solved individually so far
+
+  public:
+
+    size_t maxIter        = 0;     ///< Total Arnoldi steps (0: maxMacroIter_ * mSS_)
+
+    /// Collinear restarts of the non-seed shifts, otherwise every shift
+    /// but the seed is detached at the first restart
+    bool   collinearRestart = true;
+
+    size_t totalIterations() const { return nIterTotal_; }
+    size_t nDetached()       const { return nDetached_;  }
+
+    using LinearTrans_t = typename IterLinearSolver<_F>::LinearTrans_t;
+    using Shift_t       = typename IterLinearSolver<_F>::Shift_t;
+
+
+    ShiftedGMRES(
+      MPI_Comm c, 
+      CQMemManager &mem, 
+      const size_t N, 
+      const size_t MSS,
+      const size_t MAXMACRO,
+      double conv, 
+      const LinearTrans_t &linearTrans, 
+      const LinearTrans_t &preNoShift, 
+      const Shift_t &shiftVec = Shift_t()) :
+     IterLinearSolver<_F>(c,mem,N,MSS,MAXMACRO,MSS,conv,linearTrans,
+         preNoShift,shiftVec){ } 
+
+    ShiftedGMRES(
+      MPI_Comm c, 
+      CQMemManager &mem, 
+      const size_t N, 
+      const size_t MSS, 
+      const size_t MAXMACRO,
+      double conv, 
+      const LinearTrans_t &linearTrans, 
+      const Shift_t &preShift, 
+      const Shift_t &shiftVec = Shift_t()) : 
+     IterLinearSolver<_F>(c,mem,N,MSS,MAXMACRO,MSS,conv,linearTrans,
+         preShift,shiftVec){ } 
+
+
+    ~ShiftedGMRES() {
+
+      if(H_) this->memManager_.free(H_);
+      if(J_) this->memManager_.free(J_);
+      if(G_) this->memManager_.free(G_);
+      if(VL_) this->memManager_.free(VL_);
+
+    }
+
+
+    void alloc() {
+
+      if( this->distVec_ )
+        CErr("Distributed vectors are not implemented for the linear solvers");
+
+      // No MPI for ShiftedGMRES
+      ROOT_ONLY(this->comm_);
+
+      const size_t N   = this->N_;
+      const size_t MSS = this->mSS_;
+      const size_t nR  = this->rhsBS;
+      const size_t nS  = this->shiftBS;
+
+      // Only the Krylov bases are stored, not one space per shift
+      this->SOL_ = this->memManager_.template malloc<_F>(
+        this->nRHS_ * this->shifts_.size() * N);
+      if( this->mixedPrec_ )
+        VL_      = this->memManager_.template malloc<LowP_t>(N * (MSS+1) * nR);
+      else
+        this->V_ = this->memManager_.template malloc<_F>(N * (MSS+1) * nR);
+      this->AV_  = this->memManager_.template malloc<_F>(N * nR);
+      this->RES_ = this->memManager_.template malloc<_F>(N * nR);
+
+      H_ = this->memManager_.template malloc<_F>((MSS+1) * MSS * nR);
+      J_ = this->memManager_.template malloc<_F>(2 * MSS * nR * nS);
+      G_ = this->memManager_.template malloc<_F>((MSS+1) * nR * nS);
+
+    }
+
+    void runBatch(size_t nRHS, size_t nShift, _F* RHS, _F *shifts, 
+      _F* SOL, double *RHSNorm );
+
+    void refineBatch(size_t, size_t, _F*, _F*, _F*, double*) { }
+
+  };
+
   
 
 };
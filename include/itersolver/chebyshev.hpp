@@ -0,0 +1,287 @@
+/*
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *
+ *  Copyright (C) 2014-2022 Li Research Group (University of Washington)
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *
+ */
+#pragma once
+
+#include <itersolver.hpp>
+#include <util/timer.hpp>
+#include <cqlinalg/blas1.hpp>
+#include <cqlinalg/blas3.hpp>
+#include <cqlinalg/eig.hpp>
+#include <cqlinalg/ortho.hpp>
+#include <cerr.hpp>
+
+#include <random>
+
+namespace ChronusQ {
+
+  /**
+   *  \brief Estimate rho >= max |eig(A)| by power iteration on the first
+   *  vector of V (root process) if not set, and the filter degree from
+   *  rho and the width of the window if not set.
+   */
+  template <typename _F>
+  void ChebyshevFilter<_F>::estimateBounds(_F *V) {
+
+    bool isRoot = MPIRank(this->comm_) == 0;
+    const size_t N = this->N_;
+
+    if( rho <= 0. ) {
+
+      const size_t nPower = 30;
+
+      _F *X  = isRoot ? this->memManager_.template malloc<_F>(N) : nullptr;
+      _F *AX = isRoot ? this->memManager_.template malloc<_F>(N) : nullptr;
+
+      if( isRoot ) {
+        std::copy_n(V,N,X);
+        blas::scal(N,_F(1./blas::nrm2(N,X,1)),X,1);
+      }
+
+      double lambda = 0.;
+      for(auto k = 0ul; k < nPower; k++) {
+
+        this->linearTrans_(1,X,AX);
+
+        if( isRoot ) {
+          lambda = blas::nrm2(N,AX,1);
+          if( lambda == 0. ) break;
+          std::copy_n(AX,N,X);
+          blas::scal(N,_F(1./lambda),X,1);
+        }
+
+      }
+
+      // Power iteration underestimates |eig| (at most the dominant
+      // eigenvalue), a polynomial filter grows rapidly outside of
+      // [-rho, rho]: use a generous safety margin
+      rho = std::max(1.25 * lambda, 1.05 * std::max(std::abs(eMin),
+        std::abs(eMax)));
+
+      if( X  ) this->memManager_.free(X);
+      if( AX ) this->memManager_.free(AX);
+
+    }
+
+    if( degree == 0 ) {
+
+      size_t d = std::ceil(2. * M_PI * rho / (eMax - eMin));
+      degree = std::min(std::max(d,size_t(10)),size_t(400));
+
+    }
+
+    if( MPISize(this->comm_) > 1 ) {
+      MPIBCast(rho,0,this->comm_);
+      MPIBCast(degree,0,this->comm_);
+    }
+
+  }; // ChebyshevFilter::estimateBounds
+
+
+  template <typename _F>
+  bool ChebyshevFilter<_F>::runMicro() {
+
+    bool isRoot = MPIRank(this->comm_) == 0;
+
+    const size_t N  = this->N_;
+    const size_t nR = this->nRoots_;
+
+    _F *V  = nullptr, *AV = nullptr, *T0 = nullptr, *T1 = nullptr,
+       *T2 = nullptr, *SUB = nullptr, *XR = nullptr;
+    dcomplex *Eig = nullptr;
+
+    if( isRoot ) {
+
+      V   = this->memManager_.template malloc<_F>(N * nR);
+      AV  = this->memManager_.template malloc<_F>(N * nR);
+      T0  = this->memManager_.template malloc<_F>(N * nR);
+      T1  = this->memManager_.template malloc<_F>(N * nR);
+      T2  = this->memManager_.template malloc<_F>(N * nR);
+      SUB = this->memManager_.template malloc<_F>(nR * nR);
+      XR  = this->memManager_.template malloc<_F>(nR * nR);
+      Eig = this->memManager_.template malloc<dcomplex>(nR);
+
+      // Initial block: guess or (reproducible) random vectors
+      if( Guess ) std::copy_n(Guess,N * nR,V);
+      else {
+        std::mt19937 gen(1234);
+        std::uniform_real_distribution<double> dist(-1.,1.);
+        for(auto i = 0ul; i < N * nR; i++) V[i] = dist(gen);
+      }
+
+    }
+
+    estimateBounds(V);
+
+    // Chebyshev-Jackson coefficients of the window indicator on [-1,1]
+    const double aW = std::acos(std::max(-1.,std::min(1.,eMin / rho)));
+    const double bW = std::acos(std::max(-1.,std::min(1.,eMax / rho)));
+    const double piD = M_PI / (degree + 2);
+
+    std::vector<double> coef(degree + 1);
+    for(auto k = 0ul; k <= degree; k++) {
+
+      double jackson = ( (1. - double(k)/(degree + 2)) * std::cos(k * piD) +
+        std::sin(k * piD) / std::tan(piD) / (degree + 2) );
+
+      coef[k] = jackson * ( (k == 0) ? (aW - bW) / M_PI :
+        2. * (std::sin(k * aW) - std::sin(k * bW)) / (k * M_PI) );
+
+    }
+
+    if( isRoot ) {
+      std::cout << "\n  * Chebyshev Filtered Subspace Iteration\n\n";
+      std::cout << std::scientific << std::setprecision(6);
+      std::cout << "    * Energy Window    = [" << eMin << ", " << eMax
+                << "]\n";
+      std::cout << "    * Spectral Bound   = " << rho << "\n";
+      std::cout << "    * Filter Degree    = " << degree << "\n";
+      std::cout << "    * Block Size       = " << nR << "\n\n";
+    }
+
+    bool isConverged = false;
+    size_t nY = nR, nFoundPrev = 0;
+    std::vector<size_t> inWin;
+
+    for(auto iter = 0ul; iter < this->maxMicroIter_; iter++) {
+
+      ProgramTimer::tick("Chebyshev Iter");
+      auto topIter = tick();
+
+      // Filter: V <- p(A / rho) V by the three term recurrence
+      if( isRoot ) {
+        std::copy_n(V,N * nY,T0);
+        blas::scal(N * nY,_F(coef[0]),V,1);
+      }
+
+      for(auto k = 1ul; k <= degree; k++) {
+
+        _F *TK = (k == 1) ? T0 : T1;
+        this->linearTrans_(nY,TK,T2);
+
+        if( isRoot ) {
+
+          if( k == 1 ) blas::scal(N * nY,_F(1./rho),T2,1);
+          else {
+            blas::scal(N * nY,_F(2./rho),T2,1);
+            blas::axpy(N * nY,_F(-1.),T0,1,T2,1);
+            std::swap(T0,T1);
+          }
+
+          // T0 = T(k-1), T1 = T(k)
+          std::swap(T1,T2);
+          blas::axpy(N * nY,_F(coef[k]),T1,1,V,1);
+
+        }
+
+      }
+
+      // Rayleigh-Ritz in the orthonormalized filtered block
+      if( isRoot ) nY = BlockGramSchmidt(N,0,nY,V,N,this->memManager_,1);
+      if( MPISize(this->comm_) > 1 ) MPIBCast(nY,0,this->comm_);
+
+      this->linearTrans_(nY,V,AV);
+
+      double maxRes = 0.;
+      if( isRoot ) {
+
+        blas::gemm(blas::Layout::ColMajor,blas::Op::ConjTrans,
+          blas::Op::NoTrans,nY,nY,N,_F(1.),V,N,AV,N,_F(0.),SUB,nY);
+
+        GeneralEigenSymm('N','V',nY,SUB,nY,Eig,XR,nY,XR,nY);
+
+        // Ritz vectors and their products
+        blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,
+          blas::Op::NoTrans,N,nY,nY,_F(1.),V,N,XR,nY,_F(0.),T0,N);
+        blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,
+          blas::Op::NoTrans,N,nY,nY,_F(1.),AV,N,XR,nY,_F(0.),T1,N);
+
+        std::copy_n(T0,N * nY,V);
+
+        // Residuals of the Ritz pairs in the window
+        inWin.clear();
+        for(auto i = 0ul; i < nY; i++) {
+
+          double w = std::real(Eig[i]);
+          if( w < eMin or w > eMax ) continue;
+
+          inWin.emplace_back(i);
+
+          _F *R = T1 + i*N;
+          blas::axpy(N,_F(-w),V + i*N,1,R,1);
+          maxRes = std::max(maxRes,
+            blas::nrm2(N,R,1) / std::max(1.,std::abs(w)));
+
+        }
+
+        nFound_ = inWin.size();
+
+        // A block which is filled by the window cannot separate it
+        if( nFound_ == nY )
+          std::cout << "    * WARNING: All Ritz values in the window, "
+                    << "increase the block size\n";
+
+        isConverged = nFound_ > 0 and nFound_ < nY and
+          nFound_ == nFoundPrev and maxRes < this->convCrit_;
+        nFoundPrev = nFound_;
+
+        std::cout << "      ChebyshevIter " << std::setw(5) << iter + 1
+                  << "  :  NFOUND = " << std::setw(5) << nFound_
+                  << "  MaxRelResNorm = " << std::scientific
+                  << std::setprecision(8) << maxRes
+                  << "  DURATION = " << tock(topIter) << " s\n";
+
+      }
+
+      ProgramTimer::tock("Chebyshev Iter");
+
+      if( MPISize(this->comm_) > 1 ) MPIBCast(isConverged,0,this->comm_);
+      if( isConverged ) break;
+
+    }
+
+    if( isRoot ) {
+
+      std::cout << "\n    * Chebyshev Filter ";
+      if( isConverged ) std::cout << "Converged ";
+      else              std::cout << "Failed to Converge ";
+      std::cout << "with " << nFound_ << " Roots in the Window\n\n";
+
+      // Ritz pairs of the window in ascending order
+      for(auto k = 0ul; k < nFound_; k++) {
+        this->eigVal_[k] = std::real(Eig[inWin[k]]);
+        std::copy_n(V + inWin[k]*N,N,this->VR_ + k*N);
+      }
+
+      this->memManager_.free(V,AV,T0,T1,T2,SUB,XR,Eig);
+
+    }
+
+    if( MPISize(this->comm_) > 1 ) MPIBCast(nFound_,0,this->comm_);
+
+    converged_ = isConverged;
+    return isConverged;
+
+  }; // ChebyshevFilter::runMicro
+
+}; // namespace ChronusQ
@@ -0,0 +1,248 @@
+/*
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *
+ *  Copyright (C) 2014-2022 Li Research Group (University of Washington)
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *
+ */
+#pragma once
+
+#include <itersolver.hpp>
+
+namespace ChronusQ {
+
+  /**
+   *  \brief Write the solver state to the group prefix of file every
+   *  interval iterations (0 disables it) and read the state of a previous
+   *  run if resume is set.
+   */
+  template <typename _F>
+  void IterSolver<_F>::setCheckpoint(SafeFile &file,
+    const std::string &prefix, size_t interval, bool resume,
+    const std::vector<double> &key) {
+
+    chkFile_     = &file;
+    chkPrefix_   = prefix;
+    chkInterval_ = interval;
+    chkRead_     = resume;
+
+    chkKey_ = { double(N_), double(std::is_same<_F,dcomplex>::value) };
+    chkKey_.insert(chkKey_.end(), key.begin(), key.end());
+
+  }; // IterSolver::setCheckpoint
+
+
+  /**
+   *  \brief Write a dataset of the checkpoint (root process only). A
+   *  dataset of other dimensions is replaced.
+   */
+  template <typename _F>
+  template <typename T>
+  void IterSolver<_F>::chkSave(const std::string &name, const T *data,
+    const std::vector<hsize_t> &dims) {
+
+    std::string dataSet = chkPrefix_ + "/" + name;
+
+    auto savDims = chkFile_->getDims(dataSet);
+    if( not savDims.empty() and savDims != dims )
+      chkFile_->unlinkData(dataSet);
+
+    chkFile_->safeWriteData(dataSet, const_cast<T*>(data), dims);
+
+  }; // IterSolver::chkSave
+
+
+  /**
+   *  \brief Read a dataset of the checkpoint (root process only).
+   *
+   *  \returns false if the dataset does not exist or has other dimensions
+   *  or another field type
+   */
+  template <typename _F>
+  template <typename T>
+  bool IterSolver<_F>::chkLoad(const std::string &name, T *data,
+    const std::vector<hsize_t> &dims) {
+
+    std::string dataSet = chkPrefix_ + "/" + name;
+
+    if( chkFile_->getDims(dataSet) != dims ) return false;
+
+    // Complex data are stored as a compound type
+    if( (chkFile_->getTypeClass(dataSet) == H5T_COMPOUND) != 
+        std::is_same<T,dcomplex>::value ) return false;
+
+    chkFile_->readData(dataSet, data);
+    return true;
+
+  }; // IterSolver::chkLoad
+
+
+  /**
+   *  \brief Remove the key of the checkpoint before its datasets are
+   *  overwritten, a state which is interrupted while it is written is not
+   *  resumed.
+   */
+  template <typename _F>
+  void IterSolver<_F>::chkInvalidate() {
+
+    std::string dataSet = chkPrefix_ + "/KEY";
+    if( not chkFile_->getDims(dataSet).empty() )
+      chkFile_->unlinkData(dataSet);
+
+  }; // IterSolver::chkInvalidate
+
+
+  /**
+   *  \brief Write the key of the checkpoint once all of its datasets are
+   *  written
+   */
+  template <typename _F>
+  void IterSolver<_F>::chkValidate() {
+
+    chkSave("KEY", chkKey_.data(), {chkKey_.size()});
+
+  }; // IterSolver::chkValidate
+
+
+  /**
+   *  \brief Whether the checkpoint was written for the same problem
+   */
+  template <typename _F>
+  bool IterSolver<_F>::chkKeyMatch() {
+
+    std::vector<double> savKey(chkKey_.size());
+    if( not chkLoad("KEY", savKey.data(), {savKey.size()}) ) return false;
+
+    for(auto k = 0ul; k < chkKey_.size(); k++)
+      if( std::abs(savKey[k] - chkKey_[k]) >
+          1e-10 * std::max(1.,std::abs(chkKey_[k])) ) return false;
+
+    return true;
+
+  }; // IterSolver::chkKeyMatch
+
+
+
+
+  /**
+   *  \brief Write the state of an eigensolver: nVec (approximate)
+   *  eigenvectors X, their products AX, eigenvalues and convergence
+   *  flags. X and AX are the local rows for distributed vectors, all
+   *  processes have to take part then.
+   */
+  template <typename _F>
+  void IterDiagonalizer<_F>::saveSubspace(size_t nVec, const _F *X,
+    const _F *AX, const dcomplex *eig, const std::vector<bool> &conv) {
+
+    bool isRoot = MPIRank(this->comm_) == 0;
+    const size_t N = this->N_;
+
+    _F *XF = const_cast<_F*>(X), *AXF = const_cast<_F*>(AX);
+    if( this->distVec_ ) {
+      XF  = isRoot ? this->memManager_.template malloc<_F>(N * nVec) : nullptr;
+      AXF = isRoot ? this->memManager_.template malloc<_F>(N * nVec) : nullptr;
+      this->gatherVectors(nVec, X, XF);
+      this->gatherVectors(nVec, AX, AXF);
+    }
+
+    if( isRoot ) {
+
+      std::vector<double> flags(conv.begin(), conv.begin() + nVec);
+
+      this->chkInvalidate();
+      this->chkSave("VECTORS", XF, {nVec, N});
+      this->chkSave("SIGMA", AXF, {nVec, N});
+      this->chkSave("EIGENVALUES", eig, {nVec});
+      this->chkSave("CONVERGED", flags.data(), {nVec});
+      this->chkValidate();
+
+      std::cout << "\n  * Saved " << nVec << " Vectors to "
+                << this->chkPrefix_ << std::endl;
+
+    }
+
+    if( this->distVec_ and isRoot ) this->memManager_.free(XF, AXF);
+
+  }; // IterDiagonalizer::saveSubspace
+
+
+  /**
+   *  \brief Read the state of a previous run into X (and AX), at most
+   *  nMax and at least nMin vectors. All processes have to take part.
+   *
+   *  \returns the number of vectors read (0 if none), hasAX is set if
+   *  the state belongs to the same problem, i.e. AX is valid as well.
+   *  Otherwise the vectors are only a guess.
+   */
+  template <typename _F>
+  size_t IterDiagonalizer<_F>::loadSubspace(size_t nMin, size_t nMax,
+    _F *X, _F *AX, bool &hasAX) {
+
+    bool isRoot = MPIRank(this->comm_) == 0;
+    const size_t N = this->N_;
+
+    size_t nVec = 0;
+    hasAX = false;
+
+    if( not (this->chkFile_ and this->chkRead_) ) return 0;
+    this->chkRead_ = false; // Only for the first (macro) iteration
+
+    _F *XF = X, *AXF = AX;
+    if( isRoot ) {
+
+      auto dims = this->chkFile_->getDims(this->chkPrefix_ + "/VECTORS");
+      if( dims.size() == 2 and dims[1] == N and dims[0] >= nMin and
+          dims[0] <= nMax )
+        nVec = dims[0];
+
+      if( nVec and this->distVec_ ) {
+        XF  = this->memManager_.template malloc<_F>(N * nVec);
+        AXF = this->memManager_.template malloc<_F>(N * nVec);
+      }
+
+      if( nVec and not this->chkLoad("VECTORS", XF, {nVec, N}) ) {
+        if( this->distVec_ ) this->memManager_.free(XF, AXF);
+        nVec = 0;
+      }
+
+      if( nVec )
+        hasAX = this->chkKeyMatch() and this->chkLoad("SIGMA", AXF, {nVec, N});
+
+      if( nVec )
+        std::cout << "\n  * " << (hasAX ? "Resuming from " : "Seeding with ")
+                  << nVec << " Vectors of " << this->chkPrefix_ << std::endl;
+
+    }
+
+    if( MPISize(this->comm_) > 1 ) {
+      MPIBCast(nVec,0,this->comm_);
+      MPIBCast(hasAX,0,this->comm_);
+    }
+
+    if( nVec and this->distVec_ ) {
+      this->scatterVectors(nVec, XF, X);
+      if( hasAX ) this->scatterVectors(nVec, AXF, AX);
+      if( isRoot ) this->memManager_.free(XF, AXF);
+    }
+
+    return nVec;
+
+  }; // IterDiagonalizer::loadSubspace
+
+}; // namespace ChronusQ
@@ -25,6 +25,7 @@
 #define __INCLUDED_DAVIDSON_HPP__
 
 #include <itersolver.hpp>
+#include <itersolver/mixedprec.hpp>
 #include <util/timer.hpp>
 #include <util/matout.hpp>
 #include <cqlinalg/factorization.hpp>
@@ -32,6 +33,7 @@
 #include <cqlinalg/blasext.hpp>
 #include <cqlinalg/ortho.hpp>
 #include <cqlinalg/eig.hpp>
+#include <util/print.hpp>
 #include <cerr.hpp>
 
 // #define DEBUG_DAVIDSON
@@ -40,63 +42,93 @@
 namespace ChronusQ {
 
 
+  /**
+   *  \brief Davidson iterations with the subspace VR and its products
+   *  AVR stored as _FB. For single precision storage the residues, new
+   *  vectors and linear transformations are formed in the precision of _F
+   *  and only the subspace is rounded.
+   */
   template <typename _F>
-  bool Davidson<_F>::runMicro() {
+  template <typename _FB>
+  bool Davidson<_F>::runMicro_() {
     
+    constexpr bool lowP = not std::is_same<_FB,_F>::value;
+
     bool isRoot = MPIRank(this->comm_) == 0;
     bool isConverged = false;
+
+    // With distributed vectors every process runs the subspace algebra
+    // on its own rows and holds a copy of the small subspace matrices
+    bool dist   = this->distVec_;
+    bool isWork = isRoot or dist;
+
+    // Only the root prints
+    std::ostream out(isRoot ? std::cout.rdbuf() : nullptr);
     
     if( isRoot ) {
-      std::cout  << "\n\n";
-      std::cout  << "  * Davidson Settings:\n";
-      std::cout  << "    * Right Eigenvector is Requested. \n";
+      out  << "\n\n";
+      out  << "  * Davidson Settings:\n";
+      out  << "    * Right Eigenvector is Requested. \n";
+      if( dist )
+        out << "    * Vectors are distributed over " << MPISize(this->comm_)
+            << " processes\n";
       
       if(this->DoLeftEigVec) {
-        std::cout  << "    * Left Eigenvector is Requested.\n";
+        out  << "    * Left Eigenvector is Requested.\n";
         CErr("Do Left Eig Vec is not implemented yet");
       }
       
       if (this->EnergySpecific) {          
-        std::cout<< "    * Use Energy Specific:           " << this->EnergySpecific << "\n"
+        out<< "    * Use Energy Specific:           " << this->EnergySpecific << "\n"
                  << "      * Number of Low  Energy Roots = " << this->nHighERoots    << "\n"
                  << "      * Number of High Energy Roots = " << this-> nLowERoots    << "\n";
         if(this->adaptiveERef) {
-          std::cout<< "      * Use Ground State Energy in each iteration as Reference \n";
+          out<< "      * Use Ground State Energy in each iteration as Reference \n";
         } else {
-          std::cout<< "      * Energy Referene  = " << this->EnergyRef    << "\n";
+          out<< "      * Energy Referene  = " << this->EnergyRef    << "\n";
     }
         CErr("Energy specific is not implemented yet");
       }          
-      std::cout << "\n\n" << std::endl;
+
+      if( this->doThickRestart )
+        out << "    * Thick Restart with " << this->kThick
+            << " Ritz Vector(s) per Root\n";
+      if( this->lockRoots )
+        out << "    * Converged Roots are Locked\n";
+      if( lowP )
+        out << "    * Subspace Stored in Single Precision\n";
+
+      out << "\n\n" << std::endl;
     }
     
-    std::cout << std::setprecision(10) << std::scientific;
+    out << std::setprecision(10) << std::scientific;
     
     const size_t N   = this->N_;
+    const size_t NL  = this->nLocal(); // rows held by this process
     const size_t MSS = this->mSS_;
     const size_t nR  = this->nRoots_;
     
     const size_t MSS2 = MSS * MSS;
-    const size_t NMSS = N * MSS;
-    const size_t NNR  = N * nR;
+    const size_t NMSS = NL * MSS;
     
     const size_t nG  = this->nGuess_;
-    const size_t NNG = N * nG;  
+    const size_t NNG = NL * nG;  
     
     // Initialize pointers
-    _F *VR  = nullptr,  *XR  = nullptr, *XRPrev = nullptr; 
+    _FB *VR = nullptr,  *AVR = nullptr;
+    _F  *XR = nullptr,  *XRPrev = nullptr; 
     _F *VL  = nullptr,  *XL  = nullptr; // for left search space    
-    _F *AVR = nullptr,  *Ovlp = nullptr; // overlap is using right eigenvectors  
+    _F *Ovlp = nullptr; // overlap is using right eigenvectors  
     _F *R   = nullptr,  *S  = nullptr; // Scratch space for residue and perturbed vector
     _F *SubA = nullptr;
     _F *SCR = nullptr;
 
     dcomplex *Eig = nullptr, *EPrev = nullptr;
     
-    if( isRoot ) {
+    if( isWork ) {
        
-      VR     = this->memManager_.template malloc<_F>(NMSS); 
-      AVR    = this->memManager_.template malloc<_F>(NMSS); 
+      VR     = this->memManager_.template malloc<_FB>(NMSS); 
+      AVR    = this->memManager_.template malloc<_FB>(NMSS); 
       XR     = this->memManager_.template malloc<_F>(MSS2);
       XRPrev = this->memManager_.template malloc<_F>(MSS2);
       SubA   = this->memManager_.template malloc<_F>(MSS2);
@@ -115,14 +147,27 @@ namespace ChronusQ {
     } // Root Only
 
     // generate guess
-    if( isRoot ) {
+    int hasGuess = Guess != nullptr;
+    if( dist ) MPIBCast(hasGuess,0,this->comm_);
+
+    if( isWork ) {
       // Initailize VR as Guess, if no Guess set, 
-      if( Guess ) std::copy_n(Guess,NNG,VR);
-      else {
-        std::cout << "  * use unit vector guess" << std::endl;
-        std::fill_n(VR, NNG, 0.);
-        for(auto i = 0ul; i < nG; i++) VR[i * (N+1)] = 1.0;
+      // (through R for a single precision VR)
+      _F *VG = nullptr;
+      if constexpr ( lowP ) VG = R; else VG = VR;
+
+      if( hasGuess ) {
+        if( dist ) this->scatterVectors(nG,Guess,VG);
+        else       std::copy_n(Guess,NNG,VG);
+      } else {
+        out << "  * use unit vector guess" << std::endl;
+        std::fill_n(VG, NNG, 0.);
+        const size_t rowOff = this->rowOffset();
+        for(auto i = 0ul; i < nG; i++)
+          if( i >= rowOff and i < rowOff + NL ) VG[i*NL + i - rowOff] = 1.0;
       } // right vector guess
+
+      if( lowP ) subspaceCopy(NL,nG,VG,NL,VR,NL);
       
       // left vector guess 
       if(this->DoLeftEigVec) { 
@@ -135,21 +180,53 @@ namespace ChronusQ {
     MPI_Barrier(this->comm_);
     
     if( isRoot ) {
-      std::cout << "\n\n  * Starting Davidson Iterations" << std::endl;
+      out << "\n\n  * Starting Davidson Iterations" << std::endl;
     } // Root Only
     
     // variables during iteration
     std::vector<bool> SiConv(nG); // state_i converged?
+    std::vector<bool> SiLock(nG,false); // converged at the previous iteration
     size_t iter   = 0;
     size_t nDo    = nG;
     size_t nExam  = nG;
     size_t nVPrev = 0;     // number of vectors at previous iteration 
     size_t nVCur  = nG;    // number of vectors at current iteration 
+    size_t nVRitz = 0;     // dimension of the current Ritz vectors XR
     char   JOBVL  = this->DoLeftEigVec ? 'V': 'N';
     double VecNear = 0.1;  // criterion to determine if two vector are similar by their overlap 
     double VecConv = this->convCrit_;    
     double EConv   = VecConv * 0.01;   
 
+    // Resume from the Ritz vectors (and their products) of a previous run,
+    // or use them as the guess for a related problem
+    bool   hasAX = false;
+    size_t nChk  = 0;
+    if constexpr ( lowP ) {
+      nChk = this->loadSubspace(nR, std::min(nG,MSS), R, S, hasAX);
+      if( nChk and isWork ) {
+        subspaceCopy(NL,nChk,R,NL,VR,NL);
+        if( hasAX ) subspaceCopy(NL,nChk,S,NL,AVR,NL);
+      }
+    } else
+      nChk = this->loadSubspace(nR, std::min(nG,MSS), VR, AVR, hasAX);
+    if( nChk ) {
+      nDo   = nChk;
+      nExam = nChk;
+      nVCur = nChk;
+    }
+
+    // Keep the non-root processes, which take part in the linear
+    // transformation, in step with the root. Returns whether to stop
+    auto syncIter = [&](bool stop) {
+      if( MPISize(this->comm_) > 1 ) {
+        int iStop = stop;
+        MPIBCast(iStop,0,this->comm_);
+        MPIBCast(nDo,0,this->comm_);
+        stop = iStop;
+      }
+      return stop;
+    };
+
     // ****************************
     // ** Begin Davidson iterations **
     // ****************************
@@ -158,7 +235,7 @@ namespace ChronusQ {
       auto DavidsonSt = tick();
       
       if( isRoot ) {
-        std::cout << "\n    DavidsonIter " << std::setw(5) << iter+1  
+        out << "\n    DavidsonIter " << std::setw(5) << iter+1  
                   << ": Number of new vectors = " << std::setw(5) << nDo << std::endl;
       } // Root Only
       
@@ -168,17 +245,31 @@ namespace ChronusQ {
 
       auto LTst = tick();
       
-      // AVR <- A * VR
-      _F * VRSend  = isRoot ? VR  + N*nVPrev: nullptr;
-      _F * AVRRecv = isRoot ? AVR + N*nVPrev: nullptr;
-      this->linearTrans_(nDo,VRSend,AVRRecv);
+      // AVR <- A * VR (known for a resumed subspace), the new vectors
+      // of a single precision VR are transformed in R / S
+      _F * VRSend  = nullptr;
+      _F * AVRRecv = nullptr;
+      if( isWork ) {
+        if constexpr ( lowP ) {
+          VRSend  = R;
+          AVRRecv = S;
+          subspaceCopy(NL,nDo,VR + NL*nVPrev,NL,R,NL);
+        } else {
+          VRSend  = VR  + NL*nVPrev;
+          AVRRecv = AVR + NL*nVPrev;
+        }
+      }
+      if( not (hasAX and iter == 0) ) {
+        this->linearTrans_(nDo,VRSend,AVRRecv);
+        if( lowP and isWork ) subspaceCopy(NL,nDo,S,NL,AVR + NL*nVPrev,NL);
+      }
       
       double LTdur = tock(LTst);
       
       // Sync processes
       MPI_Barrier(this->comm_);
        
-      if( isRoot ) {
+      if( isWork ) {
         
         // Construct submatrix of A 
         if(this->DoLeftEigVec) { 
@@ -186,15 +277,22 @@ namespace ChronusQ {
           CErr("Do Left Eig Vec is not implemented yet");
         } else {
         // SubA <- VR_\dagger * AVR 
-          blas::gemm(blas::Layout::ColMajor,blas::Op::ConjTrans,blas::Op::NoTrans,nVCur,nVCur,N,_F(1.),VR,N,AVR,N,_F(0.),SubA,nVCur); 
+          this->distInnerProd(nVCur,nVCur,VR,NL,AVR,NL,SubA);
         }
     
 #ifdef DEBUG_DAVIDSON
+        if( isRoot )
         prettyPrintSmart(std::cout,"HH Davidson SubMatix ",SubA,nVCur,nVCur,nVCur);
 #endif 
 
-        // Diagonalize SubA 
-        GeneralEigenSymm(JOBVL,'V',nVCur,SubA,nVCur,Eig,XL,nVCur,XR,nVCur); 
+        // Diagonalize SubA, the root's eigenvectors are used everywhere
+        if( isRoot )
+          GeneralEigenSymm(JOBVL,'V',nVCur,SubA,nVCur,Eig,XL,nVCur,XR,nVCur); 
+        if( dist ) {
+          MPIBCast(XR,nVCur*nVCur,0,this->comm_);
+          MPIBCast(Eig,nVCur,0,this->comm_);
+        }
+        nVRitz = nVCur;
 
         // swap high energy roots for energy specific
         if(this->EnergySpecific) {
@@ -202,20 +300,21 @@ namespace ChronusQ {
         }   
 
         // print eigenvalues at current iteration
-        std::cout << "      - Eigenvalues at the current iteration:" << std::endl;
+        out << "      - Eigenvalues at the current iteration:" << std::endl;
         for(auto i = 0; i < nExam; i++) {
-          std::cout << "        Root " << std::setw(5) << std::right << i << ":"
+          out << "        Root " << std::setw(5) << std::right << i << ":"
                     << std::right << std::setw(20) << std::real(Eig[i]);
               
           if( std::is_same<dcomplex,_F>::value ) {
-            std::cout << " + " << std::setw(20) << std::imag(Eig[i]) << " i";
+            out << " + " << std::setw(20) << std::imag(Eig[i]) << " i";
           }
               
-          std::cout << std::endl;
+          out << std::endl;
         }
           
         // Exam Eigenvalues and eigenvectors and do mapping if iter > 0
         std::fill_n(SiConv.begin(),nExam,false);
+        std::vector<int> StMap(nExam,-1); // new root -> previous root
         if( iter > 0) {
             
           // overlap = (VR XR)_old ^\dagger * (VR XR)_new
@@ -226,8 +325,6 @@ namespace ChronusQ {
           blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,nExam,nExam,nVCur ,_F(1.),SCR,nExam,XR,nVCur,_F(0.),Ovlp,nExam);
           
           // mapping old vector to new vectors based on overlap
-          std::vector<int> StMap(nExam);
-          std::fill_n(StMap.begin(),nExam,-1);
           std::copy_n(Ovlp,nExam*nExam,SCR);
               
           // i -> new state, j -> old state
@@ -246,99 +343,180 @@ namespace ChronusQ {
           std::copy_n(SCR,nExam*nExam,Ovlp);
           
 #ifdef DEBUG_DAVIDSON
+          if( isRoot )
           prettyPrintSmart(std::cout,"HH Davidson States Overlap",Ovlp,nExam,nExam,nExam);
 #endif 
       
-          std::cout << "\n      - Comparison to the previous iteration: " << std::endl;  
+          out << "\n      - Comparison to the previous iteration: " << std::endl;  
           // exam eigenvectors
           // R and S as scratch space to hold full vector old and new repectively
-          blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,N,nExam,nVPrev,_F(1.),VR,N,XRPrev,nVPrev,_F(0.),R,N);
-          blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,N,nExam,nVCur,_F(1.),VR,N,XR,nVCur,_F(0.),S,N);
+          subspaceGemm(blas::Op::NoTrans,NL,nExam,nVPrev,_F(1.),VR,NL,XRPrev,nVPrev,_F(0.),R,NL);
+          subspaceGemm(blas::Op::NoTrans,NL,nExam,nVCur,_F(1.),VR,NL,XR,nVCur,_F(0.),S,NL);
               
+          // maximum differece in vectors, over the rows of all processes
+          std::vector<double> maxDel(nExam, 0.);
           _F phase;
-          _F maxDel;  // maximum differece in vectors
+          for(i = 0; i < nExam; i++) {
+            j = StMap[i];
+            if(j < 0) continue;
+
+            phase = Ovlp[j + i*nExam];
+            phase /= std::abs(phase); 
+            
+            auto iNew = S + i*NL;
+            auto jOld = R + j*NL;
+
+            MatAdd ('N','N',NL,1,_F(1.),iNew,NL,-phase,jOld,NL,jOld,NL);
+            maxDel[i] = std::abs(*std::max_element(jOld, jOld+NL, 
+                        [&] (_F A, _F B) { return std::norm(A) < std::norm(B); }));
+          }
+
+          if( dist ) MPIAllReduce(maxDel.data(), nExam,
+            [](double a, double b) { return std::max(a,b); }, this->comm_);
+
           for(i = 0; i < nExam; i++) {
             j = StMap[i];
             if(j < 0) {
-              std::cout << "          New root" << std::setw(5) << i << " is brand new" << std::endl;
+              out << "          New root" << std::setw(5) << i << " is brand new" << std::endl;
               continue; 
             } else if (j!=i) { 
-              std::cout << "          New root" << std::setw(5) << i
+              out << "          New root" << std::setw(5) << i
                         << " was old root" << std::setw(5) << j << std::endl; 
             }
 
-            phase = Ovlp[j + i*nExam];
-            phase /= std::abs(phase); 
-            
-            auto iNew = S + i*N;
-            auto jOld = R + j*N;
-
-            MatAdd ('N','N',N,1,_F(1.),iNew,N,-phase,jOld,N,jOld,N);
-            maxDel = *std::max_element(jOld, jOld+N, 
-                        [&] (_F A, _F B) { return std::norm(A) < std::norm(B); });
- 
-            SiConv[i] = std::abs(maxDel) < VecConv; 
-            if(SiConv[i]) std::cout << "        Root "   << std::setw(5) << std::right << i
+            SiConv[i] = maxDel[i] < VecConv; 
+            if(SiConv[i]) out << "        Root "   << std::setw(5) << std::right << i
                                     << " has converged"  << std::endl;
-            else std::cout << "        Root " <<  std::right << std::setw(5) << i
+            else out << "        Root " <<  std::right << std::setw(5) << i
                            << " has not converged, maximum delta is"<<  std::right  
-                           << std::setw(20) << std::abs(maxDel) << std::endl;
+                           << std::setw(20) << maxDel[i] << std::endl;
+          }
+
+          // a locked root stays converged without a vector check while
+          // its residual norm | A x - e x | (S holds the new x) is small
+          std::vector<bool> lockOK(nExam, false);
+          if( this->lockRoots ) {
+            for(i = 0; i < nExam; i++) {
+              j = StMap[i];
+              if(j < 0 or not SiLock[j]) continue;
+
+              subspaceGemm(blas::Op::NoTrans,NL,1,nVCur,_F(1.),AVR,NL,XR + i*nVCur,nVCur,_F(0.),R + i*NL,NL);
+              MatAdd ('N','N',NL,1,_F(1.),R + i*NL,NL,-this->dcomplexTo_F(Eig[i]),S + i*NL,NL,R + i*NL,NL);
+
+              double res = this->distNorm(R + i*NL);
+              lockOK[i] = res < VecConv;
+              if( not lockOK[i] )
+                out << "        Root " << std::setw(5) << std::right << i
+                    << " is unlocked, residue norm is" << std::right
+                    << std::setw(20) << res << std::endl;
+            }
           }
 
           // exam eigenvalues
           dcomplex EDiff;
           for(i = 0; i < nExam; i++) {
             j = StMap[i];
+            if(j < 0) continue;
             EDiff = Eig[i] - EPrev[j];
+            if(lockOK[i]) SiConv[i] = true;
             SiConv[i] = SiConv[i] and (std::abs(EDiff) < EConv);  
           } 
+
+          // the root decides on convergence
+          if( dist ) {
+            std::vector<int> iConv(SiConv.begin(), SiConv.begin()+nExam);
+            MPIBCast(iConv.data(),nExam,0,this->comm_);
+            std::copy(iConv.begin(), iConv.end(), SiConv.begin());
+          }
         }   // Exam eigenvales and eigenvectors
+
+        std::fill(SiLock.begin(), SiLock.end(), false);
+        std::copy_n(SiConv.begin(), nExam, SiLock.begin());
           
-        isConverged = std::all_of(SiConv.begin(), SiConv.begin()+nExam, [&] (bool i) { return i; });
-        if(isConverged or nVCur >= MSS) {
+        // Roots that still need new vectors
+        std::vector<int> unConvS(nExam);
+        size_t nUnConv = 0ul;
+        std::fill_n(unConvS.begin(),nExam,-1);
+        for (auto i = 0ul; i < nExam; i++)
+          if(not SiConv[i]) unConvS[nUnConv++] = i;
+
+        isConverged = nUnConv == 0;
+
+        // Checkpoint the Ritz vectors and their products (R and S are
+        // free until the residues are formed)
+        if( this->chkDue(iter) or (this->chkWrite() and 
+            (isConverged or iter + 1 == this->maxMicroIter_)) ) {
+
+          size_t nS = std::min(nExam,nVCur);
+          subspaceGemm(blas::Op::NoTrans,NL,nS,nVCur,_F(1.),VR,NL,XR,nVCur,_F(0.),R,NL);
+          subspaceGemm(blas::Op::NoTrans,NL,nS,nVCur,_F(1.),AVR,NL,XR,nVCur,_F(0.),S,NL);
+          this->saveSubspace(nS,R,S,Eig,SiConv);
+
+        }
+
+        // Thick restart, if the new vectors do not fit into the subspace.
+        // Without it (or if the kept vectors do not leave room for the new
+        // ones) runMicro returns on a full subspace and the macro
+        // iteration restarts
+        size_t nKeep = 0;
+        if( this->doThickRestart and nUnConv and nVCur + nUnConv > MSS ) {
+
+          // columns of XRPrev of the unconverged roots, through the
+          // mapping onto the previous roots (brand new roots have none)
+          std::vector<int> prevCols;
+          for(auto i = 0ul; i < nUnConv; i++)
+            if( StMap[unConvS[i]] >= 0 ) prevCols.push_back(StMap[unConvS[i]]);
+
+          nKeep = thickRestart_(nVCur,nVPrev,nExam,nUnConv,prevCols,VR,AVR,
+            XR,XRPrev);
+        }
+
+        if(isConverged or (nKeep == 0 and nVCur >= MSS)) {
         
           double DavidsonDur = tock(DavidsonSt);
           double perLT = LTdur * 100 / DavidsonDur;
         
-          std::cout << "\n      - DURATION = " << std::setprecision(8) << DavidsonDur 
+          out << "\n      - DURATION = " << std::setprecision(8) << DavidsonDur 
             << " s  ( " << perLT << " % LT )" << std::endl;
+          syncIter(true);
           break;
         }
 
+        if( nKeep ) {
+          out << "\n      - Thick restart: subspace collapsed from "
+              << nVCur << " to " << nKeep << " vectors" << std::endl;
+          nVCur  = nKeep;
+          nVRitz = nKeep;
+          nThickRestarts_++;
+        }
+
         // Form residue vectors only for unconverged vectors
-        std::vector<int> unConvS(nExam);
-        nDo = 0ul;
-        std::fill_n(unConvS.begin(),nExam,-1);
+        nDo = nUnConv;
         std::fill_n(SCR,nVCur*nExam,_F(0.));
-        for (auto i = 0ul; i < nExam; i++) {
-          if(not SiConv[i]) {
-            unConvS[nDo] = i;
-            std::copy_n(XR + i*nVCur,nVCur,SCR + nDo*nVCur);
-            nDo++;
-          }
-        }
+        for (auto i = 0ul; i < nDo; i++)
+          std::copy_n(XR + unConvS[i]*nVCur,nVCur,SCR + i*nVCur);
 
         if(nVCur+nDo > MSS)  nDo = MSS - nVCur;
         
         // R <- AVR * XR
-        blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,N,nDo,nVCur,_F(1.),AVR,N,SCR,nVCur,_F(0.),R,N);
+        subspaceGemm(blas::Op::NoTrans,NL,nDo,nVCur,_F(1.),AVR,NL,SCR,nVCur,_F(0.),R,NL);
 
         // S as scratch space, <- eig_i * (VR * XR_i)
-        blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,N,nDo,nVCur,_F(1.),VR,N,SCR,nVCur,_F(0.),S,N);
+        subspaceGemm(blas::Op::NoTrans,NL,nDo,nVCur,_F(1.),VR,NL,SCR,nVCur,_F(0.),S,NL);
             
         for (auto i = 0ul; i < nDo; i++) 
-          blas::scal(N,this->dcomplexTo_F(Eig[unConvS[i]]),S + i*N,1);
+          blas::scal(NL,this->dcomplexTo_F(Eig[unConvS[i]]),S + i*NL,1);
             
         // Compute the residue norm and generate perturbbed vectors
-        MatAdd ('N','N',N,nDo,_F(1.),R,N,_F(-1.),S,N,S,N);
-        std::cout << "\n      - Residues of non-converged roots: " << std::endl;  
+        MatAdd ('N','N',NL,nDo,_F(1.),R,NL,_F(-1.),S,NL,S,NL);
+        out << "\n      - Residues of non-converged roots: " << std::endl;  
         
         if(EigForT) std::fill_n(EigForT,nG,dcomplex(0.));
         std::fill_n(RelRes, nG, 0.);
         for (auto i = 0ul; i < nDo; i++) {
           auto j = unConvS[i];
-          RelRes[i] = blas::nrm2(N,S + i*N,1); 
-          std::cout << "        Root " << std::setw(5) << std::right << j+1 
+          RelRes[i] = this->distNorm(S + i*NL); 
+          out << "        Root " << std::setw(5) << std::right << j+1 
                     << " 2nd order lowering " << std::right << std::setw(20) << RelRes[i]*RelRes[i] 
                     << " norm " << std::right << std::setw(20) << RelRes[i] << std::endl;
               
@@ -349,7 +527,7 @@ namespace ChronusQ {
             
         // Append the new vectors to VR and orthogoalize against existing ones 
         // Also update the dimensions and save the XRPrev
-        std::copy_n(S,nDo*N,VR+nVCur*N);
+        if( not lowP ) subspaceCopy(NL,nDo,S,NL,VR+nVCur*NL,NL);
         std::copy_n(XR,nVCur*nVCur,XRPrev);
         std::copy_n(Eig,nVCur,EPrev);
         nVPrev = nVCur;
@@ -362,7 +540,13 @@ namespace ChronusQ {
           std::cout.setstate(std::ios_base::failbit);
 #endif
 
-          nVCur = GramSchmidt(N,nVCur,nDo,VR,N,this->memManager_);   
+          if constexpr ( lowP ) {
+            // orthonormalized in S, then rounded
+            size_t nNew = this->orthonormalize(nVCur,VR,NL,nDo,S,NL);
+            subspaceCopy(NL,nNew,S,NL,VR+nVCur*NL,NL);
+            nVCur += nNew;
+          } else
+            nVCur = this->orthonormalize(nVCur,nDo,VR,NL);
           
 #ifndef DEBUG_DAVIDSON
           std::cout.clear();
@@ -380,36 +564,46 @@ namespace ChronusQ {
         double DavidsonDur = tock(DavidsonSt);
         double perLT = LTdur * 100 / DavidsonDur;
     
-        std::cout << "\n      - DURATION = " << std::setprecision(8) << DavidsonDur 
+        out << "\n      - DURATION = " << std::setprecision(8) << DavidsonDur 
           << " s  ( " << perLT << " % LT )" << std::endl;
     
-        if(nDo == 0) {
-          isConverged = true;
-          break;
-        }
       } // Root Only 
+
+      if( syncIter(isRoot and nDo == 0) ) {
+        isConverged = true;
+        break;
+      }
     
     } // Davidson iteration    
 
+    // Gather the Ritz vectors of the distributed rows on the root
+    if( dist ) {
+      _F *VRLoc = this->memManager_.template malloc<_F>(NL*nR);
+      subspaceGemm(blas::Op::NoTrans,NL,nR,nVRitz,_F(1.),VR,NL,XR,nVRitz,_F(0.),VRLoc,NL);
+      this->gatherVectors(nR,VRLoc,this->VR_);
+      this->memManager_.free(VRLoc);
+    }
+
     if( isRoot ) {
 
       // move data before exit runMicro      
       std::copy_n(Eig,nR,this->eigVal_);
-      blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,N,nR,nVCur,_F(1.),VR,N,XR,nVCur,_F(0.),this->VR_,N);
+      if( not dist )
+      subspaceGemm(blas::Op::NoTrans,N,nR,nVRitz,_F(1.),VR,N,XR,nVRitz,_F(0.),this->VR_,N);
       //size_t nVSave = isConverged ? nR: nG;  
       //std::copy_n(Eig,nVSave,this->eigVal_);
       //blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,N,nVSave,nVCur,_F(1.),VR,N,XR,nVCur,_F(0.),this->VR_,N);
       
-      std::cout << "\n  * ";
+      out << "\n  * ";
       if( isConverged and nDo !=0)
-        std::cout << "Davidson Converged in " << iter+1 << " Iterations" 
+        out << "Davidson Converged in " << iter+1 << " Iterations" 
                   << std::endl;
       else if (nDo ==0) {
         double maxResDel = *std::max_element(RelRes, RelRes+nR);
-        std::cout << "Davidson expansion finished, and wavefunction converged "
+        out << "Davidson expansion finished, and wavefunction converged "
           << "below " << std::setw(20) << std::right << maxResDel << std::endl;
       } else
-        std::cout << "Davidson Failed to Converged in " << iter+1 << " Iterations" 
+        out << "Davidson Failed to Converged in " << iter+1 << " Iterations" 
                   << std::endl;
     } // Root Only 
 
@@ -431,23 +625,106 @@ namespace ChronusQ {
     
     return isConverged;
   
-  } // Davidson::runMicro
+  } // Davidson::runMicro_
+
+  /**
+   *  \brief Collapse the Davidson subspace for a thick restart.
+   *
+   *  The new basis spans the kThick * nExam lowest Ritz vectors and the
+   *  Ritz vectors of the previous iteration of the (first) unconverged
+   *  roots, as far as the room left for the nDo new vectors allows.
+   *  VR and AVR are transformed in place, so no linear transformation
+   *  is repeated, and XR is replaced by the Ritz vectors in the new
+   *  basis (exact for the kept Ritz vectors).
+   *
+   *  \returns the dimension of the collapsed subspace, 0 if the Ritz
+   *  vectors and the new vectors do not fit into the subspace
+   */
+  template <typename _F>
+  template <typename _FB>
+  size_t Davidson<_F>::thickRestart_(size_t nV, size_t nVPrev, size_t nExam,
+    size_t nDo, const std::vector<int> &prevCols, _FB *VR, _FB *AVR, _F *XR,
+    _F *XRPrev) {
+
+    const size_t NL  = this->nLocal();
+    const size_t MSS = std::min(this->mSS_,this->N_);
+
+    size_t nRitz = std::min(nV, kThick * nExam);
+    if( nRitz + nDo > MSS ) return 0;
+
+    size_t nPrev = nVPrev ? std::min(prevCols.size(), MSS - nRitz - nDo) : 0;
+    size_t nY    = nRitz + nPrev;
+
+    // Y = [ XR(:,:nRitz)  XRPrev(:,prevCols) ] in the current basis
+    _F *Y = this->memManager_.template malloc<_F>(nV * nY);
+    std::copy_n(XR, nV * nRitz, Y);
+    for(auto i = 0ul; i < nPrev; i++) {
+      _F *Yi = Y + (nRitz + i) * nV;
+      std::fill_n(Yi, nV, _F(0.));
+      std::copy_n(XRPrev + prevCols[i] * nVPrev, nVPrev, Yi);
+    }
+
+    {
+#ifndef DEBUG_DAVIDSON
+      SilenceOutput silence;
+#endif
+      nY = GramSchmidt(nV,nRitz,nPrev,Y,nV,this->memManager_,1);
+    }
+
+    // VR <- VR * Y, AVR <- AVR * Y
+    _F *SCR = this->memManager_.template malloc<_F>(std::max(NL,nY) * nY);
+
+    subspaceGemm(blas::Op::NoTrans,NL,nY,nV,_F(1.),VR,NL,Y,nV,_F(0.),SCR,NL);
+    subspaceCopy(NL,nY,SCR,NL,VR,NL);
+
+    subspaceGemm(blas::Op::NoTrans,NL,nY,nV,_F(1.),AVR,NL,Y,nV,_F(0.),SCR,NL);
+    subspaceCopy(NL,nY,SCR,NL,AVR,NL);
+
+    // XR <- Y**H * XR
+    blas::gemm(blas::Layout::ColMajor,blas::Op::ConjTrans,blas::Op::NoTrans,nY,nY,nV,_F(1.),Y,nV,XR,nV,_F(0.),SCR,nY);
+    std::copy_n(SCR, nY * nY, XR);
+
+    this->memManager_.free(Y, SCR);
+
+    return nY;
+
+  } // Davidson::thickRestart_
 
   template <typename _F>
   void Davidson<_F>::restart() {
     // copy full vectors as new guess  
     std::cout << "\n  * Restarting Davidson..." << std::endl;
     if(Guess) this->memManager_.template free(Guess);
+    Guess = nullptr;
     
     // restart with only nRoots_ of guess
     // as now it's more close to the solution
     this->kG      = 1;
     this->whenSc  = 1;
     this->nGuess_ = this->nRoots_;
+
+    // NO MPI
+    ROOT_ONLY(this->comm_);
+
     const size_t NNS = this->N_ * this->nGuess_;
     Guess = this->memManager_.template malloc<_F>(NNS);
     std::copy_n(this->VR_, NNS, this->Guess);
   } // Davidson::restart
+
+
+  /**
+   *  \brief Restart from the Ritz vectors of the single precision
+   *  iterations with half of the subspace, which takes the memory of the
+   *  single precision subspace in FP64.
+   */
+  template <typename _F>
+  void Davidson<_F>::startRefinement() {
+
+    this->mSS_ = std::max(this->mSS_ / 2, 
+      std::min(2 * this->nRoots_, this->mSS_));
+    restart();
+
+  } // Davidson::startRefinement
   
 }; // namespace ChronusQ
 
@@ -0,0 +1,195 @@
+/*
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *
+ *  Copyright (C) 2014-2022 Li Research Group (University of Washington)
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *
+ */
+#pragma once
+
+#include <itersolver.hpp>
+#include <cqlinalg/blas3.hpp>
+#include <cqlinalg/ortho.hpp>
+#include <itersolver/mixedprec.hpp>
+
+namespace ChronusQ {
+
+  /**
+   *  \brief Switch the row distribution of the vectors on / off.
+   *
+   *  Process r holds rows [N r / nProc, N (r+1) / nProc). The
+   *  distribution is only enabled for more than one process and
+   *  N >= nProc, so that every process holds at least one row.
+   */
+  template <typename _F>
+  void IterSolver<_F>::setDistributed(bool dist) {
+
+    const size_t nProc = MPISize(comm_);
+    const size_t rank  = MPIRank(comm_);
+
+    distVec_ = dist and nProc > 1 and N_ >= nProc;
+
+    rowCounts_.assign(nProc, 0);
+    for(auto r = 0ul; r < nProc; r++)
+      rowCounts_[r] = (N_ * (r + 1)) / nProc - (N_ * r) / nProc;
+
+    rowOff_ = (N_ * rank) / nProc;
+    NLoc_   = distVec_ ? rowCounts_[rank] : N_;
+
+  }; // IterSolver::setDistributed
+
+
+  /**
+   *  \brief C(m,n) = A(:,m)^H B(:,n) summed over the row blocks of all
+   *  processes. C is contiguous (LDC = m) and replicated.
+   */
+  template <typename _F>
+  template <typename _FA, typename _FB>
+  void IterSolver<_F>::distInnerProd(size_t m, size_t n, const _FA *A,
+    size_t LDA, const _FB *B, size_t LDB, _F *C) {
+
+    subspaceGemm(blas::Op::ConjTrans,m,n,nLocal(),_F(1.),A,LDA,B,LDB,
+      _F(0.),C,m);
+
+    if( distVec_ ) MPIAllReduce(C, m*n, comm_);
+
+  }; // IterSolver::distInnerProd
+
+
+  /**
+   *  \brief 2-norm of a row distributed vector
+   */
+  template <typename _F>
+  double IterSolver<_F>::distNorm(const _F *V) {
+
+    double nrm = blas::nrm2(nLocal(),V,1);
+    if( not distVec_ ) return nrm;
+
+    nrm *= nrm;
+    MPIAllReduce(nrm, comm_);
+    return std::sqrt(nrm);
+
+  }; // IterSolver::distNorm
+
+
+  /**
+   *  \brief Orthonormalize nNew (row distributed) vectors against nOld
+   *  orthonormal ones with BlockGramSchmidt and all-reduced projections.
+   *
+   *  The linear dependency threshold is that of the serial
+   *  GramSchmidt for the full dimension, so that every process drops
+   *  the same vectors.
+   */
+  template <typename _F>
+  size_t IterSolver<_F>::orthonormalize(size_t nOld, size_t nNew, _F *V,
+    size_t LDV) {
+
+    const size_t NL = nLocal();
+
+    return BlockGramSchmidt(NL,nOld,nNew,V,LDV,
+      [&](_F *Vc){ return _F(distNorm(Vc)); },
+      [&](size_t i, size_t j, _F *Vi, size_t LDVi, _F *Vj, size_t LDVj,
+        _F *inner){ distInnerProd(i,j,Vi,LDVi,Vj,LDVj,inner); },
+      memManager_,1,1e-12 * N_ / NL);
+
+  }; // IterSolver::orthonormalize
+
+
+  /**
+   *  \brief Gather nVec row distributed vectors (leading dimension
+   *  nLocal) into V (leading dimension N) on the root, or on every
+   *  process for allProcs.
+   *
+   *  Without the distribution the vectors live on the root and are
+   *  broadcast for allProcs.
+   */
+  template <typename _F>
+  void IterSolver<_F>::gatherVectors(size_t nVec, const _F *VLoc, _F *V,
+    bool allProcs) {
+
+    if( not distVec_ ) {
+      if( V != VLoc and MPIRank(comm_) == 0 ) std::copy_n(VLoc, nVec * N_, V);
+      if( allProcs and MPISize(comm_) > 1 ) MPIBCast(V, nVec * N_, 0, comm_);
+      return;
+    }
+
+#ifdef CQ_ENABLE_MPI
+    bool isRoot = MPIRank(comm_) == 0;
+    for(auto i = 0ul; i < nVec; i++)
+      mxx::gatherv(VLoc + i*NLoc_, NLoc_, rowCounts_,
+        isRoot ? V + i*N_ : nullptr, 0, comm_);
+
+    if( allProcs ) MPIBCast(V, nVec * N_, 0, comm_);
+#endif
+
+  }; // IterSolver::gatherVectors
+
+
+  /**
+   *  \brief Distribute the rows of nVec vectors V on the root
+   */
+  template <typename _F>
+  void IterSolver<_F>::scatterVectors(size_t nVec, const _F *V, _F *VLoc) {
+
+    if( not distVec_ ) {
+      if( V != VLoc and MPIRank(comm_) == 0 ) std::copy_n(V, nVec * N_, VLoc);
+      return;
+    }
+
+#ifdef CQ_ENABLE_MPI
+    bool isRoot = MPIRank(comm_) == 0;
+    for(auto i = 0ul; i < nVec; i++)
+      mxx::scatterv(isRoot ? V + i*N_ : nullptr, rowCounts_, VLoc + i*NLoc_,
+        NLoc_, 0, comm_);
+#endif
+
+  }; // IterSolver::scatterVectors
+
+
+  /**
+   *  \brief Sum the full length partial vectors V of all processes and
+   *  keep the local rows, e.g. for a linear transformation that is
+   *  partitioned over contributions rather than rows.
+   *
+   *  Without the distribution the sum is kept on the root, where the
+   *  vectors live.
+   */
+  template <typename _F>
+  void IterSolver<_F>::reduceScatterVectors(size_t nVec, const _F *V,
+    _F *VLoc) {
+
+    if( not distVec_ and MPISize(comm_) == 1 ) {
+      if( V != VLoc ) std::copy_n(V, nVec * N_, VLoc);
+      return;
+    }
+
+#ifdef CQ_ENABLE_MPI
+    bool isRoot = MPIRank(comm_) == 0;
+    _F *SUM = isRoot ? memManager_.template malloc<_F>(nVec * N_) : nullptr;
+
+    mxx::reduce(V, nVec * N_, SUM, 0, std::plus<_F>(), comm_);
+    if( distVec_ ) scatterVectors(nVec, SUM, VLoc);
+    else if( isRoot ) std::copy_n(SUM, nVec * N_, VLoc);
+
+    if( SUM ) memManager_.free(SUM);
+#endif
+
+  }; // IterSolver::reduceScatterVectors
+
+}; // namespace ChronusQ
@@ -24,6 +24,7 @@
 #pragma once
 
 #include <itersolver.hpp>
+#include <itersolver/mixedprec.hpp>
 #include <util/timer.hpp>
 
 namespace ChronusQ {
@@ -41,12 +42,29 @@ namespace ChronusQ {
     // Do the standard stuff...
     IterLinearSolver<_F>::runBatch(nRHS,nShift,RHS,shifts,SOL,RHSNorm);
 
+    const size_t N = this->N_;
+
+    // Householder vector k of system iDo, converted into UCol_ if the
+    // vectors are stored in single precision
+    auto getU = [&](size_t k, size_t iDo) -> _F* {
+      size_t off = (k + iDo * this->mSS_) * N;
+      if( not UL_ ) return U_ + off;
+      subspaceCopy(N,1,UL_ + off,N,UCol_,N);
+      return UCol_;
+    };
+    auto setU = [&](size_t k, size_t iDo, const _F *X) {
+      size_t off = (k + iDo * this->mSS_) * N;
+      if( UL_ ) subspaceCopy(N,1,X,N,UL_ + off,N);
+      else      std::copy_n(X,N,U_ + off);
+    };
+
 
     // Zero out the scratch allocations
     if( isRoot ) {
 
       std::fill_n(J_, 2 * this->mSS_ * nRHS * nShift         , 0.);
-      std::fill_n(U_, this->N_ * this->mSS_ * nRHS * nShift  , 0.);  
+      if( UL_ ) std::fill_n(UL_, this->N_ * this->mSS_ * nRHS * nShift, 0.);
+      else      std::fill_n(U_ , this->N_ * this->mSS_ * nRHS * nShift, 0.);
       std::fill_n(R_, this->mSS_ * this->mSS_ * nRHS * nShift, 0.);
       std::fill_n(W_, (this->mSS_ + 1) * nRHS * nShift       , 0.);
 
@@ -80,7 +98,7 @@ namespace ChronusQ {
         double norm = Normalize(this->N_,curHHR,1);
 
         // Copy the HHR to the first column of U
-        std::copy_n(curHHR,this->N_, U_ + iDo*this->N_*this->mSS_);
+        setU(0,iDo,curHHR);
 
         // Apply HHR projection to residual
         W_[iDo * (this->mSS_ + 1)] = -beta;
@@ -150,7 +168,7 @@ namespace ChronusQ {
         if( iMicro > 0 )
         for(int k = iMicro-1; k >= 0; k--) {
 
-          _F * curU = U_ + (k+iDo*this->mSS_)*this->N_;
+          _F * curU = getU(k,iDo);
 
           _F inner = blas::dot(this->N_, curU, 1, curV, 1);
           blas::axpy(this->N_, -2.*inner, curU, 1, curV, 1);
@@ -239,7 +257,7 @@ namespace ChronusQ {
 
         for(auto k = 0; k <= iMicro; k++) {
 
-          _F * curU = U_ + (k+iDo*this->mSS_)*this->N_;
+          _F * curU = getU(k,iDo);
 
           _F inner = blas::dot(this->N_, curU, 1, curV, 1);
           blas::axpy(this->N_, -2.*inner, curU, 1, curV, 1);
@@ -247,8 +265,6 @@ namespace ChronusQ {
         }
 
 
-        _F * curU = U_ + (iMicro + 1 + iDo*this->mSS_)*this->N_;
-
         // Determine next projector
         if( iMicro < maxMicroIter - 1 ) {
 
@@ -264,7 +280,7 @@ namespace ChronusQ {
             curHHR[iMicro+1] += alpha;
             double norm = Normalize(this->N_,curHHR,1);
             
-            std::copy_n(curHHR,this->N_,curU);
+            setU(iMicro + 1,iDo,curHHR);
 
             std::fill_n(curV + iMicro + 2, this->N_ - iMicro - 2, 0.);
             curV[iMicro+1] = -alpha;
@@ -402,7 +418,6 @@ namespace ChronusQ {
 
       _F *curR   = R_   + iDo * this->mSS_ * this->mSS_;
       _F *curW   = W_   + iDo * (this->mSS_ + 1);
-      _F *curU   = U_   + iDo * this->mSS_ * this->N_;
       _F *curHHR = HHR_ + iDo * this->N_;
 
       int nMicro = mDim[iDo];
@@ -412,9 +427,10 @@ namespace ChronusQ {
       lapack::gesv(nMicro,1,curR,this->mSS_,IPIV,curW,this->mSS_+1);
       this->memManager_.free(IPIV);
 
-      std::copy_n(curU + (nMicro-1)*this->N_, this->N_, curHHR);
+      _F *curU = getU(nMicro-1,iDo);
+      std::copy_n(curU, this->N_, curHHR);
 
-      _F fact = curW[nMicro-1] * SmartConj(curU[(nMicro-1)*(this->N_+1)]);
+      _F fact = curW[nMicro-1] * SmartConj(curU[nMicro-1]);
       blas::scal(this->N_,-2.*fact,curHHR,1);
       curHHR[nMicro-1] += curW[nMicro-1];
 
@@ -422,8 +438,9 @@ namespace ChronusQ {
       for(int k = nMicro - 2; k >= 0; k--) {
 
         curHHR[k] += curW[k];
-        _F inner = blas::dot(this->N_,curU + k*this->N_,1,curHHR,1);
-        blas::axpy(this->N_,-2.*inner,curU + k*this->N_,1,curHHR,1);
+        curU = getU(k,iDo);
+        _F inner = blas::dot(this->N_,curU,1,curHHR,1);
+        blas::axpy(this->N_,-2.*inner,curU,1,curHHR,1);
 
       }
 
@@ -24,6 +24,7 @@
 #pragma once
 
 #include <itersolver.hpp>
+#include <itersolver/mixedprec.hpp>
 #include <util/timer.hpp>
 #include <util/matout.hpp>
 #include <cqlinalg/factorization.hpp>
@@ -35,9 +36,21 @@
 namespace ChronusQ {
 
 
+  /**
+   *  \brief GPLHR iterations with the blocks [V W S P], [AV AW AS AP] and
+   *  [Q Q1 Q2 Q3] stored as _FB.
+   *
+   *  For single precision storage a block is operated on (QR, projections,
+   *  preconditioner, linear transformation) in the precision of _F in
+   *  the scratch VSCR / VSCR2 / BX and rounded once it is final, the
+   *  projectors and the products with the subspace are taken from the
+   *  storage. For _FB = _F the blocks are operated on in place.
+   */
   template <typename _F>
-  bool GPLHR<_F>::runMicro() {
+  template <typename _FB>
+  bool GPLHR<_F>::runMicro_() {
 
+    constexpr bool lowP = not std::is_same<_FB,_F>::value;
 
     bool isRoot = MPIRank(this->comm_) == 0;
     bool isConverged = false;
@@ -50,6 +63,8 @@ namespace ChronusQ {
                 << "    * Min                          = " << std::real(hardLim) << "\n"
                 << "    * Kyrlov-Arnoldi Parameter (M) = " << this->m
                 << std::endl;
+      if( lowP )
+        std::cout << "    * Subspace Stored in Single Precision" << std::endl;
 
 
       std::cout << "\n\n" << std::endl;
@@ -75,10 +90,11 @@ namespace ChronusQ {
 
 
     // Initialize pointers
-    _F *V = nullptr , *W = nullptr , *S = nullptr , *P = nullptr ;
-    _F *AV = nullptr, *AW = nullptr, *AS = nullptr, *AP = nullptr;
-    _F *Q = nullptr , *Qp = nullptr, *Q1 = nullptr, *Q2 = nullptr, 
-       *Q3_p = nullptr;
+    _FB *V = nullptr , *W = nullptr , *S = nullptr , *P = nullptr ;
+    _FB *AV = nullptr, *AW = nullptr, *AS = nullptr, *AP = nullptr;
+    _FB *Q = nullptr , *Qp = nullptr, *Q1 = nullptr, *Q2 = nullptr, 
+        *Q3_p = nullptr;
+    _F  *BX = nullptr; // Block scratch of single precision storage
 
 
     _F *BETA = nullptr; dcomplex *ALPHA = nullptr;
@@ -89,20 +105,20 @@ namespace ChronusQ {
     if( isRoot ) {
 
       // V  = [V W S1...Sm P]
-      V = this->memManager_.template malloc<_F>(NMSS);
+      V = this->memManager_.template malloc<_FB>(NMSS);
       W = V + NNR;
       S = W + NNR;
       P = S + this->m * NNR;
 
       // AV = [AV AW AS1...ASm AP]
-      AV = this->memManager_.template malloc<_F>(NMSS);
+      AV = this->memManager_.template malloc<_FB>(NMSS);
       AW = AV + NNR;
       AS = AW + NNR;
       AP = AS + this->m * NNR;
 
 
       // Q = [Q Q1 Q2 Q3]
-      Q = this->memManager_.template malloc<_F>(NMSS);
+      Q = this->memManager_.template malloc<_FB>(NMSS);
       Qp = Q + NNR;
 
       Q1   = Qp;
@@ -128,6 +144,8 @@ namespace ChronusQ {
       MA  = this->memManager_.template malloc<_F>(MSS2);
       MB  = this->memManager_.template malloc<_F>(MSS2);
 
+      if( lowP ) BX = this->memManager_.template malloc<_F>(N * M_NR);
+
     } // ROOT only
 
 
@@ -140,24 +158,48 @@ namespace ChronusQ {
     VSCR2 = this->memManager_.template malloc<_F>(NNR); 
 
 
+    // Block X (nC columns) in the precision of _F: X itself or the
+    // scratch buf, loaded from X (load) or only to be written (work)
+    auto work = [&](_FB *X, _F *buf) -> _F* {
+      if constexpr ( lowP ) return buf; else return X;
+    };
+    auto load = [&](_FB *X, size_t nC, _F *buf) -> _F* {
+      if constexpr ( lowP ) {
+        subspaceCopy(N,nC,X,N,buf,N);
+        return buf;
+      } else return X;
+    };
+
+    // Round the block B (nC columns) into X, if it is not X itself
+    auto store = [&](_F *B, size_t nC, _FB *X) {
+      if constexpr ( lowP ) subspaceCopy(N,nC,B,N,X,N);
+    };
 
 
 
 
+    // Resume from the Schur vectors (and their products) of a previous
+    // run, or use them as the guess for a related problem
+    _F * VSend  = isRoot ? work(V ,VSCR ) : nullptr;
+    _F * AVRecv = isRoot ? work(AV,VSCR2) : nullptr;
 
+    bool   hasAX = false;
+    size_t nChk  = this->loadSubspace(nR,nR,VSend,AVRecv,hasAX);
 
     if( isRoot ) {
 
       // Initailize V as Guess, if no Guess set, init to identity
-      if( Guess ) std::copy_n(Guess,NNR,V);
-      else {
-        std::fill_n(V, NNR, 0.);
-        for(auto i = 0ul; i < nR; i++) V[i * (N+1)] = 1.0;
+      if( nChk == 0 ) {
+        if( Guess ) std::copy_n(Guess,NNR,VSend);
+        else {
+          std::fill_n(VSend, NNR, 0.);
+          for(auto i = 0ul; i < nR; i++) VSend[i * (N+1)] = 1.0;
+        }
       }
 
 
-      // V <- QR(V)
-      QR(N,nR,V,N,this->memManager_);
+      // V <- QR(V), a resumed V is orthonormal
+      if( not hasAX ) QR(N,nR,VSend,N,this->memManager_);
 
     } // ROOT only
 
@@ -169,12 +211,8 @@ namespace ChronusQ {
     MPI_Barrier(this->comm_);
 
 
-    _F * VSend  = isRoot ? V  : nullptr;
-    _F * AVRecv = isRoot ? AV : nullptr;
-
-
     // AV <- A * V
-    this->linearTrans_(nR,VSend,AVRecv);
+    if( not hasAX ) this->linearTrans_(nR,VSend,AVRecv);
 
     // Sync processes
     MPI_Barrier(this->comm_);
@@ -189,19 +227,24 @@ namespace ChronusQ {
 
 
       // Q <- AV - sig * V 
-      std::copy_n(AV, NNR, Q);
-      blas::axpy( NNR, -sigma, V, 1, Q, 1 );
+      _F *Q0 = work(Q,BX);
+      std::copy_n(AVRecv, NNR, Q0);
+      blas::axpy( NNR, -sigma, VSend, 1, Q0, 1 );
 
       // Q <- QR(Q)
-      QR(N,nR,Q,N,this->memManager_);
+      QR(N,nR,Q0,N,this->memManager_);
+
+      store(VSend ,nR,V );
+      store(AVRecv,nR,AV);
+      store(Q0    ,nR,Q );
         
 
 
 
       // PHI <- Q**H * AV
       // PSI <- Q**H * V
-      blas::gemm(blas::Layout::ColMajor,blas::Op::ConjTrans,blas::Op::NoTrans,nR,nR,N,_F(1.),Q,N,AV,N,_F(0.),PHI,nR);
-      blas::gemm(blas::Layout::ColMajor,blas::Op::ConjTrans,blas::Op::NoTrans,nR,nR,N,_F(1.),Q,N,V,N,_F(0.),PSI,nR);
+      subspaceGemm(blas::Op::ConjTrans,nR,nR,N,_F(1.),Q,N,AV,N,_F(0.),PHI,nR);
+      subspaceGemm(blas::Op::ConjTrans,nR,nR,N,_F(1.),Q,N,V,N,_F(0.),PSI,nR);
 
 
       // VSR, VSL, ALPHA, BETA <- ORDQZ(PHI,PSI,sigma)
@@ -241,24 +284,28 @@ namespace ChronusQ {
       // VR  <- VR  * VSR
       // VL  <- VL  * VSL
       // AVR <- AVR * VSR
-      blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,N,nR,nR,_F(1.),V,N,VSR,nR,_F(0.),VSCR,N);
-      std::copy_n(VSCR,NNR,V);
+      subspaceGemm(blas::Op::NoTrans,N,nR,nR,_F(1.),V,N,VSR,nR,_F(0.),VSCR,N);
+      subspaceCopy(N,nR,VSCR,N,V,N);
       
-      blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,N,nR,nR,_F(1.),Q,N,VSL,nR,_F(0.),VSCR,N);
-      std::copy_n(VSCR,NNR,Q);
+      subspaceGemm(blas::Op::NoTrans,N,nR,nR,_F(1.),Q,N,VSL,nR,_F(0.),VSCR,N);
+      subspaceCopy(N,nR,VSCR,N,Q,N);
       
-      blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,N,nR,nR,_F(1.),AV,N,VSR,nR,_F(0.),VSCR,N);
-      std::copy_n(VSCR,NNR,AV);
+      subspaceGemm(blas::Op::NoTrans,N,nR,nR,_F(1.),AV,N,VSR,nR,_F(0.),VSCR,N);
+      subspaceCopy(N,nR,VSCR,N,AV,N);
+
+      // Matrix norm estimate (before the rounding of AV)
+      nrmA =  lapack::lange(lapack::Norm::Fro,N,nR,VSCR,N);
 
       // Form initial residuals in W
       // W = AV * MB - V * MA
-      blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,N,nR,nR,_F(1.) ,AV,N,MB,nR,_F(0.),W,N);
-      blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,N,nR,nR,_F(-1.),V ,N,MA,nR,_F(1.),W,N);
+      _F *W0 = work(W,VSCR);
+      subspaceGemm(blas::Op::NoTrans,N,nR,nR,_F(1.) ,AV,N,MB,nR,_F(0.),W0,N);
+      subspaceGemm(blas::Op::NoTrans,N,nR,nR,_F(-1.),V ,N,MA,nR,_F(1.),W0,N);
 
 
       // Get Residual Norms
-      nrmA =  lapack::lange(lapack::Norm::Fro,N,nR,AV,N);
-      getResidualNorms(N,nR,W,RelRes,this->eigVal_,nrmA);
+      getResidualNorms(N,nR,W0,RelRes,this->eigVal_,nrmA);
+      store(W0,nR,W);
 
 
 
@@ -314,21 +361,29 @@ namespace ChronusQ {
         std::cout << "    GPLHRIter " << std::setw(5) << iter+1;
     
         // V, RMAT <- QR(V)
-        QR(N,nR,V,N,RMAT,nR,this->memManager_);
+        _F *V0  = load(V ,nR,VSCR );
+        _F *AV0 = load(AV,nR,VSCR2);
+        QR(N,nR,V0,N,RMAT,nR,this->memManager_);
 
         // AV <- X : [X * RMAT = AV]
         blas::trsm(blas::Layout::ColMajor,blas::Side::Right,blas::Uplo::Upper,blas::Op::NoTrans,blas::Diag::NonUnit,
-          N,nR,_F(1.),RMAT,nR,AV,N);
+          N,nR,_F(1.),RMAT,nR,AV0,N);
+
+        store(V0 ,nR,V );
+        store(AV0,nR,AV);
 
         // Q <- QR(Q)
-        QR(N,nR,Q,N,this->memManager_);
+        _F *Q0 = load(Q,nR,VSCR);
+        QR(N,nR,Q0,N,this->memManager_);
+        store(Q0,nR,Q);
 
 
         // W = (I - V * V**H) * T * (I - V * V**H) * W 
-        newSMatrix(N,nR,V,N,V,N,W,N,RMAT,nR);
+        _F *W0 = load(W,nR,VSCR);
+        newSMatrix(N,nR,V,N,V,N,W0,N,RMAT,nR);
 
         // W <- QR(W)
-        QR(N,nR,W,N,this->memManager_);
+        QR(N,nR,W0,N,this->memManager_);
 
       } // ROOT only
 
@@ -339,10 +394,15 @@ namespace ChronusQ {
       // AW <- A * W
       auto LTst = tick();
 
-      _F * WSend  = isRoot ? W  : nullptr;
-      _F * AWRecv = isRoot ? AW : nullptr;
+      _F * WSend  = isRoot ? work(W ,VSCR ) : nullptr;
+      _F * AWRecv = isRoot ? work(AW,VSCR2) : nullptr;
       this->linearTrans_(nR,WSend,AWRecv);
 
+      if( isRoot ) {
+        store(WSend ,nR,W );
+        store(AWRecv,nR,AW);
+      }
+
 
       double LTdur = tock(LTst);
 
@@ -360,20 +420,20 @@ namespace ChronusQ {
         if( isRoot ) {
 
           // S(k-1) / AS(k-1)
-          _F *Sprev  = W  + (k-1) * NNR;
-          _F *ASprev = AW + (k-1) * NNR;
+          _FB *Sprev  = W  + (k-1) * NNR;
+          _FB *ASprev = AW + (k-1) * NNR;
 
           // S(k) / AS(k)
-          _F *Scur  = W  + k * NNR;
-          _F *AScur = AW + k * NNR;
+          _F *Scur  = work(W  + k * NNR, VSCR );
+          _F *AScur = work(AW + k * NNR, VSCR2);
 
           SSend  = Scur;
           ASRecv = AScur;
 
 
           // S(k) = AS(k-1) * MB - S(k-1) * MA
-          blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,N,nR,nR,_F(1.) ,ASprev,N,MB,nR,_F(0.),Scur,N);
-          blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,N,nR,nR,_F(-1.),Sprev ,N,MA,nR,_F(1.),Scur,N);
+          subspaceGemm(blas::Op::NoTrans,N,nR,nR,_F(1.) ,ASprev,N,MB,nR,_F(0.),Scur,N);
+          subspaceGemm(blas::Op::NoTrans,N,nR,nR,_F(-1.),Sprev ,N,MA,nR,_F(1.),Scur,N);
 
           // S(k) = (I - V * V**H) * T * (I - V * V**H) * S(k-1) 
           newSMatrix(N,nR,V,N,V,N,Scur,N,RMAT,nR);
@@ -405,6 +465,11 @@ namespace ChronusQ {
 
         this->linearTrans_(nR,SSend,ASRecv);
 
+        if( isRoot ) {
+          store(SSend ,nR,W  + k * NNR);
+          store(ASRecv,nR,AW + k * NNR);
+        }
+
         LTdur += tock(LTst);
 
         // Sync processes
@@ -426,39 +491,52 @@ namespace ChronusQ {
           // P = (I - V * V**H) * P
           // P = (I - W * W**H) * P
           // P = (I - S * S**H) * P
-          halfProj2(N,     nR,V,N,AV,N,P,N,AP,N,RMAT,nR  ); // Project out V
-          halfProj2(N,     nR,W,N,AW,N,P,N,AP,N,RMAT,nR  ); // Project out W
-          halfProj2(N,M_NR,nR,S,N,AS,N,P,N,AP,N,RMAT,M_NR); // Project out S
+          _F *P0  = load(P ,nR,VSCR );
+          _F *AP0 = load(AP,nR,VSCR2);
+          halfProj2(N,     nR,V,N,AV,N,P0,N,AP0,N,RMAT,nR  ); // Project out V
+          halfProj2(N,     nR,W,N,AW,N,P0,N,AP0,N,RMAT,nR  ); // Project out W
+          halfProj2(N,M_NR,nR,S,N,AS,N,P0,N,AP0,N,RMAT,M_NR); // Project out S
 
           // P, RMAT <- QR(P)
-          QR(N,nR,P,N,RMAT,nR,this->memManager_);
+          QR(N,nR,P0,N,RMAT,nR,this->memManager_);
 
           // AP <- X : [X * RMAT = AP]
           blas::trsm(blas::Layout::ColMajor,blas::Side::Right,blas::Uplo::Upper,blas::Op::NoTrans,blas::Diag::NonUnit,
-            N,nR,_F(1.),RMAT,nR,AP,N);
+            N,nR,_F(1.),RMAT,nR,AP0,N);
+
+          store(P0 ,nR,P );
+          store(AP0,nR,AP);
 
         }
 
-        _F * Q3 = iter ? Q3_p : nullptr;
+        _FB * Q3 = iter ? Q3_p : nullptr;
 
         // Q' = (A - sigma * I) [W, S, [P]]
-        std::copy_n(AW,nQp * NNR, Qp);
-        blas::axpy( nQp * NNR, -sigma, W, 1, Qp, 1);
+        auto shiftedBlock = [&](_FB *AX, _FB *X, size_t nC, _F *QX) {
+          subspaceCopy(N,nC,AX,N,QX,N);
+          subspaceAxpy(N,nC,-sigma,X,N,QX,N);
+        };
 
 
 
 
         // Q1 = (I - Q * Q**H) * Q1
         // Q1 = QR(Q1)
-        halfProj(N,nR,Q,N,Q1,N,RMAT,nR);
-        QR(N,nR,Q1,N,this->memManager_);
+        _F *Q10 = work(Q1,VSCR);
+        shiftedBlock(AW,W,nR,Q10);
+        halfProj(N,nR,Q,N,Q10,N,RMAT,nR);
+        QR(N,nR,Q10,N,this->memManager_);
+        store(Q10,nR,Q1);
 
         // Q2 = (I - Q  * Q**H ) * Q2
         // Q2 = (I - Q1 * Q1**H) * Q2
         // Q2 = QR(Q2)
-        halfProj(N,nR,M_NR,Q ,N,Q2,N,RMAT,nR);
-        halfProj(N,nR,M_NR,Q1,N,Q2,N,RMAT,nR);
-        QR(N,M_NR,Q2,N,this->memManager_);
+        _F *Q20 = work(Q2,BX);
+        shiftedBlock(AS,S,M_NR,Q20);
+        halfProj(N,nR,M_NR,Q ,N,Q20,N,RMAT,nR);
+        halfProj(N,nR,M_NR,Q1,N,Q20,N,RMAT,nR);
+        QR(N,M_NR,Q20,N,this->memManager_);
+        store(Q20,M_NR,Q2);
 
 
         if( Q3 ) {
@@ -466,18 +544,21 @@ namespace ChronusQ {
           // Q3 = (I - Q1 * Q1**H) * Q3
           // Q3 = (I - Q2 * Q2**H) * Q3
           // Q3 = QR(Q3)
-          halfProj(N,     nR,Q ,N,Q3,N,RMAT,nR);
-          halfProj(N,     nR,Q1,N,Q3,N,RMAT,nR);
-          halfProj(N,M_NR,nR,Q2,N,Q3,N,RMAT,M_NR);
-          QR(N,nR,Q3,N,this->memManager_);
+          _F *Q30 = work(Q3,VSCR);
+          shiftedBlock(AP,P,nR,Q30);
+          halfProj(N,     nR,Q ,N,Q30,N,RMAT,nR);
+          halfProj(N,     nR,Q1,N,Q30,N,RMAT,nR);
+          halfProj(N,M_NR,nR,Q2,N,Q30,N,RMAT,M_NR);
+          QR(N,nR,Q30,N,this->memManager_);
+          store(Q30,nR,Q3);
         }
 
 
 
         // PHI <- Q**H * AV
         // PSI <- Q**H * V
-        blas::gemm(blas::Layout::ColMajor,blas::Op::ConjTrans,blas::Op::NoTrans,nQ*nR, nQ*nR, N, _F(1.), Q,N, AV,N, _F(0.), PHI, nQ*nR); 
-        blas::gemm(blas::Layout::ColMajor,blas::Op::ConjTrans,blas::Op::NoTrans,nQ*nR, nQ*nR, N, _F(1.), Q,N, V ,N, _F(0.), PSI, nQ*nR); 
+        subspaceGemm(blas::Op::ConjTrans,nQ*nR, nQ*nR, N, _F(1.), Q,N, AV,N, _F(0.), PHI, nQ*nR); 
+        subspaceGemm(blas::Op::ConjTrans,nQ*nR, nQ*nR, N, _F(1.), Q,N, V ,N, _F(0.), PSI, nQ*nR); 
 
         // VSR, VSL, ALPHA, BETA <- ORDQZ(PHI,PSI,sigma)
         OrdQZ2('V','V',nQ*nR,PHI,nQ*nR,PSI,nQ*nR,ALPHA,BETA,hardLimD,sigmaD,
@@ -503,55 +584,55 @@ namespace ChronusQ {
         _F * VSRt_P = VSRt_S + M_NR;
 
         // VSCR = V * VSR_V + W * VSR_W + S * VSR_S + P * VSR_P
-        blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,N,nR,nR  ,_F(1.),V,N,VSR_V,nQ*nR,_F(0.),VSCR,N);
-        blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,N,nR,nR  ,_F(1.),W,N,VSR_W,nQ*nR,_F(1.),VSCR,N);
-        blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,N,nR,M_NR,_F(1.),S,N,VSR_S,nQ*nR,_F(1.),VSCR,N);
+        subspaceGemm(blas::Op::NoTrans,N,nR,nR  ,_F(1.),V,N,VSR_V,nQ*nR,_F(0.),VSCR,N);
+        subspaceGemm(blas::Op::NoTrans,N,nR,nR  ,_F(1.),W,N,VSR_W,nQ*nR,_F(1.),VSCR,N);
+        subspaceGemm(blas::Op::NoTrans,N,nR,M_NR,_F(1.),S,N,VSR_S,nQ*nR,_F(1.),VSCR,N);
         if( iter )
-          blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,N,nR,nR,_F(1.),P,N,VSR_P,nQ*nR,_F(1.),VSCR,N);
+          subspaceGemm(blas::Op::NoTrans,N,nR,nR,_F(1.),P,N,VSR_P,nQ*nR,_F(1.),VSCR,N);
 
 
         // VSCR2 = V * VSRt_V + W * VSRt_W + S * VSRt_S + P * VSRt_P
-        blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,N,nR,nR  ,_F(1.),V,N,VSRt_V,nQ*nR,_F(0.),VSCR2,N);
-        blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,N,nR,nR  ,_F(1.),W,N,VSRt_W,nQ*nR,_F(1.),VSCR2,N);
-        blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,N,nR,M_NR,_F(1.),S,N,VSRt_S,nQ*nR,_F(1.),VSCR2,N);
+        subspaceGemm(blas::Op::NoTrans,N,nR,nR  ,_F(1.),V,N,VSRt_V,nQ*nR,_F(0.),VSCR2,N);
+        subspaceGemm(blas::Op::NoTrans,N,nR,nR  ,_F(1.),W,N,VSRt_W,nQ*nR,_F(1.),VSCR2,N);
+        subspaceGemm(blas::Op::NoTrans,N,nR,M_NR,_F(1.),S,N,VSRt_S,nQ*nR,_F(1.),VSCR2,N);
         if( iter )                          
-          blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,N,nR,nR,_F(1.),P,N,VSRt_P,nQ*nR,_F(1.),VSCR2,N);
+          subspaceGemm(blas::Op::NoTrans,N,nR,nR,_F(1.),P,N,VSRt_P,nQ*nR,_F(1.),VSCR2,N);
 
         // V = VSCR
         // P = VSCR2
-        std::copy_n(VSCR ,NNR,V);
-        std::copy_n(VSCR2,NNR,P);
+        subspaceCopy(N,nR,VSCR,N,V,N);
+        subspaceCopy(N,nR,VSCR2,N,P,N);
 
 
         // VSCR = AV * VSR_V + AW * VSR_W + AS * VSR_S + AP * VSR_P
-        blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,N,nR,nR  ,_F(1.),AV,N,VSR_V,nQ*nR,_F(0.),VSCR,N);
-        blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,N,nR,nR  ,_F(1.),AW,N,VSR_W,nQ*nR,_F(1.),VSCR,N);
-        blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,N,nR,M_NR,_F(1.),AS,N,VSR_S,nQ*nR,_F(1.),VSCR,N);
+        subspaceGemm(blas::Op::NoTrans,N,nR,nR  ,_F(1.),AV,N,VSR_V,nQ*nR,_F(0.),VSCR,N);
+        subspaceGemm(blas::Op::NoTrans,N,nR,nR  ,_F(1.),AW,N,VSR_W,nQ*nR,_F(1.),VSCR,N);
+        subspaceGemm(blas::Op::NoTrans,N,nR,M_NR,_F(1.),AS,N,VSR_S,nQ*nR,_F(1.),VSCR,N);
         if( iter )
-          blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,N,nR,nR,_F(1.),AP,N,VSR_P,nQ*nR,_F(1.),VSCR,N);
+          subspaceGemm(blas::Op::NoTrans,N,nR,nR,_F(1.),AP,N,VSR_P,nQ*nR,_F(1.),VSCR,N);
 
         // VSCR2 = AV * VSRt_V + AW * VSRt_W + AS * VSRt_S + AP * VSRt_P
-        blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,N,nR,nR  ,_F(1.),AV,N,VSRt_V,nQ*nR,_F(0.),VSCR2,N);
-        blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,N,nR,nR  ,_F(1.),AW,N,VSRt_W,nQ*nR,_F(1.),VSCR2,N);
-        blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,N,nR,M_NR,_F(1.),AS,N,VSRt_S,nQ*nR,_F(1.),VSCR2,N);
+        subspaceGemm(blas::Op::NoTrans,N,nR,nR  ,_F(1.),AV,N,VSRt_V,nQ*nR,_F(0.),VSCR2,N);
+        subspaceGemm(blas::Op::NoTrans,N,nR,nR  ,_F(1.),AW,N,VSRt_W,nQ*nR,_F(1.),VSCR2,N);
+        subspaceGemm(blas::Op::NoTrans,N,nR,M_NR,_F(1.),AS,N,VSRt_S,nQ*nR,_F(1.),VSCR2,N);
         if( iter )                           
-          blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,N,nR,nR,_F(1.),AP,N,VSRt_P,nQ*nR,_F(1.),VSCR2,N);
+          subspaceGemm(blas::Op::NoTrans,N,nR,nR,_F(1.),AP,N,VSRt_P,nQ*nR,_F(1.),VSCR2,N);
 
 
         // AV = VSCR
         // AP = VSCR2
-        std::copy_n(VSCR ,NNR,AV);
-        std::copy_n(VSCR2,NNR,AP);
+        subspaceCopy(N,nR,VSCR,N,AV,N);
+        subspaceCopy(N,nR,VSCR2,N,AP,N);
 
         // VSCR = Q * VSR_V + Q1 * VSR_W + Q2 * VSR_S + Q3 * VSR_P
-        blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,N,nR,nR  ,_F(1.),Q ,N,VSL_V,nQ*nR,_F(0.),VSCR,N);
-        blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,N,nR,nR  ,_F(1.),Q1,N,VSL_W,nQ*nR,_F(1.),VSCR,N);
-        blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,N,nR,M_NR,_F(1.),Q2,N,VSL_S,nQ*nR,_F(1.),VSCR,N);
+        subspaceGemm(blas::Op::NoTrans,N,nR,nR  ,_F(1.),Q ,N,VSL_V,nQ*nR,_F(0.),VSCR,N);
+        subspaceGemm(blas::Op::NoTrans,N,nR,nR  ,_F(1.),Q1,N,VSL_W,nQ*nR,_F(1.),VSCR,N);
+        subspaceGemm(blas::Op::NoTrans,N,nR,M_NR,_F(1.),Q2,N,VSL_S,nQ*nR,_F(1.),VSCR,N);
         if( Q3 )
-          blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,N,nR,nR,_F(1.),Q3,N,VSL_P,nQ*nR,_F(1.),VSCR,N);
+          subspaceGemm(blas::Op::NoTrans,N,nR,nR,_F(1.),Q3,N,VSL_P,nQ*nR,_F(1.),VSCR,N);
 
         // Q = VSCR
-        std::copy_n(VSCR,NNR,Q);
+        subspaceCopy(N,nR,VSCR,N,Q,N);
 
       } // ROOT only
 
@@ -568,7 +649,10 @@ namespace ChronusQ {
         LTst = tick();
 
 
-        this->linearTrans_(nR,VSend,AVRecv);
+        _F *V0  = isRoot ? load(V,nR,VSCR) : nullptr;
+        _F *AV0 = isRoot ? work(AV,VSCR2)  : nullptr;
+        this->linearTrans_(nR,V0,AV0);
+        if( isRoot ) store(AV0,nR,AV);
 
         LTdur += tock(LTst);
 
@@ -587,8 +671,9 @@ namespace ChronusQ {
         
 
         // W = AV * MB - V * MA
-        blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,N,nR,nR,_F(1.) ,AV,N,MB,nR,_F(0.),W,N);
-        blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,N,nR,nR,_F(-1.),V ,N,MA,nR,_F(1.),W,N);
+        _F *W0 = work(W,VSCR);
+        subspaceGemm(blas::Op::NoTrans,N,nR,nR,_F(1.) ,AV,N,MB,nR,_F(0.),W0,N);
+        subspaceGemm(blas::Op::NoTrans,N,nR,nR,_F(-1.),V ,N,MA,nR,_F(1.),W0,N);
         
         /*
         // Adaptive sigma
@@ -628,12 +713,26 @@ namespace ChronusQ {
 
 
         // Get Residual norms
-        getResidualNorms(N,nR,W,RelRes,this->eigVal_,nrmA);
+        getResidualNorms(N,nR,W0,RelRes,this->eigVal_,nrmA);
+        store(W0,nR,W);
         
 
         // Check convergence
         isConverged = checkConv(nR,RelRes);
 
+        // Checkpoint the Schur vectors and their products
+        if( this->chkDue(iter) or (this->chkWrite() and 
+            (isConverged or iter + 1 == this->maxMicroIter_)) ) {
+
+          std::vector<bool> conv(nR);
+          for(auto i = 0ul; i < nR; i++) 
+            conv[i] = RelRes[i] <= this->convCrit_;
+
+          this->saveSubspace(nR,load(V,nR,VSCR),load(AV,nR,VSCR2),
+            this->eigVal_,conv);
+
+        }
+
       } // ROOT only
 
 
@@ -704,9 +803,9 @@ namespace ChronusQ {
     if( isRoot ) {
 
       // Reconstruct Eigen vectors
-      blas::gemm(blas::Layout::ColMajor,blas::Op::ConjTrans,blas::Op::NoTrans,nR,nR,N,_F(1.),V,N,AV,N,_F(0.),PSI,nR);
+      subspaceGemm(blas::Op::ConjTrans,nR,nR,N,_F(1.),V,N,AV,N,_F(0.),PSI,nR);
       GeneralEigenSymm('N','V',nR,PSI,nR,ALPHA,VSL,nR,VSR,nR);
-      blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,N,nR,nR,_F(1.),V,N,VSR,nR,_F(0.),this->VR_,N);
+      subspaceGemm(blas::Op::NoTrans,N,nR,nR,_F(1.),V,N,VSR,nR,_F(0.),this->VR_,N);
 
     }
 
@@ -727,6 +826,7 @@ namespace ChronusQ {
     if(MB)     this->memManager_.free(MB);
     if(VSCR)   this->memManager_.free(VSCR);
     if(VSCR2)  this->memManager_.free(VSCR2);
+    if(BX)     this->memManager_.free(BX);
 
     if( isRoot ) {
 
@@ -874,7 +974,8 @@ namespace ChronusQ {
    *  S = (I - V * V**H) * S
    */
   template <typename _F>
-  void GPLHR<_F>::halfProj(size_t N, size_t nV, size_t nS, _F *V, size_t LDV,
+  template <typename _FV>
+  void GPLHR<_F>::halfProj(size_t N, size_t nV, size_t nS, _FV *V, size_t LDV,
     _F *S, size_t LDS, _F *SCR, size_t LDSCR) {
 
     if( LDSCR < nV ) CErr("nV MUST be >= LDSCR");
@@ -882,10 +983,10 @@ namespace ChronusQ {
     ROOT_ONLY(this->comm_);
 
     // SCR = V**H * S
-    blas::gemm(blas::Layout::ColMajor,blas::Op::ConjTrans,blas::Op::NoTrans,nV,nS,N,_F(1.) ,V,LDV,S  ,LDS  ,_F(0.) ,SCR,LDSCR);
+    subspaceGemm(blas::Op::ConjTrans,nV,nS,N,_F(1.) ,V,LDV,S  ,LDS  ,_F(0.) ,SCR,LDSCR);
 
     // S = S - V * SCR
-    blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,N,nS,nV, _F(-1.),V,LDV,SCR,LDSCR,_F(1.),S,  LDS  );
+    subspaceGemm(blas::Op::NoTrans,N,nS,nV, _F(-1.),V,LDV,SCR,LDSCR,_F(1.),S,  LDS  );
 
   }
 
@@ -897,22 +998,23 @@ namespace ChronusQ {
    *  AS = AS - V * V**H  * S
    */
   template <typename _F>
-  void GPLHR<_F>::halfProj2(size_t N, size_t nV, size_t nS, _F *V, size_t LDV,
-    _F* AV, size_t LDAV, _F *S, size_t LDS, _F* AS, size_t LDAS, _F *SCR, 
-    size_t LDSCR) {
+  template <typename _FV>
+  void GPLHR<_F>::halfProj2(size_t N, size_t nV, size_t nS, _FV *V, 
+    size_t LDV, _FV* AV, size_t LDAV, _F *S, size_t LDS, _F* AS, size_t LDAS, 
+    _F *SCR, size_t LDSCR) {
 
     if( LDSCR < nV ) CErr("nV MUST be >= LDSCR");
 
     ROOT_ONLY(this->comm_);
 
     // SCR = V**H * S
-    blas::gemm(blas::Layout::ColMajor,blas::Op::ConjTrans,blas::Op::NoTrans,nV,nS,N,_F(1.) ,V,LDV,S  ,LDS  ,_F(0.) ,SCR,LDSCR);
+    subspaceGemm(blas::Op::ConjTrans,nV,nS,N,_F(1.) ,V,LDV,S  ,LDS  ,_F(0.) ,SCR,LDSCR);
 
     // S = S - V * SCR
-    blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,N,nS,nV, _F(-1.),V,LDV,SCR,LDSCR,_F(1.),S,  LDS  );
+    subspaceGemm(blas::Op::NoTrans,N,nS,nV, _F(-1.),V,LDV,SCR,LDSCR,_F(1.),S,  LDS  );
 
     // AS = AS - AV * SCR
-    blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,N,nS,nV, _F(-1.),AV,LDAV,SCR,LDSCR,_F(1.),AS,LDAS  );
+    subspaceGemm(blas::Op::NoTrans,N,nS,nV, _F(-1.),AV,LDAV,SCR,LDSCR,_F(1.),AS,LDAS  );
 
   }
 
@@ -926,7 +1028,8 @@ namespace ChronusQ {
    *  where T is the preconditioner
    */
   template <typename _F>
-  void GPLHR<_F>::newSMatrix(size_t N, size_t nR, _F *V, size_t LDV, _F *Q, 
+  template <typename _FV>
+  void GPLHR<_F>::newSMatrix(size_t N, size_t nR, _FV *V, size_t LDV, _FV *Q, 
     size_t LDQ, _F *S, size_t LDS, _F *SCR, size_t LDSCR) {
 
 
@@ -943,5 +1046,24 @@ namespace ChronusQ {
   template <typename _F>
   void GPLHR<_F>::restart() { }
 
+
+  /**
+   *  \brief Restart from the eigenvectors of the single precision
+   *  iterations with m = 1, which keeps the FP64 subspace small.
+   */
+  template <typename _F>
+  void GPLHR<_F>::startRefinement() {
+
+    setM(1);
+
+    // NO MPI
+    ROOT_ONLY(this->comm_);
+
+    const size_t NNR = this->N_ * this->nRoots_;
+    if( not Guess ) Guess = this->memManager_.template malloc<_F>(NNR);
+    std::copy_n(this->VR_, NNR, Guess);
+
+  }
+
 }; // namespace ChronusQ
 
@@ -24,10 +24,15 @@
 #pragma once
 
 #include <itersolver.hpp>
+#include <itersolver/mixedprec.hpp>
+#include <itersolver/distributed.hpp>
+#include <itersolver/checkpoint.hpp>
 #include <itersolver/iterlinearsolver.hpp>
 #include <itersolver/iterdiagonalizer.hpp>
 #include <itersolver/gmres.hpp>
+#include <itersolver/shiftedgmres.hpp>
 #include <itersolver/gplhr.hpp>
 #include <itersolver/davidson.hpp>
+#include <itersolver/chebyshev.hpp>
 
 
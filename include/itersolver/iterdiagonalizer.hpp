@@ -36,6 +36,12 @@ namespace ChronusQ {
     this->nGuess_ = std::min(this->nGuess_,this->N_);
      
     alloc(); // Allocate Scratch space
+
+    // The single precision iterations converge to lowPConv_, the
+    // solution is then refined in FP64
+    const double conv  = this->convCrit_;
+    const bool   mixed = this->mixedPrec_;
+    if( mixed ) this->convCrit_ = std::max(conv, this->lowPConv_);
     
     if( isRoot ) {
       std::cout << "\n  * IterDiagonalizer will solve for " << nRoots_ 
@@ -54,6 +60,9 @@ namespace ChronusQ {
                                  << this->maxMacroIter_ << "\n";
       std::cout << std::setw(30) << "    * Residual Conv Crit       = " 
                                  << std::scientific << std::setprecision(4)
+                                 << conv << "\n";
+      if( mixed )
+      std::cout << std::setw(30) << "    * Single Precision Conv    = " 
                                  << this->convCrit_ << "\n";
 
       std::cout << "\n\n" << std::endl;
@@ -71,11 +80,39 @@ namespace ChronusQ {
     for(auto iMacro = 0; iMacro < this->maxMacroIter_; iMacro++) {
 
       bool converged = runMicro();
+
+      // The convergence is decided on the root process
+      if( MPISize(this->comm_) > 1 ) {
+        int iConv = converged;
+        MPIBCast(iConv,0,this->comm_);
+        converged = iConv;
+      }
+
+      // Refine the single precision solution (also an unconverged one
+      // of the last macro iteration) in an extra macro iteration
+      if( this->mixedPrec_ and 
+          (converged or iMacro + 1 == this->maxMacroIter_) ) {
+
+        if( isRoot )
+          std::cout << "\n  * Refining the Eigenpairs in Double Precision" 
+                    << std::endl;
+
+        this->mixedPrec_ = false;
+        this->convCrit_  = conv;
+        startRefinement();
+        iMacro--;
+        continue;
+
+      }
+
       if( converged ) break;
 
       restart();
     }
 
+    this->mixedPrec_ = mixed;
+    this->convCrit_  = conv;
+
   }; // iterDiagonalizer::run 
 
 }; // namespace ChronusQ
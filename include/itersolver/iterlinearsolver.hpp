@@ -191,9 +191,15 @@ namespace ChronusQ {
       }
 
 
+      iBatch_ = iBatch;
       runBatch(nRHSDo,nOmegaDo,RHSBatch,&shiftBatch[0],SOLBatch,
           &rhsNorm_[iRHS]);
 
+      // FP64 refinement of the single precision solutions
+      if( this->mixedPrec_ )
+        refineBatch(nRHSDo,nOmegaDo,RHSBatch,&shiftBatch[0],SOLBatch,
+          &rhsNorm_[iRHS]);
+
 
       if( isRoot ) std::cout << "\n\n\n\n";
 
@@ -254,6 +260,88 @@ namespace ChronusQ {
 
 
 
+  /**
+   *  \brief Iterative refinement of the solutions of a batch.
+   *
+   *  The residuals R = B - (A - sI) X of the solutions of every shift are
+   *  formed in FP64 and, as long as the preconditioned residual has not
+   *  converged, the correction (A - sI) dX = R is solved by runBatch
+   *  (at most maxRefine times). SOL is in the layout of SOL_.
+   */
+  template <typename _F>
+  void IterLinearSolver<_F>::refineBatch(size_t nRHS, size_t nShift, 
+    _F* RHS, _F *shifts, _F* SOL, double *RHSNorm) {
+
+    bool isRoot = MPIRank(this->comm_) == 0;
+    const size_t N = this->N_;
+
+    _F *R  = isRoot ? this->memManager_.template malloc<_F>(nRHS * N) : nullptr;
+    _F *DX = isRoot ? this->memManager_.template malloc<_F>(N) : nullptr;
+
+    for(auto iS = 0ul; iS < nShift; iS++) {
+
+      _F *X = isRoot ? SOL + iS * nRHS_ * N : nullptr;
+
+      for(auto iRef = 0ul; iRef <= maxRefine; iRef++) {
+
+        // R <- B - (A - sI) X
+        this->linearTrans_(nRHS, X, R);
+
+        std::vector<int> doRef(nRHS, 0);
+        if( isRoot ) {
+
+          this->shiftVec_(nRHS, -shifts[iS], X, R);
+          for(auto iR = 0ul; iR < nRHS; iR++) {
+
+            _F *curR = R + iR * N;
+            blas::scal(N, _F(-1.), curR, 1);
+            blas::axpy(N, _F(1.), RHS + iR * N, 1, curR, 1);
+
+            this->preCondWShift_(1, shifts[iS], curR, DX);
+            double res = blas::nrm2(N, DX, 1) / RHSNorm[iR];
+
+            std::cout << "    * FP64 Refinement " << iRef << ": "
+              << "| RES(" << std::setw(4) << iR + iS * nRHS << ") | / | RHS |"
+              << " = " << std::scientific << std::setprecision(8) << res 
+              << "\n";
+
+            doRef[iR] = res >= this->convCrit_ and iRef < maxRefine;
+
+          }
+
+        }
+
+        if( MPISize(this->comm_) > 1 ) 
+          MPIBCast(doRef.data(), nRHS, 0, this->comm_);
+
+        if( std::none_of(doRef.begin(), doRef.end(), [](int x){ return x; }) )
+          break;
+
+        // X <- X + dX, (A - sI) dX = R
+        for(auto iR = 0ul; iR < nRHS; iR++) 
+        if( doRef[iR] ) {
+
+          runBatch(1, 1, isRoot ? R + iR * N : nullptr, shifts + iS, DX, 
+            RHSNorm + iR);
+
+          if( isRoot ) blas::axpy(N, _F(1.), DX, 1, X + iR * N, 1);
+
+        }
+
+      }
+
+      if( isRoot ) std::cout << "\n";
+
+    }
+
+    if( R  ) this->memManager_.free(R);
+    if( DX ) this->memManager_.free(DX);
+
+  }
+
+
+
+
 
 
 
@@ -0,0 +1,221 @@
+/*
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *
+ *  Copyright (C) 2014-2022 Li Research Group (University of Washington)
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *
+ */
+#pragma once
+
+#include <itersolver.hpp>
+#include <cqlinalg/blas1.hpp>
+#include <cqlinalg/blas3.hpp>
+#include <cqlinalg/ortho.hpp>
+
+namespace ChronusQ {
+
+  /// Rows of single precision vectors converted at once by subspaceGemm
+  constexpr size_t LowPRowBlock = 1024;
+
+  /**
+   *  \brief B = A for (M x N) matrices of (possibly) different precision
+   */
+  template <typename _FA, typename _FB>
+  void subspaceCopy(size_t M, size_t N, const _FA *A, size_t LDA, _FB *B,
+    size_t LDB) {
+
+    if( M == LDA and M == LDB )
+      std::transform(A, A + M*N, B, [](const _FA &x){ return _FB(x); });
+    else
+    for(auto j = 0ul; j < N; j++)
+      std::transform(A + j*LDA, A + j*LDA + M, B + j*LDB,
+        [](const _FA &x){ return _FB(x); });
+
+  }; // subspaceCopy
+
+
+  /**
+   *  \brief B = B + alpha A for (M x N) matrices, A of (possibly) another
+   *  precision than B
+   */
+  template <typename _F, typename _FA>
+  void subspaceAxpy(size_t M, size_t N, _F alpha, const _FA *A, size_t LDA,
+    _F *B, size_t LDB) {
+
+    if constexpr ( std::is_same<_FA,_F>::value ) {
+      if( M == LDA and M == LDB ) blas::axpy(M*N,alpha,A,1,B,1);
+      else
+      for(auto j = 0ul; j < N; j++) blas::axpy(M,alpha,A + j*LDA,1,B + j*LDB,1);
+    } else {
+      for(auto j = 0ul; j < N; j++)
+      for(auto i = 0ul; i < M; i++) B[i + j*LDB] += alpha * _F(A[i + j*LDA]);
+    }
+
+  }; // subspaceAxpy
+
+
+  /**
+   *  \brief C = alpha op(A) B + beta C, op(A) = A or A**H, for blocks of
+   *  vectors A and B which may be stored in single precision.
+   *
+   *  The vector dimension is the number of rows of A (m for op = NoTrans,
+   *  k otherwise). Single precision operands are converted to _F in
+   *  blocks of LowPRowBlock rows and multiplied by the BLAS3 of _F, i.e.
+   *  the products are accumulated in the precision of C. Operands of
+   *  precision _F are passed to the BLAS as they are.
+   */
+  template <typename _F, typename _FA, typename _FB>
+  void subspaceGemm(blas::Op opA, size_t m, size_t n, size_t k, _F alpha,
+    const _FA *A, size_t LDA, const _FB *B, size_t LDB, _F beta, _F *C,
+    size_t LDC) {
+
+    if constexpr ( std::is_same<_FA,_F>::value and
+                   std::is_same<_FB,_F>::value ) {
+
+      blas::gemm(blas::Layout::ColMajor,opA,blas::Op::NoTrans,m,n,k,alpha,
+        A,LDA,B,LDB,beta,C,LDC);
+
+    } else {
+
+      if( m == 0 or n == 0 ) return;
+
+      const bool   trans = opA != blas::Op::NoTrans;
+      const size_t NV    = trans ? k : m; // vector dimension
+      const size_t nA    = trans ? m : k; // number of vectors in A
+      const size_t NB    = std::min(NV, LowPRowBlock);
+
+      // Rows [i, i + nr) of X in the precision of _F
+      std::vector<_F> SCRA, SCRB;
+      auto rowBlock = [&](auto *X, size_t LDX, size_t nCol, size_t i,
+        size_t nr, std::vector<_F> &SCR, size_t &LD) -> const _F* {
+        if constexpr ( std::is_same<
+          typename std::remove_const<
+            typename std::remove_pointer<decltype(X)>::type>::type,
+          _F>::value ) {
+          LD = LDX;
+          return X + i;
+        } else {
+          if( SCR.size() < nr * nCol ) SCR.resize(nr * nCol);
+          subspaceCopy(nr,nCol,X + i,LDX,SCR.data(),nr);
+          LD = std::max(nr, size_t(1));
+          return SCR.data();
+        }
+      };
+
+      // Empty products: C = beta C
+      if( NV == 0 or (not trans and k == 0) ) {
+        for(auto j = 0ul; j < n; j++)
+          if( beta == _F(0.) ) std::fill_n(C + j*LDC, m, _F(0.));
+          else                 blas::scal(m,beta,C + j*LDC,1);
+        return;
+      }
+
+      if( not trans ) {
+
+        // B (k x n) is small, converted once
+        size_t LDBC;
+        const _F *BC = rowBlock(B,LDB,n,0,k,SCRB,LDBC);
+
+        for(auto i = 0ul; i < m; i += NB) {
+          size_t nr = std::min(NB, m - i), LDAC;
+          const _F *AC = rowBlock(A,LDA,nA,i,nr,SCRA,LDAC);
+          blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,
+            blas::Op::NoTrans,nr,n,k,alpha,AC,LDAC,BC,LDBC,beta,C + i,LDC);
+        }
+
+      } else {
+
+        // Sum over the row blocks of A and B
+        for(auto i = 0ul; i < k; i += NB) {
+          size_t nr = std::min(NB, k - i), LDAC, LDBC;
+          const _F *AC = rowBlock(A,LDA,nA,i,nr,SCRA,LDAC);
+          const _F *BC = rowBlock(B,LDB,n ,i,nr,SCRB,LDBC);
+          blas::gemm(blas::Layout::ColMajor,opA,blas::Op::NoTrans,
+            m,n,nr,alpha,AC,LDAC,BC,LDBC,i ? _F(1.) : beta,C,LDC);
+        }
+
+      }
+
+    }
+
+  }; // subspaceGemm
+
+
+
+
+  /**
+   *  \brief Switch the single precision storage of the subspace on / off.
+   *
+   *  lowPConv is the convergence criterion of the single precision phase
+   *  of the eigensolvers, it is bounded from below by the convergence
+   *  criterion of the solver.
+   */
+  template <typename _F>
+  void IterSolver<_F>::setMixedPrecision(bool mixed, double lowPConv) {
+
+    mixedPrec_ = mixed;
+    lowPConv_  = lowPConv;
+
+  }; // IterSolver::setMixedPrecision
+
+
+  /**
+   *  \brief Orthonormalize nNew (local) vectors V against nOld orthonormal
+   *  vectors VOld of another precision (e.g. the single precision
+   *  subspace) by two passes of classical Gram-Schmidt, followed by
+   *  the blocked orthonormalization of V.
+   *
+   *  The vectors of V are normalized first, those with a relative norm
+   *  below the accuracy of the single precision projection are dropped.
+   *
+   *  \returns the number of vectors kept, the leading columns of V
+   */
+  template <typename _F>
+  template <typename _FB>
+  size_t IterSolver<_F>::orthonormalize(size_t nOld, const _FB *VOld,
+    size_t LDVO, size_t nNew, _F *V, size_t LDV) {
+
+    const size_t NL = nLocal();
+    if( nNew == 0 ) return 0;
+
+    for(auto k = 0ul; k < nNew; k++) {
+      double nrm = distNorm(V + k*LDV);
+      if( nrm > 0. ) blas::scal(NL,_F(1./nrm),V + k*LDV,1);
+    }
+
+    if( nOld ) {
+
+      std::vector<_F> SCR(nOld * nNew);
+      for(auto iRe = 0; iRe < 2; iRe++) {
+        distInnerProd(nOld,nNew,VOld,LDVO,V,LDV,SCR.data());
+        subspaceGemm(blas::Op::NoTrans,NL,nNew,nOld,_F(-1.),VOld,LDVO,
+          SCR.data(),nOld,_F(1.),V,LDV);
+      }
+
+    }
+
+    return BlockGramSchmidt(NL,0,nNew,V,LDV,
+      [&](_F *Vc){ return _F(distNorm(Vc)); },
+      [&](size_t i, size_t j, _F *Vi, size_t LDVi, _F *Vj, size_t LDVj,
+        _F *inner){ distInnerProd(i,j,Vi,LDVi,Vj,LDVj,inner); },
+      memManager_,1,1e-6 / NL);
+
+  }; // IterSolver::orthonormalize
+
+}; // namespace ChronusQ
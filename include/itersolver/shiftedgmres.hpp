@@ -0,0 +1,710 @@
+/* 
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *  
+ *  Copyright (C) 2014-2022 Li Research Group (University of Washington)
+ *  
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *  
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *  
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *  
+ */
+#pragma once
+
+#include <itersolver.hpp>
+#include <itersolver/mixedprec.hpp>
+#include <cqlinalg/blas1.hpp>
+#include <cqlinalg/blas3.hpp>
+#include <util/math.hpp>
+#include <util/timer.hpp>
+
+#include <lapack.hh>
+
+namespace ChronusQ {
+
+  /**
+   *  \brief Apply the Givens rotations J(0:j) to the column c(0:j+1) and
+   *  form the rotation J(j) which annihilates c(j+1).
+   */
+  template <typename _F>
+  static inline void shiftedGivens(size_t j, _F *c, _F *J) {
+
+    for(auto i = 0ul; i < j; i++) {
+      _F tmp = c[i];
+      c[i]   = SmartConj(J[2*i]) * tmp + SmartConj(J[2*i+1]) * c[i+1];
+      c[i+1] = J[2*i] * c[i+1] - J[2*i+1] * tmp;
+    }
+
+    double rho = blas::nrm2(2,c + j,1);
+    if( rho < std::numeric_limits<double>::min() ) {
+      J[2*j] = 1.; J[2*j+1] = 0.;
+    } else {
+      J[2*j]   = c[j]   / rho;
+      J[2*j+1] = c[j+1] / rho;
+    }
+
+    c[j]   = rho;
+    c[j+1] = 0.;
+
+  }
+
+  /**
+   *  \brief y = argmin | gamma e1 - (H - s I) y | for the leading d
+   *  columns of the (LDH x d) Hessenberg matrix H
+   */
+  template <typename _F>
+  static void shiftedLeastSquares(size_t d, const _F *H, size_t LDH, _F s,
+    _F gamma, _F *y) {
+
+    std::vector<_F> R((d+1)*d), g(d+1,_F(0.)), J(2*d);
+    g[0] = gamma;
+
+    for(auto j = 0ul; j < d; j++) {
+      _F *c = &R[j*(d+1)];
+      std::copy_n(H + j*LDH, j+2, c);
+      c[j] -= s;
+
+      shiftedGivens(j,c,&J[0]);
+
+      g[j+1] = -J[2*j+1] * g[j];
+      g[j]   = SmartConj(J[2*j]) * g[j];
+    }
+
+    // Back substitution
+    for(int i = d-1; i >= 0; i--) {
+      _F tmp = g[i];
+      for(size_t k = i+1; k < d; k++) tmp -= R[i + k*(d+1)] * y[k];
+      y[i] = tmp / R[i + i*(d+1)];
+    }
+
+  }
+
+
+  template <typename _F>
+  void ShiftedGMRES<_F>::runBatch(size_t nRHS, size_t nShift, _F* RHS, 
+    _F *shifts, _F* SOL, double *RHSNorm ) {
+
+    bool isRoot = MPIRank(this->comm_) == 0;
+
+    auto topGMRES = tick();
+
+    const size_t N    = this->N_;
+    const size_t MSS  = this->mSS_;
+    const size_t LDH  = MSS + 1;
+    const size_t nDo  = nRHS * nShift;
+
+    // Index of (RHS, shift) pairs as in GMRES
+    auto iDo = [&](size_t iR, size_t iS) { return iR + iS*nRHS; };
+
+    auto solPtr = [&](size_t iR, size_t iS) {
+      return SOL + (iR + iS*this->nRHS_)*N;
+    };
+
+    // Per RHS: Krylov basis (FP64 or FP32 storage), Hessenberg matrix
+    const bool lowP = VL_ != nullptr;
+    auto hess  = [&](size_t iR) { return H_ + iR*LDH*MSS; };
+
+    auto loadVec = [&](size_t iR, size_t k, _F *X) {
+      if( lowP ) subspaceCopy(N,1,VL_ + (k + iR*LDH)*N,N,X,N);
+      else       std::copy_n(this->V_ + (k + iR*LDH)*N, N, X);
+    };
+
+    auto storeVec = [&](size_t iR, size_t k, const _F *X) {
+      if( lowP ) subspaceCopy(N,1,X,N,VL_ + (k + iR*LDH)*N,N);
+      else       std::copy_n(X, N, this->V_ + (k + iR*LDH)*N);
+    };
+
+    // x = beta * x + alpha * V(:,0:m) y  /  h = V(:,0:m)^H w
+    auto basisN = [&](size_t iR, size_t m, _F alpha, const _F *y, _F beta,
+      _F *x) {
+      const size_t LDY = std::max(m, size_t(1));
+      if( lowP ) 
+        subspaceGemm(blas::Op::NoTrans,N,1,m,alpha,VL_ + iR*N*LDH,N,y,LDY,
+          beta,x,N);
+      else       
+        subspaceGemm(blas::Op::NoTrans,N,1,m,alpha,this->V_ + iR*N*LDH,N,y,
+          LDY,beta,x,N);
+    };
+
+    auto basisC = [&](size_t iR, size_t m, const _F *w, _F *h) {
+      if( lowP ) 
+        subspaceGemm(blas::Op::ConjTrans,m,1,N,_F(1.),VL_ + iR*N*LDH,N,w,N,
+          _F(0.),h,std::max(m, size_t(1)));
+      else
+        subspaceGemm(blas::Op::ConjTrans,m,1,N,_F(1.),this->V_ + iR*N*LDH,N,
+          w,N,_F(0.),h,std::max(m, size_t(1)));
+    };
+
+    std::vector<_F>     gamma(nDo,0.);   // r(s) = gamma(s) * v0
+    std::vector<double> res(nDo,0.);     // current residual norms
+    std::vector<bool>   solConv(nDo,false);
+    std::vector<bool>   detached(nDo,false); // collinear residual grew
+    std::vector<size_t> convDim(nDo,0);  // dimension at convergence
+    std::vector<size_t> mDim(nRHS,0);
+    std::vector<bool>   rhsActive(nRHS,false);
+
+    auto isDone = [&](size_t ID) { return solConv[ID] or detached[ID]; };
+
+    size_t nDetach = 0; // shifts solved individually after the cycles
+
+    this->resNorm_.clear();
+
+    // Zero guess, v0 = b / |b|
+    if( isRoot ) {
+
+      for(auto iR = 0ul; iR < nRHS; iR++) {
+        for(auto iS = 0ul; iS < nShift; iS++)
+          std::fill_n(solPtr(iR,iS),N,_F(0.));
+
+        _F *v0 = this->RES_;
+        std::copy_n(RHS + iR*N,N,v0);
+        double nrm = Normalize(N,v0,1);
+        storeVec(iR,0,v0);
+
+        for(auto iS = 0ul; iS < nShift; iS++) {
+          gamma[iDo(iR,iS)]   = nrm;
+          res[iDo(iR,iS)]     = nrm;
+          solConv[iDo(iR,iS)] = nrm / RHSNorm[iR] < this->convCrit_ or
+                                nrm == 0.;
+        }
+      }
+
+      this->resNorm_.emplace_back(res);
+
+      std::cout << "    * Shifted GMRES: one Krylov subspace per RHS for " 
+                << nShift << " shifts\n";
+      if( lowP ) 
+        std::cout << "    * Krylov subspace stored in single precision\n";
+      std::cout << "    * Starting Shifted GMRES iterations\n\n";
+
+    }
+
+    // Checkpoint of the batch: solutions, start vectors and collinear
+    // factors of the current cycle, and the state of every system 
+    // (0 = active, 1 = converged, 2 = detached, 3 = converged in FP64).
+    // The solves of detached shifts overwrite the start vectors, the
+    // unconverged systems are saved as detached then
+    const bool useChk = this->chkFile_ and not refining_;
+    const std::string chkBatch = "BATCH" + std::to_string(this->iBatch_) + "/";
+
+    auto saveState = [&](bool final) {
+
+      std::vector<_F> X(nDo*N), V0(nRHS*N), gam(gamma);
+      std::vector<double> state(nDo);
+
+      for(auto iR = 0ul; iR < nRHS; iR++) {
+        loadVec(iR, 0, &V0[iR*N]);
+        for(auto iS = 0ul; iS < nShift; iS++) {
+          size_t ID = iDo(iR,iS);
+          std::copy_n(solPtr(iR,iS), N, &X[ID*N]);
+          if( final and solConv[ID] ) gam[ID] = res[ID];
+          state[ID] = solConv[ID] ? (final ? 3. : 1.) : 
+                      ((detached[ID] or nDetach) ? 2. : 0.);
+        }
+      }
+
+      this->chkInvalidate();
+      this->chkSave(chkBatch + "SOLUTION", X.data(), {nDo,N});
+      this->chkSave(chkBatch + "START", V0.data(), {nRHS,N});
+      this->chkSave(chkBatch + "GAMMA", gam.data(), {nDo});
+      this->chkSave(chkBatch + "STATE", state.data(), {nDo});
+      this->chkValidate();
+
+    };
+
+    // Resume a batch of the same problem at the last checkpoint, the 
+    // solutions of another problem are only used as initial guesses
+    // (solved individually as detached shifts)
+    int chkMode = 0; // 1 = resume, 2 = seed, 3 = finished
+    if( useChk and this->chkRead_ ) {
+
+      if( isRoot ) {
+
+        std::vector<_F> X(nDo*N), V0(nRHS*N), gam(nDo);
+        std::vector<double> state(nDo);
+
+        if( this->chkLoad(chkBatch + "SOLUTION", X.data(), {nDo,N}) ) {
+
+          for(auto iR = 0ul; iR < nRHS; iR++) 
+          for(auto iS = 0ul; iS < nShift; iS++) 
+            std::copy_n(&X[iDo(iR,iS)*N], N, solPtr(iR,iS));
+
+          bool match = this->chkKeyMatch() and
+            this->chkLoad(chkBatch + "START", V0.data(), {nRHS,N}) and
+            this->chkLoad(chkBatch + "GAMMA", gam.data(), {nDo}) and
+            this->chkLoad(chkBatch + "STATE", state.data(), {nDo});
+
+          if( match ) {
+
+            for(auto iR = 0ul; iR < nRHS; iR++) storeVec(iR, 0, &V0[iR*N]);
+
+            for(auto ID = 0ul; ID < nDo; ID++) {
+              gamma[ID]    = gam[ID];
+              res[ID]      = std::abs(gam[ID]);
+              solConv[ID]  = state[ID] == 1. or state[ID] == 3.;
+              detached[ID] = state[ID] == 2.;
+            }
+
+            chkMode = std::all_of(state.begin(), state.end(), 
+              [](double x){ return x == 3.; }) ? 3 : 1;
+
+          } else chkMode = 2;
+
+          std::cout << "    * " << (chkMode == 2 ? "Seeding with" : 
+            "Resuming from") << " the Solutions of " << this->chkPrefix_ 
+            << "/" << chkBatch << "\n\n";
+
+        }
+
+      }
+
+      if( MPISize(this->comm_) > 1 ) MPIBCast(chkMode,0,this->comm_);
+
+    }
+
+    // A seed which solves the system is kept, the other systems start
+    // from zero to keep the residuals collinear
+    if( chkMode == 2 )
+    for(auto iS = 0ul; iS < nShift; iS++) {
+
+      this->linearTrans_(nRHS, isRoot ? solPtr(0,iS) : nullptr,
+        isRoot ? this->AV_ : nullptr);
+
+      if( isRoot )
+      for(auto iR = 0ul; iR < nRHS; iR++) {
+
+        size_t ID = iDo(iR,iS);
+        _F *X  = solPtr(iR,iS);
+        _F *AX = this->AV_ + iR*N;
+
+        for(auto i = 0ul; i < N; i++)
+          AX[i] = RHS[i + iR*N] - AX[i] + shifts[iS] * X[i];
+
+        double resSeed = blas::nrm2(N,AX,1);
+        if( resSeed / RHSNorm[iR] < this->convCrit_ ) {
+          solConv[ID] = true;
+          res[ID]     = resSeed;
+        } else std::fill_n(X,N,_F(0.));
+
+      }
+
+    }
+
+    bool isConverged = chkMode == 3;
+    size_t iMacro = 0, nIter = 0;
+
+    // The detached shifts solved by the nested runBatch draw from the
+    // same budget, so that MAXITER bounds the total number of iterations
+    if( not refining_ ) iterLeft_ = maxIter ? maxIter : this->maxMacroIter_ * MSS;
+
+    for(iMacro = 0; iterLeft_ > 0 and not isConverged; iMacro++) {
+
+      // Start a cycle: G(s) = gamma(s) e1
+      if( isRoot ) {
+
+        std::fill_n(H_, LDH*MSS*nRHS, _F(0.));
+        std::fill_n(G_, LDH*nDo, _F(0.));
+        std::fill_n(convDim.begin(), nDo, 0);
+
+        for(auto iR = 0ul; iR < nRHS; iR++) {
+          rhsActive[iR] = false;
+          mDim[iR] = 0;
+          for(auto iS = 0ul; iS < nShift; iS++) {
+            G_[iDo(iR,iS)*LDH] = gamma[iDo(iR,iS)];
+            rhsActive[iR] = rhsActive[iR] or not isDone(iDo(iR,iS));
+          }
+        }
+
+        if( iMacro > 0 ) 
+          std::cout << "\n      * Restarting Shifted GMRES\n\n";
+
+      }
+
+
+      for(auto j = 0ul; j < MSS and iterLeft_ > 0;
+          j++, nIter++, nIterTotal_++, iterLeft_--) {
+
+        ProgramTimer::tick("Lin Solve Iter");
+        auto topMicro = tick();
+
+        // Gather the last basis vector of the active RHS
+        size_t nContract = 0;
+        if( isRoot )
+        for(auto iR = 0ul; iR < nRHS; iR++) 
+        if( rhsActive[iR] ) {
+          loadVec(iR, j, this->RES_ + nContract*N);
+          nContract++;
+        }
+
+        if( MPISize(this->comm_) > 1 ) MPIBCast(nContract,0,this->comm_);
+        if( nContract == 0 ) {
+          ProgramTimer::tock("Lin Solve Iter");
+          break;
+        }
+
+        // Form A V product: one per RHS for all the shifts
+        MPI_Barrier(this->comm_);
+        auto topLT = tick();
+
+        this->linearTrans_(nContract, isRoot ? this->RES_ : nullptr,
+          isRoot ? this->AV_ : nullptr);
+
+        double durLT = tock(topLT);
+        MPI_Barrier(this->comm_);
+
+
+        if( isRoot ) {
+
+          size_t iContract = 0;
+          for(auto iR = 0ul; iR < nRHS; iR++) {
+
+            if( not rhsActive[iR] ) continue;
+
+            _F *H  = hess(iR) + j*LDH;
+            _F *w  = this->AV_ + (iContract++)*N;
+            _F *h  = this->RES_; // RES_ is free after the product
+
+            // Arnoldi with classical Gram-Schmidt and reorthogonalization
+            for(auto iRe = 0; iRe < 2; iRe++) {
+              basisC(iR,j+1,w,h);
+              basisN(iR,j+1,_F(-1.),h,_F(1.),w);
+              for(auto k = 0ul; k <= j; k++) H[k] += h[k];
+            }
+
+            H[j+1] = blas::nrm2(N,w,1);
+            bool breakDown = std::abs(H[j+1]) < 
+              std::numeric_limits<double>::epsilon() * blas::nrm2(j+1,H,1);
+
+            if( breakDown ) H[j+1] = 0.;
+            else {
+              blas::scal(N,_F(1.)/H[j+1],w,1);
+              storeVec(iR,j+1,w);
+            }
+
+            mDim[iR] = j+1;
+
+            // Update the QR factorization of every unconverged shift
+            std::vector<_F> c(j+2);
+            bool allConv = true;
+            for(auto iS = 0ul; iS < nShift; iS++) {
+
+              size_t ID = iDo(iR,iS);
+              if( isDone(ID) or convDim[ID] ) continue;
+
+              _F *curJ = J_ + ID*2*MSS;
+              _F *curG = G_ + ID*LDH;
+
+              std::copy_n(H,j+2,c.begin());
+              c[j] -= shifts[iS];
+              shiftedGivens(j,&c[0],curJ);
+
+              curG[j+1] = -curJ[2*j+1] * curG[j];
+              curG[j]   = SmartConj(curJ[2*j]) * curG[j];
+
+              res[ID] = std::abs(curG[j+1]);
+              if( res[ID] / RHSNorm[iR] < this->convCrit_ or breakDown )
+                convDim[ID] = j+1;
+              else
+                allConv = false;
+
+            }
+
+            // Done with this RHS for the current cycle
+            if( allConv or breakDown ) rhsActive[iR] = false;
+
+          } // loop over RHS
+
+          this->resNorm_.emplace_back(res);
+
+          size_t nConv = 0;
+          for(auto ID = 0ul; ID < nDo; ID++)
+            if( solConv[ID] or convDim[ID] ) nConv++;
+
+          double maxRel = 0.;
+          for(auto ID = 0ul; ID < nDo; ID++)
+            if( not (isDone(ID) or convDim[ID]) )
+              maxRel = std::max(maxRel, res[ID] / RHSNorm[ID % nRHS]);
+
+          double durMicro = tock(topMicro);
+
+          std::cout << "      ShiftedGMRESIter " << std::setw(5) << nIter+1
+            << "  :  NCONV = " << std::setw(6) << nConv << " / " << nDo
+            << "  MaxRelResNorm = " << std::scientific 
+            << std::setprecision(8) << maxRel
+            << "  DURATION = " << durMicro << " s ( " << std::fixed 
+            << durLT * 100. / durMicro << "% LT )\n";
+
+        }
+
+        ProgramTimer::tock("Lin Solve Iter");
+
+      } // Arnoldi steps
+
+
+
+      // Update the solutions at the end of the cycle
+      if( isRoot ) {
+
+        std::vector<_F> y(MSS+1), z(LDH), A(LDH*LDH);
+        std::vector<int64_t> IPIV(LDH);
+
+        for(auto iR = 0ul; iR < nRHS; iR++) {
+
+          size_t m = mDim[iR];
+          if( m == 0 ) continue;
+
+          _F *H = hess(iR);
+
+          // Shifts converged within the cycle take their GMRES update
+          int iSeed = -1;
+          for(auto iS = 0ul; iS < nShift; iS++) {
+
+            size_t ID = iDo(iR,iS);
+            if( isDone(ID) ) continue;
+
+            if( convDim[ID] ) {
+              shiftedLeastSquares(convDim[ID],H,LDH,shifts[iS],gamma[ID],
+                &y[0]);
+              basisN(iR,convDim[ID],_F(1.),&y[0],_F(1.),solPtr(iR,iS));
+              solConv[ID] = true;
+            } else if( iSeed < 0 or res[ID] > res[iDo(iR,iSeed)] )
+              iSeed = iS;
+
+          }
+
+          if( iSeed < 0 ) continue;
+
+          // Seed: GMRES update, new residual r = V z
+          size_t IDS = iDo(iR,iSeed);
+          shiftedLeastSquares(m,H,LDH,shifts[iSeed],gamma[IDS],&y[0]);
+          basisN(iR,m,_F(1.),&y[0],_F(1.),solPtr(iR,iSeed));
+
+          std::fill_n(z.begin(),m+1,_F(0.));
+          z[0] = gamma[IDS];
+          blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,
+            blas::Op::NoTrans,m+1,1,m,_F(-1.),H,LDH,&y[0],m,_F(1.),&z[0],m+1);
+          for(auto k = 0ul; k < m; k++) z[k] += shifts[iSeed] * y[k];
+
+          double zNorm = blas::nrm2(m+1,&z[0],1);
+          blas::scal(m+1,_F(1./zNorm),&z[0],1);
+
+          gamma[IDS] = zNorm;
+          res[IDS]   = zNorm;
+
+          // Other shifts: [ H - sI | z ] [ y ; gamma' ] = gamma e1
+          //
+          // Collinear restarts are not guaranteed to reduce the residual
+          // of the other shifts (e.g. for indefinite A - sI). A shift
+          // whose residual would grow takes its own GMRES update of the
+          // cycle and is detached from the shared subspace.
+          auto detach = [&](size_t iS, size_t ID) {
+            shiftedLeastSquares(m,H,LDH,shifts[iS],gamma[ID],&y[0]);
+            basisN(iR,m,_F(1.),&y[0],_F(1.),solPtr(iR,iS));
+            detached[ID] = true;
+          };
+
+          for(auto iS = 0ul; iS < nShift; iS++) {
+
+            size_t ID = iDo(iR,iS);
+            if( isDone(ID) or ID == IDS ) continue;
+
+            if( not collinearRestart ) {
+              detach(iS,ID);
+              continue;
+            }
+
+            std::fill_n(A.begin(),(m+1)*(m+1),_F(0.));
+            for(auto k = 0ul; k < m; k++) {
+              std::copy_n(H + k*LDH, m+1, &A[k*(m+1)]);
+              A[k + k*(m+1)] -= shifts[iS];
+            }
+            std::copy_n(z.begin(),m+1,&A[m*(m+1)]);
+
+            std::fill_n(y.begin(),m+1,_F(0.));
+            y[0] = gamma[ID];
+            lapack::gesv(m+1,1,&A[0],m+1,&IPIV[0],&y[0],m+1);
+
+            if( std::abs(y[m]) > std::abs(gamma[ID]) ) {
+              detach(iS,ID);
+              continue;
+            }
+
+            basisN(iR,m,_F(1.),&y[0],_F(1.),solPtr(iR,iS));
+
+            gamma[ID] = y[m];
+            res[ID]   = std::abs(y[m]);
+
+          }
+
+          // New start vector v0 = V z
+          basisN(iR,m+1,_F(1.),&z[0],_F(0.),this->RES_);
+          storeVec(iR,0,this->RES_);
+
+          for(auto iS = 0ul; iS < nShift; iS++) {
+            size_t ID = iDo(iR,iS);
+            if( not isDone(ID) ) 
+              solConv[ID] = res[ID] / RHSNorm[iR] < this->convCrit_;
+          }
+
+        } // loop over RHS
+
+        isConverged = true;
+        for(auto ID = 0ul; ID < nDo; ID++)
+          isConverged = isConverged and isDone(ID);
+
+        if( useChk and this->chkDue(iMacro) and not isConverged ) 
+          saveState(false);
+
+      }
+
+      // Broadcast the convergence result to all the mpi processes
+      if(MPISize(this->comm_) > 1) MPIBCast(isConverged,0,this->comm_);
+
+    } // Restart cycles
+
+
+    // Mixed precision: the single precision basis limits the accuracy
+    // of the updates, verify the solutions by their FP64 residuals and
+    // refine the ones which did not converge below
+    if( lowP and not refining_ and chkMode != 3 ) {
+
+      for(auto iS = 0ul; iS < nShift; iS++) {
+
+        this->linearTrans_(nRHS, isRoot ? solPtr(0,iS) : nullptr,
+          isRoot ? this->AV_ : nullptr);
+
+        if( isRoot )
+        for(auto iR = 0ul; iR < nRHS; iR++) {
+
+          size_t ID = iDo(iR,iS);
+          _F *X  = solPtr(iR,iS);
+          _F *AX = this->AV_ + iR*N;
+
+          for(auto i = 0ul; i < N; i++)
+            AX[i] = RHS[i + iR*N] - AX[i] + shifts[iS] * X[i];
+
+          res[ID]      = blas::nrm2(N,AX,1);
+          solConv[ID]  = res[ID] / RHSNorm[iR] < this->convCrit_;
+          detached[ID] = not solConv[ID];
+
+        }
+
+      }
+
+    }
+
+
+    // Detached shifts: restarted GMRES for the residual system
+    // (A - sI) dX = B - (A - sI) X of each of them. With single precision
+    // bases this is repeated (iterative refinement) up to maxRefine times
+    nDetach = std::count(detached.begin(),detached.end(),true);
+    if( MPISize(this->comm_) > 1 ) MPIBCast(nDetach,0,this->comm_);
+
+    if( nDetach > 0 ) {
+
+      if( not refining_ ) nDetached_ += nDetach;
+
+      if( isRoot )
+        std::cout << "\n    * Solving " << nDetach 
+                  << " Detached Shifts Individually\n\n";
+
+      auto history = this->resNorm_;
+      std::vector<_F> R0(isRoot ? N : 0), DX(isRoot ? N : 0);
+
+      bool wasRefining = refining_;
+      refining_ = true;
+
+      const size_t nRefine = lowP ? this->maxRefine : 1;
+
+      for(auto ID = 0ul, k = 0ul; k < nDetach; k++, ID++) {
+
+        if( isRoot ) while( not detached[ID] ) ID++;
+        if( MPISize(this->comm_) > 1 ) MPIBCast(ID,0,this->comm_);
+
+        size_t iR = ID % nRHS;
+        size_t iS = ID / nRHS;
+        _F *X = isRoot ? solPtr(iR,iS) : nullptr;
+
+        for(auto iRef = 0ul; ; iRef++) {
+
+          this->linearTrans_(1, X, isRoot ? this->AV_ : nullptr);
+
+          bool done = false;
+          if( isRoot ) {
+
+            for(auto i = 0ul; i < N; i++)
+              R0[i] = RHS[i + iR*N] - this->AV_[i] + shifts[iS] * X[i];
+
+            res[ID]     = blas::nrm2(N,R0.data(),1);
+            solConv[ID] = res[ID] / RHSNorm[iR] < this->convCrit_;
+            done        = solConv[ID] or iRef == nRefine or iterLeft_ == 0;
+
+          }
+
+          if( MPISize(this->comm_) > 1 ) MPIBCast(done,0,this->comm_);
+          if( done ) break;
+
+          runBatch(1,1,R0.data(),shifts + iS,DX.data(),RHSNorm + iR);
+
+          if( isRoot ) {
+            blas::axpy(N,_F(1.),DX.data(),1,X,1);
+            history.insert(history.end(),this->resNorm_.begin(),
+              this->resNorm_.end());
+          }
+
+        }
+
+        if( isRoot ) detached[ID] = false;
+
+      }
+
+      refining_ = wasRefining;
+      this->resNorm_ = history;
+
+    }
+
+    if( isRoot ) {
+
+      isConverged = std::all_of(solConv.begin(),solConv.end(),
+        [&](bool x){ return x; });
+
+      if( useChk and this->chkWrite() and chkMode != 3 ) saveState(true);
+
+    }
+
+
+    double durGMRES = tock(topGMRES);
+
+    if( isRoot ) {
+
+      std::cout << "\n    * Shifted GMRES ";
+      if( isConverged ) std::cout << "Converged";
+      else              std::cout << "Failed to Converge";
+      std::cout << " in " << nIter << " Iterations (" << durGMRES 
+                << " s) \n\n";
+
+      for(auto ID = 0ul; ID < nDo; ID++)
+        std::cout << "        iDo = " << std::setw(6) << ID
+          << "  ResNorm = " << std::scientific << std::setprecision(8) 
+          << res[ID] << "  RelResNorm = " << res[ID] / RHSNorm[ID % nRHS] 
+          << "\n";
+
+      std::cout << "\n";
+
+    }
+
+  }; // ShiftedGMRES::runBatch
+
+};
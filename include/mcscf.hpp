@@ -52,6 +52,11 @@ namespace ChronusQ {
      size_t maxDavidsonSpace = 50;
      size_t nDavidsonGuess   = 3;
 
+     // Davidson checkpoints (binary file)
+     size_t ciChkInterval    = 0;     ///< Iterations between checkpoints (0 = off)
+     bool   ciChkRestart     = false; ///< Resume / seed from the checkpoint
+     bool   ciMixedPrec      = false; ///< Single precision Davidson subspace
+
      // SCF Settings 
      bool   doSCF              = false;
      bool   doIVOs             = false;
@@ -82,9 +87,15 @@ namespace ChronusQ {
     double vectorConv_ = 1.0e-6;    /// < Convergence criteria in terms of vector residue norm
     size_t maxDavidsonSpace_ = 50;  /// < Max davidson space in terms of n times of NRoots  
     size_t nDavidsonGuess_ = 3;     /// < number of guess in the intial davidson first a few iterations 
+    size_t chkInterval_ = 0;        /// < Davidson iterations between checkpoints
+    bool   chkRestart_  = false;    /// < Resume / seed davidson from the checkpoint
+    bool   mixedPrec_   = false;    /// < Davidson subspace in single precision
 
     void davidsonGS(size_t, size_t, MatsT *, MatsT *);
     void davidsonPC(size_t, size_t, MatsT *, MatsT *, MatsT *, dcomplex *);
+
+    void diagonalize(MCWaveFunction<MatsT,IntsT> &, CIDiagonalizationAlgorithm);
+    void solveSelectedCI(MCWaveFunction<MatsT,IntsT> &);
   
   public:
     
@@ -120,6 +131,15 @@ namespace ChronusQ {
         nDavidsonGuess_ = nDGuess;
     }
 
+    // Davidson checkpoints in the binary file
+    void setCheckpoint(size_t interval, bool restart) {
+        chkInterval_ = interval;
+        chkRestart_  = restart;
+    }
+
+    // Single precision Davidson subspace
+    void setMixedPrecision(bool mixed) { mixedPrec_ = mixed; }
+
     // solve CI
 	void solveCI(MCWaveFunction<MatsT,IntsT> &);
   
@@ -174,6 +194,7 @@ namespace ChronusQ {
     void computeOneRDM(size_t);
     void computeTwoRDM();
     void computeTwoRDM(size_t);
+    void computeRDMs();
 
     void saveCurrentStates();
 
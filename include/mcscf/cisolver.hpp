@@ -26,6 +26,7 @@
 #include <mcscf.hpp>
 #include <cibuilder/casci/impl.hpp>
 #include <cibuilder/rasci/impl.hpp>
+#include <cibuilder/selectedci/impl.hpp>
 #include <cqlinalg/eig.hpp>
 #include <itersolver.hpp>
 
@@ -53,6 +54,26 @@ namespace ChronusQ {
 
   template <typename MatsT, typename IntsT>
   void CISolver<MatsT, IntsT>::solveCI(MCWaveFunction<MatsT, IntsT> & mcwfn) {
+
+    // the batched TDMs belong to the previous CI vectors
+    mcwfn.TDMs.clear();
+
+    if (mcwfn.MOPartition.scheme == SCI) solveSelectedCI(mcwfn);
+    else diagonalize(mcwfn, alg_);
+
+    // add other parts of the energy 
+    double EOther = mcwfn.reference().molecule().nucRepEnergy + mcwfn.InactEnergy;
+    for (auto i = 0ul; i < mcwfn.NStates; i++) mcwfn.StateEnergy[i] += EOther;
+  
+  } // CISolver::solveCI
+
+  /*
+   * \brief Diagonalize the CI Hamiltonian of the current determinant
+   * space with the given algorithm
+   */
+  template <typename MatsT, typename IntsT>
+  void CISolver<MatsT, IntsT>::diagonalize(MCWaveFunction<MatsT, IntsT> & mcwfn,
+    CIDiagonalizationAlgorithm alg) {
     
 	size_t NDet = mcwfn.NDet;
     size_t nR   = mcwfn.NStates;
@@ -60,7 +81,7 @@ namespace ChronusQ {
     auto & CIVecs = mcwfn.CIVecs;
 	auto & mem    = mcwfn.memManager;
 
-    if (alg_ == CI_FULL_MATRIX) {
+    if (alg == CI_FULL_MATRIX) {
       
       std::cout << "  Diagonalize CI Full Hamitonian Matrix ... \n" << std::endl;
       dcomplex * Energy = mem.template malloc<dcomplex>(NDet); 
@@ -95,8 +116,33 @@ namespace ChronusQ {
 	  }
 	  mem.free(Energy, fullH, EigVec);
 
-    } else if (alg_ == CI_DAVIDSON) {
+    } else if (alg == CI_DAVIDSON) {
       
+      // CASCI sigma is distributed over the MPI processes by blocks of
+      // strings, the other builders run on the root process only. For
+      // the distributed sigma the Davidson vectors are distributed by
+      // rows as well, so that only the sigma build sees full vectors.
+      // Spaces with fewer determinants than processes keep the vectors
+      // on the root (see IterSolver::setDistributed), the sigma build
+      // still involves every process
+      bool distSigma = MPISize(mcwfn.comm) > 1 and
+        std::dynamic_pointer_cast<CASCI<MatsT,IntsT>>(mcwfn.ciBuilder);
+      bool isRoot = MPIRank(mcwfn.comm) == 0;
+
+#ifdef CQ_ENABLE_MPI
+      // The correlated space integrals are transformed (and the orbitals
+      // updated) on the root process only
+      if (distSigma) {
+        auto & hCoreP = *(mcwfn.moints.template
+          getIntegral<OnePInts,MatsT>("hCoreP_Correlated_Space"));
+        auto & moERI  = *(mcwfn.moints.template
+          getIntegral<InCore4indexTPI,MatsT>("ERI_Correlated_Space"));
+        size_t nO = moERI.nBasis();
+        MPIBCast(hCoreP.pointer(), nO * nO, 0, mcwfn.comm);
+        MPIBCast(moERI.pointer(), nO * nO * nO * nO, 0, mcwfn.comm);
+      }
+#endif
+
       // build diagonal H
       MatsT  * diagH  = mem.template malloc<MatsT>(NDet); 
       mcwfn.ciBuilder->buildDiagH(mcwfn, diagH);
@@ -115,16 +161,42 @@ namespace ChronusQ {
       using LinearTrans_t = typename IterDiagonalizer<MatsT>::LinearTrans_t;
       
       // define linear transformation
+      Davidson<MatsT> * dav = nullptr;
+
       LinearTrans_t func = [&] (size_t nVec, MatsT * V, MatsT * AV) {
           
 #ifdef CQ_ENABLE_MPI
-	    // disable MPI for now
-	    ROOT_ONLY(mcwfn.comm);
+        if (not distSigma) ROOT_ONLY(mcwfn.comm);
 #endif
-        
-        ProgramTimer::tick("Sigma");
-	    mcwfn.ciBuilder->buildSigma(mcwfn, nVec, V, AV);
-        ProgramTimer::tock("Sigma");
+
+        if (not distSigma) {
+          ProgramTimer::tick("Sigma");
+	      mcwfn.ciBuilder->buildSigma(mcwfn, nVec, V, AV);
+          ProgramTimer::tock("Sigma");
+          return;
+        }
+
+        // every process receives the full trial vectors one at a time
+        // and accumulates its share of sigma locally, so that only two
+        // full vectors live on every process next to the local rows
+        // (V and AV are only allocated on the root for replicated vectors)
+        size_t NL = dav->nLocal();
+        bool hasLocal = dav->distributed() or isRoot;
+        MatsT * VFull  = mem.template malloc<MatsT>(NDet);
+        MatsT * AVFull = mem.template malloc<MatsT>(NDet);
+
+        for (auto k = 0ul; k < nVec; k++) {
+          dav->gatherVectors(1, hasLocal ? V + k * NL : nullptr, VFull, true);
+
+          ProgramTimer::tick("Sigma");
+	      mcwfn.ciBuilder->buildSigma(mcwfn, 1, VFull, AVFull);
+          ProgramTimer::tock("Sigma");
+
+          // Sum the partial sigmas and keep the local rows
+          dav->reduceScatterVectors(1, AVFull, hasLocal ? AV + k * NL : nullptr);
+        }
+
+        mem.free(VFull, AVFull);
       
       }; 
       
@@ -132,45 +204,163 @@ namespace ChronusQ {
       LinearTrans_t PC = [&] (size_t nVec, MatsT * S, MatsT *R) {
 
 #ifdef CQ_ENABLE_MPI
-	    // disable MPI for now
-	    ROOT_ONLY(mcwfn.comm);
+        if (not dav->distributed()) ROOT_ONLY(mcwfn.comm);
 #endif
-	    this->davidsonPC(nVec, NDet, S, R, diagH, curEig);
+	    this->davidsonPC(nVec, dav->nLocal(), S, R,
+          diagH + dav->rowOffset(), curEig);
       }; 
       
       std::cout << "  Use Davidson Diagonalization ... \n" << std::endl;
 
       Davidson<MatsT> davidson(mcwfn.comm, mem, NDet, 5, maxIter_,
         vectorConv_, nR, func, PC);
+      dav = &davidson;
        
       davidson.setM(m);
       davidson.setkG(kG);
+      davidson.setDistributed(distSigma);
       davidson.setEigForT(curEig);
+      davidson.setMixedPrecision(mixedPrec_);
       davidson.setGuess(nG, [&] (size_t nGuess, MatsT * Guess, size_t N) {
 	    this->davidsonGS(nGuess, N, diagH, Guess);
       });
 
+      // The state of a previous run is resumed only for the same
+      // Hamiltonian (checksums of its diagonal), otherwise it seeds the
+      // guess, e.g. from the previous MCSCF iteration or geometry
+      if ((chkInterval_ or chkRestart_) and mcwfn.savFile.exists()) {
+        double dSum = 0., dMom = 0.;
+        for (auto i = 0ul; i < NDet; i++) {
+          dSum += std::real(diagH[i]);
+          dMom += (i % 97 + 1) * std::real(diagH[i]);
+        }
+        davidson.setCheckpoint(mcwfn.savFile, "MCWFN/CI/DAVIDSON",
+          chkInterval_, chkRestart_, { double(nR), dSum, dMom });
+      }
+
       davidson.run();
       
       // copy over eigenvalues and eigenvectors
-      auto davidsonEig = davidson.eigVal();
-      auto davidsonVec = davidson.VR();
-	  for (auto i = 0ul; i < nR; i++) {
-		StateEnergy[i] = std::real(davidsonEig[i]);
-        std::copy_n(davidsonVec+i*NDet, NDet, CIVecs[i]);
-	  }
+      if (isRoot) {
+        auto davidsonEig = davidson.eigVal();
+        auto davidsonVec = davidson.VR();
+	    for (auto i = 0ul; i < nR; i++) {
+		  StateEnergy[i] = std::real(davidsonEig[i]);
+          std::copy_n(davidsonVec+i*NDet, NDet, CIVecs[i]);
+	    }
+      }
+
+#ifdef CQ_ENABLE_MPI
+      // every process holds the solution as for the replicated builders
+      if (distSigma) {
+        MPIBCast(StateEnergy.data(), nR, 0, mcwfn.comm);
+        for (auto i = 0ul; i < nR; i++) MPIBCast(CIVecs[i], NDet, 0, mcwfn.comm);
+      }
+#endif
       
       mem.free(curEig, diagH);
 
     } else{
       CErr("Haven't Inplement Other Diagonalization yet");
     }
-      
-    // add other parts of the energy 
-     double EOther = mcwfn.reference().molecule().nucRepEnergy + mcwfn.InactEnergy;
-     for (auto i = 0ul; i < nR; i++) StateEnergy[i] += EOther;
   
-  } // CISolver::solveCI
+  } // CISolver::diagonalize
+
+  /*
+   * \brief Heat-bath selected CI
+   *
+   * Alternates between diagonalizing the sparse Hamiltonian of the
+   * current determinant space and adding the determinants D_a with
+   * |<D_a|H|D_i>| max_n |C_in| >= epsilon, until no determinant is
+   * added or the maximum number of selection cycles is reached.
+   * Small spaces are diagonalized directly. The selection runs on the
+   * root process, the space is broadcast to the other processes.
+   */
+  template <typename MatsT, typename IntsT>
+  void CISolver<MatsT, IntsT>::solveSelectedCI(MCWaveFunction<MatsT, IntsT> & mcwfn) {
+
+    auto sci = std::dynamic_pointer_cast<SelectedCI<MatsT,IntsT>>(mcwfn.ciBuilder);
+    if (not sci) CErr("Selected CI requires the SelectedCI builder");
+
+    auto & mopart = mcwfn.MOPartition;
+    auto & mem    = mcwfn.memManager;
+    size_t nR     = mcwfn.NStates;
+    double EOther = mcwfn.reference().molecule().nucRepEnergy + mcwfn.InactEnergy;
+
+    bool isRoot = MPIRank(mcwfn.comm) == 0;
+
+    // Copy the space of the root process to the other processes
+    auto bcastSpace = [&] () {
+#ifdef CQ_ENABLE_MPI
+      if (MPISize(mcwfn.comm) == 1) return;
+
+      auto & space = dynamic_cast<SCIStringManager &>(*mcwfn.detStr);
+      size_t nDet = space.nString();
+      size_t nW   = space.nWords();
+      MPIBCast(nDet, 0, mcwfn.comm);
+
+      std::vector<DetString::word_t> dets(nDet * nW);
+      if (isRoot) std::copy_n(space.det(0), nDet * nW, dets.data());
+      MPIBCast(dets.data(), nDet * nW, 0, mcwfn.comm);
+
+      if (not isRoot) {
+        space.clear();
+        for (auto i = 0ul; i < nDet; i++) space.insert(dets.data() + i * nW);
+      }
+#endif
+    };
+
+    ProgramTimer::tick("SCI Selection");
+    if (isRoot) sci->initialize(mcwfn, mopart.sciEpsilon);
+    bcastSpace();
+    ProgramTimer::tock("SCI Selection");
+
+    std::cout << "  Selected CI with epsilon = " << std::scientific
+              << std::setprecision(4) << mopart.sciEpsilon << "\n" << std::endl;
+    std::cout << std::setw(8) << "Cycle" << std::setw(16) << "NDet"
+              << std::setw(24) << "E(1)" << std::endl;
+
+    for (auto iter = 1ul; ; iter++) {
+
+      size_t NDet = mcwfn.detStr->nString();
+      if (NDet < nR) CErr("Selected CI space is smaller than the number of states");
+
+      if (NDet != mcwfn.NDet) {
+        mcwfn.NDet = NDet;
+        for (auto & C: mcwfn.CIVecs) {
+          mem.free(C);
+          C = mem.template malloc<MatsT>(NDet);
+        }
+      }
+
+      sci->buildHamiltonian(mcwfn);
+      diagonalize(mcwfn, NDet < 750 ? CI_FULL_MATRIX : alg_);
+
+#ifdef CQ_ENABLE_MPI
+      // every process holds the CI vectors of the root process
+      if (MPISize(mcwfn.comm) > 1)
+        for (auto & C: mcwfn.CIVecs) MPIBCast(C, NDet, 0, mcwfn.comm);
+#endif
+
+      std::cout << std::setw(8) << iter << std::setw(16) << NDet
+                << std::setw(24) << std::fixed << std::setprecision(10)
+                << mcwfn.StateEnergy[0] + EOther << std::endl;
+
+      if (iter >= mopart.sciMaxIter) break;
+
+      ProgramTimer::tick("SCI Selection");
+      size_t nAdd = isRoot ? sci->select(mcwfn, mopart.sciEpsilon) : 0;
+#ifdef CQ_ENABLE_MPI
+      MPIBCast(nAdd, 0, mcwfn.comm);
+#endif
+      if (nAdd != 0) bcastSpace();
+      ProgramTimer::tock("SCI Selection");
+
+      if (nAdd == 0) break;
+    }
+    std::cout << std::endl;
+
+  } // CISolver::solveSelectedCI
   
   
   // davidson guess
@@ -98,13 +98,7 @@ namespace ChronusQ {
         if(std::abs(EDiff) <= settings.scfEnergyConv) converged = true; 
         
         // compute RDMs
-        if (this->StateAverage) {
-          this->computeOneRDM(); 
-          this->computeTwoRDM(); 
-        } else {
-          this->computeOneRDM(this->NStates - 1); 
-          this->computeTwoRDM(this->NStates - 1);
-        }
+        this->computeRDMs();
         
         // this->print1RDMs();
         
@@ -184,6 +178,7 @@ namespace ChronusQ {
       ProgramTimer::tick("Property Eval");
       
       this->osc_str = this->memManager.template malloc<double>(this->NosS1*this->NStates);
+      this->computeTDMs();
       for (size_t s1 = 0ul; s1 < this->NosS1; s1++)
       for (size_t s2 = 0ul; s2 < this->NStates; s2++){
         if (s2 < this->NosS1) this->osc_str[s2+s1*this->NStates] = 0.;
@@ -222,6 +217,8 @@ namespace ChronusQ {
     ciSolver = std::make_shared<CISolver<MatsT,IntsT>>(settings.ciAlg, 
       settings.maxCIIter, settings.ciVectorConv,
       settings.maxDavidsonSpace, settings.nDavidsonGuess);
+    ciSolver->setCheckpoint(settings.ciChkInterval, settings.ciChkRestart);
+    ciSolver->setMixedPrecision(settings.ciMixedPrec);
     
     if (this->settings.doSCF) {
       
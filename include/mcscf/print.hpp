@@ -43,6 +43,12 @@ namespace ChronusQ {
       FormattedLine(std::cout,"  CI Vector Convergence Threshold:", ciVectorConv);
       FormattedLine(std::cout,"  Max Len of Davidson Subspace (x NRoots):", maxDavidsonSpace);
       FormattedLine(std::cout,"  Number of Davidson Guess(x NRoots):", nDavidsonGuess);
+      if (ciChkInterval or ciChkRestart) {
+        FormattedLine(std::cout,"  Davidson Checkpoint Interval:", ciChkInterval);
+        FormattedLine(std::cout,"  Restart Davidson from Checkpoint:", ciChkRestart);
+      }
+      if (ciMixedPrec)
+        FormattedLine(std::cout,"  Davidson Subspace Precision:", "Single");
     } else CErr("NYI CI Algorithm");
     
     if(this->doSCF) {
@@ -76,6 +82,8 @@ namespace ChronusQ {
                   +")-";
     } else if (mopart.scheme == RAS) {
       job_title += "RAS(" + std::to_string(mopart.nCorrE) + "," + std::to_string(mopart.nCorrO)+")-";
+    } else if (mopart.scheme == SCI) {
+      job_title += "SCI(" + std::to_string(mopart.nCorrE) + "," + std::to_string(mopart.nCorrO)+")-";
     } else {
       CErr("Other than CAS has not been implemented yet "); 
     }
@@ -55,7 +55,7 @@ namespace ChronusQ {
     this->ciBuilder->computeTwoRDM(*this, this->CIVecs[i], *twoRDMSOI);
     
     size_t nCorrO  = this->MOPartition.nCorrO;
-    if(this->detStr->scheme() == PRECOMPUTED_CONFIGURATION_DRIVEN_LIST) {
+    if(this->detStr->scheme() != PRECOMPUTED_INTEGRAL_DRIVEN_LIST) {
       auto & RDM2 = *twoRDMSOI;
       auto & RDM1 = *oneRDMSOI;
 #pragma omp parallel for schedule(static) default(shared)       
@@ -71,21 +71,14 @@ namespace ChronusQ {
   void MCSCF<MatsT,IntsT>::computeTwoRDM() {
     
     size_t nCorrO  = this->MOPartition.nCorrO;
-    size_t nCorrO2 = nCorrO * nCorrO; 
     
     if(this->StateAverage) {
       
-      auto twoRDMtmp = InCore4indexTPI<MatsT>(this->memManager,nCorrO); 
-      twoRDMSOI->clear();
-
-      for (auto i = 0ul; i < this->NStates; i++) {
-        this->ciBuilder->computeTwoRDM(*this, this->CIVecs[i], twoRDMtmp);
-        MatAdd('N', 'N', nCorrO2, nCorrO2, 
-          MatsT(this->SAWeight[i]), twoRDMtmp.pointer(), nCorrO2, 
-          MatsT(1.), twoRDMSOI->pointer(), nCorrO2, twoRDMSOI->pointer(), nCorrO2);
-      }  
+      // all states in one pass
+      this->ciBuilder->computeDensities(*this, this->CIVecs, this->SAWeight,
+        false, nullptr, twoRDMSOI.get());
       
-      if(this->detStr->scheme() == PRECOMPUTED_CONFIGURATION_DRIVEN_LIST) {
+      if(this->detStr->scheme() != PRECOMPUTED_INTEGRAL_DRIVEN_LIST) {
         auto & RDM2 = *twoRDMSOI;
         auto & RDM1 = *oneRDMSOI;
 #pragma omp parallel for schedule(static) default(shared)       
@@ -101,4 +94,51 @@ namespace ChronusQ {
     
   };  // MCSCF::computeTwoRDM     
 
+  /*
+   * \brief The one RDMs of the states and the (state averaged) two
+   *        RDM of the orbital optimization from one pass over the
+   *        CI vectors
+   */
+  template <typename MatsT, typename IntsT>
+  void MCSCF<MatsT,IntsT>::computeRDMs() {
+
+    size_t nCorrO = this->MOPartition.nCorrO;
+    size_t nO2    = nCorrO * nCorrO;
+    size_t nS     = this->NStates;
+
+    // state specific: the last state only
+    std::vector<MatsT*> C(this->CIVecs);
+    std::vector<double> w(this->SAWeight);
+    if (not this->StateAverage) {
+      C = { this->CIVecs.back() };
+      w = { 1. };
+    }
+
+    MatsT * SCR = this->memManager.template malloc<MatsT>(nO2 * C.size() * C.size());
+    this->ciBuilder->computeDensities(*this, C, w, false, SCR, twoRDMSOI.get());
+
+    for (auto i = 0ul; i < C.size(); i++) {
+      size_t iState = this->StateAverage ? i : nS - 1;
+      std::copy_n(SCR + nO2 * (i + C.size() * i), nO2, this->oneRDM[iState].pointer());
+    }
+    this->memManager.free(SCR);
+
+    oneRDMSOI->clear();
+    if (this->StateAverage) {
+      for (auto i = 0ul; i < nS; i++)
+        *oneRDMSOI += this->SAWeight[i] * this->oneRDM[i];
+    } else *oneRDMSOI = this->oneRDM[nS - 1];
+
+    if(this->detStr->scheme() != PRECOMPUTED_INTEGRAL_DRIVEN_LIST) {
+      auto & RDM2 = *twoRDMSOI;
+      auto & RDM1 = *oneRDMSOI;
+#pragma omp parallel for schedule(static) default(shared)       
+      for (auto w = 0ul; w < nCorrO; w++)
+      for (auto u = 0ul; u < nCorrO; u++)
+      for (auto t = 0ul; t < nCorrO; t++)
+        RDM2(t, u, u, w) -= RDM1(t, w);
+    }
+
+  }; // MCSCF::computeRDMs
+
 }; // namespace ChronusQ
@@ -40,6 +40,9 @@ namespace ChronusQ {
   template <typename MatsT, typename IntsT>
   class RASCI;
 
+  template <typename MatsT, typename IntsT>
+  class SelectedCI;
+
 
   /**
    *  \brief The MCWaveFunction class. The typed abstract interface for all
@@ -33,6 +33,7 @@ namespace ChronusQ {
     CAS,
     RAS,
     GAS,
+    SCI,
     GENERIC_DET
   };
 
@@ -41,6 +42,8 @@ namespace ChronusQ {
     //Parameters for space partition
 
     DetScheme scheme = CAS;
+    ExcitationScheme exScheme = PRECOMPUTED_CONFIGURATION_DRIVEN_LIST; /// < Excitation list storage
+    size_t exBlockSize = 0; /// < Strings per on-the-fly excitation list block (0 = cache sized)
 
     size_t nMO=0;     /// < Total Number of Molecular Orbitals
     size_t nInact=0;  /// < Number of Uncorrelated Core Orbitals
@@ -67,6 +70,10 @@ namespace ChronusQ {
     size_t mxElec=0;  /// < Maximum number of electrons in RAS 3 space
     std::vector<int> fCat;  /// < Category offset for RAS string
 
+    // for SCI
+    double sciEpsilon = 1.0e-4;  /// < Heat-bath selection threshold on |H_ai c_i|
+    size_t sciMaxIter = 20;      /// < Maximum number of selection cycles
+
     MOSpacePartition() = default;
   };
 
@@ -79,7 +79,8 @@ namespace ChronusQ {
   
     #define CONSTRUCT_CASSTRINGMANAGER(M_, N_) \
       std::dynamic_pointer_cast<DetStringManager>( \
-        std::make_shared<CASStringManager>(this->memManager, M_, N_))
+        std::make_shared<CASStringManager>(this->memManager, M_, N_, \
+          mopart.exScheme, mopart.exBlockSize))
 
     // Initialize String Engine
     if (mopart.scheme == CAS) {
@@ -95,6 +96,8 @@ namespace ChronusQ {
         this->detStr = CONSTRUCT_CASSTRINGMANAGER(nCorrO, nCorrE);
       }
     } else if (mopart.scheme == RAS) {
+      if (mopart.exScheme != PRECOMPUTED_CONFIGURATION_DRIVEN_LIST)
+        CErr("On-the-fly excitation lists are only implemented for CAS");
       size_t mhRas1 = std::min(nActO[0],mopart.mxHole);
       size_t meRas3 = std::min(nActO[2],mopart.mxElec);
       if(wfn.nC ==1) {
@@ -130,6 +133,14 @@ namespace ChronusQ {
         this->detStr = std::dynamic_pointer_cast<DetStringManager>(rasStr);
       }
       mopart.nActOs = nActO;  // Number of orbitals for each RAS space.
+    } else if (mopart.scheme == SCI) {
+      // Determinants over the spin orbitals (alpha and beta for 1C),
+      // starting from the reference determinant, the space is grown
+      // by the selected CI
+      size_t nSO = (wfn.nC == 1) ? 2 * nCorrO : nCorrO;
+      this->detStr = std::dynamic_pointer_cast<DetStringManager>(
+        std::make_shared<SCIStringManager>(this->memManager, nSO, nCorrE));
+      this->NDet = 1;
     } else
       CErr("DetStringManager other than CAS or RAS is not implemented"); 
     
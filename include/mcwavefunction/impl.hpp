@@ -137,6 +137,8 @@ namespace ChronusQ {
       ciBuilder = std::make_shared<CASCI<MatsT,IntsT>>();
     } else if (MOPartition.scheme == RAS) {
       ciBuilder = std::make_shared<RASCI<MatsT,IntsT>>();
+    } else if (MOPartition.scheme == SCI) {
+      ciBuilder = std::make_shared<SelectedCI<MatsT,IntsT>>();
     } else {
       CErr();
     }
@@ -47,7 +47,6 @@ namespace ChronusQ {
   template <typename MatsT, typename IntsT>
   void MCWaveFunction<MatsT,IntsT>::transformInts(EMPerturbation & pert) {
     
-    // TODO: expand to RI
     // build object and allocate memory
     size_t nTOrb  = this->MOPartition.nMO;
     size_t nCorrO = this->MOPartition.nCorrO;
@@ -53,6 +53,10 @@ namespace ChronusQ {
       FormattedLine(std::cout,"  Maximum Number of Holes in RAS 1:",      mopart.mxHole);
       FormattedLine(std::cout,"  Maximum Number of Electrons in RAS 3:",  mopart.mxElec);
     }
+    if (mopart.scheme == SCI) {
+      FormattedLine(std::cout,"  SCI Selection Threshold:",       mopart.sciEpsilon);
+      FormattedLine(std::cout,"  Maximum SCI Selection Cycles:",  mopart.sciMaxIter);
+    }
 
     std::cout << std::endl;
     FormattedLine(std::cout,"  Number of Correlated Electrons:",     mopart.nCorrE);
@@ -50,11 +50,17 @@ namespace ChronusQ {
     size_t nCorrO = MOPartition.nCorrO;
     size_t nInact = MOPartition.nInact;
 
-    // compute transition density matrix for specific state
+    // transition density matrix for specific state, reuse the
+    // batched TDMs if they have been formed
     SquareMatrix<MatsT> tmpTDM1(mem,nCorrO);
     SquareMatrix<MatsT> tmpTDM2(mem,nCorrO);
-    ciBuilder->computeTDM(*this, CIVecs[s1], CIVecs[s2], tmpTDM1);
-    ciBuilder->computeTDM(*this, CIVecs[s2], CIVecs[s1], tmpTDM2);
+    if (TDMs.size() == NStates) {
+      tmpTDM1 = TDMs[s1][s2];
+      tmpTDM2 = TDMs[s2][s1];
+    } else {
+      ciBuilder->computeTDM(*this, CIVecs[s1], CIVecs[s2], tmpTDM1);
+      ciBuilder->computeTDM(*this, CIVecs[s2], CIVecs[s1], tmpTDM2);
+    }
 
     MatsT D = MatsT(0.);
 
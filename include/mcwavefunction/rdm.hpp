@@ -48,29 +48,46 @@ namespace ChronusQ {
   template <typename MatsT, typename IntsT>
   void MCWaveFunction<MatsT,IntsT>::computeOneRDM() {
 
+    // all states in one pass
+    size_t nO2 = MOPartition.nCorrO * MOPartition.nCorrO;
+    MatsT * SCR = memManager.template malloc<MatsT>(nO2 * NStates * NStates);
+
+    ciBuilder->computeDensities(*this, CIVecs, {}, false, SCR, nullptr);
     for (auto i = 0ul; i < NStates; i++)
-      computeOneRDM(i);
+      std::copy_n(SCR + nO2 * (i + NStates * i), nO2, oneRDM[i].pointer());
+
+    memManager.free(SCR);
 
   } // MCWaveFunction::computeOneRDM
 
   /*
-   * \brief Compute TDM
+   * \brief Compute TDMs, TDMs[m][n](k,l) = <m|E_kl|n>, for all pairs
+   *        of states in one pass
    *
    */
   template <typename MatsT, typename IntsT>
   void MCWaveFunction<MatsT,IntsT>::computeTDMs() {
 
+    size_t nCorrO = MOPartition.nCorrO;
+    size_t nO2    = nCorrO * nCorrO;
+
     // allocate memory if not
-    if (!TDMs.empty()) {
+    if (TDMs.empty()) {
       TDMs.reserve(NStates);
-      for (auto i = 0ul; i < NStates; i++) {
+      for (auto i = 0ul; i < NStates; i++)
         TDMs.emplace_back(std::vector<SquareMatrix<MatsT>>(NStates,
-                  SquareMatrix<MatsT>(memManager, MOPartition.nCorrO)));
-        for (auto j = 0ul; j < NStates; j++) 
-          ciBuilder->computeTDM(*this, CIVecs[i], CIVecs[j], TDMs[i][j]);
-      }
+                  SquareMatrix<MatsT>(memManager, nCorrO)));
     }
 
+    MatsT * SCR = memManager.template malloc<MatsT>(nO2 * NStates * NStates);
+
+    ciBuilder->computeDensities(*this, CIVecs, {}, true, SCR, nullptr);
+    for (auto i = 0ul; i < NStates; i++)
+    for (auto j = 0ul; j < NStates; j++)
+      std::copy_n(SCR + nO2 * (j + NStates * i), nO2, TDMs[i][j].pointer());
+
+    memManager.free(SCR);
+
   } // MCWaveFunction::computeTDMs
 
 
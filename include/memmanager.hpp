@@ -24,6 +24,7 @@
 #pragma once
 
 #include <chronusq_sys.hpp>
+#include <mutex>
 
 //#define MEM_PRINT
 #define CHRONUSQ_CUSTOM_BACKEND
@@ -55,6 +56,8 @@ namespace ChronusQ {
 
     bool isAllocated_;
 
+    std::mutex allocMutex_; ///< Guards the allocation table for threaded callers
+
     /**
      *  \brief Ensures that the memory block (N_) is divisible by
      *  the segregation block size (BlockSize_)
@@ -151,6 +154,8 @@ namespace ChronusQ {
                    << " data (" << nBlocks << " blocks): ";
        #endif
 
+       const std::lock_guard<std::mutex> lock(allocMutex_);
+
        // Get a pointer from boost::simple_segregated_storage
        void * ptr = mem_backend::malloc_n(nBlocks,BlockSize_);
 
@@ -186,6 +191,8 @@ namespace ChronusQ {
      template <typename T>
      void free( T* &ptr ) {
 
+       const std::lock_guard<std::mutex> lock(allocMutex_);
+
        // Attempt to find the pointer in the list of 
        // allocated blocks
        auto it = AllocatedBlocks_.find(static_cast<void*>(ptr));
@@ -107,6 +107,13 @@ namespace ChronusQ {
         if (alg == DIRECT_N5) {
           CErr("DIRECT N5 MOIntsTransformer NYI !");   
         }
+
+        if (alg == INCORE_RI) {
+          if (not std::dynamic_pointer_cast<InCoreRITPI<IntsT>>(ss.aoints.TPI))
+            CErr("INCORE RI MOIntsTransformer requires RI AO integrals !");
+          // 4C falls back to the transformation thru the Fock build
+          if (ss.nC == 4) TPITransAlg_ = DIRECT_N6;
+        }
         
         // set default MO ranges as single slater
         setMORanges();
@@ -195,6 +202,11 @@ namespace ChronusQ {
     std::shared_ptr<InCore4indexTPI<MatsT>> formAOTPIInCore(bool);
     void subsetTransformTPIInCoreN5(const std::vector<std::pair<size_t,size_t>> &, 
       MatsT*, bool, TPI_TRANS_DELTA_TYPE delta = NO_KRONECKER_DELTA);
+    
+    std::shared_ptr<InCoreRITPI<MatsT>> formMORITPI(
+      const std::vector<std::pair<size_t,size_t>> &, const std::string &, bool, bool);
+    void subsetTransformTPIRI(const std::vector<std::pair<size_t,size_t>> &, 
+      MatsT*, const std::string &, bool, TPI_TRANS_DELTA_TYPE delta = NO_KRONECKER_DELTA);
 
 
   }; // class MOIntsTransformer
@@ -28,6 +28,7 @@
 #include <mointstransformer/hcore.hpp>
 #include <mointstransformer/tpi_ssfock.hpp>
 #include <mointstransformer/tpi_incore_n5.hpp>
+#include <mointstransformer/tpi_ri.hpp>
 #include <util/timer.hpp>
 
 
@@ -137,6 +138,7 @@ namespace ChronusQ {
    *  \param [in] cacheIntermediates ... controls whether to cache AO integrals for 
    *                                     InCore N5 and cache half transformed 
    *                                     integrals for InCore N6 and DIRECT N6
+   *                                     and MO three index factors for InCore RI
    *  \param [in] withExchange       ... whether compute Exchange part of the integrals
    *  \param [in] delta              ... whether two or more indice are indentical
    *                                     see options at include/mointstransformer.hpp 
@@ -200,6 +202,8 @@ namespace ChronusQ {
       subsetTransformTPISSFockN6(pert, off_sizes, MOTPI, C_moType, cacheIntermediates, C_delta);
     } else if (TPITransAlg_ == INCORE_N5) {
       subsetTransformTPIInCoreN5(off_sizes, MOTPI, cacheIntermediates, C_delta);
+    } else if (TPITransAlg_ == INCORE_RI) {
+      subsetTransformTPIRI(off_sizes, MOTPI, C_moType, cacheIntermediates, C_delta);
     } else {
       CErr("DIRECT_N5 NYI");
     }
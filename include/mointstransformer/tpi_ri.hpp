@@ -0,0 +1,223 @@
+/*
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *
+ *  Copyright (C) 2014-2022 Li Research Group (University of Washington)
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *
+ */
+#pragma once
+
+#include <mointstransformer.hpp>
+#include <util/timer.hpp>
+#include <cqlinalg.hpp>
+#include <cqlinalg/blasutil.hpp>
+#include <particleintegrals/twopints/incoreritpi.hpp>
+
+namespace ChronusQ {
+
+  /**
+   *  \brief form the MO three index RI / Cholesky factors of a pair type
+   *
+   *    B(L, p, q) = \sum_{sigma} \sum_{mu,nu} C(mu sigma, p)^* B(L, mu, nu) C(nu sigma, q)
+   *
+   *  with a single GEMM over nu for a batch of q followed by one GEMM
+   *  over mu per q. For KRONECKER_DELTA only the pairs (p, p) are formed.
+   *  The result is stored with L as the fastest index, (L, pq), in the
+   *  pointer of an InCoreRITPI with nBasis = 1.
+   *
+   *  \param [in] pq_off_sizes ... offsets and sizes of p and q
+   *  \param [in] pqSymbols    ... unique symbols of p and q, used for caching
+   *  \param [in] deltaPQ      ... whether p and q are identical
+   *  \param [in] cacheMORI    ... whether to cache the MO factors
+   */
+  template <typename MatsT, typename IntsT>
+  std::shared_ptr<InCoreRITPI<MatsT>> MOIntsTransformer<MatsT,IntsT>::formMORITPI(
+    const std::vector<std::pair<size_t,size_t>> & pq_off_sizes,
+    const std::string & pqSymbols, bool deltaPQ, bool cacheMORI) {
+
+    std::string moType_cache = "MORITPI-" + pqSymbols;
+    if (deltaPQ) moType_cache += "-delta";
+
+    auto MORI = ints_cache_.getIntegral<InCoreRITPI, MatsT>(moType_cache);
+    if (MORI) return MORI;
+
+    auto AORI = std::dynamic_pointer_cast<InCoreRITPI<IntsT>>(ss_.aoints.TPI);
+    if (not AORI) CErr("INCORE_RI TPI transformation requires RI AO integrals");
+
+    size_t poff = pq_off_sizes[0].first;
+    size_t qoff = pq_off_sizes[1].first;
+    size_t np   = pq_off_sizes[0].second;
+    size_t nq   = pq_off_sizes[1].second;
+
+    size_t NB    = AORI->nBasis();
+    size_t NBRI  = AORI->nRIBasis();
+    size_t nAO   = ss_.mo[0].dimension();
+    size_t NBNBRI = NB * NBRI;
+    size_t npqDim = deltaPQ ? np: np * nq;
+
+    // clear cache for more memory
+    try { MORI = std::make_shared<InCoreRITPI<MatsT>>(memManager_, 1, NBRI * npqDim); }
+    catch (...) {
+      ints_cache_.clear();
+      MORI = std::make_shared<InCoreRITPI<MatsT>>(memManager_, 1, NBRI * npqDim);
+    }
+
+    MatsT * B   = MORI->pointer();
+    MatsT * Cc  = memManager_.malloc<MatsT>(NB * np);
+
+    // batch over q to hold X(L mu, q)
+    size_t nqBatch = nq;
+    MatsT * X = nullptr;
+    try {
+      X = memManager_.malloc<MatsT>(NBNBRI * nqBatch);
+    } catch (std::bad_alloc & ba) {
+      nqBatch = std::min(nq, memManager_.max_avail_allocatable<MatsT>(NBNBRI));
+      if (nqBatch == 0) CErr("Not enough memory in formMORITPI");
+      X = memManager_.malloc<MatsT>(NBNBRI * nqBatch);
+    }
+
+    const MatsT * MO = ss_.mo[0].pointer();
+
+    // 1C: sigma = alpha only, 2C: sum over the spin diagonal blocks
+    for (auto sigma = 0ul; sigma < ss_.nC; sigma++) {
+
+      const MatsT * MOs = MO + sigma * NB;
+      MatsT beta = sigma == 0 ? MatsT(0.): MatsT(1.);
+
+      // Cc(mu, p) = C(mu sigma, p)^*
+      SetMat('R', NB, np, MatsT(1.), MOs + poff * nAO, nAO, Cc, NB);
+
+      for (auto q0 = 0ul; q0 < nq; q0 += nqBatch) {
+
+        size_t nqi = std::min(nqBatch, nq - q0);
+
+        // X(L mu, q) = B(L mu, nu) C(nu sigma, q)
+        blas::gemm(blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::NoTrans,
+          NBNBRI, nqi, NB, MatsT(1.), AORI->pointer(), NBNBRI,
+          MOs + (q0 + qoff) * nAO, nAO, MatsT(0.), X, NBNBRI);
+
+        // B(L, p, q) = X(L, mu, q) Cc(mu, p)
+        for (auto qi = 0ul; qi < nqi; qi++) {
+          size_t q = q0 + qi;
+          if (deltaPQ)
+            blas::gemm(blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::NoTrans,
+              NBRI, 1, NB, MatsT(1.), X + qi * NBNBRI, NBRI, Cc + q * NB, NB,
+              beta, B + q * NBRI, NBRI);
+          else
+            blas::gemm(blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::NoTrans,
+              NBRI, np, NB, MatsT(1.), X + qi * NBNBRI, NBRI, Cc, NB,
+              beta, B + q * np * NBRI, NBRI);
+        }
+      }
+    }
+
+    memManager_.free(X, Cc);
+
+    if (cacheMORI) ints_cache_.addIntegral(moType_cache, MORI);
+
+    return MORI;
+
+  }; // MOIntsTransformer::formMORITPI
+
+  /**
+   *  \brief subset transform TPI from the RI / Cholesky factors
+   *
+   *    (p q | r s) = \sum_L B(L, p, q) B(L, r, s)
+   *
+   *  The MO factors of each pair type are formed once (and cached), so
+   *  (tu|vw) and (pu|vw) in MCSCF share B(L, v, w) and every block is a
+   *  single GEMM over the auxiliary index.
+   */
+  template <typename MatsT, typename IntsT>
+  void MOIntsTransformer<MatsT,IntsT>::subsetTransformTPIRI(
+    const std::vector<std::pair<size_t,size_t>> & off_sizes, MatsT * MOTPI,
+    const std::string & moType, bool cacheIntermediates, TPI_TRANS_DELTA_TYPE delta) {
+
+    if (ss_.nC == 4) CErr("INCORE_RI TPI transformation for 4C is NYI");
+
+    size_t np = off_sizes[0].second;
+    size_t nq = off_sizes[1].second;
+    size_t nr = off_sizes[2].second;
+    size_t ns = off_sizes[3].second;
+    size_t npq  = np * nq;
+    size_t npr  = np * nr;
+
+    bool deltaPQ = delta == KRONECKER_DELTA_PQ or delta == KRONECKER_DELTA_PQ_RS;
+    bool deltaRS = delta == KRONECKER_DELTA_RS or delta == KRONECKER_DELTA_PQ_RS;
+
+    std::string pqSymbols, rsSymbols;
+    pqSymbols += getUniqueSymbol(moType[0]);
+    pqSymbols += getUniqueSymbol(moType[1]);
+    rsSymbols += getUniqueSymbol(moType[2]);
+    rsSymbols += getUniqueSymbol(moType[3]);
+
+    auto Bpq = formMORITPI({off_sizes[0], off_sizes[1]}, pqSymbols, deltaPQ,
+      cacheIntermediates);
+    auto Brs = (pqSymbols == rsSymbols and deltaPQ == deltaRS) ? Bpq :
+      formMORITPI({off_sizes[2], off_sizes[3]}, rsSymbols, deltaRS,
+        cacheIntermediates);
+
+    size_t NBRI   = std::dynamic_pointer_cast<InCoreRITPI<IntsT>>(ss_.aoints.TPI)->nRIBasis();
+    size_t npqDim = deltaPQ ? np: npq;
+    size_t nrsDim = deltaRS ? nr: nr * ns;
+
+    const MatsT * BPQ = Bpq->pointer();
+    const MatsT * BRS = Brs->pointer();
+
+    if (delta == NO_KRONECKER_DELTA or deltaPQ or deltaRS) {
+
+      // MOTPI(pq, rs) = B(L, pq)^T B(L, rs)
+      blas::gemm(blas::Layout::ColMajor, blas::Op::Trans, blas::Op::NoTrans,
+        npqDim, nrsDim, NBRI, MatsT(1.), BPQ, NBRI, BRS, NBRI,
+        MatsT(0.), MOTPI, npqDim);
+
+    } else if (delta == KRONECKER_DELTA_PS) {
+
+      // MOTPI(p,q,r) = (pq|rp)
+      #pragma omp parallel for schedule(static) collapse(2) default(shared)
+      for (auto r = 0ul; r < nr; r++)
+      for (auto q = 0ul; q < nq; q++)
+      for (auto p = 0ul; p < np; p++)
+        MOTPI[p + q*np + r*npq] = blas::dotu(NBRI, BPQ + (p + q*np)*NBRI, 1,
+          BRS + (r + p*nr)*NBRI, 1);
+
+    } else if (delta == KRONECKER_DELTA_RQ) {
+
+      // MOTPI(p,r,s) = (pr|rs)
+      #pragma omp parallel for schedule(static) collapse(2) default(shared)
+      for (auto s = 0ul; s < ns; s++)
+      for (auto r = 0ul; r < nr; r++)
+      for (auto p = 0ul; p < np; p++)
+        MOTPI[p + r*np + s*npr] = blas::dotu(NBRI, BPQ + (p + r*np)*NBRI, 1,
+          BRS + (r + s*nr)*NBRI, 1);
+
+    } else if (delta == KRONECKER_DELTA_PS_RQ) {
+
+      // MOTPI(p,r) = (pr|rp)
+      #pragma omp parallel for schedule(static) collapse(2) default(shared)
+      for (auto r = 0ul; r < nr; r++)
+      for (auto p = 0ul; p < np; p++)
+        MOTPI[p + r*np] = blas::dotu(NBRI, BPQ + (p + r*np)*NBRI, 1,
+          BRS + (r + p*nr)*NBRI, 1);
+
+    }
+
+  }; // MOIntsTransformer::subsetTransformTPIRI
+
+}; // namespace ChronusQ
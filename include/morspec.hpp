@@ -233,6 +233,7 @@ namespace ChronusQ {
     
       this->fdrSettings.dampFactor  = 0.01; // Default the damping factor
       this->genSettings.doFull      = true;
+      this->genSettings.autoFull    = false;
       this->genSettings.printLevel  = -1;
 
     }
@@ -633,6 +634,7 @@ namespace ChronusQ {
 
       // MOR ALWAYS has these options
       this->genSettings.doFull          = true;
+      this->genSettings.autoFull        = false;
       this->genSettings.formFullMat     = true;
       this->genSettings.distMatFromRoot = false;
       this->genSettings.formMatDist     = false;
@@ -62,6 +62,12 @@ namespace ChronusQ {
     double hessianDiagMinTol       = 1.0e-3;
      
     double XDampTol  = 0.5;
+
+    // Newton step (ORB_ROT_2ND_ORDER)
+    size_t newtonMaxIter    = 50;
+    double newtonConvTol    = 1.0e-5;
+    double newtonLevelShift = 0.0;
+    bool   newtonCheck      = false; // finite difference check of H K
     
     OrbitalRotationSettings() = default;
     OrbitalRotationSettings(const OrbitalRotationSettings &) = default;
@@ -70,6 +76,20 @@ namespace ChronusQ {
     void print();
   };
   
+  /*
+   * Intermediates of the exact orbital-orbital hessian
+   */
+  template <typename MatsT>
+  struct OrbOrbHessianIntermediates {
+    MatsT * F1   = nullptr; // generalized Fock matrix 1, F1_pq
+    MatsT * FI   = nullptr; // inactive Fock matrix, FI_pq
+    MatsT * F2   = nullptr; // generalized Fock matrix 2, F2_tq
+    MatsT * G    = nullptr; // orbital gradient of all blocks
+    MatsT * pqvw = nullptr; // (pq|vw)
+    MatsT * puqw = nullptr; // (pu|qw)
+    MatsT * puvq = nullptr; // (pu|vq), complex MOs only
+  };
+
   /* 
    * \brief the OrbitalRotation class. The class can perform 
    * post-SCF orbital rotation using Newton-Ralphson method
@@ -89,6 +109,7 @@ namespace ChronusQ {
     
     MCWaveFunction<MatsT,IntsT> & mcwfn_;
     std::shared_ptr<SquareMatrix<MatsT>> orbitalGradient_ = nullptr;
+    OrbOrbHessianIntermediates<MatsT> hessInts_;
 
   public:
     
@@ -137,7 +158,17 @@ namespace ChronusQ {
       MatsT *, const std::string &);
     void computeOrbOrbHessianDiag(EMPerturbation &, SquareMatrix<MatsT> &, InCore4indexTPI<MatsT> &, 
       MatsT *);
-    //void computeOrbOrbHessian(MatsT *);
+    
+    // exact orbital-orbital hessian and Newton step
+    void formOrbOrbHessianIntermediates(EMPerturbation &, SquareMatrix<MatsT> &,
+      InCore4indexTPI<MatsT> &);
+    void freeOrbOrbHessianIntermediates();
+    void computeOrbOrbHessianVector(EMPerturbation &, SquareMatrix<MatsT> &,
+      InCore4indexTPI<MatsT> &, const MatsT *, MatsT *);
+    void checkOrbOrbHessianVector(EMPerturbation &, SquareMatrix<MatsT> &,
+      InCore4indexTPI<MatsT> &, const MatsT *, MatsT *, MatsT *, double);
+    void computeNewtonStep(EMPerturbation &, SquareMatrix<MatsT> &,
+      InCore4indexTPI<MatsT> &, const MatsT *, const MatsT *, MatsT *);
     
     template <typename MatsU>
     void MatExpT(char, size_t, double, MatsU*, size_t, MatsU*, size_t, CQMemManager &);
@@ -41,6 +41,9 @@ namespace ChronusQ {
       FormattedLine(std::cout,"  Oribital Rotation Algorithm:",  "Quasi-2nd Order");
     } else if (alg == ORB_ROT_2ND_ORDER) {
       FormattedLine(std::cout,"  Oribital Rotation Algorithm:",  "Seconnd Order");
+      FormattedLine(std::cout,"  Newton Max Iterations:", newtonMaxIter);
+      FormattedLine(std::cout,"  Newton Convergence Tolerance:", newtonConvTol);
+      FormattedLine(std::cout,"  Newton Level Shift:", newtonLevelShift);
     } else CErr("NYI Orbital Rotation Algorithm");
    
     FormattedLine(std::cout, "  Rotation Blocks:");
@@ -57,7 +60,8 @@ namespace ChronusQ {
    * steps:
    *   1. compute Gradient if not computed
    *   2. compute (approximated) Hessian and inverse it
-   *   3. compute rotation paramemter X = - g / H
+   *   3. compute rotation paramemter X = - g / H, or solve H X = - g
+   *      with the exact hessian vector products for ORB_ROT_2ND_ORDER
    *   4. compute rotation matrix by matrix exponential U = exp(X)
    *   5. rotate MO for one step size as C' = C U
    */ 
@@ -85,20 +89,14 @@ namespace ChronusQ {
     MatsT * X = mem.template malloc<MatsT>(std::max(nAO,nTOrb)*nTOrb);
     MatsT * U = mem.template malloc<MatsT>(nTOrb2);
 
-    MatsT * H = nullptr; 
-    if (settings.alg == ORB_ROT_2ND_ORDER) {
-      H = mem.template malloc<MatsT>(nTOrb2*nTOrb2); 
-    } else {
-      H = mem.template malloc<MatsT>(nTOrb2); 
-    }
+    MatsT * H = mem.template malloc<MatsT>(nTOrb2); 
     
     ProgramTimer::tick("Form Hessian");
     // X = - H ^{-1} * G
+    this->computeOrbOrbHessianDiag(pert, oneRDM, twoRDM, H);
     if (settings.alg == ORB_ROT_2ND_ORDER) {
-      // this->computeOrbOrbHessian(H);
-      CErr("2nd Order orbital rotation not implemented");
+      this->computeNewtonStep(pert, oneRDM, twoRDM, G, H, X);
     } else {
-      this->computeOrbOrbHessianDiag(pert, oneRDM, twoRDM, H);
       for (auto i = 0ul; i < nTOrb2; i++) X[i] = - G[i] / H[i];
     }
     ProgramTimer::tock("Form Hessian");
@@ -230,6 +228,7 @@ namespace ChronusQ {
 #include <orbitalrotation/fock.hpp>      // fock matrix implementation 
 #include <orbitalrotation/gradient.hpp>  // gradient implementation
 #include <orbitalrotation/hessian.hpp>   // hessian implementation
+#include <orbitalrotation/newton.hpp>    // newton step implementation
 #include <orbitalrotation/ivo.hpp>   // hessian implementation
 
 
@@ -0,0 +1,493 @@
+/*
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *
+ *  Copyright (C) 2014-2022 Li Research Group (University of Washington)
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *
+ */
+#pragma once
+
+#include <orbitalrotation.hpp>
+#include <itersolver.hpp>
+#include <util/math.hpp>
+#include <cqlinalg/blas1.hpp>
+#include <cqlinalg/blas3.hpp>
+#include <cqlinalg/blasutil.hpp>
+#include <util/print.hpp>
+
+// #define DEBUG_ORBITALROTATION_NEWTON
+
+namespace ChronusQ {
+
+  /*
+   * Form the intermediates of the exact orbital-orbital hessian for the
+   * current MOs, p, q -> general, t, u, v, w -> correlated:
+   *
+   *   F1_pq, FI_pq = hCore_pq('i'), F2_tq,
+   *   g_pq including the CO-CO block, (pq|vw), (pu|qw) and (pu|vq)
+   *
+   * (pu|vq) = (pu|qv) is not stored for real MOs. With the DIRECT / INCORE
+   * N6 transformations (pu|qw) costs nMO * nCorrO Fock builds, the INCORE
+   * N5 and RI transformations are preferred for large systems.
+   */
+  template <typename MatsT, typename IntsT>
+  void OrbitalRotation<MatsT, IntsT>::formOrbOrbHessianIntermediates(
+    EMPerturbation & pert, SquareMatrix<MatsT> & oneRDM,
+    InCore4indexTPI<MatsT> & twoRDM) {
+
+    auto & mopart = mcwfn_.MOPartition;
+    auto & mem    = mcwfn_.memManager;
+    auto & I      = hessInts_;
+
+    size_t nTOrb   = mopart.nMO;
+    size_t nCorrO  = mopart.nCorrO;
+    size_t nInact  = mopart.nInact;
+    size_t nTOrb2  = nTOrb * nTOrb;
+    size_t nERI    = nTOrb2 * nCorrO * nCorrO;
+
+    freeOrbOrbHessianIntermediates();
+
+    I.F1 = mem.template malloc<MatsT>(nTOrb2);
+    I.FI = mem.template malloc<MatsT>(nTOrb2);
+    I.F2 = mem.template malloc<MatsT>(nCorrO * nTOrb);
+    I.G  = mem.template malloc<MatsT>(nTOrb2);
+
+    this->formGeneralizedFock1(pert, oneRDM, I.F1, "pq");
+    this->formGeneralizedFock2(pert, oneRDM, twoRDM, I.F2, "p");
+    mcwfn_.mointsTF->transformHCore(pert, I.FI, "pq", false, 'i');
+
+    // g_pq = F_pq - F_qp^*, with the generalized Fock matrix
+    //   F_pi = F1_ip^*, F_pt = F2_tp and F_pa = 0
+    auto F = [&](size_t p, size_t q) {
+      if (q < nInact)          return SmartConj(I.F1[q + p * nTOrb]);
+      if (q < nInact + nCorrO) return I.F2[(q - nInact) + p * nCorrO];
+      return MatsT(0.);
+    };
+
+    for (auto q = 0ul; q < nTOrb; q++)
+    for (auto p = 0ul; p < nTOrb; p++)
+      I.G[p + q * nTOrb] = F(p, q) - SmartConj(F(q, p));
+
+    I.pqvw = mem.template malloc<MatsT>(nERI);
+    I.puqw = mem.template malloc<MatsT>(nERI);
+    mcwfn_.mointsTF->transformTPI(pert, I.pqvw, "pqvw", true, false);
+    mcwfn_.mointsTF->transformTPI(pert, I.puqw, "puqw", true, false);
+
+    if (std::is_same<MatsT, dcomplex>::value) {
+      I.puvq = mem.template malloc<MatsT>(nERI);
+      mcwfn_.mointsTF->transformTPI(pert, I.puvq, "puvq", true, false);
+    }
+
+  }; // OrbitalRotation<MatsT>::formOrbOrbHessianIntermediates
+
+  template <typename MatsT, typename IntsT>
+  void OrbitalRotation<MatsT, IntsT>::freeOrbOrbHessianIntermediates() {
+
+    auto & mem = mcwfn_.memManager;
+    auto & I   = hessInts_;
+
+    for (MatsT ** ptr: {&I.F1, &I.FI, &I.F2, &I.G, &I.pqvw, &I.puqw, &I.puvq})
+      if (*ptr) {
+        mem.free(*ptr);
+        *ptr = nullptr;
+      }
+
+  }; // OrbitalRotation<MatsT>::freeOrbOrbHessianIntermediates
+
+  /*
+   * Exact orbital-orbital hessian times an anti-hermitian rotation K
+   * (orbital-CI coupling is not included), for C' = C (1 + K)
+   *
+   *   S = d g(C') - 1/2 [g, K]
+   *
+   * with the one-index transformed generalized Fock matrices
+   *
+   *   dF1  = F1 K - K F1 + fc * G(dD_I) + G(dD_A)
+   *   dF2_tq = \sum_m F2_tm K_qm^* + \sum_u 1PDM_tu (FI K + G(dD_I))_qu
+   *          + \sum_uvw 2PDM_tuvw [K_mu (qm|vw) + K_vm^* (qu|mw) + K_mw (qu|vm)]
+   *
+   *   dD_I = (CK)_i C_i^H + C_i (CK)_i^H
+   *   dD_A = (CK)_u 1PDM_tu C_t^H + C_u 1PDM_tu (CK)_t^H
+   *
+   * Only the first term of the commutator survives at convergence, the
+   * second makes the product the exact hessian for fixed RDMs.
+   */
+  template <typename MatsT, typename IntsT>
+  void OrbitalRotation<MatsT, IntsT>::computeOrbOrbHessianVector(
+    EMPerturbation & pert, SquareMatrix<MatsT> & oneRDM,
+    InCore4indexTPI<MatsT> & twoRDM, const MatsT * K, MatsT * S) {
+
+    auto & mopart = mcwfn_.MOPartition;
+    auto & mem    = mcwfn_.memManager;
+    auto & I      = hessInts_;
+
+    if (not I.F1) CErr("Orbital hessian intermediates are not formed");
+
+    size_t nTOrb   = mopart.nMO;
+    size_t nCorrO  = mopart.nCorrO;
+    size_t nInact  = mopart.nInact;
+    size_t nTOrb2  = nTOrb * nTOrb;
+    size_t nCorrO2 = nCorrO * nCorrO;
+    size_t nCorrO3 = nCorrO2 * nCorrO;
+    size_t nAO     = mcwfn_.reference().nAlphaOrbital() * mcwfn_.reference().nC;
+    MatsT  fc      = (mcwfn_.reference().nC > 1) ? 1.0: 2.0;
+
+    const MatsT * C    = mcwfn_.reference().mo[0].pointer() +
+      mcwfn_.mointsTF->parseMOType('p').first * nAO;
+    const MatsT * CA   = C + nInact * nAO;
+    const MatsT * KA   = K + nInact * nTOrb;
+    const MatsT * RDM1 = oneRDM.pointer();
+    const MatsT * RDM2 = twoRDM.pointer();
+
+    SquareMatrix<MatsT> Den(mem, nAO);
+    MatsT * CK  = mem.template malloc<MatsT>(nAO * nTOrb);
+    MatsT * SCR = mem.template malloc<MatsT>(nAO * nCorrO);
+    MatsT * GI  = mem.template malloc<MatsT>(nTOrb2);
+    MatsT * GA  = mem.template malloc<MatsT>(nTOrb2);
+    MatsT * dF1 = mem.template malloc<MatsT>(nTOrb2);
+    MatsT * dF2 = mem.template malloc<MatsT>(nCorrO * nTOrb);
+    MatsT * W   = mem.template malloc<MatsT>(nTOrb * nCorrO);
+    MatsT * RK  = mem.template malloc<MatsT>(nCorrO3 * nTOrb);
+
+    // CK = C K
+    blas::gemm(blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::NoTrans,
+      nAO, nTOrb, nTOrb, MatsT(1.), C, nAO, K, nTOrb, MatsT(0.), CK, nAO);
+
+    // G(dD_I)
+    if (nInact > 0) {
+      blas::gemm(blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::ConjTrans,
+        nAO, nAO, nInact, MatsT(1.), CK, nAO, C, nAO, MatsT(0.), Den.pointer(), nAO);
+      blas::gemm(blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::ConjTrans,
+        nAO, nAO, nInact, MatsT(1.), C, nAO, CK, nAO, MatsT(1.), Den.pointer(), nAO);
+      mcwfn_.mointsTF->transformGD(pert, Den, true, GI, "pq");
+    } else std::fill_n(GI, nTOrb2, MatsT(0.));
+
+    // G(dD_A), dD_A(nu,mu) = (CK)(nu,u) 1PDM_tu C(mu,t)^* + C(nu,u) 1PDM_tu (CK)(mu,t)^*
+    blas::gemm(blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::Trans,
+      nAO, nCorrO, nCorrO, MatsT(1.), CK + nInact * nAO, nAO, RDM1, nCorrO,
+      MatsT(0.), SCR, nAO);
+    blas::gemm(blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::ConjTrans,
+      nAO, nAO, nCorrO, MatsT(1.), SCR, nAO, CA, nAO, MatsT(0.), Den.pointer(), nAO);
+    blas::gemm(blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::Trans,
+      nAO, nCorrO, nCorrO, MatsT(1.), CA, nAO, RDM1, nCorrO, MatsT(0.), SCR, nAO);
+    blas::gemm(blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::ConjTrans,
+      nAO, nAO, nCorrO, MatsT(1.), SCR, nAO, CK + nInact * nAO, nAO,
+      MatsT(1.), Den.pointer(), nAO);
+    mcwfn_.mointsTF->transformGD(pert, Den, true, GA, "pq");
+
+    // dF1 = F1 K - K F1 + fc * G(dD_I) + G(dD_A)
+    blas::gemm(blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::NoTrans,
+      nTOrb, nTOrb, nTOrb, MatsT(1.), I.F1, nTOrb, K, nTOrb, MatsT(0.), dF1, nTOrb);
+    blas::gemm(blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::NoTrans,
+      nTOrb, nTOrb, nTOrb, MatsT(-1.), K, nTOrb, I.F1, nTOrb, MatsT(1.), dF1, nTOrb);
+    blas::axpy(nTOrb2, fc, GI, 1, dF1, 1);
+    blas::axpy(nTOrb2, MatsT(1.), GA, 1, dF1, 1);
+
+    // dF2_tq = \sum_m F2_tm K_qm^* = - (F2 K^T)_tq
+    blas::gemm(blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::Trans,
+      nCorrO, nTOrb, nTOrb, MatsT(-1.), I.F2, nCorrO, K, nTOrb,
+      MatsT(0.), dF2, nCorrO);
+
+    // W_qu = (FI K + G(dD_I))_qu, dF2_tq += \sum_u 1PDM_tu W_qu
+    SetMat('N', nTOrb, nCorrO, MatsT(1.), GI + nInact * nTOrb, nTOrb, W, nTOrb);
+    blas::gemm(blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::NoTrans,
+      nTOrb, nCorrO, nTOrb, MatsT(1.), I.FI, nTOrb, KA, nTOrb, MatsT(1.), W, nTOrb);
+    blas::gemm(blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::Trans,
+      nCorrO, nTOrb, nCorrO, MatsT(1.), RDM1, nCorrO, W, nTOrb,
+      MatsT(1.), dF2, nCorrO);
+
+    // RK(t,m,v,w) = \sum_u 2PDM_tuvw K_mu, dF2_tq += \sum_mvw RK(t,m,v,w) (qm|vw)
+    for (auto vw = 0ul; vw < nCorrO2; vw++)
+      blas::gemm(blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::Trans,
+        nCorrO, nTOrb, nCorrO, MatsT(1.), RDM2 + vw * nCorrO2, nCorrO, KA, nTOrb,
+        MatsT(0.), RK + vw * nCorrO * nTOrb, nCorrO);
+    blas::gemm(blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::Trans,
+      nCorrO, nTOrb, nTOrb * nCorrO2, MatsT(1.), RK, nCorrO, I.pqvw, nTOrb,
+      MatsT(1.), dF2, nCorrO);
+
+    // RK(t,u,m,w) = \sum_v 2PDM_tuvw K_vm^* = - \sum_v 2PDM_tuvw K_vm
+    for (auto w = 0ul; w < nCorrO; w++)
+      blas::gemm(blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::NoTrans,
+        nCorrO2, nTOrb, nCorrO, MatsT(-1.), RDM2 + w * nCorrO3, nCorrO2,
+        K + nInact, nTOrb, MatsT(0.), RK + w * nCorrO2 * nTOrb, nCorrO2);
+
+    // RK'(t,u,v,m) = \sum_w 2PDM_tuvw K_mw
+    if (I.puvq) {
+
+      // dF2_tq += \sum_umw RK(t,u,m,w) (qu|mw)
+      blas::gemm(blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::Trans,
+        nCorrO, nTOrb, nTOrb * nCorrO2, MatsT(1.), RK, nCorrO, I.puqw, nTOrb,
+        MatsT(1.), dF2, nCorrO);
+
+      // dF2_tq += \sum_uvm RK'(t,u,v,m) (qu|vm)
+      blas::gemm(blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::Trans,
+        nCorrO3, nTOrb, nCorrO, MatsT(1.), RDM2, nCorrO3, KA, nTOrb,
+        MatsT(0.), RK, nCorrO3);
+      blas::gemm(blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::Trans,
+        nCorrO, nTOrb, nTOrb * nCorrO2, MatsT(1.), RK, nCorrO, I.puvq, nTOrb,
+        MatsT(1.), dF2, nCorrO);
+
+    } else {
+
+      // real MOs, (qu|vm) = (qu|mv): RK(t,u,m,v) += RK'(t,u,v,m)
+      for (auto v = 0ul; v < nCorrO; v++)
+        blas::gemm(blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::Trans,
+          nCorrO2, nTOrb, nCorrO, MatsT(1.), RDM2 + v * nCorrO2, nCorrO3,
+          KA, nTOrb, MatsT(1.), RK + v * nCorrO2 * nTOrb, nCorrO2);
+
+      // dF2_tq += \sum_umw RK(t,u,m,w) (qu|mw)
+      blas::gemm(blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::Trans,
+        nCorrO, nTOrb, nTOrb * nCorrO2, MatsT(1.), RK, nCorrO, I.puqw, nTOrb,
+        MatsT(1.), dF2, nCorrO);
+
+    }
+
+    // S_pq = dF_pq - dF_qp^*
+    auto dF = [&](size_t p, size_t q) {
+      if (q < nInact)          return SmartConj(dF1[q + p * nTOrb]);
+      if (q < nInact + nCorrO) return dF2[(q - nInact) + p * nCorrO];
+      return MatsT(0.);
+    };
+
+    for (auto q = 0ul; q < nTOrb; q++)
+    for (auto p = 0ul; p < nTOrb; p++)
+      S[p + q * nTOrb] = dF(p, q) - SmartConj(dF(q, p));
+
+    // S -= 1/2 (g K - K g)
+    blas::gemm(blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::NoTrans,
+      nTOrb, nTOrb, nTOrb, MatsT(-0.5), I.G, nTOrb, K, nTOrb, MatsT(1.), S, nTOrb);
+    blas::gemm(blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::NoTrans,
+      nTOrb, nTOrb, nTOrb, MatsT(0.5), K, nTOrb, I.G, nTOrb, MatsT(1.), S, nTOrb);
+
+    mem.free(CK, SCR, GI, GA, dF1, dF2, W, RK);
+
+  }; // OrbitalRotation<MatsT>::computeOrbOrbHessianVector
+
+  /*
+   * Finite difference check of the hessian vector product for fixed RDMs
+   *
+   *   H K = [g(C (1 + eps K)) - g(C (1 - eps K))] / (2 eps) - 1/2 [g, K]
+   *
+   * The MOs and the integral caches are restored on return.
+   *
+   * \param [in]  K   ... anti-hermitian rotation
+   * \param [out] S   ... H K from computeOrbOrbHessianVector
+   * \param [out] SFD ... H K from the finite differences of the gradient
+   */
+  template <typename MatsT, typename IntsT>
+  void OrbitalRotation<MatsT, IntsT>::checkOrbOrbHessianVector(
+    EMPerturbation & pert, SquareMatrix<MatsT> & oneRDM,
+    InCore4indexTPI<MatsT> & twoRDM, const MatsT * K, MatsT * S, MatsT * SFD,
+    double eps) {
+
+    auto & mem   = mcwfn_.memManager;
+    auto & I     = hessInts_;
+    auto & mo     = mcwfn_.reference().mo[0];
+    size_t nTOrb  = mcwfn_.MOPartition.nMO;
+    size_t nTOrb2 = nTOrb * nTOrb;
+    size_t nAO    = mo.dimension();
+
+    MatsT * C  = mo.pointer() +
+      mcwfn_.mointsTF->parseMOType('i').first * nAO;
+    MatsT * C0 = mem.template malloc<MatsT>(nAO * nTOrb);
+    MatsT * G0 = mem.template malloc<MatsT>(nTOrb2);
+    std::copy_n(C, nAO * nTOrb, C0);
+
+    formOrbOrbHessianIntermediates(pert, oneRDM, twoRDM);
+    computeOrbOrbHessianVector(pert, oneRDM, twoRDM, K, S);
+    std::copy_n(I.G, nTOrb2, G0);
+
+    // SFD = [g(+) - g(-)] / (2 eps)
+    for (double sgn: {1., -1.}) {
+      std::copy_n(C0, nAO * nTOrb, C);
+      blas::gemm(blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::NoTrans,
+        nAO, nTOrb, nTOrb, MatsT(sgn * eps), C0, nAO, K, nTOrb, MatsT(1.), C, nAO);
+      mcwfn_.mointsTF->clearAllCache();
+      formOrbOrbHessianIntermediates(pert, oneRDM, twoRDM);
+
+      if (sgn > 0.) std::copy_n(I.G, nTOrb2, SFD);
+      else blas::axpy(nTOrb2, MatsT(-1.), I.G, 1, SFD, 1);
+    }
+    blas::scal(nTOrb2, MatsT(0.5 / eps), SFD, 1);
+
+    // SFD -= 1/2 (g K - K g)
+    blas::gemm(blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::NoTrans,
+      nTOrb, nTOrb, nTOrb, MatsT(-0.5), G0, nTOrb, K, nTOrb, MatsT(1.), SFD, nTOrb);
+    blas::gemm(blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::NoTrans,
+      nTOrb, nTOrb, nTOrb, MatsT(0.5), K, nTOrb, G0, nTOrb, MatsT(1.), SFD, nTOrb);
+
+    std::copy_n(C0, nAO * nTOrb, C);
+    mcwfn_.mointsTF->clearAllCache();
+    freeOrbOrbHessianIntermediates();
+
+    mem.free(C0, G0);
+
+  }; // OrbitalRotation<MatsT>::checkOrbOrbHessianVector
+
+  /*
+   * Solve the Newton equations H X = - g for the non-redundant rotations
+   * with GMRES, preconditioned by the approximated hessian diagonal.
+   * Complex rotations are solved as real and imaginary parameters since
+   * the hessian is not complex linear. A level shift solves (H + s) X = - g,
+   * the diagonal step is taken if X is not a descent direction.
+   *
+   * \param [in]  G ... orbital gradient
+   * \param [in]  H ... approximated hessian diagonal
+   * \param [out] X ... rotation parameters
+   */
+  template <typename MatsT, typename IntsT>
+  void OrbitalRotation<MatsT, IntsT>::computeNewtonStep(EMPerturbation & pert,
+    SquareMatrix<MatsT> & oneRDM, InCore4indexTPI<MatsT> & twoRDM,
+    const MatsT * G, const MatsT * H, MatsT * X) {
+
+    auto & mopart = mcwfn_.MOPartition;
+    auto & mem    = mcwfn_.memManager;
+
+    size_t nTOrb   = mopart.nMO;
+    size_t nTOrb2  = nTOrb * nTOrb;
+    size_t nCorrO  = mopart.nCorrO;
+    size_t nInact  = mopart.nInact;
+    size_t nFVirt  = mopart.nFVirt;
+    size_t nINCO   = nInact + nCorrO;
+
+    // non-redundant rotations (p, q), p > q
+    std::vector<std::pair<size_t,size_t>> pq;
+    if (settings.rotate_inact_correlated)
+      for (auto i = 0ul; i < nInact; i++)
+      for (auto t = 0ul; t < nCorrO; t++) pq.emplace_back(nInact + t, i);
+    if (settings.rotate_inact_virtual)
+      for (auto i = 0ul; i < nInact; i++)
+      for (auto a = 0ul; a < nFVirt; a++) pq.emplace_back(nINCO + a, i);
+    if (settings.rotate_correlated_virtual)
+      for (auto t = 0ul; t < nCorrO; t++)
+      for (auto a = 0ul; a < nFVirt; a++) pq.emplace_back(nINCO + a, nInact + t);
+
+    const size_t nR     = sizeof(MatsT) / sizeof(double);
+    const size_t nParam = nR * pq.size();
+
+    std::fill_n(X, nTOrb2, MatsT(0.));
+    if (nParam == 0) return;
+
+    auto pack = [&](const MatsT * M, double * x) {
+      for (auto k = 0ul; k < pq.size(); k++)
+        std::copy_n(reinterpret_cast<const double*>(
+          M + pq[k].first + pq[k].second * nTOrb), nR, x + k * nR);
+    };
+
+    auto unpack = [&](const double * x, MatsT * M) {
+      std::fill_n(M, nTOrb2, MatsT(0.));
+      for (auto k = 0ul; k < pq.size(); k++) {
+        size_t p = pq[k].first, q = pq[k].second;
+        std::copy_n(x + k * nR, nR, reinterpret_cast<double*>(M + p + q * nTOrb));
+        M[q + p * nTOrb] = - SmartConj(M[p + q * nTOrb]);
+      }
+    };
+
+    double * RHS = mem.template malloc<double>(nParam);
+    double * SOL = mem.template malloc<double>(nParam);
+    double * HD  = mem.template malloc<double>(nParam);
+    MatsT  * K   = mem.template malloc<MatsT>(nTOrb2);
+    MatsT  * S   = mem.template malloc<MatsT>(nTOrb2);
+
+    pack(G, RHS);
+    blas::scal(nParam, -1., RHS, 1);
+    for (auto k = 0ul; k < nParam; k++)
+      HD[k] = std::real(H[pq[k / nR].first + pq[k / nR].second * nTOrb]);
+
+    // H K along the (non-redundant) gradient against finite differences
+    if (settings.newtonCheck) {
+      unpack(RHS, K);
+      MatsT * SFD = mem.template malloc<MatsT>(nTOrb2);
+      double * s  = mem.template malloc<double>(2 * nParam);
+      checkOrbOrbHessianVector(pert, oneRDM, twoRDM, K, S, SFD, 1e-4);
+
+      pack(S, s);
+      pack(SFD, s + nParam);
+      double sNorm = blas::nrm2(nParam, s, 1);
+      blas::axpy(nParam, -1., s, 1, s + nParam, 1);
+      double err = blas::nrm2(nParam, s + nParam, 1) / std::max(sNorm, 1e-30);
+      mem.free(SFD, s);
+
+      std::cout << "    Newton hessian vector check: relative error = "
+                << std::scientific << std::setprecision(4) << err
+                << std::fixed << "\n" << std::endl;
+      if (err > 1e-5)
+        CErr("Orbital hessian vector product does not match the finite differences");
+    }
+
+    formOrbOrbHessianIntermediates(pert, oneRDM, twoRDM);
+
+    typename GMRES<double>::LinearTrans_t lt =
+      [&](size_t nVec, double * V, double * AV) {
+      for (auto iVec = 0ul; iVec < nVec; iVec++) {
+        unpack(V + iVec * nParam, K);
+        this->computeOrbOrbHessianVector(pert, oneRDM, twoRDM, K, S);
+        pack(S, AV + iVec * nParam);
+      }
+    };
+
+    typename GMRES<double>::Shift_t pc =
+      [&](size_t nVec, double shift, double * V, double * AV) {
+      for (auto iVec = 0ul; iVec < nVec; iVec++)
+      for (auto k = 0ul; k < nParam; k++)
+        AV[k + iVec * nParam] = V[k + iVec * nParam] / (HD[k] - shift);
+    };
+
+    double shift = - settings.newtonLevelShift;
+    bool isRoot = MPIRank(mcwfn_.comm) == 0;
+
+    GMRES<double> gmres(mcwfn_.comm, mem, nParam, settings.newtonMaxIter,
+      settings.newtonConvTol, lt, pc);
+
+    if (isRoot) {
+      gmres.setRHS(1, RHS, nParam);
+      gmres.setShifts(1, &shift);
+    }
+    gmres.rhsBS   = 1;
+    gmres.shiftBS = 1;
+
+    // disable GMRES printing
+    {
+      SilenceOutput silence;
+      gmres.run();
+    }
+
+    if (isRoot) gmres.getSol(SOL);
+    if (MPISize(mcwfn_.comm) > 1) MPIBCast(SOL, nParam, 0, mcwfn_.comm);
+
+    freeOrbOrbHessianIntermediates();
+
+    // - g X > 0 for a descent direction
+    if (blas::dot(nParam, RHS, 1, SOL, 1) <= 0.) {
+      std::cout << "    WARNING!: Newton step is not a descent direction,"
+                << " use the approximated hessian diagonal\n" << std::endl;
+      for (auto k = 0ul; k < nParam; k++) SOL[k] = RHS[k] / HD[k];
+    }
+
+    unpack(SOL, X);
+
+#ifdef DEBUG_ORBITALROTATION_NEWTON
+    prettyPrintSmart(std::cout, " OR Newton X ", X, nTOrb, nTOrb, nTOrb);
+#endif
+
+    mem.free(RHS, SOL, HD, K, S);
+
+  }; // OrbitalRotation<MatsT>::computeNewtonStep
+
+}; // namespace ChronusQ
@@ -92,6 +92,8 @@ namespace ChronusQ {
        out << "INCORE N5";
     else if (aoints.TPITransAlg == TPI_TRANSFORMATION_ALG::DIRECT_N5)
        out << "DIRECT N5";
+    else if (aoints.TPITransAlg == TPI_TRANSFORMATION_ALG::INCORE_RI)
+       out << "INCORE RI";
     else
        CErr("Unrecognized TPI_TRANSFORMATION_ALG in aoints");
 
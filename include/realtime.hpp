@@ -33,6 +33,7 @@
 // RT Headers
 #include <realtime/enums.hpp>
 #include <realtime/fields.hpp>
+#include <realtime/spectrum.hpp>
 
 
 
@@ -55,9 +56,14 @@ namespace ChronusQ {
 
     size_t iSave    = 50; ///< Save progress every N steps
     size_t restoreStep = 0;  ///< Restore propagation from this step
+    bool   restoreMMUT = false; ///< Resume a MMUT segment at restoreStep
 
     size_t nSteps = 0; ///< Electronic steps to update tMax
 
+    size_t nTeams = 1; ///< Thread teams for concurrent propagation of systems
+
+    bool   orbitalProp = false; ///< Propagate occupied orbitals instead of the density
+
     bool   includeSCFField = true;  ///< Whether to include the SCF field
 
   }; // struct IntegrationScheme
@@ -74,6 +80,9 @@ namespace ChronusQ {
 
     PropagationStep curStep;  ///< Current integration step
 
+    bool specConverged = false; ///< Spectrum peaks converged (terminate)
+    bool openMMUT      = false; ///< Run ends inside a MMUT segment
+
   };
 
   /**
@@ -104,11 +113,19 @@ namespace ChronusQ {
     IntegrationProgress curState;  ///< Current state of the time propagation
     IntegrationData     data;      ///< Data collection
 
+    std::vector<TDEMPerturbation> replicaPert; ///< TD fields of replicas 1..N-1
+    std::vector<IntegrationData>  replicaData; ///< Data collection of replicas 1..N-1
+
+    SpectrumSettings            specSettings; ///< On-the-fly spectrum settings
+    std::vector<DipoleSpectrum> spectra;      ///< On-the-fly spectrum of each replica
+
     int printLevel = 1; ///< Amount of printing in RT calc
     size_t orbitalPopFreq = 0; ///< Amount of printing in RT calc
     
     bool restart   = false; ///< Restarting calc from bin file
 
+    static constexpr int32_t checkpointVersion = 1; ///< Layout of RT/CHECKPOINT
+
     RealTimeBase()                     = delete;
     RealTimeBase(const RealTimeBase &) = delete;
     RealTimeBase(RealTimeBase &&)      = delete;
@@ -146,6 +163,24 @@ namespace ChronusQ {
       scfPert = scfp;
     }
 
+    /**
+     *  \brief Number of independent propagations carried by this
+     *  object. Replica 0 is always driven by pert.
+     */ 
+    inline size_t nReplicas() const { return replicaPert.size() + 1; }
+
+    inline TDEMPerturbation& replicaField(size_t r) {
+      return r == 0 ? pert : replicaPert[r-1];
+    }
+
+    inline IntegrationData& replicaRecord(size_t r) {
+      return r == 0 ? data : replicaData[r-1];
+    }
+
+    // Replica handling (see src/realtime/impl.cxx for docs)
+    virtual void addReplica(const TDEMPerturbation&) = 0;
+    void setPolarizations(const std::vector<cart_t>&);
+
   protected:
 
     CQMemManager     &memManager_; ///< Memory manager
@@ -163,8 +198,18 @@ namespace ChronusQ {
     _SSTyp<dcomplex,IntsT>    propagator_; ///< Total system with complex matrices 
     std::vector<SingleSlater<dcomplex, IntsT>*> systems_; ///< Objects for time propagation
 
+    std::vector<std::shared_ptr<_SSTyp<dcomplex,IntsT>>> replicas_; ///< Copies of propagator_ for replicas 1..N-1
+    std::vector<size_t> sysReplica_; ///< Replica which owns each entry of systems_
+
     std::vector<std::shared_ptr<PauliSpinorSquareMatrices<dcomplex>>> DOSav;
+    std::vector<std::shared_ptr<PauliSpinorSquareMatrices<dcomplex>>> DOPrev; ///< DO(k-1) for the checkpoint of an open MMUT segment
     std::vector<std::shared_ptr<PauliSpinorSquareMatrices<dcomplex>>> UH;
+
+    // Low-rank (occupied orbital) propagation, one entry per spin block
+    std::vector<std::vector<size_t>> nOccBlk; ///< Occupied orbitals of each system
+    std::vector<oper_t_coll>         COcc;    ///< Orthonormal occupied orbitals
+    std::vector<oper_t_coll>         COSav;   ///< Saved orbitals (MMUT / Magnus 2)
+    std::vector<SquareMatrix<dcomplex>> refMO; ///< Starting MOs (orbital populations)
     
   public:
 
@@ -192,6 +237,8 @@ namespace ChronusQ {
       alloc<RefMatsT>(); 
 
     }; // RealTime constructor
+
+    ~RealTime() { freeOccOrbitals(); }
   
     inline double totalEnergy(){
       //propagator_.computeEnergy();
@@ -199,25 +246,40 @@ namespace ChronusQ {
     }
 
     inline void formCoreH(EMPerturbation &emPert) {
-      return propagator_.formCoreH(emPert, false);
+      propagator_.formCoreH(emPert, false);
+      for( auto &rep : replicas_ ) rep->formCoreH(emPert, false);
     }
 
     inline std::vector<double> getGrad(EMPerturbation &emPert) {
       return propagator_.getGrad(emPert,false,false);
     }
 
+    inline _SSTyp<dcomplex,IntsT>& replica(size_t r) {
+      return r == 0 ? propagator_ : *replicas_[r-1];
+    }
+
     // RealTime procedural functions
     // RealTime procedural functions
     void doPropagation(); // From RealTimeBase
     void propagateStep();
     void formPropagator(size_t);
     void formFock(bool,double,size_t);
+    void formFock(bool,double);
     void updateAOProperties(double t);
     void propagateWFN(size_t);
     void saveState(EMPerturbation&);
     void restoreState(); 
+    void saveCheckpoint();
+    size_t restoreCheckpoint();
+    size_t orbitalPopPoints(size_t maxPoints);
     void createRTDataSets(size_t maxPoints);
     void orbitalPop();
+    void addReplica(const TDEMPerturbation&); // From RealTimeBase
+    void propagateSystems();
+    void formOccOrbitals();
+    void propagateOrbitals(size_t);
+    void occOrbitals2Den(size_t);
+    void completeOccOrbitals();
 
     // Progress functions
     void printRTHeader();
@@ -230,6 +292,8 @@ namespace ChronusQ {
     // Memory functions
     template <typename MatsT>
     void alloc();
+    void appendSystems(_SSTyp<dcomplex,IntsT>&, size_t);
+    void freeOccOrbitals();
 
   }; // class RealTime
   
@@ -51,7 +51,7 @@ namespace ChronusQ {
     ProgramTimer::timeOp("Form Fock", [&]() {
 
       // Get perturbation for the current time and build a Fock matrix
-      EMPerturbation pert_t = pert.getPert(t);
+      EMPerturbation pert_t = replicaField(sysReplica_[idx]).getPert(t);
 
       // Add on the SCF Perturbation
       if ( intScheme.includeSCFField )
@@ -64,6 +64,63 @@ namespace ChronusQ {
 
   };
 
+  /**
+   *  \brief Form the Fock matrices of all propagated systems at time t.
+   *
+   *  When several field replicas are propagated (and no NEO subsystems are
+   *  present), the G[D] contractions of all replicas share a single pass
+   *  over the two-body integrals through FockBuilder::formFockBatch. The
+   *  XC potential (if any) is formed separately for each replica.
+   *
+   *  \param [in] increment Whether the Fock matrices are being incremented
+   *  \param [in] t         Time at which the fields are evaluated
+   */
+  template <template <typename, typename> class _SSTyp, typename IntsT>
+  void RealTime<_SSTyp,IntsT>::formFock(bool increment, double t) {
+
+    if( nReplicas() == 1 or systems_.size() != nReplicas() ) {
+      for(auto idx = 0; idx < systems_.size(); idx++)
+        formFock(increment,t,idx);
+      return;
+    }
+
+    ProgramTimer::timeOp("Form Fock", [&]() {
+
+      std::vector<EMPerturbation> perts;
+      for(auto idx = 0; idx < systems_.size(); idx++) {
+
+        EMPerturbation pert_t = replicaField(sysReplica_[idx]).getPert(t);
+
+        if ( intScheme.includeSCFField )
+          for( auto& field : scfPert.fields )
+            pert_t.addField( field );
+
+        perts.push_back(pert_t);
+
+      }
+
+      auto ks = dynamic_cast<KohnSham<dcomplex,IntsT>*>(systems_[0]);
+      double xHFX = (ks and ks->functionals.size() != 0) ?
+        ks->functionals.back()->xHFX : 1.;
+
+      propagator_.fockBuilder->formFockBatch(systems_, perts, increment, xHFX);
+
+      if( not ks ) return;
+
+      for(auto idx = 0; idx < systems_.size(); idx++) {
+
+        auto ksIdx = dynamic_cast<KohnSham<dcomplex,IntsT>*>(systems_[idx]);
+        if( not ksIdx->doVXC_ ) continue;
+
+        ksIdx->formVXC();
+        if( MPIRank(ksIdx->comm) == 0 ) *ksIdx->fockMatrix += *ksIdx->VXC;
+
+      }
+
+    });
+
+  };
+
 }; // namespace ChronusQ
 
 
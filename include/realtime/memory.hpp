@@ -31,10 +31,25 @@ namespace ChronusQ {
   template <typename MatsT>
   void RealTime<_SSTyp,IntsT>::alloc() {
 
+    appendSystems(propagator_, 0);
+
+  };
+
+  /**
+   *  \brief Append the propagated subsystems of a (replica of the)
+   *  propagator to systems_ and allocate their storage.
+   *
+   *  \param [in] prop    Complex SingleSlater object to propagate
+   *  \param [in] replica Index of the replica which owns prop
+   */ 
+  template <template <typename, typename> class _SSTyp, typename IntsT>
+  void RealTime<_SSTyp,IntsT>::appendSystems(_SSTyp<dcomplex,IntsT> &prop,
+    size_t replica) {
+
     // XXX: Member functions can't be partially specialized,
     //   so we're just going to cram this all into a single if statement...
     if( std::is_same<NEOSS<dcomplex,IntsT>,_SSTyp<dcomplex,IntsT>>::value ) {
-      auto prop_c = dynamic_cast<NEOSS<dcomplex,IntsT>*>(&propagator_);
+      auto prop_c = dynamic_cast<NEOSS<dcomplex,IntsT>*>(&prop);
       auto map = prop_c->getSubsystemMap();
       auto order = prop_c->getOrder();
 
@@ -52,6 +67,7 @@ namespace ChronusQ {
         bool hasXY= system->onePDM->hasXY();
 
         systems_.push_back(system.get());
+        sysReplica_.push_back(replica);
 
         DOSav.push_back(
           std::make_shared<PauliSpinorSquareMatrices<dcomplex>>(
@@ -67,11 +83,12 @@ namespace ChronusQ {
     }
     else {
 
-      size_t NB = propagator_.onePDM->dimension();
-      bool hasZ = propagator_.onePDM->hasZ();
-      bool hasXY= propagator_.onePDM->hasXY();
+      size_t NB = prop.onePDM->dimension();
+      bool hasZ = prop.onePDM->hasZ();
+      bool hasXY= prop.onePDM->hasXY();
 
-      systems_.push_back(&propagator_);
+      systems_.push_back(&prop);
+      sysReplica_.push_back(replica);
 
       DOSav.emplace_back(
         std::make_shared<PauliSpinorSquareMatrices<dcomplex>>(
@@ -86,6 +103,47 @@ namespace ChronusQ {
 
   };
 
+
+  /**
+   *  \brief Add an independent propagation replica driven by its own
+   *  TD field.
+   *
+   *  The replica is a copy of the propagator in its current state, so it
+   *  shares the AO integrals, basis and DFT integration settings with the
+   *  propagator and only carries its own density / Fock storage.
+   *
+   *  \param [in] field TD perturbation for the new replica
+   */ 
+  template <template <typename, typename> class _SSTyp, typename IntsT>
+  void RealTime<_SSTyp,IntsT>::addReplica(const TDEMPerturbation &field) {
+
+    replicas_.emplace_back(
+      std::make_shared<_SSTyp<dcomplex,IntsT>>(propagator_));
+    replicaPert.push_back(field);
+    replicaData.emplace_back();
+
+    appendSystems(*replicas_.back(), replicas_.size());
+
+  };
+
+
+  /**
+   *  \brief Free the occupied orbital storage of the low-rank
+   *  propagation.
+   */ 
+  template <template <typename, typename> class _SSTyp, typename IntsT>
+  void RealTime<_SSTyp,IntsT>::freeOccOrbitals() {
+
+    for(auto idx = 0; idx < COcc.size(); idx++)
+    for(auto b = 0; b < COcc[idx].size(); b++) {
+      if( COcc[idx][b] )  memManager_.free(COcc[idx][b]);
+      if( COSav[idx][b] ) memManager_.free(COSav[idx][b]);
+    }
+
+    COcc.clear(); COSav.clear(); nOccBlk.clear(); refMO.clear();
+
+  };
+
 }; // namespace ChronusQ
 
 
@@ -154,6 +154,38 @@ namespace ChronusQ {
       expString = "Taylor Expansion";
 
     RTFormattedLine(std::cout,"Matrix Exponential Method:",expString);
+
+    RTFormattedLine(std::cout,"Propagated Quantity:", intScheme.orbitalProp ?
+      "Occupied Orbitals (Low-Rank)" : "Density Matrix");
+
+    if( nReplicas() > 1 ) {
+      RTFormattedLine(std::cout,"Independent Replicas:",nReplicas());
+      for(auto r = 0; r < nReplicas(); r++) {
+        if( replicaField(r).fields.empty() ) continue;
+        auto amp = replicaField(r).getDipoleAmp(Electric,
+          replicaField(r).fields[0]->envelope->tOn);
+        RTFormattedLine(std::cout,"  Replica " + std::to_string(r) + 
+          " Field (AU):", "{ " + std::to_string(amp[0]) + ", " + 
+          std::to_string(amp[1]) + ", " + std::to_string(amp[2]) + " }");
+      }
+    }
+
+    if( intScheme.nTeams > 1 )
+      RTFormattedLine(std::cout,"Propagation Thread Teams:",intScheme.nTeams);
+
+    if( specSettings.doSpectrum ) {
+      std::cout << std::endl;
+      RTFormattedLine(std::cout,"* On-the-fly Spectrum:");
+      RTFormattedLine(std::cout,"Frequency Window:", "[ " + 
+        std::to_string(specSettings.omegaMin) + ", " + 
+        std::to_string(specSettings.omegaMax) + " ]"," Eh");
+      RTFormattedLine(std::cout,"Frequency Points:",specSettings.nOmega);
+      RTFormattedLine(std::cout,"Damping:",specSettings.damping," Eh");
+      if( specSettings.padeOrder > 0 )
+        RTFormattedLine(std::cout,"Max Pade Order:",specSettings.padeOrder);
+      if( specSettings.convTol > 0. )
+        RTFormattedLine(std::cout,"Peak Convergence:",specSettings.convTol," Eh");
+    }
     
     std::cout << std::endl << BannerTop << std::endl;
 
@@ -28,10 +28,12 @@
 #include <cqlinalg/blas3.hpp>
 #include <cqlinalg/blasutil.hpp>
 #include <cqlinalg/matfunc.hpp>
+#include <cqlinalg/eig.hpp>
 #include <matrix.hpp>
 
 #include <util/matout.hpp>
 #include <util/timer.hpp>
+#include <util/threads.hpp>
 #include <unsupported/Eigen/MatrixFunctions>
 
 template <size_t N, typename T>
@@ -53,6 +55,12 @@ namespace ChronusQ {
 
     printRTHeader();
 
+    // Set up the on-the-fly spectra (refilled from the checkpoint on restart)
+    spectra.clear();
+    if( specSettings.doSpectrum )
+      for(auto r = 0; r < nReplicas(); r++)
+        spectra.emplace_back(specSettings, intScheme.deltaT);
+
     if ( savFile.exists() )
       if ( restart )
         restoreState();
@@ -64,6 +72,9 @@ namespace ChronusQ {
       systems_[idx]->ortho2aoMOs();
     }
 
+    // Low-rank propagation: extract the occupied orbitals from DO
+    if( intScheme.orbitalProp ) formOccOrbitals();
+
     bool Start(false); // Start the MMUT iterations
     bool FinMM(false); // Wrap up the MMUT iterations
 
@@ -90,23 +101,35 @@ namespace ChronusQ {
 
         // "Start" the MMUT if this is the first step or we just
         // "Finished" the MMUT segment
-        Start = ( curState.iStep == intScheme.restoreStep ) or FinMM;
+        // (unless resuming a MMUT segment from a checkpoint)
+        Start = ( curState.iStep == intScheme.restoreStep and
+                  not intScheme.restoreMMUT ) or FinMM;
 
         // "Start" the MMUT if the current step index is a restart
         // step
         if( intScheme.iRstrt > 0 ) 
           Start = Start or ( curState.iStep % intScheme.iRstrt == 0 );
 
-        // "Finish" the MMUT if this is the last step
-        // NOTE: To compare to Gaussian, do NOT do this restart for Ehrenfest
-        FinMM = ( curState.iStep == maxStep );
-
         // TODO: "Finish" the MMUT if the field turns on or off
-        FinMM = FinMM or pert.isFieldDiscontinuous(curState.xTime, intScheme.deltaT);
+        bool segEnd = false;
+        for(auto r = 0; r < nReplicas(); r++)
+          segEnd = segEnd or 
+            replicaField(r).isFieldDiscontinuous(curState.xTime, intScheme.deltaT);
           
         // "Finish" the MMUT if the next step will be a restart step
         if( intScheme.iRstrt > 0 ) 
-          FinMM = FinMM or ( (curState.iStep + 1) % intScheme.iRstrt == 0 );
+          segEnd = segEnd or ( (curState.iStep + 1) % intScheme.iRstrt == 0 );
+
+        // "Finish" the MMUT if this is the last step
+        // NOTE: To compare to Gaussian, do NOT do this restart for Ehrenfest
+        FinMM = ( curState.iStep == maxStep ) or segEnd;
+
+        // A segment which is only finished by the end of the run is
+        // checkpointed with DO(k-1), so that an extended run continues
+        // the leapfrog
+        curState.openMMUT = curState.iStep == maxStep and not segEnd and
+          not Start and curState.iStep > intScheme.restoreStep and
+          not intScheme.orbitalProp;
 
         // If "Starting" or "Finishing" the MMUT, the step type is
         // the specified restart step type, else it is the MMUT step
@@ -147,6 +170,10 @@ namespace ChronusQ {
           DOSav[idx] = systems_[idx]->onePDMOrtho;
           systems_[idx]->onePDMOrtho = tmp;
 
+          // COSav(k) = CO(k)
+          // CO(k)    = CO(k-1)
+          if( intScheme.orbitalProp ) std::swap(COcc[idx], COSav[idx]);
+
 
           curState.stepSize = 2. * intScheme.deltaT;
 
@@ -154,8 +181,23 @@ namespace ChronusQ {
           // Save a copy of the SingleSlater density in the saved density
           // storage
 
+          // DOPrev = DO(k-1) for the checkpoint
+          if( curState.openMMUT ) {
+            DOPrev.resize(systems_.size());
+            DOPrev[idx] = std::make_shared<PauliSpinorSquareMatrices<dcomplex>>(
+              *DOSav[idx]);
+          }
+
           // DOSav(k) = DO(k)
           *DOSav[idx] = *systems_[idx]->onePDMOrtho;
+
+          // COSav(k) = CO(k)
+          if( intScheme.orbitalProp ) {
+            size_t N = systems_[idx]->onePDMOrtho->dimension();
+            if( systems_[idx]->onePDMOrtho->hasXY() ) N *= 2;
+            for(auto b = 0; b < COcc[idx].size(); b++)
+              std::copy_n(COcc[idx][b], N*nOccBlk[idx][b], COSav[idx][b]);
+          }
      
           curState.stepSize = intScheme.deltaT;
 
@@ -163,12 +205,14 @@ namespace ChronusQ {
       }
 
       // Form the Fock matrix at the current time
-      for(auto idx = 0; idx < systems_.size(); idx++) {
-        this->formFock(false,curState.xTime,idx);
-      }
+      this->formFock(false,curState.xTime);
 
       // Compute properties for D(k) 
       propagator_.computeProperties(pert_t);
+      for(auto r = 1; r < nReplicas(); r++) {
+        EMPerturbation pert_r = replicaField(r).getPert(curState.xTime);
+        replica(r).computeProperties(pert_r);
+      }
 
       // Save data
       // TODO: Fix this when we have a stable definition of MD + electronic steps
@@ -192,63 +236,54 @@ namespace ChronusQ {
         orbitalPop();
       }
 
+      // Stop once the peaks of the spectrum have converged
+      if( curState.specConverged ) {
+        if( printLevel > 0 )
+          std::cout << "  *** Spectrum converged, terminating propagation ***\n";
+        ProgramTimer::tock("Real Time Iter");
+        break;
+      }
 
 
 
-      for(auto idx = 0; idx < systems_.size(); idx++) {
-        // Orthonormalize the AO Fock matrix
-        // F(k) -> FO(k)
-        systems_[idx]->ao2orthoFock();
-
-
-        // Form the propagator from the orthonormal Fock matrix
-        // FO(k) -> U**H(k) = exp(- i * dt * FO(k) )
-        formPropagator(idx);
-
-        // Propagator the orthonormal density matrix
-        // DO (in propagator_) will now store DO(k+1)
-        //
-        // DO(k+1) = U**H(k) * DO * U(k)
-        // - Where DO is what is currently stored in propagator_
-        //
-        // ***
-        // This function also transforms DO(k+1) to the AO
-        // basis ( DO(k+1) -> D(k+1) in propagator_ ) and
-        // computes the change in density from the previous 
-        // AO density ( delD = D(k+1) - D(k) ) 
-        // ***
-        propagateWFN(idx);
-      }
+
+      // Propagate all systems (and replicas) to the next step
+      propagateSystems();
 
       //
       // Second order magnus
       //
       if ( curState.curStep == ExplicitMagnus2 ) {
 
-        for(auto idx = 0; idx < systems_.size(); idx++) {
-          // F(k)
-          PauliSpinorSquareMatrices<dcomplex> fock_k(*systems_[idx]->fockMatrix);
+        // F(k)
+        std::vector<PauliSpinorSquareMatrices<dcomplex>> fock_k;
+        for(auto idx = 0; idx < systems_.size(); idx++)
+          fock_k.emplace_back(*systems_[idx]->fockMatrix);
           
-          // F(k + 1)
-          formFock(false, curState.xTime + intScheme.deltaT, idx);
+        // F(k + 1)
+        formFock(false, curState.xTime + intScheme.deltaT);
 
-          // Store 0.5 * ( F(k) + F(k+1) ) in propagator_.fockMatrix
-          *systems_[idx]->fockMatrix = 0.5 * (fock_k + *systems_[idx]->fockMatrix);
-        }
+        // Store 0.5 * ( F(k) + F(k+1) ) in propagator_.fockMatrix
+        for(auto idx = 0; idx < systems_.size(); idx++)
+          *systems_[idx]->fockMatrix = 0.5 * (fock_k[idx] + *systems_[idx]->fockMatrix);
 
 
         for(auto idx = 0; idx < systems_.size(); idx++) {
           // Restore old densities
           *systems_[idx]->onePDM = *den_k[idx];
           *systems_[idx]->onePDMOrtho = *denOrtho_k[idx];
+
+          // Restore CO(k) = COSav(k)
+          if( intScheme.orbitalProp ) {
+            size_t N = systems_[idx]->onePDMOrtho->dimension();
+            if( systems_[idx]->onePDMOrtho->hasXY() ) N *= 2;
+            for(auto b = 0; b < COcc[idx].size(); b++)
+              std::copy_n(COSav[idx][b], N*nOccBlk[idx][b], COcc[idx][b]);
+          }
         }
 
         // Repeat formation of propagator and propagation
-        for(auto idx = 0; idx < systems_.size(); idx++) {
-          systems_[idx]->ao2orthoFock();
-          formPropagator(idx);
-          propagateWFN(idx);
-        }
+        propagateSystems();
 
       }  // End 2nd order magnus
 
@@ -256,6 +291,8 @@ namespace ChronusQ {
 
     } // Time loop
 
+    if( intScheme.orbitalProp ) completeOccOrbitals();
+
 
     ProgramTimer::tock("Real Time Total");
 
@@ -265,6 +302,110 @@ namespace ChronusQ {
   }; // RealTime::doPropagation
 
 
+  /**
+   *  \brief Propagate the orthonormal densities of all systems by
+   *  one step using their current AO Fock matrices.
+   *
+   *  For each system:
+   *
+   *    F(k) -> FO(k) -> U**H(k) = exp(- i * dt * FO(k) )
+   *    DO(k+1) = U**H(k) * DO * U(k)
+   *
+   *  The systems (NEO subsystems and field replicas) are independent
+   *  at this point, so if more than one thread team is requested they
+   *  are distributed over teams of GetNumThreads() / nTeams threads
+   *  each.
+   *
+   *  The linear algebra of a team only runs threaded within the outer
+   *  OpenMP loop with nested parallelism, which is enabled here for the
+   *  duration of the loop. With MKL the team size is set per thread and
+   *  dynamic adjustment is disabled; OpenBLAS runs BLAS calls inside an
+   *  OpenMP region on a single thread, so with OpenBLAS each team only
+   *  threads its OpenMP loops (NTEAMS should then match the number of
+   *  systems).
+   */ 
+  template <template <typename, typename> class _SSTyp, typename IntsT>
+  void RealTime<_SSTyp,IntsT>::propagateSystems() {
+
+    size_t nSys   = systems_.size();
+    size_t nTeams = std::min(intScheme.nTeams, nSys);
+
+    auto propagateOne = [&](size_t idx) {
+
+      // Orthonormalize the AO Fock matrix
+      // F(k) -> FO(k)
+      systems_[idx]->ao2orthoFock();
+
+      // Form the propagator from the orthonormal Fock matrix
+      // FO(k) -> U**H(k) = exp(- i * dt * FO(k) )
+      formPropagator(idx);
+
+      // Propagator the orthonormal density matrix
+      // DO (in propagator_) will now store DO(k+1)
+      //
+      // DO(k+1) = U**H(k) * DO * U(k)
+      // - Where DO is what is currently stored in propagator_
+      //
+      // ***
+      // This function also transforms DO(k+1) to the AO
+      // basis ( DO(k+1) -> D(k+1) in propagator_ ) and
+      // computes the change in density from the previous 
+      // AO density ( delD = D(k+1) - D(k) ) 
+      // ***
+      //
+      // In the low-rank representation only the occupied orbitals are
+      // propagated, CO(k+1) = U**H(k) * CO, and DO(k+1) is rebuilt from
+      // them
+      if( intScheme.orbitalProp ) propagateOrbitals(idx);
+      else                        propagateWFN(idx);
+
+    };
+
+    if( nTeams <= 1 ) {
+
+      for(size_t idx = 0; idx < nSys; idx++) propagateOne(idx);
+
+    } else {
+
+      size_t LAThreads = GetLAThreads();
+      size_t teamSize  = std::max(GetNumThreads() / nTeams, size_t(1));
+
+#ifdef _OPENMP
+      int maxLevels = omp_get_max_active_levels();
+      omp_set_max_active_levels(std::max(maxLevels,2));
+#endif
+#ifdef _CQ_MKL
+      int mklDynamic = mkl_get_dynamic();
+      mkl_set_dynamic(0);
+#endif
+
+      SetLAThreads(teamSize);
+
+      #pragma omp parallel for num_threads(nTeams) schedule(dynamic,1)
+      for(size_t idx = 0; idx < nSys; idx++) {
+#ifdef _CQ_MKL
+        mkl_set_num_threads_local(teamSize);
+#endif
+        propagateOne(idx);
+#ifdef _CQ_MKL
+        mkl_set_num_threads_local(0); // Back to the global setting
+#endif
+      }
+
+      SetLAThreads(LAThreads);
+
+#ifdef _CQ_MKL
+      mkl_set_dynamic(mklDynamic);
+#endif
+#ifdef _OPENMP
+      omp_set_max_active_levels(maxLevels);
+#endif
+
+    }
+
+  }; // RealTime::propagateSystems
+
+
   /**
    *  \brief Form the adjoint of the unitary propagator
    *
@@ -447,6 +588,217 @@ namespace ChronusQ {
   }; // RealTime::propagatorWFN
 
 
+  /**
+   *  \brief Extract the orthonormal occupied orbitals of every system
+   *  from its (idempotent) orthonormal density for the low-rank
+   *  propagation.
+   *
+   *  Each spin block (alpha for restricted, alpha / beta for
+   *  unrestricted, the full spinor density for 2C) is diagonalized and
+   *  the eigenvectors with unit occupation are kept.
+   */ 
+  template <template <typename, typename> class _SSTyp, typename IntsT>
+  void RealTime<_SSTyp,IntsT>::formOccOrbitals() {
+
+    freeOccOrbitals();
+
+    // The occupied MOs are overwritten during the propagation, orbital
+    // populations project onto the starting MOs as for the density
+    refMO = propagator_.mo;
+
+    for(auto idx = 0; idx < systems_.size(); idx++) {
+
+      if( systems_[idx]->nC == 4 )
+        CErr("Occupied orbital propagation NYI for 4C references");
+
+      auto &DO = *systems_[idx]->onePDMOrtho;
+
+      std::vector<SquareMatrix<dcomplex>> DBlk;
+      if( DO.hasXY() ) DBlk.push_back(DO.template spinGather<dcomplex>());
+      else             DBlk = DO.template spinGatherToBlocks<dcomplex>(false, DO.hasZ());
+
+      nOccBlk.emplace_back();
+      COcc.emplace_back();
+      COSav.emplace_back();
+
+      for(auto &D : DBlk) {
+
+        size_t N = D.dimension();
+        std::vector<double> W(N);
+
+        HermetianEigen('V','U',N,D.pointer(),N,W.data(),memManager_);
+
+        for(auto &w : W)
+          if( std::abs(w) > 1e-6 and std::abs(w - 1.) > 1e-6 )
+            CErr("Occupied orbital propagation requires an idempotent density");
+
+        // Eigenvalues are ascending, occupied orbitals are last
+        size_t nVirt = std::count_if(W.begin(), W.end(),
+          [](double w){ return w < 0.5; });
+        size_t nOcc  = N - nVirt;
+
+        dcomplex *C = nullptr, *CSav = nullptr;
+        if( nOcc > 0 ) {
+          C    = memManager_.template malloc<dcomplex>(N*nOcc);
+          CSav = memManager_.template malloc<dcomplex>(N*nOcc);
+          std::copy_n(D.pointer() + nVirt*N, N*nOcc, C);
+        }
+
+        nOccBlk.back().push_back(nOcc);
+        COcc.back().push_back(C);
+        COSav.back().push_back(CSav);
+
+      }
+
+      occOrbitals2Den(idx);
+
+    }
+
+  }; // RealTime::formOccOrbitals
+
+
+  /**
+   *  \brief Propagate the occupied orbitals of a system with the current
+   *  propagator
+   *
+   *  CO(k+1) = U**H(k) * CO
+   *
+   *  which costs NB**2 * NOcc per spin block instead of the NB**3 of the
+   *  density propagation.
+   */ 
+  template <template <typename, typename> class _SSTyp, typename IntsT>
+  void RealTime<_SSTyp,IntsT>::propagateOrbitals(size_t idx) {
+
+    ProgramTimer::tick("Propagate WFN");
+
+    // U**H for each spin block (0.5 * U(S) for restricted)
+    std::vector<SquareMatrix<dcomplex>> UBlk;
+    if( UH[idx]->hasXY() ) UBlk.push_back(UH[idx]->template spinGather<dcomplex>());
+    else UBlk = UH[idx]->template spinGatherToBlocks<dcomplex>(false, UH[idx]->hasZ());
+
+    for(auto b = 0; b < COcc[idx].size(); b++) {
+
+      size_t N    = UBlk[b].dimension();
+      size_t nOcc = nOccBlk[idx][b];
+      if( nOcc == 0 ) continue;
+
+      dcomplex *SCR = memManager_.template malloc<dcomplex>(N*nOcc);
+
+      blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,
+        N,nOcc,N,dcomplex(1.),UBlk[b].pointer(),N,COcc[idx][b],N,
+        dcomplex(0.),SCR,N);
+
+      std::copy_n(SCR, N*nOcc, COcc[idx][b]);
+      memManager_.free(SCR);
+
+    }
+
+    occOrbitals2Den(idx);
+
+    ProgramTimer::tock("Propagate WFN");
+
+  }; // RealTime::propagateOrbitals
+
+
+  /**
+   *  \brief Rebuild the orthonormal and AO densities of a system from
+   *  its occupied orbitals, DO = CO * CO**H.
+   *
+   *  The occupied columns of the AO MOs are updated as well, so that
+   *  MO-driven exchange builds (RI) see the propagated orbitals. The
+   *  virtual columns are only made consistent with them at the end of
+   *  the propagation (completeOccOrbitals).
+   */ 
+  template <template <typename, typename> class _SSTyp, typename IntsT>
+  void RealTime<_SSTyp,IntsT>::occOrbitals2Den(size_t idx) {
+
+    auto &sys = *systems_[idx];
+    bool hasXY = sys.onePDMOrtho->hasXY();
+
+    size_t N = sys.onePDMOrtho->dimension();
+    if( hasXY ) N *= 2;
+
+    std::vector<SquareMatrix<dcomplex>> DBlk;
+    for(auto b = 0; b < COcc[idx].size(); b++) {
+
+      size_t nOcc = nOccBlk[idx][b];
+      DBlk.emplace_back(memManager_, N);
+
+      if( nOcc == 0 ) { DBlk.back().clear(); continue; }
+
+      blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::ConjTrans,
+        N,N,nOcc,dcomplex(1.),COcc[idx][b],N,COcc[idx][b],N,
+        dcomplex(0.),DBlk.back().pointer(),N);
+
+      if( b < sys.mo.size() )
+        blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,
+          N,nOcc,N,dcomplex(1.),sys.orthoAB->forwardPointer()->pointer(),N,
+          COcc[idx][b],N,dcomplex(0.),sys.mo[b].pointer(),N);
+
+    }
+
+    if( hasXY )
+      *sys.onePDMOrtho = DBlk[0].template spinScatter<dcomplex>();
+    else if( DBlk.size() == 2 )
+      *sys.onePDMOrtho = PauliSpinorSquareMatrices<dcomplex>::
+        spinBlockScatterBuild<dcomplex>(DBlk[0],DBlk[1]);
+    else
+      *sys.onePDMOrtho = PauliSpinorSquareMatrices<dcomplex>::
+        spinBlockScatterBuild<dcomplex>(DBlk[0]);
+
+    sys.ortho2aoDen();
+
+  }; // RealTime::occOrbitals2Den
+
+
+  /**
+   *  \brief Complete the propagated occupied AO MOs of every system by
+   *  an orthonormal set of virtual orbitals.
+   *
+   *  The virtual orbitals are the null space of DO = CO * CO**H (the
+   *  time evolution only defines the virtual space, not the individual
+   *  virtual orbitals), so that the AO MOs are a valid orthonormal set
+   *  spanning the propagated occupied space after the propagation.
+   */ 
+  template <template <typename, typename> class _SSTyp, typename IntsT>
+  void RealTime<_SSTyp,IntsT>::completeOccOrbitals() {
+
+    for(auto idx = 0; idx < systems_.size(); idx++) {
+
+      auto &sys = *systems_[idx];
+
+      size_t N = sys.onePDMOrtho->dimension();
+      if( sys.onePDMOrtho->hasXY() ) N *= 2;
+
+      for(auto b = 0; b < COcc[idx].size() and b < sys.mo.size(); b++) {
+
+        size_t nOcc = nOccBlk[idx][b];
+        if( nOcc == 0 or nOcc == N ) continue;
+
+        SquareMatrix<dcomplex> D(memManager_, N), C(memManager_, N);
+        std::vector<double> W(N);
+
+        blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::ConjTrans,
+          N,N,nOcc,dcomplex(1.),COcc[idx][b],N,COcc[idx][b],N,
+          dcomplex(0.),D.pointer(),N);
+
+        HermetianEigen('V','U',N,D.pointer(),N,W.data(),memManager_);
+
+        // Occupied orbitals first, then the (ascending) null space of DO
+        std::copy_n(COcc[idx][b], N*nOcc, C.pointer());
+        std::copy_n(D.pointer(), N*(N-nOcc), C.pointer() + N*nOcc);
+
+        blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,
+          N,N,N,dcomplex(1.),sys.orthoAB->forwardPointer()->pointer(),N,
+          C.pointer(),N,dcomplex(0.),sys.mo[b].pointer(),N);
+
+      }
+
+    }
+
+  }; // RealTime::completeOccOrbitals
+
+
   template <template <typename, typename> class _SSTyp, typename IntsT>
   void RealTime<_SSTyp,IntsT>::createRTDataSets(size_t maxPoints) {
 
@@ -462,48 +814,145 @@ namespace ChronusQ {
     savFile.createDataSet<double>("RT/LEN_ELEC_DIPOLE", {maxPoints,3});
     savFile.createDataSet<double>("RT/LEN_ELEC_DIPOLE_FIELD", {maxPoints,3});
 
+    // Replicas share RT/TIME
+    for(auto r = 1; r < nReplicas(); r++) {
+      std::string prefix = "RT/REPLICA" + std::to_string(r);
+      savFile.createGroup(prefix);
+      savFile.createDataSet<double>(prefix + "/ENERGY", {maxPoints});
+      savFile.createDataSet<double>(prefix + "/LEN_ELEC_DIPOLE", {maxPoints,3});
+      savFile.createDataSet<double>(prefix + "/LEN_ELEC_DIPOLE_FIELD", {maxPoints,3});
+    }
+
     if( this->orbitalPopFreq != 0 ) {
-      hsize_t nPop = (maxPoints / this->orbitalPopFreq);
-      if( this->orbitalPopFreq != 1 &&
-          (maxPoints-1) % this->orbitalPopFreq == 0 )
-        nPop += 1;
-      if( maxPoints == 1 )
-        nPop = 1;
+      hsize_t nPop  = orbitalPopPoints(maxPoints);
       hsize_t nOrbs = propagator_.nOrbital();
       savFile.createDataSet<double>("RT/ORBITALPOPULATION", {nPop, nOrbs});
     }
   }; // RealTime::createRTDataSets
 
 
+  /**
+   *  \brief Number of orbital population records for a propagation
+   *  with maxPoints time points.
+   */ 
+  template <template <typename, typename> class _SSTyp, typename IntsT>
+  size_t RealTime<_SSTyp,IntsT>::orbitalPopPoints(size_t maxPoints) {
+
+    size_t nPop = (maxPoints / this->orbitalPopFreq);
+    if( this->orbitalPopFreq != 1 &&
+        (maxPoints-1) % this->orbitalPopFreq == 0 )
+      nPop += 1;
+    if( maxPoints == 1 )
+      nPop = 1;
+
+    return nPop;
+
+  }; // RealTime::orbitalPopPoints
+
+
+  /**
+   *  \brief Restore the state of the propagation from the binary file.
+   *
+   *  Files with an RT/CHECKPOINT group restart from the checkpointed step
+   *  with the integrator state (e.g. the previous MMUT density), so that
+   *  the propagation continues at full order. Older files restart from
+   *  the last saved time point with the restart step. In either case the
+   *  saved time series are resized if RT.TMAX has changed, so that runs
+   *  may be extended (or shortened).
+   */ 
   template <template <typename, typename> class _SSTyp, typename IntsT>
   void RealTime<_SSTyp,IntsT>::restoreState() {
 
     hsize_t maxPoints = intScheme.tMax / intScheme.deltaT + 1;
 
-    if ( savFile.getDims("RT/TIME")[0] != maxPoints )
-      CErr("Mismatched requested and saved propagation length!");
-
-    // Restore time dependent density
-    try {
-      savFile.readData("RT/TD_1PDM", *propagator_.onePDM);
-      savFile.readData("RT/TD_1PDM_ORTHO", *propagator_.onePDMOrtho);
-    } catch(...) { }
-
-    // Find last time step that was checkpointed
-    double* timeData = memManager_.template malloc<double>(maxPoints);
-    savFile.readData("RT/TIME", timeData);
-    int offset = *timeData < 1e-10 ? -1 : 0;
-    size_t restoreStep = offset + std::distance( timeData, 
-      std::find_if( timeData+1, timeData+maxPoints,
-        [](double x){ return x < 1e-10; }
-      )
-    );
-    memManager_.free(timeData);
+    auto timeDims = savFile.getDims("RT/TIME");
+    if( timeDims.empty() )
+      CErr("No RT data to restart from in " + savFile.fName());
+
+    hsize_t savPoints = timeDims[0];
+
+    std::vector<double> timeData(savPoints);
+    savFile.readData("RT/TIME", timeData.data());
+
+    size_t restoreStep;
+    if( not savFile.getDims("RT/CHECKPOINT/STEP").empty() ) {
+
+      restoreStep = restoreCheckpoint();
+
+    } else {
+
+      // Restore time dependent density
+      try {
+        savFile.readData("RT/TD_1PDM", *propagator_.onePDM);
+        savFile.readData("RT/TD_1PDM_ORTHO", *propagator_.onePDMOrtho);
+      } catch(...) { }
+
+      for(auto r = 1; r < nReplicas(); r++) {
+        std::string prefix = "RT/REPLICA" + std::to_string(r);
+        try {
+          savFile.readData(prefix + "/TD_1PDM", *replica(r).onePDM);
+          savFile.readData(prefix + "/TD_1PDM_ORTHO", *replica(r).onePDMOrtho);
+        } catch(...) { }
+      }
+
+      // Last time point that was saved: times increase monotonically
+      // from t = 0 and unsaved points are zero
+      restoreStep = std::distance( timeData.begin(),
+        std::partition_point( timeData.begin() + 1, timeData.end(),
+          [](double x){ return x >= 1e-10; }
+        )
+      ) - 1;
+
+    }
+
+    if( restoreStep >= maxPoints )
+      CErr("Saved propagation already extends beyond RT.TMAX");
+
+    // Replay the checkpointed dipoles through the spectrum accumulators
+    if( not spectra.empty() and restoreStep > 0 ) {
+
+      std::vector<double> dipData(3*savPoints);
+      for(auto r = 0; r < spectra.size(); r++) {
+
+        savFile.readData(r == 0 ? std::string("RT/LEN_ELEC_DIPOLE") :
+          "RT/REPLICA" + std::to_string(r) + "/LEN_ELEC_DIPOLE", dipData.data());
+
+        for(auto i = 0ul; i < restoreStep; i++)
+          spectra[r].addSample(timeData[i],
+            {dipData[3*i], dipData[3*i+1], dipData[3*i+2]});
+
+      }
+
+    }
+
+    // Extend (or shorten) the saved time series to the requested length
+    if( savPoints != maxPoints ) {
+
+      std::vector<std::string> series = { "RT/TIME", "RT/ENERGY",
+        "RT/LEN_ELEC_DIPOLE", "RT/LEN_ELEC_DIPOLE_FIELD" };
+
+      for(auto r = 1; r < nReplicas(); r++) {
+        std::string prefix = "RT/REPLICA" + std::to_string(r);
+        series.push_back(prefix + "/ENERGY");
+        series.push_back(prefix + "/LEN_ELEC_DIPOLE");
+        series.push_back(prefix + "/LEN_ELEC_DIPOLE_FIELD");
+      }
+
+      for(auto &dataSet : series)
+        savFile.resizeDataSet<double>(dataSet, maxPoints);
+
+      if( this->orbitalPopFreq != 0 )
+        savFile.resizeDataSet<double>("RT/ORBITALPOPULATION",
+          orbitalPopPoints(maxPoints));
+
+    }
 
     if( printLevel > 0 ) {
       std::cout << "  *** Restoring from step " << restoreStep << " (";
       std::cout << std::setprecision(4) << restoreStep * intScheme.deltaT;
       std::cout << " AU) ***" << std::endl;
+      if( intScheme.restoreMMUT )
+        std::cout << "  *** Resuming MMUT from checkpoint ***" << std::endl;
     }
 
     intScheme.restoreStep = restoreStep;
@@ -511,6 +960,104 @@ namespace ChronusQ {
   }; // RealTime::restoreState
 
 
+  /**
+   *  \brief Write the integrator state to RT/CHECKPOINT.
+   *
+   *  Stores the orthonormal density of every propagated system at the
+   *  current step and, during a MMUT segment (or at the end of a run
+   *  inside one), the previous density DO(k-1) needed to resume the
+   *  leapfrog. STEP is removed first and written last, so that a
+   *  checkpoint which is interrupted while it is rewritten is not
+   *  picked up (the restart then falls back to the last saved point).
+   */ 
+  template <template <typename, typename> class _SSTyp, typename IntsT>
+  void RealTime<_SSTyp,IntsT>::saveCheckpoint() {
+
+    int32_t version  = checkpointVersion;
+    int32_t stepType = curState.openMMUT ? ModifiedMidpoint : curState.curStep;
+    size_t  nSys     = systems_.size();
+
+    if( not savFile.getDims("RT/CHECKPOINT/STEP").empty() )
+      savFile.unlinkData("RT/CHECKPOINT/STEP");
+
+    savFile.safeWriteData("RT/CHECKPOINT/VERSION", &version, {1});
+    savFile.safeWriteData("RT/CHECKPOINT/DELTAT", &intScheme.deltaT, {1});
+    savFile.safeWriteData("RT/CHECKPOINT/NSYSTEMS", &nSys, {1});
+
+    for(auto idx = 0; idx < nSys; idx++) {
+
+      std::string prefix = "RT/CHECKPOINT/SYSTEM" + std::to_string(idx);
+
+      // For MMUT steps DOSav holds DO(k) and the SingleSlater DO(k-1)
+      if( curState.curStep == ModifiedMidpoint ) {
+        savFile.safeWriteData(prefix + "/TD_1PDM_ORTHO", *DOSav[idx]);
+        savFile.safeWriteData(prefix + "/TD_1PDM_ORTHO_PREV",
+          *systems_[idx]->onePDMOrtho);
+      } else if( curState.openMMUT ) {
+        savFile.safeWriteData(prefix + "/TD_1PDM_ORTHO",
+          *systems_[idx]->onePDMOrtho);
+        savFile.safeWriteData(prefix + "/TD_1PDM_ORTHO_PREV", *DOPrev[idx]);
+      } else
+        savFile.safeWriteData(prefix + "/TD_1PDM_ORTHO",
+          *systems_[idx]->onePDMOrtho);
+
+    }
+
+    savFile.safeWriteData("RT/CHECKPOINT/STEP_TYPE", &stepType, {1});
+    savFile.safeWriteData("RT/CHECKPOINT/TIME", &curState.xTime, {1});
+    savFile.safeWriteData("RT/CHECKPOINT/STEP", &curState.iStep, {1});
+
+  }; // RealTime::saveCheckpoint
+
+
+  /**
+   *  \brief Read the integrator state from RT/CHECKPOINT.
+   *
+   *  \returns The checkpointed step
+   */ 
+  template <template <typename, typename> class _SSTyp, typename IntsT>
+  size_t RealTime<_SSTyp,IntsT>::restoreCheckpoint() {
+
+    int32_t version, stepType;
+    double  savDeltaT;
+    size_t  nSys, step;
+
+    savFile.readData("RT/CHECKPOINT/VERSION", &version);
+    savFile.readData("RT/CHECKPOINT/DELTAT", &savDeltaT);
+    savFile.readData("RT/CHECKPOINT/NSYSTEMS", &nSys);
+    savFile.readData("RT/CHECKPOINT/STEP_TYPE", &stepType);
+    savFile.readData("RT/CHECKPOINT/STEP", &step);
+
+    if( version > checkpointVersion )
+      CErr("RT checkpoint was written by a newer version of ChronusQ");
+
+    if( std::abs(savDeltaT - intScheme.deltaT) > 1e-12 )
+      CErr("RT.DELTAT must match the checkpointed propagation");
+
+    if( nSys != systems_.size() )
+      CErr("RT checkpoint does not match the propagated systems");
+
+    // Orbital propagation restarts the MMUT from DO(k)
+    bool resumeMMUT = stepType == ModifiedMidpoint and
+      intScheme.intAlg == MMUT and not intScheme.orbitalProp;
+
+    for(auto idx = 0; idx < nSys; idx++) {
+
+      std::string prefix = "RT/CHECKPOINT/SYSTEM" + std::to_string(idx);
+
+      savFile.readData(prefix + "/TD_1PDM_ORTHO", *systems_[idx]->onePDMOrtho);
+      if( resumeMMUT )
+        savFile.readData(prefix + "/TD_1PDM_ORTHO_PREV", *DOSav[idx]);
+
+    }
+
+    intScheme.restoreMMUT = resumeMMUT;
+
+    return step;
+
+  }; // RealTime::restoreCheckpoint
+
+
   template <template <typename, typename> class _SSTyp, typename IntsT>
   void RealTime<_SSTyp,IntsT>::saveState(EMPerturbation& pert_t) {
     
@@ -521,6 +1068,40 @@ namespace ChronusQ {
     if( pert_t.fields.size() > 0 )
       data.ElecDipoleField.push_back( pert_t.getDipoleAmp(Electric) );
 
+    for(auto r = 1; r < nReplicas(); r++) {
+      EMPerturbation pert_r = replicaField(r).getPert(curState.xTime);
+      IntegrationData &rData = replicaRecord(r);
+      rData.Time.push_back(curState.xTime);
+      rData.Energy.push_back(replica(r).totalEnergy);
+      rData.ElecDipole.push_back(replica(r).elecDipole);
+      if( pert_r.fields.size() > 0 )
+        rData.ElecDipoleField.push_back( pert_r.getDipoleAmp(Electric) );
+    }
+
+    // Update the spectra and check their peaks at every checkpoint
+    for(auto r = 0; r < spectra.size(); r++)
+      spectra[r].addSample(curState.xTime, replicaRecord(r).ElecDipole.back());
+
+    if( not spectra.empty() and specSettings.convTol > 0. and
+        curState.iStep % intScheme.iSave == 0 and
+        curState.iStep != intScheme.restoreStep ) {
+
+      curState.specConverged = true;
+      for(auto r = 0; r < spectra.size(); r++) {
+
+        curState.specConverged = spectra[r].checkConvergence() and
+          curState.specConverged;
+
+        if( printLevel > 1 ) {
+          std::cout << "  *** Spectrum peaks (Eh) for replica " << r << ":";
+          for(auto &pk : spectra[r].peaks) std::cout << " " << pk;
+          std::cout << " ***" << std::endl;
+        }
+
+      }
+
+    }
+
     // Write to file
     if( savFile.exists() ) {
 
@@ -556,6 +1137,40 @@ namespace ChronusQ {
           savFile.safeWriteData("RT/TD_1PDM_ORTHO",*DOSav[0]);
         else
           savFile.safeWriteData("RT/TD_1PDM_ORTHO",*propagator_.onePDMOrtho);
+
+        for(auto r = 1; r < nReplicas(); r++) {
+
+          std::string prefix = "RT/REPLICA" + std::to_string(r);
+          IntegrationData &rData = replicaRecord(r);
+
+          savFile.partialWriteData(prefix + "/ENERGY", &rData.Energy[0],
+            {lastPos}, {nSteps}, {memLastPos}, {rData.Time.size()});
+          savFile.partialWriteData(prefix + "/LEN_ELEC_DIPOLE",
+            &rData.ElecDipole[0][0], {lastPos, 0}, {nSteps, 3},
+            {memLastPos, 0}, {rData.Time.size(), 3});
+
+          if( rData.ElecDipoleField.size() > 0 )
+            savFile.partialWriteData(prefix + "/LEN_ELEC_DIPOLE_FIELD",
+              &rData.ElecDipoleField[0][0], {lastPos,0}, {nSteps,3},
+              {memLastPos, 0}, {rData.Time.size(), 3});
+
+          // First system which belongs to this replica
+          size_t iSys = std::distance(sysReplica_.begin(),
+            std::find(sysReplica_.begin(), sysReplica_.end(), r));
+
+          savFile.safeWriteData(prefix + "/TD_1PDM", *replica(r).onePDM);
+          if ( curState.curStep == ModifiedMidpoint )
+            savFile.safeWriteData(prefix + "/TD_1PDM_ORTHO",*DOSav[iSys]);
+          else
+            savFile.safeWriteData(prefix + "/TD_1PDM_ORTHO",
+              *replica(r).onePDMOrtho);
+        }
+
+        saveCheckpoint();
+
+        for(auto r = 0; r < spectra.size(); r++)
+          spectra[r].write(savFile, r == 0 ? std::string("RT/SPECTRUM") :
+            "RT/REPLICA" + std::to_string(r) + "/SPECTRUM");
       }
     }
   }; // RealTime::saveState
@@ -572,7 +1187,8 @@ namespace ChronusQ {
     }
 
     // Transform a copy of the MOs because
-    std::vector<SquareMatrix<dcomplex>> orthoMO = propagator_.mo;
+    std::vector<SquareMatrix<dcomplex>> orthoMO = 
+      intScheme.orbitalProp ? refMO : propagator_.mo;
 
     propagator_.orthoAB->nonortho2orthoCoeffs(orthoMO);
 
@@ -757,12 +1373,14 @@ namespace ChronusQ {
 
 
     // Form fock matrix
-    for(auto idx = 0; idx < systems_.size(); idx++) {
-      this->formFock(false,currentTime,idx);
-    }
+    this->formFock(false,currentTime);
     // Compute properties
     EMPerturbation pert_t = pert.getPert(currentTime);
     propagator_.computeProperties(pert_t);
+    for(auto r = 1; r < nReplicas(); r++) {
+      EMPerturbation pert_r = replicaField(r).getPert(currentTime);
+      replica(r).computeProperties(pert_r);
+    }
     // Print progress line in the output file
     // printRTStep();
 
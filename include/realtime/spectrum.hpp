@@ -0,0 +1,99 @@
+/*
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *
+ *  Copyright (C) 2014-2022 Li Research Group (University of Washington)
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *
+ */
+#pragma once
+
+#include <chronusq_sys.hpp>
+#include <util/files.hpp>
+
+namespace ChronusQ {
+
+  /**
+   *  \brief Settings for the on-the-fly spectrum of the induced dipole
+   *  moment during a RealTime propagation.
+   */
+  struct SpectrumSettings {
+
+    bool   doSpectrum = false;  ///< Accumulate the spectrum while propagating
+
+    double omegaMin = 0.;       ///< Lower bound of the frequency window (Eh)
+    double omegaMax = 1.;       ///< Upper bound of the frequency window (Eh)
+    size_t nOmega   = 1000;     ///< Number of frequency points in the window
+    double damping  = 0.004;    ///< Exponential damping of the signal (Eh)
+
+    size_t padeOrder = 0;       ///< Max order M of the Pade approximant (0 = off),
+                                ///< fit to the first 2M + 1 samples
+
+    double convTol   = 0.;      ///< Peak position convergence in Eh (0 = off)
+    size_t nConvChecks = 3;     ///< Consecutive converged checks to terminate
+
+  }; // struct SpectrumSettings
+
+
+  /**
+   *  \brief Streaming damped Fourier transform (and optional Pade
+   *  approximant) of the induced dipole moment
+   *
+   *  \f[
+   *    \mu(\omega) = \delta t \sum_k \left(\mu(t_k) - \mu(0)\right)
+   *      e^{-\gamma t_k} e^{i \omega t_k}
+   *  \f]
+   *
+   *  The Fourier transform is accumulated sample by sample, so the
+   *  spectrum is available at any point of the propagation without
+   *  post-processing the full dipole history.
+   */
+  struct DipoleSpectrum {
+
+    SpectrumSettings settings; ///< Window / damping / convergence settings
+    double deltaT;             ///< Sampling interval
+
+    std::vector<double>                 omega;  ///< Frequency grid
+    std::vector<std::array<dcomplex,3>> dipFT;  ///< Damped FT of mu(t) - mu(0)
+    std::vector<std::array<double,3>>   signal; ///< Damped mu(t) - mu(0), first
+                                                ///< 2 padeOrder + 1 samples (Pade only)
+
+    std::array<double,3> dipole0 = {0.,0.,0.}; ///< mu(0)
+    size_t nSamples = 0;                      ///< Samples accumulated so far
+
+    std::vector<double> peaks;   ///< Peak positions at the last check
+    size_t nConverged = 0;       ///< Consecutive converged checks
+
+    bool padeTruncWarned = false; ///< Whether the unused samples were reported
+
+    DipoleSpectrum(const SpectrumSettings &set, double dt);
+
+    // Accumulation / evaluation (see src/realtime/spectrum.cxx for docs)
+    void addSample(double t, const std::array<double,3> &dipole);
+    std::vector<std::array<dcomplex,3>> pade() const;
+    std::vector<double> findPeaks(const std::vector<std::array<dcomplex,3>>&) const;
+    bool checkConvergence();
+    void write(SafeFile &savFile, const std::string &prefix);
+
+    inline bool isConverged() const {
+      return settings.convTol > 0. and nConverged >= settings.nConvChecks;
+    }
+
+  }; // struct DipoleSpectrum
+
+}; // namespace ChronusQ
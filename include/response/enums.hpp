@@ -51,6 +51,18 @@ namespace ChronusQ {
     { Brillouin,              1  }
   };
 
+  static std::map<ResponseOperator,std::string> OperatorName = {
+    { LenElectricDipole,      "LEN_ELEC_DIPOLE"      },
+    { LenElectricQuadrupole,  "LEN_ELEC_QUADRUPOLE"  },
+    { LenElectricOctupole,    "LEN_ELEC_OCTUPOLE"    },
+    { VelElectricDipole,      "VEL_ELEC_DIPOLE"      },
+    { VelElectricQuadrupole,  "VEL_ELEC_QUADRUPOLE"  },
+    { VelElectricOctupole,    "VEL_ELEC_OCTUPOLE"    },
+    { MagneticDipole,         "MAG_DIPOLE"           },
+    { MagneticQuadrupole,     "MAG_QUADRUPOLE"       },
+    { Brillouin,              "BRILLOUIN"            }
+  };
+
   static std::vector<ResponseOperator> AllOps = {
     LenElectricDipole,
     LenElectricQuadrupole,
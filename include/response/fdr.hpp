@@ -220,6 +220,52 @@ namespace ChronusQ {
 
     MPI_Comm gmresComm = (isDist or not genSettings.formFullMat) 
       ? comm_ : rcomm_;
+
+    // All the frequencies in one Krylov subspace per RHS. The checkpoints
+    // are only implemented for the shifted solver, the input requires
+    // RESPONSE.SHIFTEDKRYLOV with them
+    if( fdrSettings.shiftedKrylov and (results.shifts.size() > 1 or
+        genSettings.chkInterval or genSettings.chkRestart) ) {
+
+      size_t mSS = std::min(fdrSettings.krylovDim,
+                            size_t(genSettings.maxIter));
+      size_t nMacro = (genSettings.maxIter + mSS - 1) / mSS;
+
+      ShiftedGMRES<U> sgmres(gmresComm,this->memManager_,nSingleDim_,mSS,
+        nMacro,genSettings.convCrit,lt,pc);
+
+      if( isRoot ) {
+        sgmres.setRHS(fdrSettings.nRHS,results.RHS,this->nSingleDim_);
+        sgmres.setShifts(results.shifts.size(),&results.shifts[0]);
+      }
+
+      sgmres.rhsBS   = fdrSettings.nRHS;
+      sgmres.shiftBS = results.shifts.size();
+      sgmres.maxIter = genSettings.maxIter;
+      sgmres.setMixedPrecision(genSettings.mixedPrec);
+
+      // The solutions belong to the RHS and the shifts
+      std::vector<double> key;
+      for(auto &s : results.shifts) {
+        key.emplace_back(std::real(s));
+        key.emplace_back(std::imag(s));
+      }
+      if( isRoot )
+      for(auto iRHS = 0ul; iRHS < fdrSettings.nRHS; iRHS++)
+        key.emplace_back(blas::nrm2(nSingleDim_,
+          results.RHS + iRHS*nSingleDim_,1));
+
+      setSolverCheckpoint(sgmres, std::is_same<U,dcomplex>::value ? 
+        "/RESP/DFDR/SOLVER" : "/RESP/FDR/SOLVER", key);
+
+      sgmres.run();
+
+      if( isRoot ) sgmres.getSol(results.SOL);
+
+      ProgramTimer::tock("Iter FDR");
+      return;
+
+    }
     
     GMRES<U> gmres(gmresComm,this->memManager_,nSingleDim_,
       genSettings.maxIter,genSettings.convCrit,lt,pc);
@@ -233,6 +279,7 @@ namespace ChronusQ {
 
     gmres.rhsBS   = fdrSettings.nRHS;
     gmres.shiftBS = results.shifts.size();
+    gmres.setMixedPrecision(genSettings.mixedPrec);
 
     gmres.run();
 
@@ -39,6 +39,8 @@ namespace ChronusQ {
     size_t N = nSingleDim_;
 
     size_t nVec = genSettings.doFull ? nSingleDim_ : resSettings.nRoots;
+    if( not genSettings.doFull and resSettings.useWindow() )
+      nVec = resSettings.windowBlockSize(nSingleDim_);
 
     //std::cerr << " NV " << nVec << std::endl;
 
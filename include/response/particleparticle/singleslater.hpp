@@ -110,6 +110,9 @@ namespace ChronusQ {
     // TDA -> Hermetian
     this->genSettings.matIsHer = this->genSettings.doTDA;
 
+    // Full vs. iterative solver for the final problem
+    if( this->genSettings.autoFull ) this->selectSolver();
+
 
 
     // Direct logic
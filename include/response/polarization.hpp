@@ -152,6 +152,14 @@ namespace ChronusQ {
       void                 constructShifts();
       void                 postLinearSolve();
       virtual void         resGuess(size_t, MatsT*, size_t);
+      virtual void         projectCVS(size_t, MatsT*);
+
+      // MO basis property integral cache
+      std::map<ResponseOperator, std::vector<MatsT>> moPropCache_;
+
+      std::vector<double>  propCacheKey();
+      std::vector<double>  solverKey() { return propCacheKey(); }
+      std::vector<MatsT>&  moPropInts(ResponseOperator);
 
       MatsT getGDiag(size_t, size_t, bool, SingleSlater<MatsT,IntsT>&, MatsT*,
         MatsT*);
@@ -277,6 +285,17 @@ namespace ChronusQ {
       template <typename U>
       void phEpsilonScale(bool doInc, bool doInv, size_t nVec, size_t N,SingleSlater<MatsT, IntsT>& ss, 
        U* V, U* HV);
+
+      // Number of ph vectors per direct contraction batch
+      template <typename U>
+      size_t phDirectBatchSize(MPI_Comm c, SingleSlater<MatsT,IntsT>& ss,
+        bool doXC, size_t nVec);
+
+      // Direct linear transformation of all the vectors in x in batches
+      template <typename U>
+      void phDirectContract(MPI_Comm c, RC_coll<U> &x, 
+        SingleSlater<MatsT,IntsT>& ss, bool doXC,
+        const std::function<void(std::vector<TwoBodyContraction<U>>&)> &G);
   }; 
 
 
@@ -44,70 +44,18 @@ namespace ChronusQ {
 
     KohnSham<MatsT, IntsT> &ks = dynamic_cast<KohnSham<MatsT, IntsT>&>(*this->ref_);
 
-    const size_t N        = this->getNSingleDim(this->genSettings.doTDA) * (this->doReduced ? 2 : 1);  
-    const size_t tdOffSet = N / 2;
-    const size_t chunk    = 600;
-
     std::shared_ptr<TPIContractions<U,IntsT>> TPI =
         TPIContractions<MatsT,IntsT>::template convert<U>(ks.TPI);
 
     ProgramTimer::tick("Direct Hessian Contract");
 
-    for(auto &X : x) {
-
-      const size_t nVec = X.nVec;
-
-      if( X.AX ) std::fill_n(X.AX,N*nVec,0.);
-
-      for(size_t k = 0; k < nVec; k += chunk) {
-
-        MPI_Barrier(c); // Sync MPI Processes at begining of each batch of 
-                        // vectors
-
-        const size_t nDo = std::min( chunk, nVec - k);
-
-        auto *V_c  = X.X  + k*N;
-        auto *HV_c = X.AX + k*N;
-
-
-        bool scatter = not bool(X.X);
-#ifdef CQ_ENABLE_MPI
-        scatter = mxx::any_of(scatter,c);
-#endif
-
-
-        // Transform ph vector MO -> AO
-        auto cList = 
-          this->template phTransitionVecMO2AO<U>(c, scatter, nDo, N, ks, ks,
-            true, V_c, V_c + tdOffSet);
+    this->template phDirectContract<U>(c,x,ks,true,
+      [&](std::vector<TwoBodyContraction<U>> &cList) {
 
         TPI->twoBodyContract(c,cList); // form G[V]
         ks.formFXC(c,cList); // Fxc contraction
 
-
-        // Only finish transformation on root process
-        if( MPIRank(c) == 0 ) {
-
-          // Transform ph vector AO -> MO
-          this->phTransitionVecAO2MO(nDo,N,cList,ks,true,HV_c,HV_c + tdOffSet);
-
-          // Scale by diagonals
-          this->phEpsilonScale(true,false,nDo,N,ks,V_c,HV_c);
-          this->phEpsilonScale(true,false,nDo,N,ks,V_c+tdOffSet,
-            HV_c+tdOffSet);
-
-        }
-
-        // Free up transformation memory
-        this->memManager_.free(cList[0].X);
-
-      }
-
-
-      if( X.AX and this->incMet and not this->doAPB_AMB )
-        SetMat('N', N/2, nVec, U(-1.), X.AX + (N/2), N, X.AX + (N/2), N);
-
-    } // loop over groups of vectors
+      });
 
     ProgramTimer::tock("Direct Hessian Contract");
 
@@ -51,20 +51,6 @@ namespace ChronusQ {
     // Set the internal NSingleDim
     this->nSingleDim_ = getNSingleDim(this->genSettings.doTDA);
 
-    // Direct logic
-    if( not this->genSettings.formFullMat ) {
-
-      // Turn off doAPB_AMB and doReduced
-      doAPB_AMB = false;
-      doReduced = false;
-
-      // Turn off distribution
-      this->genSettings.formMatDist     = false;
-      this->genSettings.distMatFromRoot = false;
-
-    }
-
-
     // Stab or NR
     if( doStab or doNR ) {
 
@@ -82,6 +68,51 @@ namespace ChronusQ {
 
 
 
+    // GIAO handling
+    if( this->ref_->basisSet().basisType == COMPLEX_GIAO ) {
+
+      auto remove_op = []( std::vector<ResponseOperator> &ops,
+                           ResponseOperator op ) {
+
+        ops.erase( std::remove(ops.begin(), ops.end(), op), ops.end() );
+
+      };
+
+
+      // Remove certain properties from eval list
+      remove_op( this->genSettings.aOps, VelElectricDipole     );
+      remove_op( this->genSettings.aOps, VelElectricQuadrupole );
+      remove_op( this->genSettings.aOps, VelElectricOctupole   );
+      remove_op( this->genSettings.aOps, MagneticQuadrupole    );
+
+      remove_op( this->genSettings.bOps, VelElectricDipole     );
+      remove_op( this->genSettings.bOps, VelElectricQuadrupole );
+      remove_op( this->genSettings.bOps, VelElectricOctupole   );
+      remove_op( this->genSettings.bOps, MagneticQuadrupole    );
+
+    }
+
+
+
+    // Full vs. iterative solver for the final job type and operators
+    if( this->genSettings.autoFull ) this->selectSolver();
+
+
+
+    // Direct logic
+    if( not this->genSettings.formFullMat ) {
+
+      // Turn off doAPB_AMB and doReduced
+      doAPB_AMB = false;
+      doReduced = false;
+
+      // Turn off distribution
+      this->genSettings.formMatDist     = false;
+      this->genSettings.distMatFromRoot = false;
+
+    }
+
+
     // Logic handling for reduced
     if( doReduced ) {
       doAPB_AMB = true; // Reduced -> A+B/A-B
@@ -116,32 +147,6 @@ namespace ChronusQ {
     if( not incMet ) this->genSettings.matIsHer = true;
 
   
-    // GIAO handling
-    if( this->ref_->basisSet().basisType == COMPLEX_GIAO ) {
-
-      auto remove_op = []( std::vector<ResponseOperator> &ops,
-                           ResponseOperator op ) {
-
-        ops.erase( std::remove(ops.begin(), ops.end(), op), ops.end() );
-
-      };
-
-
-      // Remove certain properties from eval list
-      remove_op( this->genSettings.aOps, VelElectricDipole     );
-      remove_op( this->genSettings.aOps, VelElectricQuadrupole );
-      remove_op( this->genSettings.aOps, VelElectricOctupole   );
-      remove_op( this->genSettings.aOps, MagneticQuadrupole    );
-
-      remove_op( this->genSettings.bOps, VelElectricDipole     );
-      remove_op( this->genSettings.bOps, VelElectricQuadrupole );
-      remove_op( this->genSettings.bOps, VelElectricOctupole   );
-      remove_op( this->genSettings.bOps, MagneticQuadrupole    );
-
-    }
-
-
-
     // FDR problem settings
     if( this->genSettings.jobType == FDR ) {
 
@@ -1386,17 +1391,91 @@ namespace ChronusQ {
   };
 
 
+  /**
+   *  \brief Appends position weighted checksums of the real and the
+   *  imaginary parts of X to a cache key. The weights make the sums
+   *  sensitive to permutations, not only to the magnitudes.
+   */
+  template <typename T>
+  inline void appendCacheChecksum(std::vector<double> &key, const T *X,
+    size_t n) {
+
+    double sumAbs = 0., sumRe = 0., sumIm = 0.;
+    for(auto k = 0ul; k < n; k++) {
+      sumAbs += std::abs(X[k]);
+      sumRe  += std::real(X[k]) * double(k % 97 + 1);
+      sumIm  += std::imag(X[k]) * double(k % 89 + 1);
+    }
+
+    key.emplace_back(sumAbs);
+    key.emplace_back(sumRe);
+    key.emplace_back(sumIm);
+
+  };
+
+  /**
+   *  \brief Reference fingerprint for the MO property integral cache:
+   *  dimensions, field type, the nuclei, the basis set and checksums of
+   *  the (real and imaginary) MO coefficients.
+   */
   template <typename MatsT, typename IntsT>
-  std::pair<size_t,MatsT*> 
-    PolarizationPropagator<SingleSlater<MatsT, IntsT>>::formPropGrad(
+  std::vector<double> 
+    PolarizationPropagator<SingleSlater<MatsT, IntsT>>::propCacheKey() {
+
+    SingleSlater<MatsT, IntsT>& ss = dynamic_cast<SingleSlater<MatsT, IntsT>&>(*this->ref_);
+
+    const size_t NB  = ss.nAlphaOrbital();
+    const size_t NBC = ss.nC * NB;
+
+    std::vector<double> key = { double(ss.nC), double(NB), double(ss.nOA),
+      double(ss.nOB), double(ss.iCS), 
+      double(std::is_same<MatsT,dcomplex>::value) };
+
+    // Geometry
+    for(auto &atom : ss.molecule().atoms) {
+      key.emplace_back(double(atom.atomicNumber));
+      key.insert(key.end(), atom.coord.begin(), atom.coord.end());
+    }
+
+    // Basis set
+    BasisSet &basis = ss.basisSet();
+    key.emplace_back(double(basis.nBasis));
+    key.emplace_back(double(basis.nPrimitive));
+    key.emplace_back(double(basis.nShell));
+    for(auto &sh : basis.shells) {
+      key.emplace_back(double(sh.contr[0].l));
+      appendCacheChecksum(key, sh.alpha.data(), sh.alpha.size());
+      for(auto &c : sh.contr)
+        appendCacheChecksum(key, c.coeff.data(), c.coeff.size());
+    }
+
+    for(auto &MO : this->ref_->mo) 
+      appendCacheChecksum(key, MO.pointer(), NBC*NBC);
+
+    return key;
+
+  };
+
+
+  /**
+   *  \brief MO basis property integrals of op, (nVec x nSpin) NBC x NBC
+   *  matrices. The transformation is done once per operator and
+   *  reference: the result is kept in memory and persisted in the
+   *  binary file under /RESP/PROPGRAD/MO, such that subsequent jobs on
+   *  the same reference (other operators, restarts) reuse it.
+   */
+  template <typename MatsT, typename IntsT>
+  std::vector<MatsT>& 
+    PolarizationPropagator<SingleSlater<MatsT, IntsT>>::moPropInts(
       ResponseOperator op) {
-    std::vector<IntsT*> opS;
-    std::vector<MatsT*>      opT;
+
+    auto cached = moPropCache_.find(op);
+    if( cached != moPropCache_.end() ) return cached->second;
 
     Integrals<IntsT> &aoi    = this->ref_->aoints;
     SingleSlater<MatsT, IntsT>& ss = dynamic_cast<SingleSlater<MatsT, IntsT>&>(*this->ref_);
 
-    bool needTrans = true;
+    std::vector<IntsT*> opS;
     switch (op) {
 
       case LenElectricDipole: 
@@ -1431,25 +1510,114 @@ namespace ChronusQ {
         opS = aoi.magnetic->quadrupolePointers();
         break;
 
-      case Brillouin:
-        needTrans = false;
-        opT = ss.fockMO.size() > 1 ?
-              std::vector<MatsT*>{ss.fockMO[0].pointer(), ss.fockMO[1].pointer()}
-              : std::vector<MatsT*>{ss.fockMO[0].pointer()};
-        break;
+      default:
+        CErr("No AO property integrals for the requested operator");
 
     }
 
-    /*
-    if(needTrans and (this->ref_->nC == 2 or not this->ref_->iCS)) 
-      CErr("NO 2C or U");
-      */
+    const size_t nVec  = OperatorSize[op];
+    const size_t NB    = ss.nAlphaOrbital();
+    const size_t NBC   = ss.nC * NB;
+    const size_t NBC2  = NBC * NBC;
+    const size_t nSpin = (ss.nC == 1 and not ss.iCS) ? 2 : 1;
+
+    std::vector<MatsT> &ints = moPropCache_[op];
+    ints.resize(nVec * nSpin * NBC2);
+
+    // The AO integrals also carry the operator origin
+    std::vector<double> key = propCacheKey();
+    for(auto iVec = 0ul; iVec < nVec; iVec++)
+      appendCacheChecksum(key, opS[iVec], NB*NB);
+
+    std::string dataSet = "/RESP/PROPGRAD/MO/" + OperatorName[op];
 
-    //std::cerr << opS.size() << ", " << opT.size() << std::endl;
+    // Binary file is only accessed by the root process
+    bool useFile = this->savFile.exists() and MPIRank(this->comm_) == 0;
+
+    // Reuse the integrals of a previous job on the same reference
+    if( useFile ) {
+
+      auto dims    = this->savFile.getDims(dataSet);
+      auto keyDims = this->savFile.getDims(dataSet + "_KEY");
+
+      bool match = 
+        dims    == std::vector<hsize_t>{nVec * nSpin, NBC, NBC} and
+        keyDims == std::vector<hsize_t>{key.size()};
+
+      if( match ) {
+
+        std::vector<double> savKey(key.size());
+        this->savFile.readData(dataSet + "_KEY", savKey.data());
+
+        // Loose enough for MO coefficients reconverged by another job
+        for(auto k = 0ul; k < key.size(); k++)
+          match = match and 
+            std::abs(savKey[k] - key[k]) <= 1e-8 * std::max(1.,std::abs(key[k]));
+
+      }
+
+      if( match ) {
+
+        this->savFile.readData(dataSet, ints.data());
+        return ints;
+
+      }
+
+    }
+
+    MatsT* SCR  = ss.memManager.template malloc<MatsT>(NBC2);
+    MatsT* CMO  = this->ref_->mo[0].pointer();
+    MatsT* CMOB = (ss.nC == 2) ? CMO + NB : 
+                  (nSpin == 2) ? this->ref_->mo[1].pointer() : nullptr;
+
+    for(auto iVec = 0; iVec < nVec; iVec++) {
+
+      MatsT* opT = ints.data() + iVec * nSpin * NBC2;
+
+      blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,NB,NBC,NB,MatsT(1.),opS[iVec],NB ,CMO,NBC,MatsT(0.),SCR   ,NB);
+      blas::gemm(blas::Layout::ColMajor,blas::Op::ConjTrans,blas::Op::NoTrans,NBC,NBC,NB,MatsT(1.),CMO     ,NBC,SCR,NB ,MatsT(0.),opT,NBC);
+
+      if( ss.nC == 1 and not ss.iCS ) {
+
+        blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,NB,NB,NB,MatsT(1.),opS[iVec],NB,CMOB,NB,MatsT(0.),SCR ,NB);
+        blas::gemm(blas::Layout::ColMajor,blas::Op::ConjTrans,blas::Op::NoTrans,NB,NB,NB,MatsT(1.),CMOB     ,NB,SCR,NB,MatsT(0.),opT + NBC2,NB);
+
+      } else if( ss.nC == 2 ) {
+
+        blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,NB,NBC,NB,MatsT(1.),opS[iVec],NB ,CMOB,NBC,MatsT(0.),SCR  ,NB);
+        blas::gemm(blas::Layout::ColMajor,blas::Op::ConjTrans,blas::Op::NoTrans,NBC,NBC,NB,MatsT(1.),CMOB    ,NBC,SCR,NB ,MatsT(1.),opT,NBC);
+
+      }
+
+    }
+
+    ss.memManager.free(SCR);
+
+    if( useFile ) {
+
+      this->savFile.safeWriteData(dataSet, ints.data(), {nVec * nSpin, NBC, NBC});
+      this->savFile.safeWriteData(dataSet + "_KEY", key.data(), {key.size()});
+
+    }
+
+    return ints;
+
+  };
+
+
+  template <typename MatsT, typename IntsT>
+  std::pair<size_t,MatsT*> 
+    PolarizationPropagator<SingleSlater<MatsT, IntsT>>::formPropGrad(
+      ResponseOperator op) {
+
+    std::vector<MatsT*> opT;
+
+    SingleSlater<MatsT, IntsT>& ss = dynamic_cast<SingleSlater<MatsT, IntsT>&>(*this->ref_);
 
     size_t nVec = OperatorSize[op];
     size_t NB = ss.nAlphaOrbital();
     size_t NBC = ss.nC * NB;
+    size_t nSpin = (ss.nC == 1 and not ss.iCS) ? 2 : 1;
 
     int nOAVA = ss.nOA * ss.nVA;
     int nOBVB = ss.nOB * ss.nVB;
@@ -1459,39 +1627,24 @@ namespace ChronusQ {
     int NV = (ss.nC == 1) ? ss.nVA : ss.nV;
     int NO = (ss.nC == 1) ? ss.nOA : ss.nO;
 
-    MatsT* grad  = ss.memManager.template malloc<MatsT>(this->nSingleDim_*nVec);
+    bool needTrans = op != Brillouin;
+    MatsT* moInts = needTrans ? moPropInts(op).data() : nullptr;
 
-    MatsT* SCR(nullptr);
-    if( needTrans ) {
-      SCR   = ss.memManager.template malloc<MatsT>(NBC*NBC);
-      opT.emplace_back(ss.memManager.template malloc<MatsT>(NBC*NBC));
-      if( ss.nC == 1 and not ss.iCS)
-        opT.emplace_back(ss.memManager.template malloc<MatsT>(NBC*NBC));
-    }
+    if( not needTrans )
+      opT = ss.fockMO.size() > 1 ?
+            std::vector<MatsT*>{ss.fockMO[0].pointer(), ss.fockMO[1].pointer()}
+            : std::vector<MatsT*>{ss.fockMO[0].pointer()};
+
+    MatsT* grad  = ss.memManager.template malloc<MatsT>(this->nSingleDim_*nVec);
 
     for(auto iVec = 0; iVec < nVec; iVec++) {
-      MatsT* CMO = this->ref_->mo[0].pointer();
-      MatsT* CMOB = (ss.nC == 1) ? this->ref_->mo[1].pointer() : CMO + NB;
 
       MatsT* V = grad + iVec*this->nSingleDim_;
 
       if( needTrans ) {
-
-        blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,NB,NBC,NB,MatsT(1.),opS[iVec],NB ,CMO,NBC,MatsT(0.),SCR   ,NB);
-        blas::gemm(blas::Layout::ColMajor,blas::Op::ConjTrans,blas::Op::NoTrans,NBC,NBC,NB,MatsT(1.),CMO     ,NBC,SCR,NB ,MatsT(0.),opT[0],NBC);
-
-        if( ss.nC == 1 and not ss.iCS ) {
-
-          blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,NB,NB,NB,MatsT(1.),opS[iVec],NB,CMOB,NB,MatsT(0.),SCR ,NB);
-          blas::gemm(blas::Layout::ColMajor,blas::Op::ConjTrans,blas::Op::NoTrans,NB,NB,NB,MatsT(1.),CMOB     ,NB,SCR,NB,MatsT(0.),opT[1],NB);
-
-        } else if( ss.nC == 2 ) {
-
-          blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,NB,NBC,NB,MatsT(1.),opS[iVec],NB ,CMOB,NBC,MatsT(0.),SCR  ,NB);
-          blas::gemm(blas::Layout::ColMajor,blas::Op::ConjTrans,blas::Op::NoTrans,NBC,NBC,NB,MatsT(1.),CMOB    ,NBC,SCR,NB ,MatsT(1.),opT[0],NBC);
-
-        }
-
+        opT.clear();
+        for(auto iS = 0ul; iS < nSpin; iS++)
+          opT.emplace_back(moInts + (iVec * nSpin + iS) * NBC * NBC);
       }
 
       MatsT* BOP = (ss.nC == 1 and not ss.iCS) ? opT[1] : opT[0];
@@ -1551,11 +1704,6 @@ namespace ChronusQ {
 
     }
 
-    if(SCR) ss.memManager.free(SCR);
-    if( needTrans )
-      for(auto &X : opT ) ss.memManager.free(X);
-
-
     // Transform to proper form form
     if( doAPB_AMB and not doReduced ) 
       blockTransform(this->nSingleDim_/2,nVec,std::sqrt(0.5),
@@ -2194,6 +2342,160 @@ namespace ChronusQ {
   };
 
 
+
+
+  /**
+   *  \brief Number of ph vectors per batch of the direct linear
+   *  transformation from the available memory.
+   *
+   *  Per vector: the AO transition densities (2 nC), G[V] (1 + 2 nC) and
+   *  its per thread scratch in the direct ERI contraction, and for XC
+   *  the symmetrized densities and the per thread Fxc scratch. A quarter
+   *  of the available memory is left for the fixed size scratch.
+   */
+  template <typename MatsT, typename IntsT>
+  template <typename U>
+  size_t PolarizationPropagator< SingleSlater<MatsT, IntsT> >::phDirectBatchSize(
+    MPI_Comm c, SingleSlater<MatsT,IntsT>& ss, bool doXC, size_t nVec) {
+
+    if( nVec == 0 ) return 0;
+
+    const size_t NB   = ss.nAlphaOrbital();
+    const size_t NB2  = NB * NB;
+    const size_t nT   = GetNumThreads();
+    const size_t nMat = 1 + 2 * ss.nC;
+
+    size_t nPerVec = (2 * ss.nC + nMat * (1 + nT)) * NB2;
+    if( doXC ) nPerVec += 2 * ss.nC * (1 + nT) * NB2;
+
+    size_t nAvail = this->memManager_.template max_avail_allocatable<U>();
+    size_t batch  = std::max(size_t(1), (3 * (nAvail / 4)) / nPerVec);
+
+    // All processes take part in the same contractions
+    MPIAllReduce(&batch,1,
+      [](size_t x, size_t y){ return std::min(x,y); },c);
+
+    // Even out the batches
+    size_t nBatch = (nVec + batch - 1) / batch;
+    return (nVec + nBatch - 1) / nBatch;
+
+  }; 
+
+
+
+
+  /**
+   *  \brief Direct linear transformation of the ph vectors of all the
+   *  groups in x.
+   *
+   *  The vectors of all groups are packed into batches of
+   *  phDirectBatchSize vectors, so that every batch takes a single
+   *  pass of G (ERIs and, for KS, the grid) regardless of how the
+   *  caller splits the vectors into groups.
+   */
+  template <typename MatsT, typename IntsT>
+  template <typename U>
+  void PolarizationPropagator< SingleSlater<MatsT, IntsT> >::phDirectContract(
+    MPI_Comm c, RC_coll<U> &x, SingleSlater<MatsT,IntsT>& ss, bool doXC,
+    const std::function<void(std::vector<TwoBodyContraction<U>>&)> &G) {
+
+    const size_t N        = this->getNSingleDim(this->genSettings.doTDA) * (this->doReduced ? 2 : 1);  
+    const size_t tdOffSet = N / 2;
+
+    size_t nVecTot = 0;
+    std::vector<bool> scatter;
+
+    for(auto &X : x) {
+
+      if( X.AX ) std::fill_n(X.AX,N*X.nVec,0.);
+
+      bool sc = not bool(X.X);
+#ifdef CQ_ENABLE_MPI
+      sc = mxx::any_of(sc,c);
+#endif
+      scatter.push_back(sc);
+
+      nVecTot += X.nVec;
+
+    }
+
+    // Nothing to contract (and no batch to size)
+    if( nVecTot == 0 ) return;
+
+    const size_t batch = phDirectBatchSize<U>(c,ss,doXC,nVecTot);
+
+    // Slices (group, first vector, number of vectors) of a batch
+    std::vector<std::array<size_t,3>> slices;
+
+    for(size_t iX = 0, k = 0; iX < x.size(); ) {
+
+      slices.clear();
+      for(size_t nBatch = 0; iX < x.size() and nBatch < batch; ) {
+
+        size_t nDo = std::min(batch - nBatch, x[iX].nVec - k);
+        if( nDo ) slices.push_back({iX,k,nDo});
+
+        nBatch += nDo; k += nDo;
+        if( k == x[iX].nVec ) { iX++; k = 0; }
+
+      }
+
+      if( slices.empty() ) continue;
+
+      MPI_Barrier(c); // Sync MPI Processes at begining of each batch of 
+                      // vectors
+
+      // Transform ph vectors MO -> AO
+      std::vector<std::vector<TwoBodyContraction<U>>> sliceList;
+      std::vector<TwoBodyContraction<U>> cList;
+
+      for(auto &s : slices) {
+
+        auto *V_c = x[s[0]].X + s[1]*N;
+
+        sliceList.emplace_back(
+          this->template phTransitionVecMO2AO<U>(c, scatter[s[0]], s[2], N, 
+            ss, ss, true, V_c, V_c + tdOffSet)
+        );
+
+        cList.insert(cList.end(),sliceList.back().begin(),
+          sliceList.back().end());
+
+      }
+
+      G(cList); // form G[V]
+
+      // Only finish transformation on root process
+      if( MPIRank(c) == 0 ) 
+      for(auto iS = 0ul; iS < slices.size(); iS++) {
+
+        auto &s = slices[iS];
+        auto *V_c  = x[s[0]].X  + s[1]*N;
+        auto *HV_c = x[s[0]].AX + s[1]*N;
+
+        // Transform ph vector AO -> MO
+        this->phTransitionVecAO2MO(s[2],N,sliceList[iS],ss,true,HV_c,
+          HV_c + tdOffSet);
+
+        // Scale by diagonals
+        this->phEpsilonScale(true,false,s[2],N,ss,V_c,HV_c);
+        this->phEpsilonScale(true,false,s[2],N,ss,V_c+tdOffSet,
+          HV_c+tdOffSet);
+
+      }
+
+      // Free up transformation memory
+      for(auto &l : sliceList) this->memManager_.free(l[0].X);
+
+    }
+
+    for(auto &X : x)
+      if( X.AX and this->incMet and not this->doAPB_AMB )
+        SetMat('N', N/2, X.nVec, U(-1.), X.AX + (N/2), N, X.AX + (N/2), N);
+
+  };
+
+
   template <typename MatsT, typename IntsT>
   void PolarizationPropagator< SingleSlater<MatsT, IntsT> >::resGuess(
       size_t nGuess, MatsT *G, size_t LDG) {
@@ -2236,8 +2538,22 @@ namespace ChronusQ {
 
     };
 
+    // Transitions out of the CVS core space (if any) are ordered first
+    const size_t nCore = this->resSettings.cvsCore;
+    auto is_core = [&](size_t INDX) -> bool {
+
+      if( not nCore ) return true;
+      return (INDX >= NOV1) ? ((INDX - NOV1) / NV2 < nCore) : 
+                              (INDX / NV1 < nCore);
+
+    };
+
     std::function< bool(size_t, size_t) > compare = 
       [&](size_t INDX1, size_t INDX2) -> bool {
+
+        bool core1 = is_core(INDX1);
+        bool core2 = is_core(INDX2);
+        if( core1 != core2 ) return core1;
        
         double delta1 = conv_indx(INDX1); 
         double delta2 = conv_indx(INDX2); 
@@ -2269,6 +2585,50 @@ namespace ChronusQ {
   }
 
 
+  /**
+   *  \brief Core-valence separation: zero all components of V (and of the
+   *  de-excitation block for full RPA) whose occupied index is outside of
+   *  the lowest resSettings.cvsCore orbitals (per spin for 1C references,
+   *  spin orbitals for 2C/4C).
+   */
+  template <typename MatsT, typename IntsT>
+  void PolarizationPropagator< SingleSlater<MatsT, IntsT> >::projectCVS(
+      size_t nVec, MatsT *V) {
+
+    const size_t nCore = this->resSettings.cvsCore;
+    if( not nCore ) return;
+
+    SingleSlater<MatsT, IntsT>& ss = dynamic_cast<SingleSlater<MatsT,IntsT>&>(*this->ref_);
+
+    const size_t NO1 = (ss.nC == 1) ? ss.nOA : ss.nO;
+    const size_t NV1 = (ss.nC == 1) ? ss.nVA : ss.nV;
+    const size_t NO2 = ss.nOB;
+    const size_t NV2 = ss.nVB;
+
+    const size_t NOV1 = NO1 * NV1;
+    const size_t NOV2 = NO2 * NV2;
+
+    if( nCore > NO1 or (ss.nC == 1 and nCore > NO2) )
+      CErr("CVSCORE exceeds the number of occupied orbitals");
+
+    const size_t N     = this->nSingleDim_;
+    const size_t nHalf = (this->genSettings.doTDA or doReduced) ? N : N / 2;
+
+    // ai = i * NV + a, the valence transitions form the tail of each block
+    for(size_t iVec = 0; iVec < nVec;  iVec++         ) 
+    for(size_t off  = 0; off  < N;     off  += nHalf ) {
+
+      MatsT *X = V + iVec * N + off;
+
+      std::fill(X + nCore * NV1, X + NOV1, MatsT(0.));
+      if( ss.nC == 1 )
+        std::fill(X + NOV1 + nCore * NV2, X + NOV1 + NOV2, MatsT(0.));
+
+    }
+
+  }
+
+
   /**
    * Get the diagonal double bar integral (ai||ai)
    * - XSCR needs to be 2*nC*NB2
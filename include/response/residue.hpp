@@ -126,8 +126,13 @@ namespace ChronusQ {
 
     typename GPLHR<T>::LinearTrans_t lt = [&](size_t nVec, T *V, T *AV) {
 
+      // Restrict the search space to the CVS space (root only)
+      if( resSettings.cvsCore and V ) projectCVS(nVec,V);
+
       iterLinearTrans(nVec,V,AV);
 
+      if( resSettings.cvsCore and AV ) projectCVS(nVec,AV);
+
     };
 
     ProgramTimer::tick("Iter Diagonalize");
@@ -148,6 +153,14 @@ namespace ChronusQ {
 
     MPI_Comm gplhrComm = (isDist or not genSettings.formFullMat) 
       ? comm_ : rcomm_;
+
+    if( resSettings.useWindow() ) {
+
+      runWindowResidue(gplhrComm,lt);
+      ProgramTimer::tock("Iter Diagonalize");
+      return;
+
+    }
     
     GPLHR<T> gplhr(gplhrComm,this->memManager_,nSingleDim_,
       genSettings.maxIter,genSettings.convCrit,
@@ -156,11 +169,15 @@ namespace ChronusQ {
     gplhr.setM(resSettings.gplhr_m);
     gplhr.sigma   = resSettings.gplhr_sigma;
     gplhr.hardLim = resSettings.deMin;
+    gplhr.setMixedPrecision(genSettings.mixedPrec);
 
     if( hasResGuess_ )
       gplhr.setGuess(resSettings.nRoots,
           [&](size_t nG, T* G, size_t LDG){ this->resGuess(nG,G,LDG); });
 
+    setSolverCheckpoint(gplhr,"/RESP/RESIDUE/SOLVER",
+      { double(resSettings.cvsCore) });
+
 
 
     gplhr.run();
@@ -180,5 +197,54 @@ namespace ChronusQ {
 
   };
 
+
+  /**
+   *  \brief Obtain all of the roots in [eWinMin, eWinMax] by Chebyshev
+   *  filtered subspace iteration. Interior (e.g. core) excitations are
+   *  resolved without converging the roots below the window. Upon exit
+   *  resSettings.nRoots is the number of roots found in the window, an
+   *  unconverged filter is an error.
+   */
+  template <typename T>
+  void ResponseTBase<T>::runWindowResidue(MPI_Comm wComm,
+    std::function<void(size_t,T*,T*)> &lt) {
+
+    bool isRoot = MPIRank(comm_) == 0;
+    size_t nBlock = resSettings.windowBlockSize(nSingleDim_);
+
+    ChebyshevFilter<T> filter(wComm,this->memManager_,nSingleDim_,
+      genSettings.maxIter,genSettings.convCrit,nBlock,lt);
+
+    filter.setWindow(resSettings.eWinMin,resSettings.eWinMax);
+    filter.setMixedPrecision(genSettings.mixedPrec);
+
+    if( hasResGuess_ )
+      filter.setGuess(nBlock,
+          [&](size_t nG, T* G, size_t LDG){ 
+            this->resGuess(nG,G,LDG); 
+            if( resSettings.cvsCore ) projectCVS(nG,G);
+          });
+
+    filter.run();
+
+    // Unconverged Ritz pairs (or a partial count) are not the window
+    if( not filter.isConverged() )
+      CErr("Energy window not converged: increase MAXITER, or NROOTS if "
+           "the block is filled by the window",std::cout);
+
+    resSettings.nRoots = filter.nFound();
+
+    if( isRoot ) {
+
+      for(auto k = 0; k < resSettings.nRoots; k++)
+        resResults.W[k] = std::real(filter.eigVal()[k]);
+  
+      std::copy_n(filter.VR(), this->nSingleDim_ * resSettings.nRoots,
+          resResults.VR);
+
+    }
+
+  };
+
 }; // namespace ChronusQ
 
@@ -41,6 +41,8 @@ namespace ChronusQ {
 
     // Matrix Handle
     bool doFull        = true; ///< Solve Problem by (Sca)LAPACK
+    bool autoFull      = true; ///< Choose doFull / formFullMat by cost
+    double nIterEst    = 30.;  ///< Iterations per root / system assumed by autoFull
     bool formFullMat   = true; ///< Form The Full Matrix
     bool distMatFromRoot = false; ///< Form mat on root process and distribute
     bool formMatDist     = false; ///< Form matrix distributed
@@ -63,6 +65,12 @@ namespace ChronusQ {
     int  printLevel = 1;
     bool evalProp   = true;
 
+    // Iterative solver checkpoints (binary file)
+    size_t chkInterval = 0;     ///< Iterations between checkpoints (0 = off)
+    bool   chkRestart  = false; ///< Resume / seed from the checkpoint
+
+    bool mixedPrec = false; ///< Single precision subspace of the solvers
+
     std::vector<ResponseOperator> aOps  = AllOps;
     std::vector<ResponseOperator> bOps  = { LenElectricDipole };
 
@@ -77,6 +85,10 @@ namespace ChronusQ {
 
     size_t              nRHS       = 0;
 
+    // Iterative solver
+    bool                shiftedKrylov = false; ///< Shared subspace for all shifts
+    size_t              krylovDim     = 100;   ///< Shifted GMRES restart length
+
     bool                needP      = false;
     bool                needQ      = false;
   };
@@ -95,6 +107,24 @@ namespace ChronusQ {
     // GPLHR specific settings
     size_t gplhr_m     = 3;
     double gplhr_sigma = 0.;
+
+    // Energy window (Chebyshev filtered subspace) settings
+    double eWinMin = 0.;
+    double eWinMax = 0.;
+
+    // Number of core orbitals kept in the core-valence separation
+    size_t cvsCore = 0;
+
+    inline bool useWindow() const { return eWinMax > eWinMin; }
+
+    /**
+     *  \brief Block size of the filtered subspace. nRoots is the
+     *  expected number of roots in the window, the block is padded to
+     *  resolve the edges of the window.
+     */
+    inline size_t windowBlockSize(size_t N) const {
+      return std::min(N, std::max(2 * nRoots, nRoots + 4));
+    }
   };
 
 
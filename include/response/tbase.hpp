@@ -111,6 +111,7 @@ namespace ChronusQ {
 
 
     void writeMeta();
+    void selectSolver();
 
     template <typename U> void iterLinearTrans(size_t nVec, U* V, U* AV);
 
@@ -127,7 +128,10 @@ namespace ChronusQ {
         memManager_(mem), nSingleDim_(0), 
         fullMatrix_(fullMatrix) {
 
-        if(fullMatrix) genSettings.doFull = true; 
+        if(fullMatrix) {
+          genSettings.doFull   = true; 
+          genSettings.autoFull = false;
+        }
 
     }
 
@@ -216,6 +220,46 @@ namespace ChronusQ {
 
     };
 
+    /**
+     *  \brief Project a set of response vectors onto the core-valence
+     *  separated space (resSettings.cvsCore). Method specific, the
+     *  default throws if CVS has been requested.
+     */
+    virtual void projectCVS(size_t nVec, T *V) {
+
+      if( resSettings.cvsCore )
+        CErr("Core-Valence Separation not implemented for this Response");
+
+    };
+
+    /**
+     *  \brief Fingerprint of the reference the iterative solvers are
+     *  checkpointed for (method specific). A checkpoint of another
+     *  reference only seeds the solver.
+     */
+    virtual std::vector<double> solverKey() { return {}; }
+
+    /**
+     *  \brief Checkpoint the state of an iterative solver in the group
+     *  prefix of the binary file, key identifies the problem beyond the
+     *  reference (e.g. RHS and shifts).
+     */
+    template <typename Solver>
+    void setSolverCheckpoint(Solver &solver, const std::string &prefix,
+      const std::vector<double> &key = {}) {
+
+      if( not (genSettings.chkInterval or genSettings.chkRestart) ) return;
+
+      std::vector<double> fullKey = solverKey();
+      fullKey.emplace_back(genSettings.doTDA);
+      fullKey.emplace_back(genSettings.doSA);
+      fullKey.insert(fullKey.end(), key.begin(), key.end());
+
+      solver.setCheckpoint(savFile, prefix, genSettings.chkInterval,
+        genSettings.chkRestart, fullKey);
+
+    };
+
     // Memory allocation
     void allocResidueResults(); // Residue memory allocation
     void allocFDRResults();     // FDR memory allocation
@@ -242,7 +286,7 @@ namespace ChronusQ {
       ProgramTimer::tick("Response Total");
 
       genSettings.matIsHer = genSettings.doTDA; // TDA always implies hermetian matrix
-      configOptions();
+      configOptions(); // selects the solver if genSettings.autoFull
 
       bool rootHasFullMat = (MPIRank(comm_) == 0) and fullMatrix_;
 #ifdef CQ_ENABLE_MPI
@@ -297,6 +341,7 @@ namespace ChronusQ {
 
     void runFullResidue();
     void runIterResidue();
+    void runWindowResidue(MPI_Comm, std::function<void(size_t,T*,T*)>&);
 
 
 
@@ -574,6 +619,94 @@ namespace ChronusQ {
   }
 
 
+  /**
+   *  \brief Choose between the full (Sca)LAPACK and the matrix free
+   *  iterative solution of the response problem.
+   *
+   *  Costs are estimated in units of linear transformations (LT). The
+   *  full problem needs N LT to form the matrix, and its dense algebra
+   *  is counted with one LT per N^2 flops, which underestimates the cost
+   *  of a (direct) LT. The iterative estimate assumes genSettings.nIterEst
+   *  (RESPONSE.ITERESTIMATE) iterations per root / linear system. The
+   *  default of 30 is a rough guess for the default CONV, not a fit, and
+   *  should be raised for slowly converging (e.g. near degenerate or
+   *  core) problems. The full problem is only considered if its dense
+   *  storage fits into the available memory.
+   *
+   *  Called by configOptions once the job type, the dimension and the
+   *  operators of the problem are final, before the handling of the
+   *  full matrix is configured.
+   */
+  template <typename T>
+  void ResponseTBase<T>::selectSolver() {
+
+    const double nIterEst = genSettings.nIterEst;
+
+    bool isRoot = MPIRank(comm_) == 0;
+    bool doFull = genSettings.doFull;
+
+    if( isRoot ) {
+
+      const size_t N  = getNSingleDim(genSettings.doTDA);
+      const double dN = N;
+
+      double fullLT, iterLT, nDense;
+
+      if( genSettings.jobType == RESIDUE ) {
+
+        // Form + diagonalize, matrix + eigenvectors + workspace
+        fullLT = dN + dN;
+        nDense = (resSettings.needVL ? 4. : 3.) * dN * dN;
+
+        iterLT = nIterEst * (resSettings.gplhr_m + 1) * resSettings.nRoots;
+
+      } else {
+
+        size_t nRHS = 0;
+        for(auto &op : genSettings.bOps) nRHS += OperatorSize[op];
+        const double nOmega = fdrSettings.bFreq.size();
+
+        // Form + one factorization per frequency, matrix + factors
+        fullLT = dN + nOmega * dN;
+        nDense = 2. * dN * dN;
+
+        // The shifted solver shares the subspace among the frequencies
+        iterLT = nIterEst * nRHS * 
+          (fdrSettings.shiftedKrylov ? 1. : nOmega);
+
+      }
+
+      if( genSettings.isDist() ) nDense /= MPISize(comm_);
+
+      double memAvail = memManager_.template max_avail_allocatable<T>();
+      bool   fullFits = nDense < memAvail;
+
+      doFull = fullFits and fullLT <= iterLT;
+
+      if( genSettings.printLevel > 0 ) {
+        std::cout << "  * AUTOMATIC RESPONSE SOLVER SELECTION (NSINGLEDIM = "
+                  << N << ")\n";
+        std::cout << std::scientific << std::setprecision(2);
+        std::cout << "    * FULL      ~ " << fullLT << " LT, " 
+                  << nDense * sizeof(T) / 1e9 << " GB";
+        if( not fullFits ) std::cout << " (EXCEEDS AVAILABLE MEMORY)";
+        std::cout << "\n";
+        std::cout << "    * ITERATIVE ~ " << iterLT << " LT\n";
+        std::cout << "    * USING " << (doFull ? "FULL" : "MATRIX FREE ITERATIVE")
+                  << " SOLVER\n\n";
+        std::cout << std::fixed;
+      }
+
+    }
+
+    if( MPISize(comm_) > 1 ) MPIBCast(doFull,0,comm_);
+
+    genSettings.doFull = doFull;
+    if( not doFull ) genSettings.formFullMat = false;
+
+  }
+
+
   /**
    *  \brief General implementation of linear transformation required
    *  for iterative solvers (GMRES, GPLHR, etc)
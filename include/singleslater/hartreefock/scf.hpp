@@ -40,6 +40,7 @@ void HartreeFock<MatsT, IntsT>::computeFullNRStep(MatsT* orbRot) {
   auto ptr = getPtr();
   PolarizationPropagator<HartreeFock<MatsT, IntsT>> resp(this->comm, FDR, ptr);
   resp.doNR              = true;
+  resp.genSettings.autoFull = false; // The full Hessian is freed below
   resp.fdrSettings.bFreq = {0.001};
 
   std::cout << "  * STARTING HESSIAN INVERSE FOR NEWTON-RAPHSON\n";
@@ -119,6 +120,7 @@ std::pair<double, MatsT*> HartreeFock<MatsT, IntsT>::getStab() {
   auto ptr = getPtr();
   PolarizationPropagator<HartreeFock<MatsT, IntsT>> resp(this->comm, RESIDUE, ptr);
   resp.doStab = true;
+  resp.genSettings.autoFull = false; // Lowest root of the full Hessian
 
   std::cout << "  * STARTING HESSIAN DIAG FOR STABILITY CHECK\n";
   resp.run();
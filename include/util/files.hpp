@@ -252,6 +252,42 @@ namespace ChronusQ {
         }
       };
 
+      inline void unlinkData(const std::string &dataSet) {
+        OpenH5File(file,H5F_ACC_RDWR);
+        file.unlink(dataSet);
+      };
+
+      /**
+       *  \brief Change the leading dimension of a DataSet.
+       *
+       *  The leading rows which fit into the new DataSet are kept, new
+       *  rows are zero. Does nothing if the DataSet does not exist.
+       */
+      template <typename T>
+      void resizeDataSet(const std::string &dataSet, hsize_t newRows) {
+
+        std::vector<hsize_t> dims = getDims(dataSet);
+        if( dims.empty() or dims[0] == newRows ) return;
+
+        hsize_t rowSize = 1;
+        for(auto i = 1; i < dims.size(); i++) rowSize *= dims[i];
+
+        std::vector<T> data(dims[0] * rowSize);
+        readData(dataSet, data.data());
+        unlinkData(dataSet);
+
+        std::vector<hsize_t> newDims(dims);
+        newDims[0] = newRows;
+        this->template createDataSet<T>(dataSet, newDims);
+
+        std::vector<hsize_t> start(dims.size(), 0), count(dims);
+        count[0] = std::min(dims[0], newRows);
+
+        if( count[0] > 0 )
+          partialWriteData(dataSet, data.data(), start, count, start, dims);
+
+      };
+
       std::vector<hsize_t> getDims(const std::string &dataSet) {
 
         std::vector<hsize_t> dims;
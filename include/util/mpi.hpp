@@ -138,6 +138,34 @@ namespace ChronusQ {
 
   }
 
+  /**
+   *  \brief In place reduction of count elements over all the processes
+   *  in c with the binary operation func (a sum by default).
+   */
+  template <typename T, typename Func>
+  static inline void MPIAllReduce(T* msg, int count, Func func, MPI_Comm c) {
+
+#ifdef CQ_ENABLE_MPI
+    std::vector<T> in(msg, msg + count);
+    mxx::allreduce(in.data(), count, msg, func, c);
+#endif
+
+  }
+
+  template <typename T>
+  static inline void MPIAllReduce(T* msg, int count, MPI_Comm c) {
+
+    MPIAllReduce(msg, count, std::plus<T>(), c);
+
+  }
+
+  template <typename T>
+  static inline void MPIAllReduce(T& msg, MPI_Comm c) {
+
+    MPIAllReduce(&msg, 1, c);
+
+  }
+
 #define ROOT_ONLY(comm) if(MPIRank(comm) != 0) return;
 
   static inline MPI_Comm CreateRootComm(MPI_Comm c) {
@@ -38,5 +38,28 @@ namespace ChronusQ {
   void FormattedLine(std::ostream &out, std::string s, T v, U u) {
     out << std::setw(45) << "  " + s << v << u << std::endl;
   }
+
+  /**
+   *  Silences an output stream for the lifetime of the object, the
+   *  stream state is restored also if an exception is thrown.
+   */
+  class SilenceOutput {
+
+    std::ostream &out_;
+    std::ios_base::iostate state_;
+
+  public:
+
+    SilenceOutput(std::ostream &out = std::cout) :
+      out_(out), state_(out.rdstate()) {
+      out_.setstate(std::ios_base::failbit);
+    }
+
+    SilenceOutput(const SilenceOutput &) = delete;
+    SilenceOutput& operator=(const SilenceOutput &) = delete;
+
+    ~SilenceOutput() { out_.clear(state_); }
+
+  }; // class SilenceOutput
  
 }; // namespace ChronusQ
@@ -41,7 +41,9 @@ namespace ChronusQ {
       "NDIIS",
       "ETOL",
       "TTOL",
-      "MAXITER"
+      "MAXITER",
+      "LADDER",
+      "BLOCKSIZE"
     };
       // Specified keywords
     std::vector<std::string> ccKeywords = input.getDataInSection("CC"); 
@@ -122,6 +124,23 @@ namespace ChronusQ {
       if(input.containsData("CC.MAXITER")){
         OPTOPT(cc->ccSettings.maxiter = input.getData<int>("CC.MAXITER");)
       }
+
+      if(input.containsData("CC.LADDER")){
+        std::string ladder = input.getData<std::string>("CC.LADDER");
+        trim(ladder);
+        if( not ladder.compare("AUTO") )
+          cc->ccSettings.ladderAlg = CC_LADDER_ALG::AUTO;
+        else if( not ladder.compare("STORED") )
+          cc->ccSettings.ladderAlg = CC_LADDER_ALG::STORED;
+        else if( not ladder.compare("RI") )
+          cc->ccSettings.ladderAlg = CC_LADDER_ALG::RI;
+        else CErr(ladder + " NOT RECOGNIZED CC.LADDER");
+      }
+
+      if(input.containsData("CC.BLOCKSIZE")){
+        OPTOPT(cc->ccSettings.blockSize = input.getData<size_t>("CC.BLOCKSIZE");)
+        if(cc->ccSettings.blockSize == 0) CErr("CC.BLOCKSIZE must be positive");
+      }
     }
     else {
       CErr("NYI");
@@ -50,7 +50,7 @@ namespace ChronusQ {
     std::vector<std::string> allowedKeywords = {
       "ALG",          // Direct or Incore?
       "GRADALG",      // Direct or Incore for gradients?
-      "TPITRANSALG",   // N5 or N6
+      "TPITRANSALG",   // N5, N6 or RI
       "SCHWARZ",     // double
       "RI",           // AUXBASIS or CHOLESKY or False
       "RITHRESHOLD",  // double
@@ -116,7 +116,7 @@ namespace ChronusQ {
     OPTOPT( ALG = input.getData<std::string>(int_sec+".ALG"); )
     trim(ALG);
     
-    std::string TPITRANSALG = "N6"; 
+    std::string TPITRANSALG = ""; 
     OPTOPT( TPITRANSALG = input.getData<std::string>(int_sec+".TPITRANSALG"); )
     trim(TPITRANSALG);
 
@@ -232,6 +232,9 @@ namespace ChronusQ {
       aoi = std::dynamic_pointer_cast<IntegralsBase>(giaoint);
     }
     
+    // RI integrals default to the RI transformation
+    if (TPITRANSALG.empty()) TPITRANSALG = RI.compare("FALSE") ? "RI" : "N6";
+
     if (not TPITRANSALG.compare("N5")) {
       if (contrAlg == CONTRACTION_ALGORITHM::DIRECT) {
         aoi->TPITransAlg = TPI_TRANSFORMATION_ALG::DIRECT_N5;
@@ -243,6 +246,10 @@ namespace ChronusQ {
         aoi->TPITransAlg = TPI_TRANSFORMATION_ALG::DIRECT_N6;
       else
         aoi->TPITransAlg = TPI_TRANSFORMATION_ALG::INCORE_N6;
+    } else if (not TPITRANSALG.compare("RI")){
+      if (not RI.compare("FALSE"))
+        CErr("INTS.TPITRANSALG = RI requires INTS.RI",out);
+      aoi->TPITransAlg = TPI_TRANSFORMATION_ALG::INCORE_RI;
     } else {
       CErr(TPITRANSALG + " not a valid INTS.TPITRANSALG",out);
     }
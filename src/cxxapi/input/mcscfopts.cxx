@@ -53,6 +53,10 @@ namespace ChronusQ {
       "SCFGRADCONV",
       "SCFALG",
       "HESSDIAGSCALE",
+      "NEWTONMAXITER",
+      "NEWTONCONV",
+      "NEWTONSHIFT",
+      "NEWTONCHECK",
       "CASORBITAL",
       "RAS1ORBITAL",
       "RAS2ORBITAL",
@@ -63,7 +67,14 @@ namespace ChronusQ {
       "OSCISTREN",
       "GENIVO",
       "MAXDAVIDSONSPACE",
-      "NDAVIDSONGUESS"
+      "NDAVIDSONGUESS",
+      "CICHKINTERVAL",
+      "CICHKRESTART",
+      "CIMIXEDPREC",
+      "EXCITATIONLIST",
+      "EXCITATIONBLOCK",
+      "SCIEPSILON",
+      "SCIMAXITER"
     };
 
     // Specified keywords
@@ -164,10 +175,11 @@ namespace ChronusQ {
     };
     
     // Construct valid job types 
-    std::vector<std::string> CASJobs, RASJobs, DMRGJobs;
+    std::vector<std::string> CASJobs, RASJobs, SCIJobs, DMRGJobs;
     for (auto &m: MCMethods) {
       CASJobs.emplace_back("CAS" + m);
       RASJobs.emplace_back("RAS" + m);
+      SCIJobs.emplace_back("SCI" + m);
       DMRGJobs.emplace_back("DMRG" + m);
     }
      
@@ -176,10 +188,12 @@ namespace ChronusQ {
       std::find(CASJobs.begin(),CASJobs.end(),jobType) != CASJobs.end();
     bool isRASJob = 
       std::find(RASJobs.begin(),RASJobs.end(),jobType) != RASJobs.end();
+    bool isSCIJob = 
+      std::find(SCIJobs.begin(),SCIJobs.end(),jobType) != SCIJobs.end();
     bool isDMRGJob = 
       std::find(DMRGJobs.begin(),DMRGJobs.end(),jobType) != DMRGJobs.end();
     
-    if(not isCASJob and not isRASJob and not isDMRGJob) 
+    if(not isCASJob and not isRASJob and not isSCIJob and not isDMRGJob) 
       CErr(jobType + " is not a valid MCSCF.JOBTYPE",out);
     
     // erase scheme and get methods
@@ -248,6 +262,32 @@ namespace ChronusQ {
     // set up scheme
     if      (isCASJob) mcscf->MOPartition.scheme = CAS;
     else if (isRASJob) mcscf->MOPartition.scheme = RAS;
+    else if (isSCIJob) mcscf->MOPartition.scheme = SCI;
+
+    // Selected CI threshold and number of selection cycles
+    if (isSCIJob) {
+      OPTOPT( mcscf->MOPartition.sciEpsilon = input.getData<double>("MCSCF.SCIEPSILON"); )
+      OPTOPT( mcscf->MOPartition.sciMaxIter = input.getData<size_t>("MCSCF.SCIMAXITER"); )
+      if (mcscf->MOPartition.sciEpsilon < 0.)
+        CErr("MCSCF.SCIEPSILON must be non-negative",out);
+      if (mcscf->MOPartition.sciMaxIter == 0)
+        CErr("MCSCF.SCIMAXITER must be positive",out);
+    }
+
+    // Excitation list storage: PRECOMPUTED (default) or ONTHEFLY
+    std::string exListStr = "PRECOMPUTED";
+    OPTOPT( exListStr = input.getData<std::string>("MCSCF.EXCITATIONLIST"); )
+    trim(exListStr);
+
+    if( not exListStr.compare("PRECOMPUTED") )
+      mcscf->MOPartition.exScheme = PRECOMPUTED_CONFIGURATION_DRIVEN_LIST;
+    else if( not exListStr.compare("ONTHEFLY") )
+      mcscf->MOPartition.exScheme = COMPUTING_EXCITATION_ON_THE_FLY;
+    else CErr(exListStr + " is not a valid MCSCF.EXCITATIONLIST option");
+
+    // Strings per on-the-fly excitation list block (default: cache sized)
+    OPTOPT( mcscf->MOPartition.exBlockSize =
+      input.getData<size_t>("MCSCF.EXCITATIONBLOCK"); )
     
     // Parse space partition
     std::string sActO;
@@ -332,7 +372,7 @@ namespace ChronusQ {
 
     bool selectMO = not fcMOStrings.empty() or not fvMOStrings.empty();
     
-    if (isCASJob or isDMRGJob) 
+    if (isCASJob or isSCIJob or isDMRGJob) 
       selectMO = selectMO or not casMOStrings.empty();
     else if (isRASJob)
       selectMO = selectMO or not rasMOStrings[0].empty() or 
@@ -350,7 +390,7 @@ namespace ChronusQ {
       // parse input
       SET_ORBITAL_INDEX(inputOrbIndices, fcMOStrings, 'I');
       SET_ORBITAL_INDEX(inputOrbIndices, fvMOStrings, 'S');
-      if (isCASJob or isDMRGJob) {
+      if (isCASJob or isSCIJob or isDMRGJob) {
         SET_ORBITAL_INDEX(inputOrbIndices, casMOStrings, 'A');
       } else if (isRASJob) {
         for (auto i = 0; i < 3; i++) {
@@ -366,7 +406,7 @@ namespace ChronusQ {
         FILL_DEFAULT_INDEX(inputOrbIndices, mo_iter, 'I', n_char);
       }
       
-      if (isCASJob or isDMRGJob) {
+      if (isCASJob or isSCIJob or isDMRGJob) {
         if (casMOStrings.empty()) {
           size_t n_char = mcscf->MOPartition.nCorrO;
           FILL_DEFAULT_INDEX(inputOrbIndices, mo_iter, 'A', n_char);
@@ -410,7 +450,9 @@ namespace ChronusQ {
 
       // Change default based on # determinants
       std::string ciALG;
-      if( mcscf->NDet<750 ) ciALG = "FULLMATRIX";
+      // SCI spaces grow during the selection, small ones are
+      // always diagonalized directly
+      if( mcscf->NDet<750 and not isSCIJob ) ciALG = "FULLMATRIX";
       else ciALG = "DAVIDSON";
       OPTOPT( ciALG = input.getData<std::string>("MCSCF.CIDIAGALG");)
       trim(ciALG);
@@ -427,6 +469,12 @@ namespace ChronusQ {
                   input.getData<size_t>("MCSCF.MAXDAVIDSONSPACE");)
         OPTOPT( mcscfSettings->nDavidsonGuess = 
                   input.getData<size_t>("MCSCF.NDAVIDSONGUESS");)
+        OPTOPT( mcscfSettings->ciChkInterval = 
+                  input.getData<size_t>("MCSCF.CICHKINTERVAL");)
+        OPTOPT( mcscfSettings->ciChkRestart = 
+                  input.getData<bool>("MCSCF.CICHKRESTART");)
+        OPTOPT( mcscfSettings->ciMixedPrec = 
+                  input.getData<bool>("MCSCF.CIMIXEDPREC");)
       } else CErr(ciALG + "is not a valid MCSCF.CIDIAGALG",out);
       
     } // CI Options
@@ -464,7 +512,14 @@ namespace ChronusQ {
         ORSettings.alg = OrbitalRotationAlgorithm::ORB_ROT_QUASI_2ND_ORDER;
       } else if( not scfALG.compare("2nd") ) {
         ORSettings.alg = OrbitalRotationAlgorithm::ORB_ROT_2ND_ORDER;
-        CErr("Second Order method is not implemented yet");
+        OPTOPT( ORSettings.newtonMaxIter = 
+                  input.getData<size_t>("MCSCF.NEWTONMAXITER"); )
+        OPTOPT( ORSettings.newtonConvTol = 
+                  input.getData<double>("MCSCF.NEWTONCONV"); )
+        OPTOPT( ORSettings.newtonLevelShift = 
+                  input.getData<double>("MCSCF.NEWTONSHIFT"); )
+        OPTOPT( ORSettings.newtonCheck = 
+                  input.getData<bool>("MCSCF.NEWTONCHECK"); )
       } else {
         CErr(scfALG + " is not a valid MCSCF.SCFALG",out);
       }
@@ -45,15 +45,24 @@ namespace ChronusQ {
       "MAXITER",
       "FULLMAT",
       "DOFULL",
+      "ITERESTIMATE",
       "TDA",
       "DISTMATFROMROOT",
       "FORMMATDIST",
       "DAMP",
       "FORCEDAMP",
+      "SHIFTEDKRYLOV",
+      "KRYLOVDIM",
+      "MIXEDPREC",
+      "CHKINTERVAL",
+      "CHKRESTART",
       "NROOTS",
       "DEMIN",
       "GPLHR_M",
       "GPLHR_SIGMA",
+      "EWINMIN",
+      "EWINMAX",
+      "CVSCORE",
       "DOAPBAMB",
       "DOREDUCED",
       "DOSTAB",
@@ -381,6 +390,8 @@ namespace ChronusQ {
               input.getData<bool>("RESPONSE.FULLMAT") );
     OPTOPT( resp->genSettings.doFull = 
               input.getData<bool>("RESPONSE.DOFULL") );
+    OPTOPT( resp->genSettings.nIterEst = 
+              input.getData<double>("RESPONSE.ITERESTIMATE") );
     OPTOPT( resp->genSettings.doTDA = 
               input.getData<bool>("RESPONSE.TDA") );
 
@@ -392,12 +403,46 @@ namespace ChronusQ {
     OPTOPT( resp->genSettings.formMatDist = 
               input.getData<bool>("RESPONSE.FORMMATDIST") );
 
+    // Checkpoints of the iterative solvers
+    OPTOPT( resp->genSettings.chkInterval = 
+              input.getData<size_t>("RESPONSE.CHKINTERVAL") );
+    OPTOPT( resp->genSettings.chkRestart = 
+              input.getData<bool>("RESPONSE.CHKRESTART") );
+
+    // Single precision subspace of the iterative solvers
+    OPTOPT( resp->genSettings.mixedPrec = 
+              input.getData<bool>("RESPONSE.MIXEDPREC") );
+
+    // Cost based choice between full and iterative unless the problem
+    // handling is specified (A+B/A-B and reduced require the full matrix)
+    for(auto key : { "DOFULL", "FULLMAT", "DISTMATFROMROOT", "FORMMATDIST",
+                     "DOAPBAMB", "DOREDUCED" })
+      if( input.containsData(std::string("RESPONSE.") + key) )
+        resp->genSettings.autoFull = false;
+
+    if( resp->genSettings.nIterEst <= 0. )
+      CErr("RESPONSE.ITERESTIMATE must be positive");
+
     // FDR settings
       
     OPTOPT( resp->fdrSettings.dampFactor = 
               input.getData<double>("RESPONSE.DAMP") );
     OPTOPT( resp->fdrSettings.forceDamp = 
               input.getData<bool>("RESPONSE.FORCEDAMP") );
+    OPTOPT( resp->fdrSettings.shiftedKrylov = 
+              input.getData<bool>("RESPONSE.SHIFTEDKRYLOV") );
+    OPTOPT( resp->fdrSettings.krylovDim = 
+              input.getData<size_t>("RESPONSE.KRYLOVDIM") );
+
+    if( resp->fdrSettings.krylovDim == 0 )
+      CErr("RESPONSE.KRYLOVDIM must be positive");
+
+    // Only the shifted GMRES checkpoints its state, the FDR solver is not
+    // switched implicitly
+    if( (jobTyp == FDR or doMOR) and not resp->fdrSettings.shiftedKrylov and
+        (resp->genSettings.chkInterval or resp->genSettings.chkRestart) )
+      CErr("RESPONSE.CHKINTERVAL / RESPONSE.CHKRESTART require "
+           "RESPONSE.SHIFTEDKRYLOV = TRUE for the FDR");
 
 
     // RESIDUE settings
@@ -410,6 +455,12 @@ namespace ChronusQ {
               input.getData<size_t>("RESPONSE.GPLHR_M") );
     OPTOPT( resp->resSettings.gplhr_sigma =
               input.getData<double>("RESPONSE.GPLHR_SIGMA") );
+    OPTOPT( resp->resSettings.eWinMin =
+              input.getData<double>("RESPONSE.EWINMIN") );
+    OPTOPT( resp->resSettings.eWinMax =
+              input.getData<double>("RESPONSE.EWINMAX") );
+    OPTOPT( resp->resSettings.cvsCore =
+              input.getData<size_t>("RESPONSE.CVSCORE") );
 
 
 
@@ -437,6 +488,30 @@ namespace ChronusQ {
       }
     }
 
+    // Energy window: all roots in [EWINMIN,EWINMAX] by the (iterative)
+    // Chebyshev filter, NROOTS is the expected number of roots
+    if( input.containsData("RESPONSE.EWINMIN") or
+        input.containsData("RESPONSE.EWINMAX") ) {
+
+      if( not resp->resSettings.useWindow() )
+        CErr("RESPONSE.EWINMAX must be larger than RESPONSE.EWINMIN");
+
+      if( input.containsData("RESPONSE.DOFULL") and 
+          input.getData<bool>("RESPONSE.DOFULL") )
+        CErr("Energy window requires DOFULL = FALSE");
+
+      resp->genSettings.doFull   = false;
+      resp->genSettings.autoFull = false;
+      if( not input.containsData("RESPONSE.FULLMAT") )
+        resp->genSettings.formFullMat = false;
+
+      // Guess vectors about the center of the window
+      if( not input.containsData("RESPONSE.DEMIN") )
+        resp->resSettings.deMin = 
+          0.5 * (resp->resSettings.eWinMin + resp->resSettings.eWinMax);
+
+    }
+
 
 
 
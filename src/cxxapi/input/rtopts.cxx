@@ -47,7 +47,16 @@ namespace ChronusQ {
       "RESTART",
       "SCFFIELD",
       "PRINTLEVEL",
-      "ORBITALPOPULATION"
+      "ORBITALPOPULATION",
+      "POLARIZATION",  // Field directions to propagate concurrently: X, Y, Z or ISOTROPIC
+      "NTEAMS",        // Thread teams for concurrent propagation: 1 (Default)
+      "REPRESENTATION",  // Propagated quantity: DENSITY (Default), ORBITALS
+      "SPECTRUM",      // Accumulate the dipole spectrum on the fly: False (Default)
+      "SPECTRUMWINDOW",  // Frequency window in Eh: 0.0 1.0 (Default)
+      "SPECTRUMPOINTS",  // Number of frequency points: 1000 (Default)
+      "SPECTRUMDAMPING", // Exponential damping in Eh: 0.004 (Default)
+      "SPECTRUMPADE",    // Max Pade order M (fit to the first 2M+1 samples), 0 disables Pade: 0 (Default)
+      "SPECTRUMCONV"     // Peak convergence in Eh to stop early, 0 disables: 0 (Default)
     };
 
     // Specified keywords
@@ -280,11 +289,113 @@ namespace ChronusQ {
 
     }
 
+    // Field polarization replicas
+    try {
+
+      std::string polStr = input.getData<std::string>("RT.POLARIZATION");
+      std::vector<std::string> tokens;
+      split(tokens,polStr," \t,");
+
+      std::vector<cart_t> dirs;
+      for(auto &X : tokens) {
+        trim(X);
+        if( X.empty() ) continue;
+
+        if( not X.compare("ISOTROPIC") ) {
+          dirs.push_back({1.,0.,0.});
+          dirs.push_back({0.,1.,0.});
+          dirs.push_back({0.,0.,1.});
+        }
+        else if( not X.compare("X") ) dirs.push_back({1.,0.,0.});
+        else if( not X.compare("Y") ) dirs.push_back({0.,1.,0.});
+        else if( not X.compare("Z") ) dirs.push_back({0.,0.,1.});
+        else CErr(X + " not a valid RT.POLARIZATION direction",out);
+      }
+
+      if( rt->pert.fields.empty() )
+        CErr("RT.POLARIZATION requires an RT.FIELD specification",out);
+
+      rt->setPolarizations(dirs);
+
+    } catch( std::runtime_error &e ) {
+
+      throw;
+
+    } catch(...) { }
+
+    // Number of thread teams
+    OPTOPT(
+      rt->intScheme.nTeams = input.getData<size_t>("RT.NTEAMS");
+    )
+
+    if( rt->intScheme.nTeams == 0 )
+      CErr("RT.NTEAMS must be positive",out);
+
+    // Propagate the density or only the occupied orbitals
+    try {
+      auto repStr = input.getData<std::string>("RT.REPRESENTATION");
+
+      if( not repStr.compare("ORBITALS") )
+        rt->intScheme.orbitalProp = true;
+      else if( repStr.compare("DENSITY") )
+        CErr(repStr + " not a valid RT.REPRESENTATION",out);
+
+    } catch( std::runtime_error &e ) {
+
+      throw;
+
+    } catch(...) { }
+
     // Save frequency
     OPTOPT(
       rt->intScheme.iSave = input.getData<size_t>("RT.SAVESTEP")
     )
 
+    // On-the-fly spectrum
+    OPTOPT(
+      rt->specSettings.doSpectrum = input.getData<bool>("RT.SPECTRUM");
+    )
+
+    if( rt->specSettings.doSpectrum ) {
+
+      try {
+        std::string winStr = input.getData<std::string>("RT.SPECTRUMWINDOW");
+        std::vector<std::string> tokens;
+        split(tokens,winStr," \t,");
+
+        if( tokens.size() != 2 )
+          CErr("RT.SPECTRUMWINDOW takes 2 arguments",out);
+
+        rt->specSettings.omegaMin = std::stod(tokens[0]);
+        rt->specSettings.omegaMax = std::stod(tokens[1]);
+
+        if( rt->specSettings.omegaMax <= rt->specSettings.omegaMin )
+          CErr("RT.SPECTRUMWINDOW upper bound must be > lower bound",out);
+
+      } catch( std::runtime_error &e ) {
+
+        throw;
+
+      } catch(...) { }
+
+      OPTOPT(
+        rt->specSettings.nOmega = input.getData<size_t>("RT.SPECTRUMPOINTS");
+      )
+      OPTOPT(
+        rt->specSettings.damping = input.getData<double>("RT.SPECTRUMDAMPING");
+      )
+      OPTOPT(
+        rt->specSettings.padeOrder = input.getData<size_t>("RT.SPECTRUMPADE");
+      )
+      OPTOPT(
+        rt->specSettings.convTol = input.getData<double>("RT.SPECTRUMCONV");
+      )
+
+      if( rt->specSettings.nOmega < 3 )
+        CErr("RT.SPECTRUMPOINTS must be at least 3",out);
+
+    }
+
     // Whether we are restarting an RT calculation
     OPTOPT(
       rt->restart = input.getData<bool>("RT.RESTART");
@@ -166,6 +166,7 @@ namespace ChronusQ {
       printSub("      - Diagonalization", "Diagonalization", "Solve CI",mcscfId);
       printReg("        - Full Matrix Formation", "Full Matrix", mcscfId);
       printReg("        - Sigma Formation", "Sigma", mcscfId);
+      printReg("        - SCI Selection", "SCI Selection", mcscfId);
       // Orbital Rotation
       printReg("    - Orbital Rotation", "Orbital Rotation", mcscfId);
       printReg("      - Gradient Formation", "Form Gradient", mcscfId);
@@ -46,9 +46,15 @@ namespace ChronusQ {
   template class GMRES<double>;
   template class GMRES<dcomplex>;
 
+  template class ShiftedGMRES<double>;
+  template class ShiftedGMRES<dcomplex>;
+
   template class GPLHR<double>;
   template class GPLHR<dcomplex>;
   
   template class Davidson<double>;
   template class Davidson<dcomplex>;
+
+  template class ChebyshevFilter<double>;
+  template class ChebyshevFilter<dcomplex>;
 };
@@ -42,6 +42,10 @@ namespace ChronusQ {
   template class RASCI<dcomplex,double>;
   template class RASCI<dcomplex,dcomplex>;
 
+  template class SelectedCI<double,double>;
+  template class SelectedCI<dcomplex,double>;
+  template class SelectedCI<dcomplex,dcomplex>;
+
 
   // Instantiate copy constructors
   template MCWaveFunction<dcomplex,double>::MCWaveFunction(const MCWaveFunction<double,double> &, int);
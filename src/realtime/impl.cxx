@@ -26,6 +26,61 @@
 
 namespace ChronusQ {
 
+  /**
+   *  \brief Replicate the TD perturbation along a set of polarization
+   *  directions.
+   *
+   *  Each dipole field keeps its envelope and magnitude but is redirected
+   *  along dirs[0] for replica 0 (pert itself) and along dirs[r] for
+   *  replica r. Propagating along three orthogonal directions yields the
+   *  full polarizability (and isotropic spectrum) from a single job.
+   *
+   *  \param [in] dirs Polarization directions (need not be normalized)
+   */ 
+  void RealTimeBase::setPolarizations(const std::vector<cart_t> &dirs) {
+
+    if( dirs.empty() ) return;
+
+    if( not replicaPert.empty() )
+      CErr("RealTime polarization replicas may only be set once");
+
+    TDEMPerturbation basePert = pert;
+
+    auto polarize = [&](const cart_t &dir) {
+
+      double dirNorm = std::sqrt(dir[0]*dir[0] + dir[1]*dir[1] + dir[2]*dir[2]);
+      if( dirNorm < 1e-12 )
+        CErr("Invalid (zero) RealTime polarization direction");
+
+      TDEMPerturbation polPert;
+      for(auto &field : basePert.fields) {
+
+        auto *dip = dynamic_cast<TDDipoleField*>(field.get());
+        if( not dip )
+          CErr("RealTime polarization directions require a dipole field");
+
+        TDDipoleField &fld = *dip;
+        auto &amp = fld.ampVec;
+        double ampNorm = std::sqrt(amp[0]*amp[0] + amp[1]*amp[1] + amp[2]*amp[2]);
+
+        cart_t polAmp = { ampNorm * dir[0] / dirNorm, ampNorm * dir[1] / dirNorm,
+                          ampNorm * dir[2] / dirNorm };
+
+        polPert.addField(std::make_shared<TDDipoleField>(fld.emFieldTyp,
+          fld.fieldGauge, fld.envelope, polAmp));
+
+      }
+
+      return polPert;
+
+    };
+
+    pert = polarize(dirs[0]);
+    for(auto r = 1; r < dirs.size(); r++) addReplica(polarize(dirs[r]));
+
+  }; // RealTimeBase::setPolarizations
+
+
   template class RealTime<HartreeFock,double>;
   template class RealTime<HartreeFock,dcomplex>;
   template class RealTime<KohnSham,double>;
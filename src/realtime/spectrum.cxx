@@ -0,0 +1,238 @@
+/*
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *
+ *  Copyright (C) 2014-2022 Li Research Group (University of Washington)
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *
+ */
+#include <realtime/spectrum.hpp>
+#include <cqlinalg.hpp>
+#include <cerr.hpp>
+
+namespace ChronusQ {
+
+  /**
+   *  \brief DipoleSpectrum constructor. Sets up the frequency grid.
+   *
+   *  \param [in] set Spectrum settings
+   *  \param [in] dt  Sampling interval (the RT time step)
+   */
+  DipoleSpectrum::DipoleSpectrum(const SpectrumSettings &set, double dt) :
+    settings(set), deltaT(dt) {
+
+    if( settings.nOmega == 0 )
+      CErr("Spectrum requires at least one frequency point");
+    if( settings.omegaMax < settings.omegaMin )
+      CErr("Spectrum frequency window is empty");
+
+    double dOmega = settings.nOmega == 1 ? 0. :
+      (settings.omegaMax - settings.omegaMin) / (settings.nOmega - 1);
+
+    for(auto j = 0ul; j < settings.nOmega; j++)
+      omega.push_back(settings.omegaMin + j * dOmega);
+
+    dipFT.resize(settings.nOmega, {0.,0.,0.});
+
+  }; // DipoleSpectrum::DipoleSpectrum
+
+
+  /**
+   *  \brief Accumulate a dipole sample into the damped Fourier transform.
+   *
+   *  Samples must be supplied in order at uniform spacing deltaT,
+   *  the first sample defines mu(0).
+   *
+   *  \param [in] t      Time of the sample
+   *  \param [in] dipole Dipole moment at time t
+   */
+  void DipoleSpectrum::addSample(double t, const std::array<double,3> &dipole) {
+
+    if( nSamples == 0 ) dipole0 = dipole;
+
+    double damp = std::exp(-settings.damping * t);
+
+    std::array<double,3> dMu;
+    for(auto k = 0; k < 3; k++) dMu[k] = (dipole[k] - dipole0[k]) * damp;
+
+    // The Pade approximant of order M only uses the first 2M + 1 samples
+    if( signal.size() < 2 * settings.padeOrder + 1 ) signal.push_back(dMu);
+
+    for(auto j = 0ul; j < omega.size(); j++) {
+      dcomplex phase = std::polar(deltaT, omega[j] * t);
+      for(auto k = 0; k < 3; k++) dipFT[j][k] += phase * dMu[k];
+    }
+
+    nSamples++;
+
+  }; // DipoleSpectrum::addSample
+
+
+  /**
+   *  \brief Evaluate the Pade approximant of the damped Fourier
+   *  transform on the frequency grid.
+   *
+   *  The power series \f$ G(z) = \sum_k c_k z^k \f$ of the damped signal
+   *  is approximated by \f$ a(z) / b(z) \f$ of order M (Bruner et al.,
+   *  JCTC 12, 3741 (2016)), which resolves peaks from far shorter
+   *  propagations than the bare transform. The [M/M] approximant is
+   *  fixed by the first 2M + 1 samples, later samples only enter the
+   *  Fourier transform (write warns when samples are left out). Falls
+   *  back to the Fourier transform if too few samples are available or
+   *  the Toeplitz system is singular.
+   *
+   *  \returns Pade estimate of mu(omega) for x, y and z
+   */
+  std::vector<std::array<dcomplex,3>> DipoleSpectrum::pade() const {
+
+    if( signal.empty() ) return dipFT;
+
+    size_t M = std::min(settings.padeOrder, (signal.size() - 1) / 2);
+    if( M == 0 ) return dipFT;
+
+    std::vector<std::array<dcomplex,3>> result(dipFT);
+
+    std::vector<double> A(M*M), b(M+1), a(M+1);
+    std::vector<int64_t> IPIV(M);
+
+    for(auto k = 0; k < 3; k++) {
+
+      // Solve sum_m b_m c_{n-m} = -c_n for n = M+1 ... 2M
+      for(auto i = 0ul; i < M; i++) {
+        for(auto m = 1ul; m <= M; m++)
+          A[i + (m-1)*M] = signal[M + 1 + i - m][k];
+        b[i+1] = -signal[M + 1 + i][k];
+      }
+
+      int64_t INFO = lapack::gesv(M, 1, A.data(), M, IPIV.data(), &b[1], M);
+      if( INFO != 0 ) continue;
+
+      b[0] = 1.;
+      for(auto n = 0ul; n <= M; n++) {
+        a[n] = 0.;
+        for(auto m = 0ul; m <= n; m++) a[n] += b[m] * signal[n-m][k];
+      }
+
+      for(auto j = 0ul; j < omega.size(); j++) {
+
+        dcomplex z = std::polar(1., omega[j] * deltaT);
+        dcomplex num(a[M]), den(b[M]);
+        for(int n = M - 1; n >= 0; n--) {
+          num = num * z + a[n];
+          den = den * z + b[n];
+        }
+
+        result[j][k] = deltaT * num / den;
+
+      }
+
+    }
+
+    return result;
+
+  }; // DipoleSpectrum::pade
+
+
+  /**
+   *  \brief Locate the peaks of the absorption strength
+   *  \f$ S(\omega) = \omega \sum_k |\mathrm{Im}\, \mu_k(\omega)| \f$.
+   *
+   *  Local maxima below 5% of the largest value in the window are
+   *  discarded.
+   *
+   *  \param [in] spec Spectrum on the frequency grid
+   *  \returns         Peak frequencies in ascending order
+   */
+  std::vector<double> DipoleSpectrum::findPeaks(
+    const std::vector<std::array<dcomplex,3>> &spec) const {
+
+    std::vector<double> S(omega.size(), 0.);
+    for(auto j = 0ul; j < omega.size(); j++)
+      for(auto k = 0; k < 3; k++)
+        S[j] += omega[j] * std::abs(std::imag(spec[j][k]));
+
+    std::vector<double> pk;
+    if( S.size() < 3 ) return pk;
+
+    double sMax = *std::max_element(S.begin(), S.end());
+
+    for(auto j = 1ul; j < S.size() - 1; j++)
+      if( S[j] > S[j-1] and S[j] >= S[j+1] and S[j] > 0.05 * sMax )
+        pk.push_back(omega[j]);
+
+    return pk;
+
+  }; // DipoleSpectrum::findPeaks
+
+
+  /**
+   *  \brief Compare the current peak positions with those of the
+   *  previous check.
+   *
+   *  \returns Whether the peaks in the window have been stable for
+   *  settings.nConvChecks consecutive checks
+   */
+  bool DipoleSpectrum::checkConvergence() {
+
+    std::vector<double> newPeaks =
+      findPeaks(settings.padeOrder > 0 ? pade() : dipFT);
+
+    bool conv = not newPeaks.empty() and newPeaks.size() == peaks.size();
+    for(auto i = 0ul; conv and i < newPeaks.size(); i++)
+      conv = std::abs(newPeaks[i] - peaks[i]) < settings.convTol;
+
+    nConverged = conv ? nConverged + 1 : 0;
+    peaks = newPeaks;
+
+    return isConverged();
+
+  }; // DipoleSpectrum::checkConvergence
+
+
+  /**
+   *  \brief Write the current spectrum to the binary file
+   *
+   *  \param [in] savFile Binary file
+   *  \param [in] prefix  Group to write FREQUENCY, DIPOLE_FT (and
+   *                      DIPOLE_PADE) into
+   */
+  void DipoleSpectrum::write(SafeFile &savFile, const std::string &prefix) {
+
+    hsize_t nOmega = omega.size();
+
+    savFile.safeWriteData(prefix + "/FREQUENCY", omega.data(), {nOmega});
+    savFile.safeWriteData(prefix + "/DIPOLE_FT", &dipFT[0][0], {nOmega,3});
+
+    if( settings.padeOrder > 0 ) {
+
+      if( nSamples > signal.size() and not padeTruncWarned ) {
+        std::cout << "\n    *** WARNING: Pade approximant of order "
+                  << settings.padeOrder << " uses the first " << signal.size()
+                  << " of " << nSamples << " dipole samples, increase "
+                  << "SPECTRUMPADE to use the whole propagation ***"
+                  << std::endl;
+        padeTruncWarned = true;
+      }
+
+      std::vector<std::array<dcomplex,3>> padeFT = pade();
+      savFile.safeWriteData(prefix + "/DIPOLE_PADE", &padeFT[0][0], {nOmega,3});
+    }
+
+  }; // DipoleSpectrum::write
+
+}; // namespace ChronusQ
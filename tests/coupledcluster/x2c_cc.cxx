@@ -36,3 +36,39 @@ TEST( GHF_CCSD, Water_STO3G_X2C_CCSD) {
     "water_sto3g_ghf_ccsd.bin.ref");
 }
 
+
+#ifndef _CQ_GENERATE_TESTS
+
+// Packed <ab||cd> ladder with one orbital per tile, so that the pair
+// ranges and the (vv,oo) gathers span many tiles
+TEST( PACKED_LADDER_CCSD, Water_STO3G_GHF_CCSD) {
+  CQCCTEST("coupledcluster/ccsd/water_sto3g_ghf_ccsd_packed",
+    "water_sto3g_ghf_ccsd.bin.ref");
+}
+
+TEST( PACKED_LADDER_CCSD, Water_STO3G_X2C_CCSD) {
+  CQCCTEST("coupledcluster/ccsd/water_sto3g_x2c_ccsd_packed",
+    "water_sto3g_x2c_ccsd.bin.ref");
+}
+
+// Integral-direct RI ladder against the packed ladder stored from the
+// same (tight) Cholesky integrals
+TEST( RI_LADDER_CCSD, Water_STO3G_GHF_CCSD) {
+
+  std::string ri     = "coupledcluster/ccsd/water_sto3g_ghf_ccsd_cholesky_ri";
+  std::string stored = "coupledcluster/ccsd/water_sto3g_ghf_ccsd_cholesky_stored";
+
+  CQCCTEST(ri, "water_sto3g_ghf_ccsd.bin.ref");
+  CQCCTEST(stored, "water_sto3g_ghf_ccsd.bin.ref");
+
+  SafeFile riFile(TEST_OUT + ri + ".bin", true);
+  SafeFile storedFile(TEST_OUT + stored + ".bin", true);
+
+  double eRI, eStored;
+  riFile.readData("/CC/CORRELATION_ENERGY", &eRI);
+  storedFile.readData("/CC/CORRELATION_ENERGY", &eStored);
+
+  EXPECT_NEAR( eRI, eStored, 1e-10 );
+}
+
+#endif
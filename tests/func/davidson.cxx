@@ -40,7 +40,8 @@ using namespace ChronusQ;
 template <typename ReadT, typename EigT>
 void DAVIDSON_TEST(size_t nRoots, size_t m, size_t kG,
   std::string fname, bool doPre = false, double conver = 1e-10, 
-  double etol = 8e-8, size_t block_size = 128) {
+  double etol = 8e-8, size_t block_size = 128, bool thickOnly = false,
+  bool mixed = false, size_t chkIter = 0) {
   
   MPI_Barrier(MPI_COMM_WORLD);
 
@@ -121,9 +122,12 @@ void DAVIDSON_TEST(size_t nRoots, size_t m, size_t kG,
 #endif
 
 
+  size_t nLT = 0; // Number of linear transformations
   typename Davidson<EigT>::LinearTrans_t func = [&]( size_t nVec, EigT *V, 
       EigT *AV) {
 
+    nLT += nVec;
+
 #ifdef CQ_ENABLE_MPI
     if( isMPI ) {
 
@@ -171,21 +175,70 @@ void DAVIDSON_TEST(size_t nRoots, size_t m, size_t kG,
 
   size_t nThreads = omp_get_num_threads();
   ProgramTimer::initialize("Davidson test", nThreads);
-  Davidson<EigT> davidson(MPI_COMM_WORLD,mem,N,5,128,conver,nRoots,
-    func,PC);
+  // thickOnly: a single macro iteration, the subspace is only
+  // collapsed by thick restarts
+  auto setup = [&](Davidson<EigT> &dav) {
+    dav.setM(m);
+    dav.setkG(kG);
+    dav.setMixedPrecision(mixed);
+  };
+
+  // chkIter: the run is resumed from the checkpoint of a run which was 
+  // interrupted after chkIter iterations and compared to an 
+  // uninterrupted one
+  SafeFile chkFile(TEST_OUT "davidson_chk.bin");
+  std::vector<dcomplex> WRef(nRoots);
+  size_t nLTRef = 0;
+
+  if( chkIter ) {
+
+    Davidson<EigT> ref(MPI_COMM_WORLD,mem,N,thickOnly ? 1 : 5,128,conver,
+      nRoots,func,PC);
+    setup(ref);
+    ref.run();
+
+    if( isRoot ) std::copy_n(ref.eigVal(),nRoots,WRef.begin());
+    nLTRef = nLT;
+
+    if( isRoot ) chkFile.createFile();
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    Davidson<EigT> part(MPI_COMM_WORLD,mem,N,1,chkIter,conver,nRoots,func,
+      PC);
+    setup(part);
+    part.setCheckpoint(chkFile,"/DAVIDSON",1,false);
+    part.run();
 
-  davidson.setM(m);
-  davidson.setkG(kG);
+    nLT = 0;
+
+  }
+
+  Davidson<EigT> davidson(MPI_COMM_WORLD,mem,N,thickOnly ? 1 : 5,128,conver,
+    nRoots,func,PC);
+
+  setup(davidson);
+  if( chkIter ) davidson.setCheckpoint(chkFile,"/DAVIDSON",1,true);
   
   davidson.run();
 
   ROOT_ONLY(MPI_COMM_WORLD);
 
+  // The resumed run does not repeat the transformations of the
+  // interrupted one
+  if( chkIter ) {
+    EXPECT_LT( nLT, nLTRef );
+    for(auto k = 0ul; k < nRoots; k++)
+      EXPECT_LT( std::abs(davidson.eigVal()[k] - WRef[k]) / std::abs(WRef[k]),
+        etol ) << "ROOT = " << k;
+  }
+
   dcomplex *refW = mem.malloc<dcomplex>(N);
   matFile.readData("/W",refW);
 
   dcomplex *W = davidson.eigVal();
 
+  if( thickOnly and not chkIter ) EXPECT_GE( davidson.nThickRestarts(), 2 );
+
   for(auto k = 0ul; k < nRoots; k++) {
     double diff1 = std::abs((W[k] - refW[k])/refW[k]);
     double diff2 = std::abs((W[k] - std::conj(refW[k]))/refW[k]);
@@ -244,5 +297,40 @@ TEST(DAVIDSON, DAVIDSON_COMPLEX_NONHERMITIAN) {
 
 }
 
+//
+// Small subspace, converged through several thick restarts
+//
+TEST(DAVIDSON, DAVIDSON_THICK_RESTART) {
+
+  DAVIDSON_TEST<double,double>(3,4,1,"real_Hermitian.hdf5",true,1e-10,8e-8,
+    128,true);
+  DAVIDSON_TEST<dcomplex,dcomplex>(3,4,1,"complex_Hermitian.hdf5",true,1e-10,
+    8e-8,128,true);
+
+}
+
+//
+// Single precision subspace, refined in FP64 to the same accuracy
+//
+TEST(DAVIDSON, DAVIDSON_MIXED_PRECISION) {
 
+  DAVIDSON_TEST<double,double>(3,50,3,"real_Hermitian.hdf5",true,1e-10,8e-8,
+    128,false,true);
+  DAVIDSON_TEST<dcomplex,dcomplex>(3,50,3,"complex_Hermitian.hdf5",true,
+    1e-10,8e-8,128,false,true);
+  DAVIDSON_TEST<double,double>(3,4,1,"real_Hermitian.hdf5",true,1e-10,8e-8,
+    128,true,true);
 
+}
+
+//
+// Resumed from the checkpoint of an interrupted run
+//
+TEST(DAVIDSON, DAVIDSON_CHECKPOINT) {
+
+  DAVIDSON_TEST<double,double>(3,50,3,"real_Hermitian.hdf5",true,1e-10,8e-8,
+    128,false,false,6);
+  DAVIDSON_TEST<dcomplex,dcomplex>(3,4,1,"complex_Hermitian.hdf5",true,
+    1e-10,8e-8,128,true,false,6);
+
+}
@@ -0,0 +1,140 @@
+/* 
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *  
+ *  Copyright (C) 2014-2022 Li Research Group (University of Washington)
+ *  
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *  
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *  
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *  
+ */
+#include <func.hpp>
+#include <cerr.hpp>
+#include <memmanager.hpp>
+#include <itersolver.hpp>
+#include <util/files.hpp>
+#include <util/timer.hpp>
+
+#include <cqlinalg/blas1.hpp>
+#include <cqlinalg/blas3.hpp>
+
+using namespace ChronusQ;
+
+
+/**
+ *  Solves (A - s I) X = B by preconditioned GMRES (diagonal of A - s I)
+ *  and checks the FP64 preconditioned residuals of the solutions.
+ *
+ *  \param [in] shiftsEig  Shifts as fractions between the lowest two
+ *                         eigenvalues (0: lowest, 0.5: interior)
+ *  \param [in] damp       Imaginary part of the shifts (complex only)
+ *  \param [in] mixed      Householder vectors in single precision
+ */
+template <typename MatT>
+void GMRES_TEST(std::string fname, std::vector<double> shiftsEig,
+  double damp, size_t mSS, bool mixed, double conver = 1e-8) {
+
+  if( MPISize(MPI_COMM_WORLD) > 1 ) return;
+
+  SafeFile matFile(FUNC_REFERENCE + fname,true);
+  CQMemManager mem(2e9,256);
+
+  auto dims = matFile.getDims("/matrix");
+  size_t N = dims[0];
+
+  MatT *A = mem.malloc<MatT>(N*N);
+  matFile.readData("/matrix",A);
+
+  std::vector<dcomplex> W(N);
+  matFile.readData("/W",W.data());
+  std::sort(W.begin(),W.end(),
+    [](dcomplex a, dcomplex b){ return std::real(a) < std::real(b); });
+
+  double e0 = std::real(W[0]), e1 = std::real(W[1]);
+  std::vector<MatT> shifts;
+  for(auto f : shiftsEig) {
+    dcomplex s(e0 + f * (e1 - e0), damp);
+    shifts.emplace_back(*reinterpret_cast<MatT*>(&s));
+  }
+
+  const size_t nRHS = 2, nS = shifts.size();
+  std::vector<MatT> RHS(N*nRHS), SOL(N*nRHS*nS);
+  for(auto i = 0ul; i < N; i++) {
+    RHS[i]     = MatT(1.);
+    RHS[i + N] = MatT(double(i % 7) - 3.);
+  }
+
+  typename GMRES<MatT>::LinearTrans_t lt = 
+    [&](size_t nVec, MatT *V, MatT *AV) {
+    blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,
+      N,nVec,N,MatT(1.),A,N,V,N,MatT(0.),AV,N);
+  };
+
+  // PV = (diag(A) - s)^-1 V
+  typename GMRES<MatT>::Shift_t pc = 
+    [&](size_t nVec, MatT s, MatT *V, MatT *PV) {
+    for(auto k = 0ul; k < nVec; k++)
+    for(auto i = 0ul; i < N; i++)
+      PV[i + k*N] = V[i + k*N] / (A[i*(N+1)] - s);
+  };
+
+  ProgramTimer::initialize("GMRES test", omp_get_num_threads());
+  GMRES<MatT> gmres(MPI_COMM_WORLD,mem,N,mSS,conver,lt,pc);
+
+  gmres.setRHS(nRHS,RHS.data(),N);
+  gmres.setShifts(nS,shifts.data());
+  gmres.rhsBS   = nRHS;
+  gmres.shiftBS = nS;
+  gmres.setMixedPrecision(mixed);
+
+  gmres.run();
+  gmres.getSol(SOL.data());
+
+  // | P (B - (A - s I) X) | / | B |
+  std::vector<MatT> R(N), PR(N);
+  for(auto iS = 0ul; iS < nS; iS++)
+  for(auto iR = 0ul; iR < nRHS; iR++) {
+    const MatT *X = SOL.data() + (iR + iS*nRHS)*N;
+    std::copy_n(RHS.data() + iR*N, N, R.data());
+    blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,
+      N,1,N,MatT(-1.),A,N,X,N,MatT(1.),R.data(),N);
+    blas::axpy(N,shifts[iS],X,1,R.data(),1);
+    pc(1,shifts[iS],R.data(),PR.data());
+
+    double rel = blas::nrm2(N,PR.data(),1) / 
+      blas::nrm2(N,RHS.data() + iR*N,1);
+    EXPECT_LT( rel, 10 * conver ) << "IRHS = " << iR << " ISHIFT = " << iS;
+  }
+
+  mem.free(A);
+
+}
+
+#ifndef _CQ_GENERATE_TESTS
+
+// Shifts below the spectrum and between the lowest two eigenvalues
+TEST(GMRES, REAL) {
+  GMRES_TEST<double>("real_Hermitian.hdf5", {-1.0, 0.3}, 0., 100, false);
+}
+
+// Single precision Householder vectors, FP64 refined solutions
+TEST(GMRES, MIXED_PRECISION) {
+  GMRES_TEST<double>("real_Hermitian.hdf5", {-1.0, 0.3}, 0., 100, true);
+  GMRES_TEST<dcomplex>("complex_Hermitian.hdf5", {-0.5, 0.5}, 0.01, 100,
+    true);
+}
+
+#endif
@@ -42,7 +42,7 @@ using namespace ChronusQ;
 template <typename ReadT, typename EigT>
 void GPLHR_TEST(size_t nRoots, size_t m, dcomplex sigma, 
   std::string fname, bool doPre = false, double conver = 1e-10, 
-  double etol = 8e-8, size_t block_size = 128) {
+  double etol = 8e-8, size_t block_size = 128, bool mixed = false) {
 
   MPI_Barrier(MPI_COMM_WORLD);
 
@@ -194,6 +194,7 @@ void GPLHR_TEST(size_t nRoots, size_t m, dcomplex sigma,
 
   gplhr.setM(m);
   gplhr.sigma = std::real(sigma);
+  gplhr.setMixedPrecision(mixed);
   gplhr.run();
 
 
@@ -321,6 +322,19 @@ TEST( GPLHR, GPLHR_REALMAT_REALEIG_NOPRE_10R_4M_2E07S ) {
 }
 
 
+//
+// Single precision subspace, refined in FP64 to the same accuracy
+//
+TEST( GPLHR, GPLHR_MIXED_PRECISION ) {
+
+  GPLHR_TEST<double,double>(6,5,1.e7,"bcsstkm05.hdf5",false,1e-8,8e-8,128,
+    true);
+  GPLHR_TEST<dcomplex,dcomplex>(3,3,0.,"complex_Hermitian.hdf5",false,1e-8,
+    8e-8,128,true);
+
+}
+
+
 
 
 
@@ -0,0 +1,112 @@
+/*
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *
+ *  Copyright (C) 2014-2022 Li Research Group (University of Washington)
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *
+ */
+
+#include <func.hpp>
+#include <cerr.hpp>
+#include <memmanager.hpp>
+#include <cqlinalg/ortho.hpp>
+
+#include <random>
+
+using namespace ChronusQ;
+
+template <typename T>
+void fillRandom(size_t n, T *X, std::mt19937 &gen) {
+  std::uniform_real_distribution<double> dist(-1.,1.);
+  for(auto i = 0ul; i < n; i++) X[i] = dist(gen);
+}
+
+template <>
+void fillRandom(size_t n, dcomplex *X, std::mt19937 &gen) {
+  std::uniform_real_distribution<double> dist(-1.,1.);
+  for(auto i = 0ul; i < n; i++) X[i] = dcomplex(dist(gen),dist(gen));
+}
+
+/**
+ *  Orthonormalizes Mnew random vectors (nDep of which are linear
+ *  combinations of the others) against Mold orthonormal ones and
+ *  compares BlockGramSchmidt to GramSchmidt.
+ */
+template <typename T>
+void BLOCK_ORTHO_TEST(size_t N, size_t Mold, size_t Mnew, size_t nDep) {
+
+  CQMemManager mem(256e6,256);
+  std::mt19937 gen(1234);
+
+  size_t M = Mold + Mnew;
+  T *V   = mem.malloc<T>(N*M);
+  T *VGS = mem.malloc<T>(N*M);
+  T *V0  = mem.malloc<T>(N*Mnew);
+  T *S   = mem.malloc<T>(M*M);
+
+  fillRandom(N*M, V, gen);
+  for(auto k = 0ul; k < nDep; k++) {
+    T *Vk = V + (M-1-k)*N;
+    std::fill_n(Vk, N, T(0.));
+    blas::axpy(N, T(0.5), V + k*N, 1, Vk, 1);
+    blas::axpy(N, T(-2.), V + (M-1-nDep)*N, 1, Vk, 1);
+  }
+
+  if( Mold ) GramSchmidt(N,0,Mold,V,N,mem,1);
+  std::copy_n(V + Mold*N, N*Mnew, V0);
+  std::copy_n(V, N*M, VGS);
+
+  size_t nGS = GramSchmidt(N,Mold,Mnew,VGS,N,mem,1);
+  size_t nB  = BlockGramSchmidt(N,Mold,Mnew,V,N,mem);
+
+  EXPECT_EQ( nB, nGS );
+  EXPECT_EQ( nB, M - nDep );
+
+  // V**H V = I
+  blas::gemm(blas::Layout::ColMajor,blas::Op::ConjTrans,blas::Op::NoTrans,
+    nB,nB,N,T(1.),V,N,V,N,T(0.),S,nB);
+  for(auto k = 0ul; k < nB; k++) S[k*(nB+1)] -= 1.;
+  EXPECT_LT( blas::nrm2(nB*nB,S,1), 1e-12 );
+
+  // The new vectors are contained in span(V): V0 - V V**H V0 = 0
+  blas::gemm(blas::Layout::ColMajor,blas::Op::ConjTrans,blas::Op::NoTrans,
+    nB,Mnew,N,T(1.),V,N,V0,N,T(0.),S,nB);
+  blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,
+    N,Mnew,nB,T(-1.),V,N,S,nB,T(1.),V0,N);
+  EXPECT_LT( blas::nrm2(N*Mnew,V0,1), 1e-10 );
+
+  mem.free(V, VGS, V0, S);
+
+}
+
+TEST(ORTHO, BLOCK_GRAM_SCHMIDT) {
+
+  BLOCK_ORTHO_TEST<double>(500, 0, 12, 0);
+  BLOCK_ORTHO_TEST<double>(500, 20, 12, 0);
+  BLOCK_ORTHO_TEST<dcomplex>(500, 20, 12, 0);
+
+}
+
+TEST(ORTHO, BLOCK_GRAM_SCHMIDT_DEPENDENT) {
+
+  BLOCK_ORTHO_TEST<double>(500, 20, 12, 2);
+  BLOCK_ORTHO_TEST<dcomplex>(500, 20, 12, 2);
+
+}
+
@@ -0,0 +1,226 @@
+/* 
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *  
+ *  Copyright (C) 2014-2022 Li Research Group (University of Washington)
+ *  
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *  
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *  
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *  
+ */
+
+#include <func.hpp>
+#include <cerr.hpp>
+#include <memmanager.hpp>
+#include <itersolver.hpp>
+#include <util/files.hpp>
+#include <util/timer.hpp>
+
+#include <cqlinalg/blas1.hpp>
+#include <cqlinalg/blas3.hpp>
+
+using namespace ChronusQ;
+
+
+/**
+ *  Solves (A - s I) X = B by shifted GMRES for a set of shifts and checks
+ *  the FP64 residuals of the solutions directly.
+ *
+ *  \param [in] shiftsEig  Shifts as fractions between the lowest two
+ *                         eigenvalues (0: lowest, 0.5: interior)
+ *  \param [in] damp       Imaginary part of the shifts (complex only)
+ *  \param [in] collinear  Collinear restarts, otherwise all shifts but
+ *                         the seed are detached at the first restart
+ *  \param [in] maxIter    Total iteration budget (0: converge)
+ *  \param [in] mixed      Krylov bases in single precision
+ *  \param [in] chkIter    Resume from the checkpoint of a run which was
+ *                         interrupted after chkIter iterations and
+ *                         compare to an uninterrupted run
+ */
+template <typename MatT>
+void SHIFTED_GMRES_TEST(std::string fname, std::vector<double> shiftsEig,
+  double damp, size_t mSS, bool collinear, size_t maxIter = 0,
+  double conver = 1e-8, bool mixed = false, size_t chkIter = 0) {
+
+  if( MPISize(MPI_COMM_WORLD) > 1 ) return;
+
+  SafeFile matFile(FUNC_REFERENCE + fname,true);
+  CQMemManager mem(2e9,256);
+
+  auto dims = matFile.getDims("/matrix");
+  size_t N = dims[0];
+
+  MatT *A = mem.malloc<MatT>(N*N);
+  matFile.readData("/matrix",A);
+
+  std::vector<dcomplex> W(N);
+  matFile.readData("/W",W.data());
+  std::sort(W.begin(),W.end(),
+    [](dcomplex a, dcomplex b){ return std::real(a) < std::real(b); });
+
+  double e0 = std::real(W[0]), e1 = std::real(W[1]);
+  std::vector<MatT> shifts;
+  for(auto f : shiftsEig) {
+    dcomplex s(e0 + f * (e1 - e0), damp);
+    shifts.emplace_back(*reinterpret_cast<MatT*>(&s));
+  }
+
+  const size_t nRHS = 2, nS = shifts.size();
+  std::vector<MatT> RHS(N*nRHS), SOL(N*nRHS*nS);
+  for(auto i = 0ul; i < N; i++) {
+    RHS[i]     = MatT(1.);
+    RHS[i + N] = MatT(double(i % 7) - 3.);
+  }
+
+  size_t nLT = 0; // Number of linear transformations
+  typename ShiftedGMRES<MatT>::LinearTrans_t lt = 
+    [&](size_t nVec, MatT *V, MatT *AV) {
+    nLT += nVec;
+    blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,
+      N,nVec,N,MatT(1.),A,N,V,N,MatT(0.),AV,N);
+  };
+
+  typename ShiftedGMRES<MatT>::Shift_t pc = 
+    [&](size_t nVec, MatT, MatT *V, MatT *PV) {
+    if( V != PV ) std::copy_n(V,nVec*N,PV);
+  };
+
+  ProgramTimer::initialize("Shifted GMRES test", omp_get_num_threads());
+  size_t nMacro = 200;
+  auto setup = [&](ShiftedGMRES<MatT> &solver, size_t budget) {
+    solver.setRHS(nRHS,RHS.data(),N);
+    solver.setShifts(nS,shifts.data());
+    solver.rhsBS   = nRHS;
+    solver.shiftBS = nS;
+    solver.maxIter = budget;
+    solver.collinearRestart = collinear;
+    solver.setMixedPrecision(mixed);
+  };
+
+  SafeFile chkFile(TEST_OUT "shiftedgmres_chk.bin");
+  std::vector<MatT> SOLRef(N*nRHS*nS);
+  size_t nLTRef = 0;
+
+  if( chkIter ) {
+
+    ShiftedGMRES<MatT> ref(MPI_COMM_WORLD,mem,N,mSS,nMacro,conver,lt,pc);
+    setup(ref,maxIter);
+    ref.run();
+    ref.getSol(SOLRef.data());
+    nLTRef = nLT;
+
+    chkFile.createFile();
+
+    ShiftedGMRES<MatT> part(MPI_COMM_WORLD,mem,N,mSS,nMacro,conver,lt,pc);
+    setup(part,chkIter);
+    part.setCheckpoint(chkFile,"/SHIFTED_GMRES",1,false);
+    part.run();
+
+    nLT = 0;
+
+  }
+
+  ShiftedGMRES<MatT> sgmres(MPI_COMM_WORLD,mem,N,mSS,nMacro,conver,lt,pc);
+  setup(sgmres,maxIter);
+  if( chkIter ) sgmres.setCheckpoint(chkFile,"/SHIFTED_GMRES",1,true);
+
+  sgmres.run();
+  sgmres.getSol(SOL.data());
+
+  // The resumed run continues the interrupted one
+  if( chkIter ) {
+    EXPECT_LT( nLT, nLTRef );
+    for(auto iDo = 0ul; iDo < nRHS*nS; iDo++) {
+      std::vector<MatT> D(SOLRef.begin() + iDo*N, SOLRef.begin() + (iDo+1)*N);
+      blas::axpy(N,MatT(-1.),SOL.data() + iDo*N,1,D.data(),1);
+      EXPECT_LT( blas::nrm2(N,D.data(),1), 
+        1e3 * conver * blas::nrm2(N,SOLRef.data() + iDo*N,1) ) 
+        << "IDO = " << iDo;
+    }
+  }
+
+  if( maxIter ) {
+    EXPECT_LE( sgmres.totalIterations(), maxIter );
+    return;
+  }
+
+  if( not collinear ) EXPECT_GT( sgmres.nDetached(), 0ul );
+
+  // | B - (A - s I) X | / | B |
+  std::vector<MatT> R(N);
+  for(auto iS = 0ul; iS < nS; iS++)
+  for(auto iR = 0ul; iR < nRHS; iR++) {
+    const MatT *X = SOL.data() + (iR + iS*nRHS)*N;
+    std::copy_n(RHS.data() + iR*N, N, R.data());
+    blas::gemm(blas::Layout::ColMajor,blas::Op::NoTrans,blas::Op::NoTrans,
+      N,1,N,MatT(-1.),A,N,X,N,MatT(1.),R.data(),N);
+    blas::axpy(N,shifts[iS],X,1,R.data(),1);
+
+    double rel = blas::nrm2(N,R.data(),1) / 
+      blas::nrm2(N,RHS.data() + iR*N,1);
+    EXPECT_LT( rel, 10 * conver ) << "IRHS = " << iR << " ISHIFT = " << iS;
+  }
+
+  mem.free(A);
+
+}
+
+#ifndef _CQ_GENERATE_TESTS
+
+// Shifts below the spectrum and between the lowest two eigenvalues
+// (indefinite A - sI), restarted every 30 iterations
+TEST(SHIFTED_GMRES, REAL_COLLINEAR) {
+  SHIFTED_GMRES_TEST<double>("real_Hermitian.hdf5",
+    {-1.0, -0.2, 0.3, 0.5}, 0., 30, true);
+}
+
+// Every shift but the seed is solved on its own residual system
+TEST(SHIFTED_GMRES, REAL_DETACHED) {
+  SHIFTED_GMRES_TEST<double>("real_Hermitian.hdf5",
+    {-1.0, -0.2, 0.3, 0.5}, 0., 30, false);
+}
+
+// The detached solves draw from the same iteration budget
+TEST(SHIFTED_GMRES, REAL_DETACHED_BUDGET) {
+  SHIFTED_GMRES_TEST<double>("real_Hermitian.hdf5",
+    {-1.0, -0.2, 0.3, 0.5}, 0., 30, false, 35);
+}
+
+// Damped (complex) shifts
+TEST(SHIFTED_GMRES, COMPLEX_DAMPED) {
+  SHIFTED_GMRES_TEST<dcomplex>("complex_Hermitian.hdf5",
+    {-2.0, -0.5, 0.3, 0.5}, 0.01, 30, true);
+  SHIFTED_GMRES_TEST<dcomplex>("complex_Hermitian.hdf5",
+    {-2.0, -0.5, 0.3, 0.5}, 0.01, 30, false);
+}
+
+// Single precision Krylov bases, FP64 refined solutions
+TEST(SHIFTED_GMRES, MIXED_PRECISION) {
+  SHIFTED_GMRES_TEST<double>("real_Hermitian.hdf5",
+    {-1.0, -0.2, 0.3, 0.5}, 0., 30, true, 0, 1e-8, true);
+  SHIFTED_GMRES_TEST<dcomplex>("complex_Hermitian.hdf5",
+    {-2.0, -0.5, 0.3, 0.5}, 0.01, 30, false, 0, 1e-8, true);
+}
+
+// Resumed from the checkpoint of a run interrupted at a restart
+TEST(SHIFTED_GMRES, CHECKPOINT) {
+  SHIFTED_GMRES_TEST<double>("real_Hermitian.hdf5",
+    {-1.0, -0.2, 0.3, 0.5}, 0., 30, true, 0, 1e-8, false, 60);
+  SHIFTED_GMRES_TEST<dcomplex>("complex_Hermitian.hdf5",
+    {-2.0, -0.5, 0.3, 0.5}, 0.01, 30, false, 0, 1e-8, false, 30);
+}
+
+#endif
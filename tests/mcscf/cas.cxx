@@ -88,6 +88,46 @@ TEST(TwoC_CAS_SWAP, Be_2c_SWAP_sto3G ) {
 
 };
 
+#ifndef _CQ_GENERATE_TESTS
+
+// MO integrals from the RI / Cholesky factors against the N6
+// transformation of the same (Cholesky) AO integrals
+TEST(OneC_CASSCF_RI, Al_631G ) {
+
+  std::string ri = "mcscf/serial/cas/al_6-31G_1c_casscf_ri";
+  std::string n6 = "mcscf/serial/cas/al_6-31G_1c_casscf_ri_n6";
+
+  CQMCSCFREFTEST( ri, "al_6-31G_1c_casscf.bin.ref", 1e-6 );
+  CQMCSCFREFTEST( n6, "al_6-31G_1c_casscf.bin.ref", 1e-6 );
+
+  SafeFile riFile(TEST_OUT + ri + ".bin", true);
+  SafeFile n6File(TEST_OUT + n6 + ".bin", true);
+
+  double NS;
+  riFile.readData("MCWFN/NSTATES", &NS);
+
+  std::vector<double> riE(NS), n6E(NS);
+  riFile.readData("MCWFN/STATE_ENERGY", riE.data());
+  n6File.readData("MCWFN/STATE_ENERGY", n6E.data());
+
+  for (auto i = 0; i < NS; i++)
+    EXPECT_NEAR( riE[i], n6E[i], 1e-9 ) << "ISTATE = " << i;
+
+};
+
+// Exact second order (Newton-Raphson) orbital optimization, with and
+// without the finite difference check of the orbital hessian
+TEST(OneC_CASSCF_NEWTON, Al_631G ) {
+
+  CQMCSCFREFTEST( "mcscf/serial/cas/al_6-31G_1c_casscf_newton",
+    "al_6-31G_1c_casscf.bin.ref", 1e-7 );
+  CQMCSCFREFTEST( "mcscf/serial/cas/al_6-31G_1c_casscf_newton_check",
+    "al_6-31G_1c_casscf.bin.ref", 1e-7 );
+
+};
+
+#endif
+
 // oscillator strength test
 TEST(GHF_CAS_OSC, Al_GHF_OSC_STR) {
 
@@ -108,6 +148,152 @@ TEST(CASCI_DAVIDSON, Al_631G ) {
  
 };
 
+TEST(CASCI_DAVIDSON_ONTHEFLY, Al_631G ) {
+
+  CQMCSCFREFTEST( "mcscf/serial/cas/al_6-31G_1c_casci_davidson_onthefly", "al_6-31G_1c_casci.bin.ref");
+  CQMCSCFTEST( "mcscf/serial/cas/al_6-31G_x2c_casci_davidson_onthefly",   "al_6-31G_x2c_casci.bin.ref" );
+
+  // Blocks of 3 strings: several blocks per list, the last one partial
+  CQMCSCFREFTEST( "mcscf/serial/cas/al_6-31G_1c_casci_davidson_onthefly_block", "al_6-31G_1c_casci.bin.ref");
+  CQMCSCFTEST( "mcscf/serial/cas/al_6-31G_x2c_casci_davidson_onthefly_block",   "al_6-31G_x2c_casci.bin.ref" );
+ 
+};
+
+// With MPI the sigma build is distributed and the integrals are
+// transformed on the root process only
+TEST(CASCI_DAVIDSON_DIRECT, Al_631G ) {
+
+  CQMCSCFREFTEST( "mcscf/serial/cas/al_6-31G_1c_casci_davidson_direct",  "al_6-31G_1c_casci.bin.ref");
+  CQMCSCFREFTEST( "mcscf/serial/cas/al_6-31G_1c_casscf_davidson_direct", "al_6-31G_1c_casscf.bin.ref", 1e-7);
+ 
+};
+
+// CAS(1,2) with fewer determinants than processes in the MPI run: the
+// Davidson vectors stay on the root while the sigma build is distributed.
+// Checked against the full diagonalization of the same space
+TEST(CASCI_DAVIDSON_TINY, Li_sto3G ) {
+
+#ifndef _CQ_GENERATE_TESTS
+  std::string full = "mcscf/serial/cas/li_sto-3G_1c_casci_full";
+  std::string dav  = "mcscf/serial/cas/li_sto-3G_1c_casci_davidson";
+
+  RunChronusQ(TEST_ROOT + full + ".inp", "STDOUT", TEST_OUT + full + ".bin", "");
+  RunChronusQ(TEST_ROOT + dav  + ".inp", "STDOUT", TEST_OUT + dav  + ".bin", "");
+
+  SafeFile refFile(TEST_OUT + full + ".bin", true);
+  SafeFile resFile(TEST_OUT + dav  + ".bin", true);
+
+  double xNS, yNS;
+  refFile.readData("MCWFN/NSTATES", &xNS);
+  resFile.readData("MCWFN/NSTATES", &yNS);
+  ASSERT_EQ( xNS, yNS ) << "NUMBER OF STATES TEST FAILED ";
+
+  std::vector<double> xStateEnergy(xNS), yStateEnergy(yNS);
+  refFile.readData("MCWFN/STATE_ENERGY", &xStateEnergy[0]);
+  resFile.readData("MCWFN/STATE_ENERGY", &yStateEnergy[0]);
+
+  for(auto i = 0; i < xNS; i++)
+    EXPECT_NEAR(xStateEnergy[i], yStateEnergy[i], 1e-8 ) <<
+      "ENERGY TEST FAILED ISTATE = " << i;
+#endif
+
+};
+
+TEST(SCICI, Al_631G ) {
+
+  // A zero selection threshold closes the selection on the full CAS space
+  CQMCSCFREFTEST( "mcscf/serial/cas/al_6-31G_1c_scici", "al_6-31G_1c_casci.bin.ref");
+  CQMCSCFTEST( "mcscf/serial/cas/al_6-31G_x2c_scici",   "al_6-31G_x2c_casci.bin.ref" );
+ 
+};
+
+#ifndef _CQ_GENERATE_TESTS
+
+// A finite threshold truncates the space: the energies are variational
+// upper bounds close to the CASCI ones
+TEST(SCICI, Al_631G_Epsilon ) {
+
+  std::string in  = "mcscf/serial/cas/al_6-31G_1c_scici_eps";
+  std::string ref = "al_6-31G_1c_casci.bin.ref";
+
+  std::ifstream src(MCSCF_TEST_REF + ref, std::ios::binary);
+  std::ofstream dst(TEST_OUT + in + ".bin", std::ios::binary);
+  dst << src.rdbuf();
+  dst.flush();
+
+  RunChronusQ(TEST_ROOT + in + ".inp", "STDOUT", TEST_OUT + in + ".bin", "");
+
+  SafeFile refFile(MCSCF_TEST_REF + ref, true);
+  SafeFile resFile(TEST_OUT + in + ".bin", true);
+
+  double xNS, yNS;
+  refFile.readData("MCWFN/NSTATES", &xNS);
+  resFile.readData("MCWFN/NSTATES", &yNS);
+  ASSERT_EQ( xNS, yNS );
+
+  std::vector<double> xE(xNS), yE(yNS);
+  refFile.readData("MCWFN/STATE_ENERGY", xE.data());
+  resFile.readData("MCWFN/STATE_ENERGY", yE.data());
+
+  for (auto i = 0; i < xNS; i++) {
+    EXPECT_GE( yE[i], xE[i] - 1e-8 ) << "ISTATE = " << i;
+    EXPECT_NEAR( yE[i], xE[i], 1e-4 ) << "ISTATE = " << i;
+  }
+
+};
+
+// The transition densities of the GEMM CAS builder against the per
+// determinant loops of the SCI builder over the same (full) space.
+// Oscillator strengths of the ground state are summed over degenerate
+// excited levels, which makes them independent of the eigenvectors
+// chosen within a level
+TEST(SCICI, Be_STO3G_OSC_STR ) {
+
+  std::string cas = "mcscf/serial/cas/be_sto-3G_1c_casci_osc_str";
+  std::string sci = "mcscf/serial/cas/be_sto-3G_1c_scici_osc_str";
+
+  RunChronusQ(TEST_ROOT + cas + ".inp", "STDOUT", TEST_OUT + cas + ".bin", "");
+  RunChronusQ(TEST_ROOT + sci + ".inp", "STDOUT", TEST_OUT + sci + ".bin", "");
+
+  SafeFile casFile(TEST_OUT + cas + ".bin", true);
+  SafeFile sciFile(TEST_OUT + sci + ".bin", true);
+
+  auto oscDim = casFile.getDims("MCWFN/OSC_STR");
+  ASSERT_EQ( oscDim.size(), 2 );
+  ASSERT_EQ( oscDim, sciFile.getDims("MCWFN/OSC_STR") );
+
+  const size_t NS = oscDim[1];
+  std::vector<double> casE(NS), sciE(NS), casOsc(NS), sciOsc(NS);
+  casFile.readData("MCWFN/STATE_ENERGY", casE.data());
+  sciFile.readData("MCWFN/STATE_ENERGY", sciE.data());
+  casFile.readData("MCWFN/OSC_STR", casOsc.data());
+  sciFile.readData("MCWFN/OSC_STR", sciOsc.data());
+
+  for (auto i = 0ul; i < NS; i++)
+    EXPECT_NEAR( casE[i], sciE[i], 1e-8 ) << "ISTATE = " << i;
+
+  for (auto lev = 1ul; lev < NS; ) {
+    auto end = lev + 1;
+    while (end < NS and std::abs(casE[end] - casE[lev]) < 1e-6) end++;
+
+    double casF = 0., sciF = 0.;
+    for (auto s = lev; s < end; s++) { casF += casOsc[s]; sciF += sciOsc[s]; }
+    EXPECT_NEAR( casF, sciF, 1e-8 ) << "STATES " << lev << " - " << end - 1;
+
+    lev = end;
+  }
+
+};
+
+// SCISCF with a zero threshold is CASSCF
+TEST(SCICI, Al_631G_SCISCF ) {
+
+  CQMCSCFREFTEST( "mcscf/serial/cas/al_6-31G_1c_sciscf", "al_6-31G_1c_casscf.bin.ref", 1e-7);
+
+};
+
+#endif
+
 #ifndef _CQ_GENERATE_TESTS
 #ifdef _CQ_DO_PARTESTS
 
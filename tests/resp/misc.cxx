@@ -33,3 +33,51 @@ CQRESTEST_IMPL( Water_631Gd_RESIDUE_XRAY_540eV,
     "resp/serial/misc/water_6-31Gd_rhf_residue_xray_540eV",
     "water_6-31Gd_rhf_residue.bin.ref" )
 
+
+#ifndef _CQ_GENERATE_TESTS
+
+// Water 6-31G(d) FDR: a second job on the same binary file reads the MO
+// property integrals cached by the first one. The cached dipole
+// integrals are doubled in between, which has to show up as a factor
+// of four in the ED-ED polarizability
+TEST( MISC_RESP, Water_631Gd_FDR_PROPCACHE ) {
+
+  std::string in = "resp/serial/misc/water_6-31Gd_rhf_fdr_propcache";
+  std::string polarSet = "/RESP/FDR/ED_ED_POLARIZABILITY_LENGTH";
+
+  CQFDRTEST<double>( true, true, in, "water_6-31Gd_rhf_fdr.bin.ref" );
+
+  std::vector<double> polar;
+  if( MPIRank() == 0 ) {
+
+    SafeFile resFile(TEST_OUT + in + ".bin",true);
+    std::string dataSet = "/RESP/PROPGRAD/MO/LEN_ELEC_DIPOLE";
+
+    auto dims = resFile.getDims(dataSet);
+    ASSERT_EQ( dims.size(), 3 );
+
+    std::vector<double> ints(dims[0]*dims[1]*dims[2]);
+    resFile.readData(dataSet,ints.data());
+    for(auto &x : ints) x *= 2.;
+    resFile.safeWriteData(dataSet,ints.data(),dims);
+
+    polar.resize(resFile.getDims(polarSet)[0] * 9);
+    resFile.readData(polarSet,polar.data());
+
+  }
+
+  CQRESPTEST( in, "water_6-31Gd_rhf_fdr.bin.ref" );
+  if( MPIRank() != 0 ) return;
+
+  SafeFile resFile(TEST_OUT + in + ".bin",true);
+
+  std::vector<double> polar2(polar.size());
+  resFile.readData(polarSet,polar2.data());
+
+  for(auto i = 0ul; i < polar.size(); i++)
+    EXPECT_NEAR( polar2[i], 4. * polar[i], 1e-6 ) <<
+      "ED ED POLAR (CACHED) TEST FAILED IO = " << i;
+
+}
+
+#endif
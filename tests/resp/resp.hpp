@@ -103,6 +103,21 @@ static void CQRESPSCRTEST( std::string in, std::string ref, std::string scr ) {
 };
 
 
+// Checks the full / iterative choice recorded in the output file
+static void CQRESPFULLTEST( std::string in, bool expectFull ) {
+
+  if( MPIRank() != 0 ) return;
+
+  SafeFile resFile(TEST_OUT + in + ".bin",true);
+
+  int isFull;
+  resFile.readData("/RESP/DOFULL", &isFull);
+
+  EXPECT_EQ( bool(isFull), expectFull ) << "UNEXPECTED RESPONSE SOLVER";
+
+};
+
+
 static void CQRESTEST( bool checkProp, std::string in, std::string ref, 
     bool runCQ = true, double tol = 1e-06 ) {
 
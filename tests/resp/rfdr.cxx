@@ -51,6 +51,33 @@ CQFDRTEST_IMPL( Water_631Gd_FDR,  true, true,
       "resp/serial/rresp/water_6-31Gd_rhf_fdr_gmres_direct",
       "water_6-31Gd_rhf_fdr.bin.ref" )
 
+  // Water 6-31G(d) FDR (AUTOMATIC -> GMRES)
+  TEST( RHF_FDR, Water_631Gd_FDR_AUTO ) {
+    CQFDRTEST<double>( true, true, 
+      "resp/serial/rresp/water_6-31Gd_rhf_fdr_auto",
+      "water_6-31Gd_rhf_fdr.bin.ref" );
+    CQRESPFULLTEST( "resp/serial/rresp/water_6-31Gd_rhf_fdr_auto", false );
+  }
+
+  // Water 6-31G(d) FDR (AUTOMATIC -> FULL)
+  TEST( RHF_FDR, Water_631Gd_FDR_AUTO_FULL ) {
+    CQFDRTEST<double>( true, true, 
+      "resp/serial/rresp/water_6-31Gd_rhf_fdr_auto_full",
+      "water_6-31Gd_rhf_fdr.bin.ref" );
+    CQRESPFULLTEST( "resp/serial/rresp/water_6-31Gd_rhf_fdr_auto_full", 
+      true );
+  }
+
+  // Water 6-31G(d) FDR (Shifted GMRES)
+  CQFDRTEST_IMPL( Water_631Gd_FDR_SHIFTED,  true, true, 
+      "resp/serial/rresp/water_6-31Gd_rhf_fdr_shifted",
+      "water_6-31Gd_rhf_fdr.bin.ref" )
+
+  // Water 6-31G(d) FDR (Shifted GMRES, restarted every 8 iterations)
+  CQFDRTEST_IMPL( Water_631Gd_FDR_SHIFTED_RESTART,  true, true, 
+      "resp/serial/rresp/water_6-31Gd_rhf_fdr_shifted_restart",
+      "water_6-31Gd_rhf_fdr.bin.ref" )
+
 #endif
 
 #ifdef _CQ_DO_PARTESTS
@@ -324,6 +351,16 @@ CQDFDRTEST_IMPL( Water_631Gd_DFDR,  true, true,
       "resp/serial/rresp/water_6-31Gd_rhf_dfdr_gmres_direct",
       "water_6-31Gd_rhf_dfdr.bin.ref" )
 
+  // Water 6-31G(d) DFDR (Shifted GMRES, complex shifts)
+  CQDFDRTEST_IMPL( Water_631Gd_DFDR_SHIFTED,  true, true, 
+      "resp/serial/rresp/water_6-31Gd_rhf_dfdr_shifted",
+      "water_6-31Gd_rhf_dfdr.bin.ref" )
+
+  // Water 6-31G(d) DFDR (Shifted GMRES, restarted every 8 iterations)
+  CQDFDRTEST_IMPL( Water_631Gd_DFDR_SHIFTED_RESTART,  true, true, 
+      "resp/serial/rresp/water_6-31Gd_rhf_dfdr_shifted_restart",
+      "water_6-31Gd_rhf_dfdr.bin.ref" )
+
 #endif
 
 #ifdef _CQ_DO_PARTESTS
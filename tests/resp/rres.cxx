@@ -49,6 +49,37 @@ CQRESTEST_IMPL( Water_631Gd_RESIDUE,
       "resp/serial/rresp/water_6-31Gd_rhf_residue_gplhr_direct",
       "water_6-31Gd_rhf_residue.bin.ref" )
 
+  // Water 6-31G(d) TDHF (RESIDUE, ENERGY WINDOW)
+  // The 12th and 13th roots of the full reference, DEMIN = EWINMIN
+  // aligns the window with the reference
+  CQRESTEST_IMPL( Water_631Gd_RESIDUE_WINDOW,  
+      "resp/serial/rresp/water_6-31Gd_rhf_residue_window",
+      "water_6-31Gd_rhf_residue.bin.ref" )
+
+  // Water 6-31G(d) TDHF (RESIDUE, ENERGY WINDOW + CVS)
+  // Lowest four O K-edge roots, compared loosely since the core-valence
+  // separation drops the coupling to the valence excitations
+  TEST( RHF_RESIDUE, Water_631Gd_RESIDUE_WINDOW_CVS ) {
+    CQRESTEST( false, "resp/serial/rresp/water_6-31Gd_rhf_residue_window_cvs",
+      "water_6-31Gd_rhf_residue.bin.ref", true, 1e-2 );
+  }
+
+  // Water 6-31G(d) TDHF (RESIDUE, AUTOMATIC -> GPLHR)
+  TEST( RHF_RESIDUE, Water_631Gd_RESIDUE_AUTO ) {
+    CQRESTEST( true, "resp/serial/rresp/water_6-31Gd_rhf_residue_auto",
+      "water_6-31Gd_rhf_residue.bin.ref" );
+    CQRESPFULLTEST( "resp/serial/rresp/water_6-31Gd_rhf_residue_auto", 
+      false );
+  }
+
+  // Water 6-31G(d) TDHF (RESIDUE, AUTOMATIC -> FULL)
+  TEST( RHF_RESIDUE, Water_631Gd_RESIDUE_AUTO_FULL ) {
+    CQRESTEST( true, "resp/serial/rresp/water_6-31Gd_rhf_residue_auto_full",
+      "water_6-31Gd_rhf_residue.bin.ref" );
+    CQRESPFULLTEST( "resp/serial/rresp/water_6-31Gd_rhf_residue_auto_full",
+      true );
+  }
+
 #endif
 
 
@@ -34,6 +34,61 @@ TEST( RHF_RT, Water_631Gd_Delta_Y ) {
 
 }
 
+// Water 6-31G(d) Delta Spike propagated along Y, X and Z concurrently
+// (the Y replica is stored in RT/ and must match the single run)
+TEST( RHF_RT, Water_631Gd_Delta_Y_Polarization ) {
+
+  CQRTTEST( rt/serial/rrt/water_6-31Gd_rhf_delta_y_polarization,
+    water_6-31Gd_rhf_delta_y.bin.ref );
+
+#ifndef _CQ_GENERATE_TESTS
+
+  // The X and Z replicas must match separate runs along X and Z
+  CQRTReplicaTest("rt/serial/rrt/water_6-31Gd_rhf_delta_y_polarization", 1,
+    "rt/serial/rrt/water_6-31Gd_rhf_delta_x");
+  CQRTReplicaTest("rt/serial/rrt/water_6-31Gd_rhf_delta_y_polarization", 2,
+    "rt/serial/rrt/water_6-31Gd_rhf_delta_z");
+
+#endif
+
+}
+
+// Water 6-31G(d) Delta Spike with the on-the-fly spectrum accumulated
+// (propagation must be unaffected)
+TEST( RHF_RT, Water_631Gd_Delta_Y_Spectrum ) {
+
+  CQRTTEST( rt/serial/rrt/water_6-31Gd_rhf_delta_y_spectrum,
+    water_6-31Gd_rhf_delta_y.bin.ref );
+
+}
+
+// Water 6-31G(d) Delta Spike propagating only the occupied orbitals
+TEST( RHF_RT, Water_631Gd_Delta_Y_Orbitals ) {
+
+  CQRTTEST( rt/serial/rrt/water_6-31Gd_rhf_delta_y_orbitals,
+    water_6-31Gd_rhf_delta_y.bin.ref );
+
+}
+
+#ifndef _CQ_GENERATE_TESTS
+
+// Orbital populations (projections onto the starting MOs) of the
+// occupied orbital propagation must match the density propagation
+TEST( RHF_RT, Water_631Gd_Orbitals_Population ) {
+
+  std::string den = "rt/serial/rrt/water_6-31Gd_rhf_delta_y_pop";
+  std::string orb = "rt/serial/rrt/water_6-31Gd_rhf_delta_y_pop_orbitals";
+
+  RunChronusQ(TEST_ROOT + den + ".inp", "STDOUT", TEST_OUT + den + ".bin", "");
+  RunChronusQ(TEST_ROOT + orb + ".inp", "STDOUT", TEST_OUT + orb + ".bin", "");
+
+  CQRTCompareSeries(orb, "/RT", den, "/RT");
+  CQRTCompareData(orb, den, "/RT/ORBITALPOPULATION");
+
+}
+
+#endif
+
 // Magnus 2 delta electric field
 TEST( RHF_RT, Water_631Gd_Magnus2 ) {
 
@@ -42,6 +97,20 @@ TEST( RHF_RT, Water_631Gd_Magnus2 ) {
 
 }
 
+// Magnus 2 with Y and X replicas, F(k+1) of both replicas is formed in
+// one batched G[D] build
+TEST( RHF_RT, Water_631Gd_Magnus2_Polarization ) {
+
+  CQRTTEST( rt/serial/rrt/water_6-31Gd_rhf_magnus2_polarization,
+    water_6-31Gd_rhf_magnus2.bin.ref );
+
+#ifndef _CQ_GENERATE_TESTS
+  CQRTReplicaTest("rt/serial/rrt/water_6-31Gd_rhf_magnus2_polarization", 1,
+    "rt/serial/rrt/water_6-31Gd_rhf_magnus2_x");
+#endif
+
+}
+
 // MMUT w/ Magnus 2 restart non-delta electric field
 TEST( RHF_RT, Water_631Gd_MMUT_Magnus2 ) {
 
@@ -83,6 +152,20 @@ TEST( RKS_RT, Water_631Gd_B3LYP_Delta_Y ) {
 
 }
 
+// Water 6-31G(d) B3LYP Delta Spike with Y and X replicas (batched G[D]
+// with scaled exchange, VXC per replica)
+TEST( RKS_RT, Water_631Gd_B3LYP_Delta_Y_Polarization ) {
+
+  CQRTTEST( rt/serial/rrt/water_6-31Gd_rb3lyp_delta_y_polarization,
+    water_6-31Gd_rb3lyp_delta_y.bin.ref );
+
+#ifndef _CQ_GENERATE_TESTS
+  CQRTReplicaTest("rt/serial/rrt/water_6-31Gd_rb3lyp_delta_y_polarization", 1,
+    "rt/serial/rrt/water_6-31Gd_rb3lyp_delta_x");
+#endif
+
+}
+
 
 // MMUT w/ Magnus 2 restart non-delta electric field
 TEST( RKS_RT, Water_631Gd_MMUT_Magnus2 ) {
@@ -119,6 +202,52 @@ TEST( RESTART_RT, Restart_Water_631Gd_B3LYP_Delta_Y ) {
 
 }
 
+#ifndef _CQ_GENERATE_TESTS
+
+// Propagate to 0.5 and extend the run to 1. from the checkpoint, the
+// MMUT segment open at 0.5 must be resumed (no restart step)
+TEST( RESTART_RT, Restart_Water_631Gd_Delta_Y_Extend ) {
+
+  std::string in = "rt/serial/rrt/water_6-31Gd_rhf_delta_y_restart";
+  CQRTRestartRun("rt/serial/rrt/water_6-31Gd_rhf_delta_y_restart_mid", in);
+
+  CQRTCompareFiles(TEST_OUT + in + ".bin", "/RT",
+    RT_TEST_REF "water_6-31Gd_rhf_delta_y.bin.ref", "/RT");
+
+}
+
+// Same for MMUT with Magnus 2 restart steps
+TEST( RESTART_RT, Restart_Water_631Gd_MMUT_Magnus2_Extend ) {
+
+  std::string in = "rt/serial/rrt/water_6-31Gd_rhf_mmut_magnus2_restart";
+  CQRTRestartRun("rt/serial/rrt/water_6-31Gd_rhf_mmut_magnus2_restart_mid", in);
+
+  CQRTCompareFiles(TEST_OUT + in + ".bin", "/RT",
+    RT_TEST_REF "water_6-31Gd_rhf_mmut_magnus2.bin.ref", "/RT");
+
+}
+
+// Resume from a checkpoint and from an interrupted checkpoint write
+// (falls back to the last saved time point); the MMUT is restarted at
+// 0.5 in all runs so that both must match the uninterrupted run
+TEST( RESTART_RT, Restart_Water_631Gd_Delta_Y_Interrupted ) {
+
+  std::string ref = "rt/serial/rrt/water_6-31Gd_rhf_delta_y_irstrt";
+  std::string mid = "rt/serial/rrt/water_6-31Gd_rhf_delta_y_irstrt_mid";
+  std::string in  = "rt/serial/rrt/water_6-31Gd_rhf_delta_y_irstrt_restart";
+
+  RunChronusQ(TEST_ROOT + ref + ".inp", "STDOUT", TEST_OUT + ref + ".bin", "");
+
+  CQRTRestartRun(mid, in);
+  CQRTCompareSeries(in, "/RT", ref, "/RT");
+
+  CQRTRestartRun(mid, in, true);
+  CQRTCompareSeries(in, "/RT", ref, "/RT");
+
+}
+
+#endif
+
 #ifdef _CQ_DO_PARTESTS
 
 TEST( RESTART_RT, PAR_Restart_Water_631Gd_B3LYP_Delta_Y ) {
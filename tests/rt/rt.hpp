@@ -180,3 +180,103 @@ using namespace ChronusQ;
 
 #endif
 
+
+#ifndef _CQ_GENERATE_TESTS
+
+// Compare the time series (ENERGY and LEN_ELEC_DIPOLE) stored in the
+// group resGroup of the file resName to the group refGroup of refName
+inline void CQRTCompareFiles( std::string resName, std::string resGroup,
+  std::string refName, std::string refGroup, double tol = 1e-8 ) {
+
+  SafeFile resFile(resName, true);
+  SafeFile refFile(refName, true);
+
+  auto resDims = resFile.getDims(resGroup + "/LEN_ELEC_DIPOLE");
+  auto refDims = refFile.getDims(refGroup + "/LEN_ELEC_DIPOLE");
+  ASSERT_EQ( resDims.size(), 2 );
+  ASSERT_EQ( resDims, refDims );
+
+  std::vector<double> x(resDims[0]), y(resDims[0]);
+  resFile.readData(resGroup + "/ENERGY", x.data());
+  refFile.readData(refGroup + "/ENERGY", y.data());
+
+  for(auto i = 0; i < x.size(); i++)
+    EXPECT_NEAR(x[i], y[i], tol) << "ENERGY " << i;
+
+  x.resize(3 * resDims[0]); y.resize(3 * resDims[0]);
+  resFile.readData(resGroup + "/LEN_ELEC_DIPOLE", x.data());
+  refFile.readData(refGroup + "/LEN_ELEC_DIPOLE", y.data());
+
+  for(auto i = 0; i < x.size(); i++)
+    EXPECT_NEAR(x[i], y[i], tol) << "LEN_ELEC_DIPOLE " << i;
+
+}
+
+// Compare the time series of two RT runs of the test suite, the group
+// resGroup of the result file to the group refGroup of the reference
+// file (e.g. a field replica to a separate run along its direction)
+inline void CQRTCompareSeries( std::string res, std::string resGroup,
+  std::string ref, std::string refGroup, double tol = 1e-8 ) {
+
+  CQRTCompareFiles(TEST_OUT + res + ".bin", resGroup,
+    TEST_OUT + ref + ".bin", refGroup, tol);
+
+}
+
+// Propagate the input mid and continue its checkpoint (in the same
+// binary file) with the restart input in. If interrupt is set, the
+// completion marker of the checkpoint is removed in between, as if the
+// last checkpoint write of mid had been interrupted
+inline void CQRTRestartRun( std::string mid, std::string in,
+  bool interrupt = false ) {
+
+  std::string binName = TEST_OUT + in + ".bin";
+  std::remove(binName.c_str());
+
+  RunChronusQ(TEST_ROOT + mid + ".inp", "STDOUT", binName, "");
+
+  if( interrupt ) {
+    SafeFile binFile(binName, false);
+    ASSERT_FALSE( binFile.getDims("RT/CHECKPOINT/STEP").empty() );
+    binFile.unlinkData("RT/CHECKPOINT/STEP");
+  }
+
+  RunChronusQ(TEST_ROOT + in + ".inp", "STDOUT", binName, "");
+
+}
+
+// Compare a (real) dataset of two RT runs of the test suite
+inline void CQRTCompareData( std::string res, std::string ref,
+  std::string dataSet, double tol = 1e-8 ) {
+
+  SafeFile resFile(TEST_OUT + res + ".bin", true);
+  SafeFile refFile(TEST_OUT + ref + ".bin", true);
+
+  auto dims = resFile.getDims(dataSet);
+  ASSERT_FALSE( dims.empty() ) << dataSet;
+  ASSERT_EQ( dims, refFile.getDims(dataSet) ) << dataSet;
+
+  size_t len = 1;
+  for(auto d : dims) len *= d;
+
+  std::vector<double> x(len), y(len);
+  resFile.readData(dataSet, x.data());
+  refFile.readData(dataSet, y.data());
+
+  for(auto i = 0; i < len; i++)
+    EXPECT_NEAR(x[i], y[i], tol) << dataSet << " " << i;
+
+}
+
+// Run the input single (along one direction) and compare it to the
+// field replica r of the run in
+inline void CQRTReplicaTest( std::string in, size_t r, std::string single ) {
+
+  RunChronusQ(TEST_ROOT + single + ".inp", "STDOUT",
+    TEST_OUT + single + ".bin", "");
+
+  CQRTCompareSeries(in, "/RT/REPLICA" + std::to_string(r), single, "/RT");
+
+}
+
+#endif
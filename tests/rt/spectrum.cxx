@@ -0,0 +1,146 @@
+/* 
+ *  This file is part of the Chronus Quantum (ChronusQ) software package
+ *  
+ *  Copyright (C) 2014-2022 Li Research Group (University of Washington)
+ *  
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *  
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *  
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *  
+ *  Contact the Developers:
+ *    E-Mail: xsli@uw.edu
+ *  
+ */
+
+
+#include "rt.hpp"
+#include <realtime/spectrum.hpp>
+
+// Induced dipole of two undamped modes along Y
+static std::array<double,3> twoModeDipole(double t) {
+  return { 0., 0.1 + 0.01 * std::sin(0.5 * t) + 0.005 * std::sin(1.2 * t), 0. };
+}
+
+// The damped Fourier transform of a long signal peaks at the mode
+// frequencies
+TEST( RT_SPECTRUM, TwoMode_FT ) {
+
+  SpectrumSettings set;
+  set.omegaMin = 0.;
+  set.omegaMax = 2.;
+  set.nOmega   = 401;
+  set.damping  = 0.02;
+
+  double dt = 0.05;
+  DipoleSpectrum spec(set, dt);
+
+  for(auto i = 0ul; i <= 8000; i++) spec.addSample(i * dt, twoModeDipole(i * dt));
+
+  auto peaks = spec.findPeaks(spec.dipFT);
+
+  ASSERT_EQ( peaks.size(), 2 );
+  EXPECT_NEAR( peaks[0], 0.5, 0.005 );
+  EXPECT_NEAR( peaks[1], 1.2, 0.005 );
+
+}
+
+// The Pade approximant resolves the same peaks from a short signal
+TEST( RT_SPECTRUM, TwoMode_Pade ) {
+
+  SpectrumSettings set;
+  set.omegaMin  = 0.;
+  set.omegaMax  = 2.;
+  set.nOmega    = 401;
+  set.damping   = 0.02;
+  set.padeOrder = 50;
+
+  double dt = 0.05;
+  DipoleSpectrum spec(set, dt);
+
+  for(auto i = 0ul; i <= 400; i++) spec.addSample(i * dt, twoModeDipole(i * dt));
+
+  auto peaks = spec.findPeaks(spec.pade());
+
+  ASSERT_EQ( peaks.size(), 2 );
+  EXPECT_NEAR( peaks[0], 0.5, 0.005 );
+  EXPECT_NEAR( peaks[1], 1.2, 0.005 );
+
+}
+
+#ifndef _CQ_GENERATE_TESTS
+
+// The spectrum written by the propagation is the transform of the
+// reference dipoles, and so are its peaks
+TEST( RT_SPECTRUM, Water_631Gd_Delta_Y ) {
+
+  RunChronusQ(TEST_ROOT "rt/serial/rrt/water_6-31Gd_rhf_delta_y_spectrum.inp",
+    "STDOUT", TEST_OUT "rt/serial/rrt/water_6-31Gd_rhf_delta_y_spectrum.bin", "");
+
+  SafeFile refFile(RT_TEST_REF "water_6-31Gd_rhf_delta_y.bin.ref", true);
+  SafeFile resFile(TEST_OUT "rt/serial/rrt/water_6-31Gd_rhf_delta_y_spectrum.bin",
+    true);
+
+  // Settings of the spectrum input
+  SpectrumSettings set;
+  set.omegaMin  = 0.;
+  set.omegaMax  = 2.;
+  set.nOmega    = 200;
+  set.padeOrder = 10;
+
+  auto nT = refFile.getDims("/RT/TIME")[0];
+  std::vector<double> time(nT);
+  std::vector<std::array<double,3>> dipole(nT);
+  refFile.readData("/RT/TIME", time.data());
+  refFile.readData("/RT/LEN_ELEC_DIPOLE", &dipole[0][0]);
+
+  double dt = time[1] - time[0];
+  DipoleSpectrum refSpec(set, dt);
+
+  std::vector<std::array<dcomplex,3>> refFT(set.nOmega, {0.,0.,0.});
+  for(auto i = 0ul; i < nT; i++) {
+    refSpec.addSample(time[i], dipole[i]);
+    for(auto j = 0ul; j < set.nOmega; j++)
+    for(auto k = 0; k < 3; k++)
+      refFT[j][k] += std::polar(dt, refSpec.omega[j] * time[i]) *
+        (dipole[i][k] - dipole[0][k]) * std::exp(-set.damping * time[i]);
+  }
+
+  ASSERT_EQ( resFile.getDims("/RT/SPECTRUM/DIPOLE_FT"),
+    std::vector<hsize_t>({set.nOmega, 3}) );
+
+  std::vector<double> omega(set.nOmega);
+  std::vector<std::array<dcomplex,3>> resFT(set.nOmega), resPade(set.nOmega);
+  resFile.readData("/RT/SPECTRUM/FREQUENCY", omega.data());
+  resFile.readData("/RT/SPECTRUM/DIPOLE_FT", &resFT[0][0]);
+  resFile.readData("/RT/SPECTRUM/DIPOLE_PADE", &resPade[0][0]);
+
+  for(auto j = 0ul; j < set.nOmega; j++) {
+    EXPECT_NEAR( omega[j], refSpec.omega[j], 1e-12 );
+    for(auto k = 0; k < 3; k++)
+      EXPECT_NEAR( std::abs(resFT[j][k] - refFT[j][k]), 0., 1e-7 );
+  }
+
+  // Peak positions agree to the grid spacing
+  double dOmega = omega[1] - omega[0];
+  auto comparePeaks = [&](std::vector<double> res, std::vector<double> ref) {
+    ASSERT_EQ( res.size(), ref.size() );
+    for(auto i = 0ul; i < res.size(); i++)
+      EXPECT_NEAR( res[i], ref[i], 1.01 * dOmega );
+  };
+
+  comparePeaks(refSpec.findPeaks(resFT), refSpec.findPeaks(refFT));
+  comparePeaks(refSpec.findPeaks(resPade), refSpec.findPeaks(refSpec.pade()));
+
+}
+
+#endif
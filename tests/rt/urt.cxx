@@ -34,6 +34,39 @@ TEST( UHF_RT, O2_631Gd_Delta_Y ) {
 
 }
 
+// Oxygen 6-31G(d) Delta Spike with Y and X replicas (batched G[D] of
+// the unrestricted densities)
+TEST( UHF_RT, O2_631Gd_Delta_Y_Polarization ) {
+
+  CQRTTEST( rt/serial/urt/oxygen_6-31Gd_uhf_delta_y_polarization,
+    oxygen_6-31Gd_uhf_delta_y.bin.ref );
+
+#ifndef _CQ_GENERATE_TESTS
+  CQRTReplicaTest("rt/serial/urt/oxygen_6-31Gd_uhf_delta_y_polarization", 1,
+    "rt/serial/urt/oxygen_6-31Gd_uhf_delta_x");
+#endif
+
+}
+
+#ifndef _CQ_GENERATE_TESTS
+
+// Alpha and beta orbital populations of the occupied orbital
+// propagation must match the density propagation
+TEST( UHF_RT, O2_631Gd_Orbitals_Population ) {
+
+  std::string den = "rt/serial/urt/oxygen_6-31Gd_uhf_delta_y_pop";
+  std::string orb = "rt/serial/urt/oxygen_6-31Gd_uhf_delta_y_pop_orbitals";
+
+  RunChronusQ(TEST_ROOT + den + ".inp", "STDOUT", TEST_OUT + den + ".bin", "");
+  RunChronusQ(TEST_ROOT + orb + ".inp", "STDOUT", TEST_OUT + orb + ".bin", "");
+
+  CQRTCompareSeries(orb, "/RT", den, "/RT");
+  CQRTCompareData(orb, den, "/RT/ORBITALPOPULATION");
+
+}
+
+#endif
+
 // Magnus 2 delta electric field
 TEST( UHF_RT, O2_631Gd_Magnus2 ) {
 